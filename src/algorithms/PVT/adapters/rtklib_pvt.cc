@@ -443,6 +443,94 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         }
 
     // RTKLIB PVT solver options
+    const prcopt_t rtklib_configuration_options = get_rtklib_options(configuration, role);
+    rtkinit(&rtk, &rtklib_configuration_options);
+
+    // Outputs
+    const bool default_output_enabled = configuration->property(role + ".output_enabled", true);
+    pvt_output_parameters.output_enabled = default_output_enabled;
+    pvt_output_parameters.rinex_output_enabled = configuration->property(role + ".rinex_output_enabled", default_output_enabled);
+    pvt_output_parameters.gpx_output_enabled = configuration->property(role + ".gpx_output_enabled", default_output_enabled);
+    pvt_output_parameters.geojson_output_enabled = configuration->property(role + ".geojson_output_enabled", default_output_enabled);
+    pvt_output_parameters.kml_output_enabled = configuration->property(role + ".kml_output_enabled", default_output_enabled);
+    pvt_output_parameters.xml_output_enabled = configuration->property(role + ".xml_output_enabled", default_output_enabled);
+    pvt_output_parameters.nmea_output_file_enabled = configuration->property(role + ".nmea_output_file_enabled", default_output_enabled);
+    pvt_output_parameters.rtcm_output_file_enabled = configuration->property(role + ".rtcm_output_file_enabled", false);
+
+    const std::string default_output_path = configuration->property(role + ".output_path", std::string("."));
+    pvt_output_parameters.output_path = default_output_path;
+    pvt_output_parameters.rinex_output_path = configuration->property(role + ".rinex_output_path", default_output_path);
+    pvt_output_parameters.gpx_output_path = configuration->property(role + ".gpx_output_path", default_output_path);
+    pvt_output_parameters.geojson_output_path = configuration->property(role + ".geojson_output_path", default_output_path);
+    pvt_output_parameters.kml_output_path = configuration->property(role + ".kml_output_path", default_output_path);
+    pvt_output_parameters.xml_output_path = configuration->property(role + ".xml_output_path", default_output_path);
+    pvt_output_parameters.nmea_output_file_path = configuration->property(role + ".nmea_output_file_path", default_output_path);
+    pvt_output_parameters.rtcm_output_file_path = configuration->property(role + ".rtcm_output_file_path", default_output_path);
+
+    // Read PVT MONITOR Configuration
+    pvt_output_parameters.monitor_enabled = configuration->property(role + ".enable_monitor", false);
+    pvt_output_parameters.udp_addresses = configuration->property(role + ".monitor_client_addresses", std::string("127.0.0.1"));
+    pvt_output_parameters.udp_port = configuration->property(role + ".monitor_udp_port", 1234);
+    pvt_output_parameters.protobuf_enabled = configuration->property(role + ".enable_protobuf", true);
+    if (configuration->property("Monitor.enable_protobuf", false) == true)
+        {
+            pvt_output_parameters.protobuf_enabled = true;
+        }
+
+    // Read EPHEMERIS MONITOR Configuration
+    pvt_output_parameters.monitor_ephemeris_enabled = configuration->property(role + ".enable_monitor_ephemeris", false);
+    pvt_output_parameters.udp_eph_addresses = configuration->property(role + ".monitor_ephemeris_client_addresses", std::string("127.0.0.1"));
+    pvt_output_parameters.udp_eph_port = configuration->property(role + ".monitor_ephemeris_udp_port", 1234);
+
+    // Show time in local zone
+    pvt_output_parameters.show_local_time_zone = configuration->property(role + ".show_local_time_zone", false);
+
+    // Enable or disable rx clock correction in observables
+    pvt_output_parameters.enable_rx_clock_correction = configuration->property(role + ".enable_rx_clock_correction", false);
+
+    // Set maximum clock offset allowed if pvt_output_parameters.enable_rx_clock_correction = false
+    pvt_output_parameters.max_obs_block_rx_clock_offset_ms = configuration->property(role + ".max_clock_offset_ms", pvt_output_parameters.max_obs_block_rx_clock_offset_ms);
+
+
+    // Source timetag
+    pvt_output_parameters.log_source_timetag = configuration->property(role + ".log_timetag", pvt_output_parameters.log_source_timetag);
+    pvt_output_parameters.log_source_timetag_file = configuration->property(role + ".log_source_timetag_file", pvt_output_parameters.log_source_timetag_file);
+
+    // Observables and navigation data log, to solve them again offline
+    pvt_output_parameters.log_observables = configuration->property(role + ".log_observables", pvt_output_parameters.log_observables);
+    pvt_output_parameters.log_observables_file = configuration->property(role + ".log_observables_file", pvt_output_parameters.log_observables_file);
+
+    // make PVT object
+    pvt_ = rtklib_make_pvt_gs(in_streams_, pvt_output_parameters, rtk);
+    DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
+    if (out_streams_ > 0)
+        {
+            LOG(ERROR) << "The PVT block does not have an output stream";
+        }
+}
+
+
+Rtklib_Pvt::~Rtklib_Pvt()
+{
+    DLOG(INFO) << "PVT adapter destructor called.";
+    rtkfree(&rtk);
+}
+
+
+prcopt_t Rtklib_Pvt::get_rtklib_options(const ConfigurationInterface* configuration, const std::string& role)
+{
+    const int gps_1C_count = configuration->property("Channels_1C.count", 0);
+    const int gps_2S_count = configuration->property("Channels_2S.count", 0);
+    const int gps_L5_count = configuration->property("Channels_L5.count", 0);
+    const int gal_1B_count = configuration->property("Channels_1B.count", 0);
+    const int gal_E5a_count = configuration->property("Channels_5X.count", 0);
+    const int gal_E5b_count = configuration->property("Channels_7X.count", 0);
+    const int gal_E6_count = configuration->property("Channels_E6.count", 0);
+    const int glo_1G_count = configuration->property("Channels_1G.count", 0);
+    const int glo_2G_count = configuration->property("Channels_2G.count", 0);
+    const int bds_B1_count = configuration->property("Channels_B1.count", 0);
+    const int bds_B3_count = configuration->property("Channels_B3.count", 0);
+
     // Settings 1
     int positioning_mode = -1;
     const std::string default_pos_mode("Single");
@@ -806,72 +894,7 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         {}                                                                                 /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
     };
 
-    rtkinit(&rtk, &rtklib_configuration_options);
-
-    // Outputs
-    const bool default_output_enabled = configuration->property(role + ".output_enabled", true);
-    pvt_output_parameters.output_enabled = default_output_enabled;
-    pvt_output_parameters.rinex_output_enabled = configuration->property(role + ".rinex_output_enabled", default_output_enabled);
-    pvt_output_parameters.gpx_output_enabled = configuration->property(role + ".gpx_output_enabled", default_output_enabled);
-    pvt_output_parameters.geojson_output_enabled = configuration->property(role + ".geojson_output_enabled", default_output_enabled);
-    pvt_output_parameters.kml_output_enabled = configuration->property(role + ".kml_output_enabled", default_output_enabled);
-    pvt_output_parameters.xml_output_enabled = configuration->property(role + ".xml_output_enabled", default_output_enabled);
-    pvt_output_parameters.nmea_output_file_enabled = configuration->property(role + ".nmea_output_file_enabled", default_output_enabled);
-    pvt_output_parameters.rtcm_output_file_enabled = configuration->property(role + ".rtcm_output_file_enabled", false);
-
-    const std::string default_output_path = configuration->property(role + ".output_path", std::string("."));
-    pvt_output_parameters.output_path = default_output_path;
-    pvt_output_parameters.rinex_output_path = configuration->property(role + ".rinex_output_path", default_output_path);
-    pvt_output_parameters.gpx_output_path = configuration->property(role + ".gpx_output_path", default_output_path);
-    pvt_output_parameters.geojson_output_path = configuration->property(role + ".geojson_output_path", default_output_path);
-    pvt_output_parameters.kml_output_path = configuration->property(role + ".kml_output_path", default_output_path);
-    pvt_output_parameters.xml_output_path = configuration->property(role + ".xml_output_path", default_output_path);
-    pvt_output_parameters.nmea_output_file_path = configuration->property(role + ".nmea_output_file_path", default_output_path);
-    pvt_output_parameters.rtcm_output_file_path = configuration->property(role + ".rtcm_output_file_path", default_output_path);
-
-    // Read PVT MONITOR Configuration
-    pvt_output_parameters.monitor_enabled = configuration->property(role + ".enable_monitor", false);
-    pvt_output_parameters.udp_addresses = configuration->property(role + ".monitor_client_addresses", std::string("127.0.0.1"));
-    pvt_output_parameters.udp_port = configuration->property(role + ".monitor_udp_port", 1234);
-    pvt_output_parameters.protobuf_enabled = configuration->property(role + ".enable_protobuf", true);
-    if (configuration->property("Monitor.enable_protobuf", false) == true)
-        {
-            pvt_output_parameters.protobuf_enabled = true;
-        }
-
-    // Read EPHEMERIS MONITOR Configuration
-    pvt_output_parameters.monitor_ephemeris_enabled = configuration->property(role + ".enable_monitor_ephemeris", false);
-    pvt_output_parameters.udp_eph_addresses = configuration->property(role + ".monitor_ephemeris_client_addresses", std::string("127.0.0.1"));
-    pvt_output_parameters.udp_eph_port = configuration->property(role + ".monitor_ephemeris_udp_port", 1234);
-
-    // Show time in local zone
-    pvt_output_parameters.show_local_time_zone = configuration->property(role + ".show_local_time_zone", false);
-
-    // Enable or disable rx clock correction in observables
-    pvt_output_parameters.enable_rx_clock_correction = configuration->property(role + ".enable_rx_clock_correction", false);
-
-    // Set maximum clock offset allowed if pvt_output_parameters.enable_rx_clock_correction = false
-    pvt_output_parameters.max_obs_block_rx_clock_offset_ms = configuration->property(role + ".max_clock_offset_ms", pvt_output_parameters.max_obs_block_rx_clock_offset_ms);
-
-
-    // Source timetag
-    pvt_output_parameters.log_source_timetag = configuration->property(role + ".log_timetag", pvt_output_parameters.log_source_timetag);
-    pvt_output_parameters.log_source_timetag_file = configuration->property(role + ".log_source_timetag_file", pvt_output_parameters.log_source_timetag_file);
-
-    // make PVT object
-    pvt_ = rtklib_make_pvt_gs(in_streams_, pvt_output_parameters, rtk);
-    DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
-    if (out_streams_ > 0)
-        {
-            LOG(ERROR) << "The PVT block does not have an output stream";
-        }
-}
-
-
-Rtklib_Pvt::~Rtklib_Pvt()
-{
-    DLOG(INFO) << "PVT adapter destructor called.";
-    rtkfree(&rtk);
+    return rtklib_configuration_options;
 }
 
 
@@ -169,6 +169,9 @@ class Gps_Ephemeris;
  *  .show_local_time_zone - (false)
  *  .enable_rx_clock_correction - (false)
  *  .max_clock_offset_ms - (40)
+ *
+ *  .log_observables - log the observables and the navigation data used by the solver (false)
+ *  .log_observables_file - ("./pvt_observables.dat"), to be solved again with pvt-batch
  */
 class Rtklib_Pvt : public PvtInterface
 {
@@ -220,6 +223,13 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) override;
 
+    /*!
+     * \brief Reads the options of the RTKLIB solver of the PVT block \p role
+     * from \p configuration, as this block does. Used to solve recorded
+     * observables with the configuration of a receiver.
+     */
+    static prcopt_t get_rtklib_options(const ConfigurationInterface* configuration, const std::string& role);
+
 private:
     rtklib_pvt_gs_sptr pvt_;
     rtk_t rtk{};
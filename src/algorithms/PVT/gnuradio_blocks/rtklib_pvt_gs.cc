@@ -32,6 +32,7 @@
 #include "glonass_gnav_almanac.h"
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
+#include "gnss_block_profiler.h"
 #include "gnss_frequencies.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
@@ -52,6 +53,7 @@
 #include "monitor_pvt_udp_sink.h"
 #include "nmea_printer.h"
 #include "pvt_conf.h"
+#include "pvt_observables_log.h"
 #include "rinex_printer.h"
 #include "rtcm_printer.h"
 #include "rtklib_rtkcmn.h"
@@ -171,6 +173,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
       d_an_printer_enabled(conf_.an_output_enabled),
       d_log_timetag(conf_.log_source_timetag)
 {
+    d_profiler_stats = Gnss_Block_Profiler::instance().register_block(this->name(), static_cast<uint32_t>(this->unique_id()));
     // Send feedback message to observables block with the receiver clock offset
     this->message_port_register_out(pmt::mp("pvt_to_observables"));
     // Experimental: VLT commands from PVT to tracking channels
@@ -296,14 +299,24 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_nmea_output_file_enabled = false;
         }
 
-    if (d_nmea_output_file_enabled)
+    // The file and the serial port are written by different sinks, so each
+    // one gets its own printer
+    if (d_nmea_output_file_enabled and conf_.nmea_output_file_enabled)
         {
-            d_nmea_printer = std::make_unique<Nmea_Printer>(conf_.nmea_dump_filename, conf_.nmea_output_file_enabled, conf_.flag_nmea_tty_port, conf_.nmea_dump_devname, conf_.nmea_output_file_path);
+            d_nmea_printer = std::make_unique<Nmea_Printer>(conf_.nmea_dump_filename, true, false, conf_.nmea_dump_devname, conf_.nmea_output_file_path);
         }
     else
         {
             d_nmea_printer = nullptr;
         }
+    if (d_nmea_output_file_enabled and conf_.flag_nmea_tty_port)
+        {
+            d_nmea_tty_printer = std::make_unique<Nmea_Printer>(conf_.nmea_dump_filename, false, true, conf_.nmea_dump_devname, conf_.nmea_output_file_path);
+        }
+    else
+        {
+            d_nmea_tty_printer = nullptr;
+        }
 
     // initialize rtcm_printer
     const std::string rtcm_dump_filename = d_dump_filename;
@@ -459,6 +472,38 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_udp_sink_ptr = nullptr;
         }
 
+    // Each output writes the solutions from its own thread. Files must not lose
+    // any epoch, devices and network clients only want the latest ones.
+    d_output_fanout = std::make_unique<Pvt_Output_Fanout>();
+    if (d_kml_output_enabled)
+        {
+            d_kml_sink = d_output_fanout->add_sink("KML", [this](const Pvt_Output_Snapshot& pvt) { d_kml_dump->print_position(&pvt, false); }, Pvt_Output_Fanout::Backpressure::BLOCK);
+        }
+    if (d_gpx_output_enabled)
+        {
+            d_gpx_sink = d_output_fanout->add_sink("GPX", [this](const Pvt_Output_Snapshot& pvt) { d_gpx_dump->print_position(&pvt, false); }, Pvt_Output_Fanout::Backpressure::BLOCK);
+        }
+    if (d_geojson_output_enabled)
+        {
+            d_geojson_sink = d_output_fanout->add_sink("GeoJSON", [this](const Pvt_Output_Snapshot& pvt) { d_geojson_printer->print_position(&pvt, false); }, Pvt_Output_Fanout::Backpressure::BLOCK);
+        }
+    if (d_nmea_printer)
+        {
+            d_nmea_sink = d_output_fanout->add_sink("NMEA", [this](const Pvt_Output_Snapshot& pvt) { d_nmea_printer->Print_Nmea_Line(&pvt, false); }, Pvt_Output_Fanout::Backpressure::BLOCK);
+        }
+    if (d_nmea_tty_printer)
+        {
+            d_nmea_tty_sink = d_output_fanout->add_sink("NMEA serial port", [this](const Pvt_Output_Snapshot& pvt) { d_nmea_tty_printer->Print_Nmea_Line(&pvt, false); }, Pvt_Output_Fanout::Backpressure::DROP_OLDEST);
+        }
+    if (d_an_printer_enabled)
+        {
+            d_an_sink = d_output_fanout->add_sink("AN packet", [this](const Pvt_Output_Snapshot& pvt) { d_an_printer->print_packet(&pvt, pvt.observables); }, Pvt_Output_Fanout::Backpressure::DROP_OLDEST);
+        }
+    if (d_flag_monitor_pvt_enabled)
+        {
+            d_monitor_sink = d_output_fanout->add_sink("PVT monitor", [this](const Pvt_Output_Snapshot& pvt) { d_udp_sink_ptr->write_monitor_pvt(&pvt.monitor_pvt); }, Pvt_Output_Fanout::Backpressure::DROP_OLDEST);
+        }
+
     // EPHEMERIS MONITOR
     if (d_flag_monitor_ephemeris_enabled)
         {
@@ -575,6 +620,21 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
                 }
         }
 
+    // observables and navigation data log
+    if (conf_.log_observables)
+        {
+            d_observables_log = std::make_unique<Pvt_Observables_Log_Writer>(conf_.log_observables_file);
+            if (d_observables_log->is_open())
+                {
+                    std::cout << "Log of PVT observables enabled, log file: " << conf_.log_observables_file << '\n';
+                }
+            else
+                {
+                    std::cerr << "Log of PVT observables " << conf_.log_observables_file << " cannot be created\n";
+                    d_observables_log.reset();
+                }
+        }
+
     d_start = std::chrono::system_clock::now();
 }
 
@@ -1187,10 +1247,15 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph);
                                 }
                         }
-                    d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
+                    d_internal_pvt_solver->store_ephemeris(*gps_eph);
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*gps_eph);
+                        }
+                    d_ephemeris_store.update(*gps_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
+                            d_user_pvt_solver->store_ephemeris(*gps_eph);
                         }
                     if (gps_eph->SV_health != 0)
                         {
@@ -1203,6 +1268,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS IONO ###
                     const auto gps_iono = wht::any_cast<std::shared_ptr<Gps_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_iono = *gps_iono;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*gps_iono);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->gps_iono = *gps_iono;
@@ -1214,6 +1283,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS UTC MODEL ###
                     const auto gps_utc_model = wht::any_cast<std::shared_ptr<Gps_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_utc_model = *gps_utc_model;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*gps_utc_model);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->gps_utc_model = *gps_utc_model;
@@ -1247,10 +1320,15 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph);
                                 }
                         }
-                    d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                    d_internal_pvt_solver->store_ephemeris(*gps_cnav_ephemeris);
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*gps_cnav_ephemeris);
+                        }
+                    d_ephemeris_store.update(*gps_cnav_ephemeris);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                            d_user_pvt_solver->store_ephemeris(*gps_cnav_ephemeris);
                         }
                     if (gps_cnav_ephemeris->signal_health != 0)
                         {
@@ -1264,6 +1342,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS CNAV IONO ###
                     const auto gps_cnav_iono = wht::any_cast<std::shared_ptr<Gps_CNAV_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*gps_cnav_iono);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
@@ -1275,6 +1357,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS CNAV UTC MODEL ###
                     const auto gps_cnav_utc_model = wht::any_cast<std::shared_ptr<Gps_CNAV_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*gps_cnav_utc_model);
+                        }
                     {
                         d_user_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
                     }
@@ -1331,10 +1417,15 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph);
                                 }
                         }
-                    d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                    d_internal_pvt_solver->store_ephemeris(*galileo_eph);
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*galileo_eph);
+                        }
+                    d_ephemeris_store.update(*galileo_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                            d_user_pvt_solver->store_ephemeris(*galileo_eph);
                         }
                     if (((galileo_eph->E1B_HS != 0) || (galileo_eph->E1B_DVS == true)) ||
                         ((galileo_eph->E5a_HS != 0) || (galileo_eph->E5a_DVS == true)) ||
@@ -1349,6 +1440,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### Galileo IONO ###
                     const auto galileo_iono = wht::any_cast<std::shared_ptr<Galileo_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->galileo_iono = *galileo_iono;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*galileo_iono);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->galileo_iono = *galileo_iono;
@@ -1360,6 +1455,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### Galileo UTC MODEL ###
                     const auto galileo_utc_model = wht::any_cast<std::shared_ptr<Galileo_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->galileo_utc_model = *galileo_utc_model;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*galileo_utc_model);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->galileo_utc_model = *galileo_utc_model;
@@ -1446,10 +1545,15 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph);
                                 }
                         }
-                    d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+                    d_internal_pvt_solver->store_ephemeris(*glonass_gnav_eph);
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*glonass_gnav_eph);
+                        }
+                    d_ephemeris_store.update(*glonass_gnav_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+                            d_user_pvt_solver->store_ephemeris(*glonass_gnav_eph);
                         }
                 }
             else if (msg_type_hash_code == d_glonass_gnav_utc_model_sptr_type_hash_code)
@@ -1457,6 +1561,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GLONASS GNAV UTC MODEL ###
                     const auto glonass_gnav_utc_model = wht::any_cast<std::shared_ptr<Glonass_Gnav_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*glonass_gnav_utc_model);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
@@ -1509,10 +1617,15 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph);
                                 }
                         }
-                    d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                    d_internal_pvt_solver->store_ephemeris(*bds_dnav_eph);
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*bds_dnav_eph);
+                        }
+                    d_ephemeris_store.update(*bds_dnav_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                            d_user_pvt_solver->store_ephemeris(*bds_dnav_eph);
                         }
                     if (bds_dnav_eph->SV_health != 0)
                         {
@@ -1525,6 +1638,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### BeiDou IONO ###
                     const auto bds_dnav_iono = wht::any_cast<std::shared_ptr<Beidou_Dnav_Iono>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*bds_dnav_iono);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
@@ -1536,6 +1653,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### BeiDou UTC MODEL ###
                     const auto bds_dnav_utc_model = wht::any_cast<std::shared_ptr<Beidou_Dnav_Utc_Model>>(pmt::any_ref(msg));
                     d_internal_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
+                    if (d_observables_log)
+                        {
+                            d_observables_log->write(*bds_dnav_utc_model);
+                        }
                     if (d_enable_rx_clock_correction == true)
                         {
                             d_user_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
@@ -1630,6 +1751,13 @@ void rtklib_pvt_gs::clear_ephemeris()
     d_internal_pvt_solver->galileo_almanac_map.clear();
     d_internal_pvt_solver->beidou_dnav_ephemeris_map.clear();
     d_internal_pvt_solver->beidou_dnav_almanac_map.clear();
+    d_ephemeris_store.clear(Pvt_Ephemeris_Store::GPS_LNAV);
+    d_ephemeris_store.clear(Pvt_Ephemeris_Store::GALILEO_NAV);
+    d_ephemeris_store.clear(Pvt_Ephemeris_Store::BEIDOU_DNAV);
+    if (d_observables_log)
+        {
+            d_observables_log->write_clear_ephemeris();
+        }
     if (d_enable_rx_clock_correction == true)
         {
             d_user_pvt_solver->gps_ephemeris_map.clear();
@@ -1946,6 +2074,7 @@ void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
 int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
+    const Gnss_Block_Timer profiler_timer(d_profiler_stats.get(), this->nitems_read(0), noutput_items);
     //**************** time tags ****************
     if (d_enable_rx_clock_correction == false)  // todo: currently only works if clock correction is disabled
         {
@@ -1986,6 +2115,16 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
             bool flag_write_RINEX_obs_output = false;
             d_local_counter_ms += static_cast<uint64_t>(d_observable_interval_ms);
 
+            // Copy of the solution handed to the outputs, made once per epoch if any of them needs it
+            std::shared_ptr<const Pvt_Output_Snapshot> output_snapshot;
+            const auto get_output_snapshot = [this, &output_snapshot]() -> const std::shared_ptr<const Pvt_Output_Snapshot>& {
+                if (!output_snapshot)
+                    {
+                        output_snapshot = std::make_shared<const Pvt_Output_Snapshot>(*d_user_pvt_solver, d_gnss_observables_map, static_cast<uint64_t>(d_rx_time * 1000.0));
+                    }
+                return output_snapshot;
+            };
+
             d_gnss_observables_map.clear();
             const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);  // Get the input buffer pointer
             // ############ 1. READ PSEUDORANGES ####
@@ -1993,59 +2132,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                 {
                     if (in[i][epoch].Flag_valid_pseudorange)
                         {
-                            const auto tmp_eph_iter_gps = d_internal_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_gal = d_internal_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_cnav = d_internal_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_glo_gnav = d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_bds_dnav = d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(in[i][epoch].PRN);
-
-                            bool store_valid_observable = false;
-
-                            if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_gps->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (std::string(in[i][epoch].Signal) == std::string("1C")) && (tmp_eph_iter_gps->second.SV_health == 0))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-                            if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_gal->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) &&
-                                        (((std::string(in[i][epoch].Signal) == std::string("1B")) && (tmp_eph_iter_gal->second.E1B_DVS == false) && (tmp_eph_iter_gal->second.E1B_HS == 0)) ||
-                                            ((std::string(in[i][epoch].Signal) == std::string("5X")) && (tmp_eph_iter_gal->second.E5a_DVS == false) && (tmp_eph_iter_gal->second.E5a_HS == 0)) ||
-                                            ((std::string(in[i][epoch].Signal) == std::string("7X")) && (tmp_eph_iter_gal->second.E5b_DVS == false) && (tmp_eph_iter_gal->second.E5b_HS == 0))))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-                            if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_cnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (((std::string(in[i][epoch].Signal) == std::string("2S")) || (std::string(in[i][epoch].Signal) == std::string("L5"))) && (tmp_eph_iter_cnav->second.signal_health == 0)))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-                            if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_glo_gnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && ((std::string(in[i][epoch].Signal) == std::string("1G")) || (std::string(in[i][epoch].Signal) == std::string("2G"))))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-                            if (tmp_eph_iter_bds_dnav != d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_bds_dnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (((std::string(in[i][epoch].Signal) == std::string("B1")) || (std::string(in[i][epoch].Signal) == std::string("B3"))) && (tmp_eph_iter_bds_dnav->second.SV_health == 0)))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-
-                            if (store_valid_observable)
+                            if (d_ephemeris_store.usable(in[i][epoch]))
                                 {
                                     // store valid observables in a map.
                                     d_gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, in[i][epoch]));
@@ -2055,33 +2142,22 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                 {
                                     try
                                         {
-                                            if (d_internal_pvt_solver->gps_ephemeris_map.empty() == false)
+                                            const uint32_t prn = in[i][epoch].PRN;
+                                            if (d_ephemeris_store.has(Pvt_Ephemeris_Store::GPS_LNAV, prn))
                                                 {
-                                                    if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_ephemeris_map.at(prn), in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                 }
-                                            if (d_internal_pvt_solver->galileo_ephemeris_map.empty() == false)
+                                            if (d_ephemeris_store.has(Pvt_Ephemeris_Store::GALILEO_NAV, prn))
                                                 {
-                                                    if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(d_internal_pvt_solver->galileo_ephemeris_map.at(prn), in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                 }
-                                            if (d_internal_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
+                                            if (d_ephemeris_store.has(Pvt_Ephemeris_Store::GPS_CNAV, prn))
                                                 {
-                                                    if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_cnav_ephemeris_map.at(prn), in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                 }
-                                            if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
+                                            if (d_ephemeris_store.has(Pvt_Ephemeris_Store::GLONASS_GNAV, prn))
                                                 {
-                                                    if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(d_internal_pvt_solver->glonass_gnav_ephemeris_map.at(prn), in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
                                                 }
                                         }
                                     catch (const boost::exception& ex)
@@ -2217,6 +2293,10 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     // compute on the fly PVT solution
                     if (flag_compute_pvt_output == true)
                         {
+                            if (d_observables_log)
+                                {
+                                    d_observables_log->write(d_gnss_observables_map);
+                                }
                             flag_pvt_valid = d_user_pvt_solver->get_PVT(d_gnss_observables_map, false);
                         }
 
@@ -2330,28 +2410,29 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                         {
                                             if (current_RX_time_ms % d_kml_rate_ms == 0)
                                                 {
-                                                    d_kml_dump->print_position(d_user_pvt_solver.get(), false);
+                                                    d_output_fanout->publish(d_kml_sink, get_output_snapshot());
                                                 }
                                         }
                                     if (d_gpx_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_gpx_rate_ms == 0)
                                                 {
-                                                    d_gpx_dump->print_position(d_user_pvt_solver.get(), false);
+                                                    d_output_fanout->publish(d_gpx_sink, get_output_snapshot());
                                                 }
                                         }
                                     if (d_geojson_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_geojson_rate_ms == 0)
                                                 {
-                                                    d_geojson_printer->print_position(d_user_pvt_solver.get(), false);
+                                                    d_output_fanout->publish(d_geojson_sink, get_output_snapshot());
                                                 }
                                         }
                                     if (d_nmea_output_file_enabled)
                                         {
                                             if (current_RX_time_ms % d_nmea_rate_ms == 0)
                                                 {
-                                                    d_nmea_printer->Print_Nmea_Line(d_user_pvt_solver.get(), false);
+                                                    d_output_fanout->publish(d_nmea_sink, get_output_snapshot());
+                                                    d_output_fanout->publish(d_nmea_tty_sink, get_output_snapshot());
                                                 }
                                         }
                                     if (d_rinex_output_enabled)
@@ -2447,7 +2528,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                 }
                             if (d_flag_monitor_pvt_enabled)
                                 {
-                                    d_udp_sink_ptr->write_monitor_pvt(monitor_pvt.get());
+                                    d_output_fanout->publish(d_monitor_sink, get_output_snapshot());
                                 }
                         }
                 }
@@ -2455,7 +2536,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                 {
                     if (d_local_counter_ms % static_cast<uint64_t>(d_an_rate_ms) == 0)
                         {
-                            d_an_printer->print_packet(d_user_pvt_solver.get(), d_gnss_observables_map);
+                            d_output_fanout->publish(d_an_sink, get_output_snapshot());
                         }
                 }
         }
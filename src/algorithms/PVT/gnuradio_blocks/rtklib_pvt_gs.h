@@ -20,6 +20,8 @@
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
+#include "pvt_ephemeris_store.h"
+#include "pvt_output_fanout.h"
 #include "rtklib.h"
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -50,6 +52,7 @@ class Beidou_Dnav_Ephemeris;
 class Galileo_Almanac;
 class Galileo_Ephemeris;
 class GeoJSON_Printer;
+class Gnss_Block_Stats;
 class Gps_Almanac;
 class Gps_Ephemeris;
 class Gpx_Printer;
@@ -58,6 +61,7 @@ class Monitor_Pvt_Udp_Sink;
 class Monitor_Ephemeris_Udp_Sink;
 class Nmea_Printer;
 class Pvt_Conf;
+class Pvt_Observables_Log_Writer;
 class Rinex_Printer;
 class Rtcm_Printer;
 class An_Packet_Printer;
@@ -177,12 +181,16 @@ private:
     std::unique_ptr<Kml_Printer> d_kml_dump;
     std::unique_ptr<Gpx_Printer> d_gpx_dump;
     std::unique_ptr<Nmea_Printer> d_nmea_printer;
+    std::unique_ptr<Nmea_Printer> d_nmea_tty_printer;
     std::unique_ptr<GeoJSON_Printer> d_geojson_printer;
     std::unique_ptr<Rtcm_Printer> d_rtcm_printer;
     std::unique_ptr<Monitor_Pvt_Udp_Sink> d_udp_sink_ptr;
     std::unique_ptr<Monitor_Ephemeris_Udp_Sink> d_eph_udp_sink_ptr;
     std::unique_ptr<Has_Simple_Printer> d_has_simple_printer;
     std::unique_ptr<An_Packet_Printer> d_an_printer;
+    std::unique_ptr<Pvt_Output_Fanout> d_output_fanout;  // destroyed before the printers it writes to
+    std::unique_ptr<Pvt_Observables_Log_Writer> d_observables_log;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     std::chrono::time_point<std::chrono::system_clock> d_start;
     std::chrono::time_point<std::chrono::system_clock> d_end;
@@ -215,6 +223,8 @@ private:
     std::map<int, Gnss_Synchro> d_gnss_observables_map_t0;
     std::map<int, Gnss_Synchro> d_gnss_observables_map_t1;
 
+    Pvt_Ephemeris_Store d_ephemeris_store;  // ephemerides of the internal solver, indexed by PRN
+
     std::queue<GnssTime> d_TimeChannelTagTimestamps;
 
     boost::posix_time::time_duration d_utc_diff_time;
@@ -264,6 +274,13 @@ private:
     int32_t d_display_rate_ms;
     int32_t d_report_rate_ms;
     int32_t d_max_obs_block_rx_clock_offset_ms;
+    int32_t d_kml_sink{-1};  // identifiers of the sinks in d_output_fanout
+    int32_t d_gpx_sink{-1};
+    int32_t d_geojson_sink{-1};
+    int32_t d_nmea_sink{-1};
+    int32_t d_nmea_tty_sink{-1};
+    int32_t d_an_sink{-1};
+    int32_t d_monitor_sink{-1};
 
     uint32_t d_nchannels;
     uint32_t d_type_of_rx;
@@ -0,0 +1,232 @@
+/*!
+ * \file pvt_batch_solver.cc
+ * \brief Solves the PVT of recorded observables, using all the cores
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_batch_solver.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_solver.h"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <thread>
+
+
+namespace
+{
+// Keeps the navigation data of a solver as they were when the PVT block
+// solved a given epoch, moving forwards or backwards in the recording
+class Navigation_Replay
+{
+public:
+    Navigation_Replay(const std::vector<Pvt_Navigation_Record>& records, Rtklib_Solver& solver)
+        : d_records(records), d_solver(solver)
+    {
+    }
+
+    // Applies the records received up to the epoch
+    void forward_to(std::size_t epoch)
+    {
+        while (d_applied < d_records.size() && d_records[d_applied].epoch <= epoch)
+            {
+                d_records[d_applied].store(d_solver);
+                d_applied++;
+            }
+    }
+
+    // Undoes the records received after the epoch
+    void backward_to(std::size_t epoch)
+    {
+        while (d_applied > 0 && d_records[d_applied - 1].epoch > epoch)
+            {
+                const Pvt_Navigation_Record& record = d_records[d_applied - 1];
+                if (record.previous >= 0)
+                    {
+                        d_records[record.previous].store(d_solver);
+                    }
+                else
+                    {
+                        record.reset(d_solver);
+                    }
+                d_applied--;
+            }
+    }
+
+private:
+    const std::vector<Pvt_Navigation_Record>& d_records;
+    Rtklib_Solver& d_solver;
+    std::size_t d_applied{0};  // number of records applied
+};
+
+
+// 3x3 position covariance matrix from the RTKLIB solution, and back
+std::array<double, 9> position_covariance(const sol_t& sol)
+{
+    return {{sol.qr[0], sol.qr[3], sol.qr[5],
+        sol.qr[3], sol.qr[1], sol.qr[4],
+        sol.qr[5], sol.qr[4], sol.qr[2]}};
+}
+
+
+void set_position_covariance(const std::array<double, 9>& Q, sol_t& sol)
+{
+    sol.qr[0] = static_cast<float>(Q[0]);
+    sol.qr[1] = static_cast<float>(Q[4]);
+    sol.qr[2] = static_cast<float>(Q[8]);
+    sol.qr[3] = static_cast<float>(Q[1]);
+    sol.qr[4] = static_cast<float>(Q[5]);
+    sol.qr[5] = static_cast<float>(Q[2]);
+}
+}  // namespace
+
+
+Pvt_Batch_Solver::Pvt_Batch_Solver(const prcopt_t& options,
+    bool pre_2009_file,
+    uint32_t num_threads,
+    bool smoothing)
+    : d_options(options),
+      d_num_threads(num_threads),
+      d_pre_2009_file(pre_2009_file),
+      d_smoothing(smoothing)
+{
+    if (d_num_threads == 0)
+        {
+            d_num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+}
+
+
+std::vector<Pvt_Batch_Solution> Pvt_Batch_Solver::solve(const Pvt_Recorded_Observables& recording) const
+{
+    const std::size_t num_epochs = recording.epochs.size();
+    std::vector<Pvt_Batch_Solution> solutions(num_epochs);
+    if (num_epochs == 0)
+        {
+            return solutions;
+        }
+
+    if (d_options.mode == PMODE_SINGLE)
+        {
+            // Each block starts without a previous position, which only
+            // costs a few more iterations in its first epoch
+            const std::size_t num_blocks = std::min<std::size_t>(d_num_threads, num_epochs);
+            std::vector<std::thread> threads;
+            threads.reserve(num_blocks);
+            for (std::size_t block = 0; block < num_blocks; block++)
+                {
+                    threads.emplace_back(&Pvt_Batch_Solver::solve_pass, this, std::cref(recording),
+                        num_epochs * block / num_blocks, num_epochs * (block + 1) / num_blocks,
+                        false, std::ref(solutions));
+                }
+            for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+        }
+    else if (d_smoothing && (d_options.mode == PMODE_KINEMA || d_options.mode == PMODE_PPP_KINEMA))
+        {
+            std::vector<Pvt_Batch_Solution> backward_solutions(num_epochs);
+            std::thread backward_thread(&Pvt_Batch_Solver::solve_pass, this, std::cref(recording),
+                0, num_epochs, true, std::ref(backward_solutions));
+            solve_pass(recording, 0, num_epochs, false, solutions);
+            backward_thread.join();
+            for (std::size_t epoch = 0; epoch < num_epochs; epoch++)
+                {
+                    solutions[epoch] = combine_pvt_solutions(solutions[epoch], backward_solutions[epoch]);
+                }
+        }
+    else
+        {
+            solve_pass(recording, 0, num_epochs, false, solutions);
+        }
+    return solutions;
+}
+
+
+void Pvt_Batch_Solver::solve_pass(const Pvt_Recorded_Observables& recording,
+    std::size_t first,
+    std::size_t last,
+    bool backward,
+    std::vector<Pvt_Batch_Solution>& solutions) const
+{
+    // Each pass needs its own filter state, the solver only copies the
+    // pointers of the one it is given
+    rtk_t rtk{};
+    rtkinit(&rtk, &d_options);
+    {
+        Rtklib_Solver solver(rtk, "", false, false);
+        solver.set_averaging_depth(1);
+        solver.set_pre_2009_file(d_pre_2009_file);
+        Navigation_Replay navigation(recording.navigation, solver);
+        if (backward)
+            {
+                navigation.forward_to(last - 1);
+            }
+        for (std::size_t i = first; i < last; i++)
+            {
+                const std::size_t epoch = backward ? first + last - 1 - i : i;
+                if (backward)
+                    {
+                        navigation.backward_to(epoch);
+                    }
+                else
+                    {
+                        navigation.forward_to(epoch);
+                    }
+                const std::map<int, Gnss_Synchro>& observables = recording.epochs[epoch];
+                if (observables.empty())
+                    {
+                        continue;
+                    }
+                Pvt_Batch_Solution& solution = solutions[epoch];
+                solution.rx_time = observables.cbegin()->second.RX_time;
+                solution.valid = solver.get_PVT(observables, false);
+                if (solution.valid)
+                    {
+                        solution.sol = solver.pvt_sol;
+                    }
+            }
+    }
+    rtkfree(&rtk);
+}
+
+
+Pvt_Batch_Solution combine_pvt_solutions(const Pvt_Batch_Solution& forward, const Pvt_Batch_Solution& backward)
+{
+    const bool forward_valid = forward.valid && forward.sol.stat != SOLQ_NONE;
+    const bool backward_valid = backward.valid && backward.sol.stat != SOLQ_NONE;
+    if (!forward_valid || !backward_valid)
+        {
+            return backward_valid ? backward : forward;
+        }
+    if (forward.sol.stat != backward.sol.stat)
+        {
+            return forward.sol.stat < backward.sol.stat ? forward : backward;  // SOLQ_FIX is the lowest
+        }
+
+    // Only the position is smoothed, there is no velocity covariance
+    Pvt_Batch_Solution combined = forward;
+    const std::array<double, 9> Qf = position_covariance(forward.sol);
+    const std::array<double, 9> Qb = position_covariance(backward.sol);
+    std::array<double, 3> xs{};
+    std::array<double, 9> Qs{};
+    if (smoother(forward.sol.rr, Qf.data(), backward.sol.rr, Qb.data(), 3, xs.data(), Qs.data()) == 0)
+        {
+            std::copy(xs.cbegin(), xs.cend(), combined.sol.rr);
+            set_position_covariance(Qs, combined.sol);
+        }
+    return combined;
+}
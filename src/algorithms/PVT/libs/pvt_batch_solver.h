@@ -0,0 +1,96 @@
+/*!
+ * \file pvt_batch_solver.h
+ * \brief Solves the PVT of recorded observables, using all the cores
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_BATCH_SOLVER_H
+#define GNSS_SDR_PVT_BATCH_SOLVER_H
+
+#include "pvt_observables_log.h"
+#include "rtklib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Solution of a recorded epoch
+ */
+struct Pvt_Batch_Solution
+{
+    sol_t sol{};          //!< RTKLIB solution
+    double rx_time{0.0};  //!< Receiver time of the observables [s]
+    bool valid{false};    //!< False if the epoch could not be solved
+};
+
+
+/*!
+ * \brief Solves again the epochs of a Pvt_Recorded_Observables log, each one
+ * with the navigation data that the PVT block had when it solved it.
+ *
+ * The work is split according to the positioning mode:
+ *  - Single: the epochs do not depend on each other, so they are split in
+ *    contiguous blocks solved in parallel, one per thread.
+ *  - Kinematic and PPP kinematic: the Kalman filter runs forwards and
+ *    backwards over the whole recording in two threads, and the positions
+ *    of both passes are combined at each epoch (forward-backward smoothing).
+ *  - Static modes, PPP static included: a single filter accumulates all the
+ *    epochs, so they are solved in order in the calling thread.
+ */
+class Pvt_Batch_Solver
+{
+public:
+    /*!
+     * \brief \p num_threads limits the threads used in single mode, 0 for
+     * one per core. \p smoothing enables the backward pass in kinematic
+     * modes.
+     */
+    Pvt_Batch_Solver(const prcopt_t& options,
+        bool pre_2009_file = false,
+        uint32_t num_threads = 0,
+        bool smoothing = true);
+
+    std::vector<Pvt_Batch_Solution> solve(const Pvt_Recorded_Observables& recording) const;
+
+private:
+    // Solves the epochs [first, last) in order, forwards or backwards
+    void solve_pass(const Pvt_Recorded_Observables& recording,
+        std::size_t first,
+        std::size_t last,
+        bool backward,
+        std::vector<Pvt_Batch_Solution>& solutions) const;
+
+    prcopt_t d_options;
+    uint32_t d_num_threads;
+    bool d_pre_2009_file;
+    bool d_smoothing;
+};
+
+
+/*!
+ * \brief Combines the positions of a forward and a backward pass of the
+ * same epoch, weighting them with their covariances. If only one of them is
+ * valid, or their quality differs, the best one is taken.
+ */
+Pvt_Batch_Solution combine_pvt_solutions(const Pvt_Batch_Solution& forward, const Pvt_Batch_Solution& backward);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_BATCH_SOLVER_H
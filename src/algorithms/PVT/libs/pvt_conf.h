@@ -91,6 +91,8 @@ public:
     bool dump_mat = true;
     bool log_source_timetag;
     std::string log_source_timetag_file;
+    bool log_observables = false;
+    std::string log_observables_file = std::string("./pvt_observables.dat");
 };
 
 
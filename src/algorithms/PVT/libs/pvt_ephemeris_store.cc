@@ -0,0 +1,110 @@
+/*!
+ * \file pvt_ephemeris_store.cc
+ * \brief Flat index of the ephemerides available to the PVT block and of the
+ * signals that can be used for navigation
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_ephemeris_store.h"
+#include "beidou_dnav_ephemeris.h"
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+
+
+void Pvt_Ephemeris_Store::update(const Gps_Ephemeris& eph)
+{
+    set(GPS_LNAV, eph.PRN, eph.SV_health == 0 ? SIGNAL_1C : 0U);
+}
+
+
+void Pvt_Ephemeris_Store::update(const Gps_CNAV_Ephemeris& eph)
+{
+    set(GPS_CNAV, eph.PRN, eph.signal_health == 0 ? SIGNAL_2S | SIGNAL_L5 : 0U);
+}
+
+
+void Pvt_Ephemeris_Store::update(const Galileo_Ephemeris& eph)
+{
+    uint16_t usable_signals = 0U;
+    if (!eph.E1B_DVS && eph.E1B_HS == 0)
+        {
+            usable_signals |= SIGNAL_1B;
+        }
+    if (!eph.E5a_DVS && eph.E5a_HS == 0)
+        {
+            usable_signals |= SIGNAL_5X;
+        }
+    if (!eph.E5b_DVS && eph.E5b_HS == 0)
+        {
+            usable_signals |= SIGNAL_7X;
+        }
+    set(GALILEO_NAV, eph.PRN, usable_signals);
+}
+
+
+void Pvt_Ephemeris_Store::update(const Glonass_Gnav_Ephemeris& eph)
+{
+    // GLONASS observables are used as long as there is an ephemeris
+    set(GLONASS_GNAV, eph.PRN, SIGNAL_1G | SIGNAL_2G);
+}
+
+
+void Pvt_Ephemeris_Store::update(const Beidou_Dnav_Ephemeris& eph)
+{
+    set(BEIDOU_DNAV, eph.PRN, eph.SV_health == 0 ? SIGNAL_B1 | SIGNAL_B3 : 0U);
+}
+
+
+void Pvt_Ephemeris_Store::clear(Nav_Source source)
+{
+    const auto keep_signals = static_cast<uint16_t>(~source_signals(source));
+    const auto keep_sources = static_cast<uint8_t>(~(1U << source));
+    for (uint32_t prn = 0; prn < MAX_PRN; prn++)
+        {
+            d_usable_signals[prn] &= keep_signals;
+            d_sources[prn] &= keep_sources;
+        }
+}
+
+
+uint16_t Pvt_Ephemeris_Store::source_signals(Nav_Source source)
+{
+    switch (source)
+        {
+        case GPS_LNAV:
+            return SIGNAL_1C;
+        case GPS_CNAV:
+            return SIGNAL_2S | SIGNAL_L5;
+        case GALILEO_NAV:
+            return SIGNAL_1B | SIGNAL_5X | SIGNAL_7X;
+        case GLONASS_GNAV:
+            return SIGNAL_1G | SIGNAL_2G;
+        case BEIDOU_DNAV:
+            return SIGNAL_B1 | SIGNAL_B3;
+        default:
+            return 0U;
+        }
+}
+
+
+void Pvt_Ephemeris_Store::set(Nav_Source source, uint32_t prn, uint16_t usable_signals)
+{
+    if (prn >= MAX_PRN)
+        {
+            return;
+        }
+    d_usable_signals[prn] = (d_usable_signals[prn] & static_cast<uint16_t>(~source_signals(source))) | usable_signals;
+    d_sources[prn] |= static_cast<uint8_t>(1U << source);
+}
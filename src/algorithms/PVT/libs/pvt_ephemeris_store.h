@@ -0,0 +1,147 @@
+/*!
+ * \file pvt_ephemeris_store.h
+ * \brief Flat index of the ephemerides available to the PVT block and of the
+ * signals that can be used for navigation
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_EPHEMERIS_STORE_H
+#define GNSS_SDR_PVT_EPHEMERIS_STORE_H
+
+#include "gnss_synchro.h"
+#include <array>
+#include <cstdint>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+class Beidou_Dnav_Ephemeris;
+class Galileo_Ephemeris;
+class Glonass_Gnav_Ephemeris;
+class Gps_CNAV_Ephemeris;
+class Gps_Ephemeris;
+
+/*!
+ * \brief Mirrors the ephemeris maps of the PVT solver in fixed-size arrays
+ * indexed by PRN.
+ *
+ * For each PRN, it keeps a bitmap of the navigation messages with an
+ * ephemeris, and a bitmap of the signals that are healthy according to it.
+ * Both are updated only when a new ephemeris arrives, so checking whether an
+ * observable can be used is reduced to two array reads, without map lookups
+ * or string comparisons.
+ */
+class Pvt_Ephemeris_Store
+{
+public:
+    enum Nav_Source : uint8_t
+    {
+        GPS_LNAV = 0,
+        GPS_CNAV,
+        GALILEO_NAV,
+        GLONASS_GNAV,
+        BEIDOU_DNAV
+    };
+
+    static constexpr uint32_t MAX_PRN = 64;  //!< PRNs (or GLONASS slots) from 0 to MAX_PRN - 1 are stored
+
+    Pvt_Ephemeris_Store() = default;
+
+    void update(const Gps_Ephemeris& eph);
+    void update(const Gps_CNAV_Ephemeris& eph);
+    void update(const Galileo_Ephemeris& eph);
+    void update(const Glonass_Gnav_Ephemeris& eph);
+    void update(const Beidou_Dnav_Ephemeris& eph);
+
+    void clear(Nav_Source source);  //!< Removes all the ephemerides of a navigation message
+
+    /*!
+     * \brief True if there is an ephemeris of \p source for satellite \p prn
+     */
+    inline bool has(Nav_Source source, uint32_t prn) const
+    {
+        return prn < MAX_PRN && ((d_sources[prn] >> source) & 1U) != 0;
+    }
+
+    /*!
+     * \brief True if there is an ephemeris for the satellite of the
+     * observable, and it flags its signal as healthy
+     */
+    inline bool usable(const Gnss_Synchro& gnss_synchro) const
+    {
+        return gnss_synchro.PRN < MAX_PRN && (d_usable_signals[gnss_synchro.PRN] & signal_bit(gnss_synchro.Signal)) != 0;
+    }
+
+    /*!
+     * \brief Bit assigned to a signal code (e.g. "1C"), or 0 for the codes
+     * not used by the PVT solver
+     */
+    static inline uint16_t signal_bit(const char* signal)
+    {
+        if (signal[0] == '\0' || signal[2] != '\0')
+            {
+                return 0;
+            }
+        switch ((signal[0] << 8) | signal[1])
+            {
+            case ('1' << 8) | 'C':
+                return SIGNAL_1C;
+            case ('2' << 8) | 'S':
+                return SIGNAL_2S;
+            case ('L' << 8) | '5':
+                return SIGNAL_L5;
+            case ('1' << 8) | 'B':
+                return SIGNAL_1B;
+            case ('5' << 8) | 'X':
+                return SIGNAL_5X;
+            case ('7' << 8) | 'X':
+                return SIGNAL_7X;
+            case ('1' << 8) | 'G':
+                return SIGNAL_1G;
+            case ('2' << 8) | 'G':
+                return SIGNAL_2G;
+            case ('B' << 8) | '1':
+                return SIGNAL_B1;
+            case ('B' << 8) | '3':
+                return SIGNAL_B3;
+            default:
+                return 0;
+            }
+    }
+
+private:
+    static constexpr uint16_t SIGNAL_1C = 1U << 0U;
+    static constexpr uint16_t SIGNAL_2S = 1U << 1U;
+    static constexpr uint16_t SIGNAL_L5 = 1U << 2U;
+    static constexpr uint16_t SIGNAL_1B = 1U << 3U;
+    static constexpr uint16_t SIGNAL_5X = 1U << 4U;
+    static constexpr uint16_t SIGNAL_7X = 1U << 5U;
+    static constexpr uint16_t SIGNAL_1G = 1U << 6U;
+    static constexpr uint16_t SIGNAL_2G = 1U << 7U;
+    static constexpr uint16_t SIGNAL_B1 = 1U << 8U;
+    static constexpr uint16_t SIGNAL_B3 = 1U << 9U;
+
+    static uint16_t source_signals(Nav_Source source);  // signals whose health is given by the source
+    void set(Nav_Source source, uint32_t prn, uint16_t usable_signals);
+
+    std::array<uint16_t, MAX_PRN> d_usable_signals{};
+    std::array<uint8_t, MAX_PRN> d_sources{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_EPHEMERIS_STORE_H
@@ -0,0 +1,524 @@
+/*!
+ * \file pvt_observables_log.cc
+ * \brief Compact binary log of the observables solved by the PVT block and of
+ * the navigation data it had when solving them
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_observables_log.h"
+#include "beidou_dnav_ephemeris.h"
+#include "beidou_dnav_iono.h"
+#include "beidou_dnav_utc_model.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include "rtklib_solver.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <glog/logging.h>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+const std::array<char, 8> LOG_MAGIC = {'G', 'S', 'D', 'R', 'O', 'B', 'S', '\0'};
+constexpr uint32_t LOG_VERSION = 1;
+
+// Record types
+constexpr uint8_t EPOCH = 0;
+constexpr uint8_t GPS_EPHEMERIS = 1;
+constexpr uint8_t GPS_CNAV_EPHEMERIS = 2;
+constexpr uint8_t GALILEO_EPHEMERIS = 3;
+constexpr uint8_t GLONASS_GNAV_EPHEMERIS = 4;
+constexpr uint8_t BEIDOU_DNAV_EPHEMERIS = 5;
+constexpr uint8_t GPS_IONO = 6;
+constexpr uint8_t GPS_UTC_MODEL = 7;
+constexpr uint8_t GPS_CNAV_IONO = 8;
+constexpr uint8_t GPS_CNAV_UTC_MODEL = 9;
+constexpr uint8_t GALILEO_IONO = 10;
+constexpr uint8_t GALILEO_UTC_MODEL = 11;
+constexpr uint8_t GLONASS_GNAV_UTC_MODEL = 12;
+constexpr uint8_t BEIDOU_DNAV_IONO = 13;
+constexpr uint8_t BEIDOU_DNAV_UTC_MODEL = 14;
+constexpr uint8_t CLEAR_EPHEMERIS = 15;  // no content
+
+// Ephemerides removed from the solver on a cold start
+bool cleared_on_cold_start(uint8_t type)
+{
+    return type == GPS_EPHEMERIS || type == GALILEO_EPHEMERIS || type == BEIDOU_DNAV_EPHEMERIS;
+}
+
+template <class T>
+void append(std::string& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+
+// Reads the values of a record, checking that they are inside of it
+class Record_Reader
+{
+public:
+    explicit Record_Reader(const std::string& record) : d_record(record) {}
+
+    template <class T>
+    bool read(T& value)
+    {
+        if (d_record.size() - d_offset < sizeof(T))
+            {
+                return false;
+            }
+        std::memcpy(&value, d_record.data() + d_offset, sizeof(T));
+        d_offset += sizeof(T);
+        return true;
+    }
+
+private:
+    const std::string& d_record;
+    std::size_t d_offset{0};
+};
+
+
+bool read_epoch(const std::string& record, std::map<int, Gnss_Synchro>& gnss_observables_map)
+{
+    Record_Reader reader(record);
+    uint32_t count = 0;
+    if (!reader.read(count))
+        {
+            return false;
+        }
+    for (uint32_t i = 0; i < count; i++)
+        {
+            int32_t channel = 0;
+            Gnss_Synchro observable{};
+            if (!(reader.read(channel) &&
+                    reader.read(observable.System) &&
+                    reader.read(observable.Signal[0]) &&
+                    reader.read(observable.Signal[1]) &&
+                    reader.read(observable.PRN) &&
+                    reader.read(observable.TOW_at_current_symbol_ms) &&
+                    reader.read(observable.Pseudorange_m) &&
+                    reader.read(observable.Carrier_phase_rads) &&
+                    reader.read(observable.Carrier_Doppler_hz) &&
+                    reader.read(observable.CN0_dB_hz) &&
+                    reader.read(observable.RX_time) &&
+                    reader.read(observable.interp_TOW_ms)))
+                {
+                    return false;
+                }
+            observable.Channel_ID = channel;
+            observable.Flag_valid_pseudorange = true;
+            gnss_observables_map[channel] = observable;
+        }
+    return true;
+}
+
+
+template <class T>
+bool read_navigation(const std::string& record, T& data)
+{
+    try
+        {
+            std::istringstream stream(record);
+            boost::archive::binary_iarchive archive{stream};
+            archive >> data;
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Error reading navigation data from the observables log: " << e.what();
+            return false;
+        }
+    return true;
+}
+
+
+// Last record of each message and satellite, to link the records that replace each other
+using Last_Records = std::map<std::pair<uint8_t, uint32_t>, int64_t>;
+
+void link(std::vector<Pvt_Navigation_Record>& navigation, Last_Records& last, uint8_t type, uint32_t prn)
+{
+    const auto key = std::make_pair(type, prn);
+    const auto it = last.find(key);
+    navigation.back().previous = it == last.cend() ? -1 : it->second;
+    last[key] = static_cast<int64_t>(navigation.size()) - 1;
+}
+
+
+template <class T>
+bool add_ephemeris(const std::string& record, uint8_t type, std::size_t epoch,
+    std::map<int, T> Rtklib_Solver::*ephemeris_map,
+    std::vector<Pvt_Navigation_Record>& navigation, Last_Records& last)
+{
+    T eph;
+    if (!read_navigation(record, eph))
+        {
+            return false;
+        }
+    const int prn = static_cast<int>(eph.PRN);
+    Pvt_Navigation_Record nav_record;
+    nav_record.epoch = epoch;
+    nav_record.store = [eph](Rtklib_Solver& solver) { solver.store_ephemeris(eph); };
+    nav_record.reset = [ephemeris_map, prn](Rtklib_Solver& solver) { (solver.*ephemeris_map).erase(prn); };
+    navigation.push_back(std::move(nav_record));
+    link(navigation, last, type, eph.PRN);
+    return true;
+}
+
+
+template <class T>
+bool add_model(const std::string& record, uint8_t type, std::size_t epoch,
+    T Rtklib_Solver::*model,
+    std::vector<Pvt_Navigation_Record>& navigation, Last_Records& last)
+{
+    T data;
+    if (!read_navigation(record, data))
+        {
+            return false;
+        }
+    Pvt_Navigation_Record nav_record;
+    nav_record.epoch = epoch;
+    nav_record.store = [model, data](Rtklib_Solver& solver) { solver.*model = data; };
+    nav_record.reset = [model](Rtklib_Solver& solver) { solver.*model = T(); };
+    navigation.push_back(std::move(nav_record));
+    link(navigation, last, type, 0);
+    return true;
+}
+
+
+void add_clear_ephemeris(std::size_t epoch, std::vector<Pvt_Navigation_Record>& navigation, Last_Records& last)
+{
+    // Undoing the cold start restores the ephemerides in use before it, and
+    // undoing the ephemerides received after it leaves none
+    std::vector<std::function<void(Rtklib_Solver&)>> in_use;
+    for (auto it = last.begin(); it != last.end();)
+        {
+            if (cleared_on_cold_start(it->first.first))
+                {
+                    in_use.push_back(navigation[it->second].store);
+                    it = last.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    Pvt_Navigation_Record nav_record;
+    nav_record.epoch = epoch;
+    nav_record.store = [](Rtklib_Solver& solver) {
+        solver.gps_ephemeris_map.clear();
+        solver.galileo_ephemeris_map.clear();
+        solver.beidou_dnav_ephemeris_map.clear();
+    };
+    nav_record.reset = [in_use](Rtklib_Solver& solver) {
+        for (const auto& store : in_use)
+            {
+                store(solver);
+            }
+    };
+    navigation.push_back(std::move(nav_record));
+}
+}  // namespace
+
+
+Pvt_Observables_Log_Writer::Pvt_Observables_Log_Writer(const std::string& filename)
+    : d_filename(filename)
+{
+    d_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+        {
+            d_file.open(d_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+            d_file.write(LOG_MAGIC.data(), LOG_MAGIC.size());
+            d_file.write(reinterpret_cast<const char*>(&LOG_VERSION), sizeof(LOG_VERSION));
+        }
+    catch (const std::ofstream::failure& e)
+        {
+            LOG(WARNING) << "Cannot create the observables log " << d_filename << ": " << e.what();
+            d_file.exceptions(std::ofstream::goodbit);  // closing a failed stream must not throw
+            d_file.close();
+        }
+}
+
+
+void Pvt_Observables_Log_Writer::write(const std::map<int, Gnss_Synchro>& gnss_observables_map)
+{
+    d_record.clear();
+    append(d_record, static_cast<uint32_t>(gnss_observables_map.size()));
+    for (const auto& observable : gnss_observables_map)
+        {
+            const Gnss_Synchro& obs = observable.second;
+            append(d_record, static_cast<int32_t>(observable.first));
+            append(d_record, obs.System);
+            append(d_record, obs.Signal[0]);
+            append(d_record, obs.Signal[1]);
+            append(d_record, obs.PRN);
+            append(d_record, obs.TOW_at_current_symbol_ms);
+            append(d_record, obs.Pseudorange_m);
+            append(d_record, obs.Carrier_phase_rads);
+            append(d_record, obs.Carrier_Doppler_hz);
+            append(d_record, obs.CN0_dB_hz);
+            append(d_record, obs.RX_time);
+            append(d_record, obs.interp_TOW_ms);
+        }
+    write_record(EPOCH);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Gps_Ephemeris& eph)
+{
+    write_navigation(GPS_EPHEMERIS, eph);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Gps_CNAV_Ephemeris& eph)
+{
+    write_navigation(GPS_CNAV_EPHEMERIS, eph);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Galileo_Ephemeris& eph)
+{
+    write_navigation(GALILEO_EPHEMERIS, eph);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Glonass_Gnav_Ephemeris& eph)
+{
+    write_navigation(GLONASS_GNAV_EPHEMERIS, eph);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Beidou_Dnav_Ephemeris& eph)
+{
+    write_navigation(BEIDOU_DNAV_EPHEMERIS, eph);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Gps_Iono& iono)
+{
+    write_navigation(GPS_IONO, iono);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Gps_Utc_Model& utc_model)
+{
+    write_navigation(GPS_UTC_MODEL, utc_model);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Gps_CNAV_Iono& iono)
+{
+    write_navigation(GPS_CNAV_IONO, iono);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Gps_CNAV_Utc_Model& utc_model)
+{
+    write_navigation(GPS_CNAV_UTC_MODEL, utc_model);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Galileo_Iono& iono)
+{
+    write_navigation(GALILEO_IONO, iono);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Galileo_Utc_Model& utc_model)
+{
+    write_navigation(GALILEO_UTC_MODEL, utc_model);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Glonass_Gnav_Utc_Model& utc_model)
+{
+    write_navigation(GLONASS_GNAV_UTC_MODEL, utc_model);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Beidou_Dnav_Iono& iono)
+{
+    write_navigation(BEIDOU_DNAV_IONO, iono);
+}
+
+
+void Pvt_Observables_Log_Writer::write(const Beidou_Dnav_Utc_Model& utc_model)
+{
+    write_navigation(BEIDOU_DNAV_UTC_MODEL, utc_model);
+}
+
+
+void Pvt_Observables_Log_Writer::write_clear_ephemeris()
+{
+    d_clear_ephemeris = true;
+}
+
+
+template <class T>
+void Pvt_Observables_Log_Writer::write_navigation(uint8_t type, const T& data)
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    std::ostringstream stream;
+    {
+        boost::archive::binary_oarchive archive{stream};
+        archive << data;
+    }
+    d_record = stream.str();
+    write_record(type);
+}
+
+
+void Pvt_Observables_Log_Writer::write_record(uint8_t type)
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    try
+        {
+            if (d_clear_ephemeris.exchange(false))
+                {
+                    const uint32_t no_content = 0;
+                    d_file.write(reinterpret_cast<const char*>(&CLEAR_EPHEMERIS), sizeof(CLEAR_EPHEMERIS));
+                    d_file.write(reinterpret_cast<const char*>(&no_content), sizeof(no_content));
+                }
+            const auto size = static_cast<uint32_t>(d_record.size());
+            d_file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+            d_file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            d_file.write(d_record.data(), d_record.size());
+        }
+    catch (const std::ofstream::failure& e)
+        {
+            LOG(WARNING) << "Error writing to the observables log " << d_filename << ": " << e.what();
+            d_file.exceptions(std::ofstream::goodbit);
+            d_file.close();
+        }
+}
+
+
+bool Pvt_Recorded_Observables::read(const std::string& filename)
+{
+    epochs.clear();
+    navigation.clear();
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        {
+            LOG(WARNING) << "Cannot open the observables log " << filename;
+            return false;
+        }
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    if (!file.read(magic.data(), magic.size()) || magic != LOG_MAGIC ||
+        !file.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != LOG_VERSION)
+        {
+            LOG(WARNING) << filename << " is not a valid observables log";
+            return false;
+        }
+
+    Last_Records last;
+    std::string record;
+    while (true)
+        {
+            uint8_t type = 0;
+            uint32_t size = 0;
+            if (!file.read(reinterpret_cast<char*>(&type), sizeof(type)) ||
+                !file.read(reinterpret_cast<char*>(&size), sizeof(size)))
+                {
+                    break;
+                }
+            record.resize(size);
+            if (!file.read(&record[0], size))
+                {
+                    LOG(WARNING) << "Incomplete record at the end of the observables log " << filename;
+                    break;
+                }
+
+            bool valid = true;
+            const std::size_t epoch = epochs.size();
+            switch (type)
+                {
+                case EPOCH:
+                    epochs.emplace_back();
+                    valid = read_epoch(record, epochs.back());
+                    break;
+                case GPS_EPHEMERIS:
+                    valid = add_ephemeris(record, type, epoch, &Rtklib_Solver::gps_ephemeris_map, navigation, last);
+                    break;
+                case GPS_CNAV_EPHEMERIS:
+                    valid = add_ephemeris(record, type, epoch, &Rtklib_Solver::gps_cnav_ephemeris_map, navigation, last);
+                    break;
+                case GALILEO_EPHEMERIS:
+                    valid = add_ephemeris(record, type, epoch, &Rtklib_Solver::galileo_ephemeris_map, navigation, last);
+                    break;
+                case GLONASS_GNAV_EPHEMERIS:
+                    valid = add_ephemeris(record, type, epoch, &Rtklib_Solver::glonass_gnav_ephemeris_map, navigation, last);
+                    break;
+                case BEIDOU_DNAV_EPHEMERIS:
+                    valid = add_ephemeris(record, type, epoch, &Rtklib_Solver::beidou_dnav_ephemeris_map, navigation, last);
+                    break;
+                case GPS_IONO:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::gps_iono, navigation, last);
+                    break;
+                case GPS_UTC_MODEL:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::gps_utc_model, navigation, last);
+                    break;
+                case GPS_CNAV_IONO:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::gps_cnav_iono, navigation, last);
+                    break;
+                case GPS_CNAV_UTC_MODEL:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::gps_cnav_utc_model, navigation, last);
+                    break;
+                case GALILEO_IONO:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::galileo_iono, navigation, last);
+                    break;
+                case GALILEO_UTC_MODEL:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::galileo_utc_model, navigation, last);
+                    break;
+                case GLONASS_GNAV_UTC_MODEL:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::glonass_gnav_utc_model, navigation, last);
+                    break;
+                case BEIDOU_DNAV_IONO:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::beidou_dnav_iono, navigation, last);
+                    break;
+                case BEIDOU_DNAV_UTC_MODEL:
+                    valid = add_model(record, type, epoch, &Rtklib_Solver::beidou_dnav_utc_model, navigation, last);
+                    break;
+                case CLEAR_EPHEMERIS:
+                    add_clear_ephemeris(epoch, navigation, last);
+                    break;
+                default:
+                    DLOG(INFO) << "Unknown record type " << static_cast<int>(type) << " in the observables log";
+                    break;
+                }
+            if (!valid)
+                {
+                    LOG(WARNING) << "Invalid record in the observables log " << filename;
+                    return false;
+                }
+        }
+    return true;
+}
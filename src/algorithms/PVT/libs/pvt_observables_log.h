@@ -0,0 +1,140 @@
+/*!
+ * \file pvt_observables_log.h
+ * \brief Compact binary log of the observables solved by the PVT block and of
+ * the navigation data it had when solving them
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OBSERVABLES_LOG_H
+#define GNSS_SDR_PVT_OBSERVABLES_LOG_H
+
+#include "gnss_synchro.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+class Beidou_Dnav_Ephemeris;
+class Beidou_Dnav_Iono;
+class Beidou_Dnav_Utc_Model;
+class Galileo_Ephemeris;
+class Galileo_Iono;
+class Galileo_Utc_Model;
+class Glonass_Gnav_Ephemeris;
+class Glonass_Gnav_Utc_Model;
+class Gps_CNAV_Ephemeris;
+class Gps_CNAV_Iono;
+class Gps_CNAV_Utc_Model;
+class Gps_Ephemeris;
+class Gps_Iono;
+class Gps_Utc_Model;
+class Rtklib_Solver;
+
+/*!
+ * \brief Writes the observables passed to the PVT solver at each epoch, and
+ * the ephemerides and iono and UTC models as the PVT block receives them, so
+ * that the same epochs can be solved again offline (see Pvt_Batch_Solver).
+ *
+ * The file is a sequence of records, each one made of a type (1 byte), the
+ * size of its content (4 bytes) and the content. An epoch record keeps only
+ * the fields of each observable that the solver uses. The navigation data
+ * are serialized with Boost binary archives, so the log is meant to be read
+ * on the same platform that wrote it.
+ */
+class Pvt_Observables_Log_Writer
+{
+public:
+    explicit Pvt_Observables_Log_Writer(const std::string& filename);
+
+    inline bool is_open() const { return d_file.is_open(); }
+
+    void write(const std::map<int, Gnss_Synchro>& gnss_observables_map);  //!< Writes an epoch
+
+    void write(const Gps_Ephemeris& eph);
+    void write(const Gps_CNAV_Ephemeris& eph);
+    void write(const Galileo_Ephemeris& eph);
+    void write(const Glonass_Gnav_Ephemeris& eph);
+    void write(const Beidou_Dnav_Ephemeris& eph);
+    void write(const Gps_Iono& iono);
+    void write(const Gps_Utc_Model& utc_model);
+    void write(const Gps_CNAV_Iono& iono);
+    void write(const Gps_CNAV_Utc_Model& utc_model);
+    void write(const Galileo_Iono& iono);
+    void write(const Galileo_Utc_Model& utc_model);
+    void write(const Glonass_Gnav_Utc_Model& utc_model);
+    void write(const Beidou_Dnav_Iono& iono);
+    void write(const Beidou_Dnav_Utc_Model& utc_model);
+
+    /*!
+     * \brief Records that the GPS, Galileo and BeiDou ephemerides were
+     * cleared (cold start). The record is written before the next one, so
+     * this can be called from any thread.
+     */
+    void write_clear_ephemeris();
+
+private:
+    template <class T>
+    void write_navigation(uint8_t type, const T& data);
+    void write_record(uint8_t type);
+
+    std::ofstream d_file;
+    std::string d_filename;
+    std::string d_record;  // content of the record being written, reused
+    std::atomic<bool> d_clear_ephemeris{false};
+};
+
+
+/*!
+ * \brief Navigation data read from the log. It applies from the epoch
+ * \p epoch on, until the next record for the same message and satellite.
+ */
+struct Pvt_Navigation_Record
+{
+    std::size_t epoch{0};                       //!< Index of the first epoch solved with these data
+    int64_t previous{-1};                       //!< Index of the former record of the same message and satellite, -1 if none
+    std::function<void(Rtklib_Solver&)> store;  //!< Hands the data to a solver
+    std::function<void(Rtklib_Solver&)> reset;  //!< Removes the data from a solver
+};
+
+
+/*!
+ * \brief Contents of a log written by Pvt_Observables_Log_Writer
+ */
+class Pvt_Recorded_Observables
+{
+public:
+    /*!
+     * \brief Reads the log \p filename. Returns false if it cannot be read
+     * or it is not a valid log. A record truncated at the end of the file,
+     * as left by a receiver that did not stop cleanly, is ignored.
+     */
+    bool read(const std::string& filename);
+
+    std::vector<std::map<int, Gnss_Synchro>> epochs;  //!< Observables of each epoch, by channel
+    std::vector<Pvt_Navigation_Record> navigation;    //!< In the order in which they were received
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_OBSERVABLES_LOG_H
@@ -0,0 +1,239 @@
+/*!
+ * \file pvt_output_fanout.cc
+ * \brief Delivers the PVT solutions to the output printers, each one running
+ * in its own thread
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_output_fanout.h"
+#include "gnss_sdr_make_unique.h"
+#include "rtklib_solver.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+
+Pvt_Output_Snapshot::Pvt_Output_Snapshot(const Rtklib_Solver& solver,
+    const std::map<int, Gnss_Synchro>& gnss_observables_map,
+    uint64_t rx_time_ms)
+    : Pvt_Solution(solver),
+      pvt_sol(solver.pvt_sol),
+      pvt_ssat(solver.pvt_ssat),
+      monitor_pvt(solver.get_monitor_pvt()),
+      observables(gnss_observables_map),
+      rx_time_ms(rx_time_ms),
+      d_dop{solver.get_gdop(), solver.get_pdop(), solver.get_hdop(), solver.get_vdop()}
+{
+}
+
+
+Pvt_Output_Fanout::~Pvt_Output_Fanout()
+{
+    stop();
+    if (!d_sinks.empty())
+        {
+            LOG(INFO) << "PVT outputs:\n"
+                      << report();
+        }
+}
+
+
+int32_t Pvt_Output_Fanout::add_sink(const std::string& name,
+    Sink_Function function,
+    Backpressure backpressure,
+    std::size_t capacity)
+{
+    d_sinks.push_back(std::make_unique<Sink>(name, std::move(function), backpressure, capacity));
+    return static_cast<int32_t>(d_sinks.size()) - 1;
+}
+
+
+void Pvt_Output_Fanout::publish(int32_t sink, const std::shared_ptr<const Pvt_Output_Snapshot>& snapshot)
+{
+    if (sink >= 0 && sink < static_cast<int32_t>(d_sinks.size()))
+        {
+            d_sinks[sink]->push(snapshot);
+        }
+}
+
+
+void Pvt_Output_Fanout::stop()
+{
+    for (auto& sink : d_sinks)
+        {
+            sink->stop();
+        }
+}
+
+
+Pvt_Output_Fanout::Sink_Stats Pvt_Output_Fanout::stats(int32_t sink) const
+{
+    if (sink >= 0 && sink < static_cast<int32_t>(d_sinks.size()))
+        {
+            return d_sinks[sink]->stats();
+        }
+    return Sink_Stats();
+}
+
+
+std::string Pvt_Output_Fanout::report() const
+{
+    std::stringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << std::left << std::setw(24) << "Output" << std::right
+           << std::setw(12) << "Published"
+           << std::setw(12) << "Written"
+           << std::setw(12) << "Dropped"
+           << std::setw(12) << "Blocked [ms]"
+           << std::setw(14) << "Mean lat. [us]"
+           << std::setw(14) << "Max lat. [us]" << '\n';
+    for (const auto& sink : d_sinks)
+        {
+            const Sink_Stats stats = sink->stats();
+            report << std::left << std::setw(24) << stats.name << std::right
+                   << std::setw(12) << stats.published
+                   << std::setw(12) << stats.written
+                   << std::setw(12) << stats.dropped
+                   << std::setw(12) << static_cast<double>(stats.blocked_ns) / 1e6
+                   << std::setw(14) << static_cast<double>(stats.mean_latency_ns) / 1e3
+                   << std::setw(14) << static_cast<double>(stats.max_latency_ns) / 1e3 << '\n';
+        }
+    return report.str();
+}
+
+
+Pvt_Output_Fanout::Sink::Sink(std::string name,
+    Sink_Function function,
+    Backpressure backpressure,
+    std::size_t capacity)
+    : d_ring(std::max<std::size_t>(capacity, 1)),
+      d_name(std::move(name)),
+      d_function(std::move(function)),
+      d_backpressure(backpressure)
+{
+    d_thread = std::thread(&Pvt_Output_Fanout::Sink::run, this);
+}
+
+
+Pvt_Output_Fanout::Sink::~Sink()
+{
+    stop();
+}
+
+
+void Pvt_Output_Fanout::Sink::push(const std::shared_ptr<const Pvt_Output_Snapshot>& snapshot)
+{
+    const int64_t publish_ns = now_ns();
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if (d_head - d_tail == d_ring.size())
+        {
+            if (d_backpressure == Backpressure::BLOCK)
+                {
+                    d_cv_not_full.wait(lock, [this] { return d_stop || d_head - d_tail < d_ring.size(); });
+                    add(d_blocked_ns, now_ns() - publish_ns);
+                }
+            else
+                {
+                    d_ring[d_tail % d_ring.size()].snapshot.reset();
+                    d_tail++;
+                    add(d_dropped, 1);
+                }
+        }
+    if (d_stop)
+        {
+            return;
+        }
+    d_ring[d_head % d_ring.size()] = Entry{snapshot, publish_ns};
+    d_head++;
+    add(d_published, 1);
+    lock.unlock();
+    d_cv_not_empty.notify_one();
+}
+
+
+void Pvt_Output_Fanout::Sink::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv_not_empty.notify_one();
+    d_cv_not_full.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+}
+
+
+Pvt_Output_Fanout::Sink_Stats Pvt_Output_Fanout::Sink::stats() const
+{
+    Sink_Stats stats;
+    stats.name = d_name;
+    stats.published = d_published.load(std::memory_order_relaxed);
+    stats.written = d_written.load(std::memory_order_relaxed);
+    stats.dropped = d_dropped.load(std::memory_order_relaxed);
+    stats.blocked_ns = d_blocked_ns.load(std::memory_order_relaxed);
+    stats.mean_latency_ns = stats.written > 0 ? d_latency_ns.load(std::memory_order_relaxed) / stats.written : 0;
+    stats.max_latency_ns = d_max_latency_ns.load(std::memory_order_relaxed);
+    return stats;
+}
+
+
+void Pvt_Output_Fanout::Sink::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cv_not_empty.wait(lock, [this] { return d_stop || d_tail < d_head; });
+            if (d_tail == d_head)
+                {
+                    break;  // stopped, and all the queued snapshots have been written
+                }
+            Entry entry = std::move(d_ring[d_tail % d_ring.size()]);
+            d_tail++;
+            lock.unlock();
+            d_cv_not_full.notify_one();
+
+            try
+                {
+                    d_function(*entry.snapshot);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Error in the " << d_name << " output: " << e.what();
+                }
+            const auto latency_ns = static_cast<uint64_t>(now_ns() - entry.publish_ns);
+            add(d_written, 1);
+            add(d_latency_ns, latency_ns);
+            if (latency_ns > d_max_latency_ns.load(std::memory_order_relaxed))
+                {
+                    d_max_latency_ns.store(latency_ns, std::memory_order_relaxed);
+                }
+            entry.snapshot.reset();
+            lock.lock();
+        }
+}
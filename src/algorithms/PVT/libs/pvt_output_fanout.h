@@ -0,0 +1,192 @@
+/*!
+ * \file pvt_output_fanout.h
+ * \brief Delivers the PVT solutions to the output printers, each one running
+ * in its own thread
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OUTPUT_FANOUT_H
+#define GNSS_SDR_PVT_OUTPUT_FANOUT_H
+
+#include "gnss_synchro.h"
+#include "monitor_pvt.h"
+#include "pvt_solution.h"
+#include "rtklib.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+class Rtklib_Solver;
+
+/*!
+ * \brief Copy of the state of the PVT solver after an epoch, with everything
+ * the output printers need from it. It is not modified once created, so it
+ * can be shared by several threads while the solver goes on with the next
+ * epochs.
+ */
+class Pvt_Output_Snapshot : public Pvt_Solution
+{
+public:
+    Pvt_Output_Snapshot(const Rtklib_Solver& solver,
+        const std::map<int, Gnss_Synchro>& gnss_observables_map,
+        uint64_t rx_time_ms);
+
+    double get_hdop() const override { return d_dop[2]; }
+    double get_vdop() const override { return d_dop[3]; }
+    double get_pdop() const override { return d_dop[1]; }
+    double get_gdop() const override { return d_dop[0]; }
+
+    const sol_t pvt_sol;                            //!< RTKLIB solution
+    const std::array<ssat_t, MAXSAT> pvt_ssat;      //!< RTKLIB satellite status
+    const Monitor_Pvt monitor_pvt;                  //!< Monitoring message of the solution
+    const std::map<int, Gnss_Synchro> observables;  //!< Observables used by the solver, by channel
+    const uint64_t rx_time_ms;                      //!< Receiver time of the epoch [ms]
+
+private:
+    const std::array<double, 4> d_dop;  // GDOP, PDOP, HDOP, VDOP
+};
+
+
+/*!
+ * \brief Fans out the PVT solutions to a set of sinks (KML, GPX, NMEA, the
+ * PVT monitor, ...), each one served by its own thread.
+ *
+ * The PVT block publishes a shared, immutable snapshot of each solution to
+ * the sinks that must output it. Each sink keeps the snapshots in a ring
+ * buffer of fixed capacity, from which its thread takes them in order. What
+ * happens when the ring is full depends on the sink:
+ *  - BLOCK: the publisher waits for a free slot. Used by the sinks writing
+ *    files, which must not lose any solution, for instance when processing
+ *    a file faster than real time.
+ *  - DROP_OLDEST: the oldest queued snapshot is discarded. Used by the
+ *    sinks writing to devices or to the network, for which only the latest
+ *    solutions matter, so that a slow serial port or a stuck client never
+ *    delays the PVT computation.
+ *
+ * Each sink measures the number of snapshots written and dropped, and the
+ * latency from publication to the end of the write.
+ */
+class Pvt_Output_Fanout
+{
+public:
+    enum class Backpressure
+    {
+        BLOCK,
+        DROP_OLDEST
+    };
+
+    using Sink_Function = std::function<void(const Pvt_Output_Snapshot&)>;
+
+    struct Sink_Stats
+    {
+        std::string name;
+        uint64_t published{0};   // snapshots handed to the sink
+        uint64_t written{0};     // snapshots processed by the sink
+        uint64_t dropped{0};     // snapshots discarded because the ring was full
+        uint64_t blocked_ns{0};  // time spent by the publisher waiting for the sink
+        uint64_t mean_latency_ns{0};
+        uint64_t max_latency_ns{0};
+    };
+
+    Pvt_Output_Fanout() = default;
+    ~Pvt_Output_Fanout();  //!< Writes the queued snapshots and joins the threads
+
+    Pvt_Output_Fanout(const Pvt_Output_Fanout&) = delete;
+    Pvt_Output_Fanout& operator=(const Pvt_Output_Fanout&) = delete;
+
+    /*!
+     * \brief Adds a sink and starts its thread. Returns the identifier to be
+     * used in publish(). Sinks must be added before publishing.
+     */
+    int32_t add_sink(const std::string& name,
+        Sink_Function function,
+        Backpressure backpressure,
+        std::size_t capacity = 64);
+
+    /*!
+     * \brief Queues \p snapshot for the sink \p sink. Ignored if \p sink is
+     * not a valid identifier.
+     */
+    void publish(int32_t sink, const std::shared_ptr<const Pvt_Output_Snapshot>& snapshot);
+
+    void stop();  //!< Writes the queued snapshots and stops all the sinks
+
+    Sink_Stats stats(int32_t sink) const;
+
+    std::string report() const;  //!< Table with the statistics of all the sinks
+
+private:
+    class Sink
+    {
+    public:
+        Sink(std::string name, Sink_Function function, Backpressure backpressure, std::size_t capacity);
+        ~Sink();
+        void push(const std::shared_ptr<const Pvt_Output_Snapshot>& snapshot);
+        void stop();
+        Sink_Stats stats() const;
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<const Pvt_Output_Snapshot> snapshot;
+            int64_t publish_ns;
+        };
+
+        static inline void add(std::atomic<uint64_t>& counter, uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void run();
+
+        std::vector<Entry> d_ring;
+        std::string d_name;
+        Sink_Function d_function;
+        std::mutex d_mutex;
+        std::condition_variable d_cv_not_empty;
+        std::condition_variable d_cv_not_full;
+        std::thread d_thread;
+        uint64_t d_head{0};                         // number of snapshots pushed
+        uint64_t d_tail{0};                         // number of snapshots taken or dropped
+        std::atomic<uint64_t> d_published{0};       // written by the publisher
+        std::atomic<uint64_t> d_dropped{0};         // written by the publisher
+        std::atomic<uint64_t> d_blocked_ns{0};      // written by the publisher
+        std::atomic<uint64_t> d_written{0};         // written by the sink thread
+        std::atomic<uint64_t> d_latency_ns{0};      // written by the sink thread, sum over all the snapshots
+        std::atomic<uint64_t> d_max_latency_ns{0};  // written by the sink thread
+        Backpressure d_backpressure;
+        bool d_stop{false};
+    };
+
+    std::vector<std::unique_ptr<Sink>> d_sinks;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_OUTPUT_FANOUT_H
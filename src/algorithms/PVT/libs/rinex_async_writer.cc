@@ -0,0 +1,208 @@
+/*!
+ * \file rinex_async_writer.cc
+ * \brief Background writer of RINEX records, and the reusable buffer in which
+ * they are formatted
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rinex_async_writer.h"
+#include <glog/logging.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>   // for strerror
+#include <fcntl.h>   // for open
+#include <unistd.h>  // for write, fsync, close
+#include <utility>   // for move
+
+
+Rinex_Async_Writer::Rinex_Async_Writer(const std::string& filename,
+    uint32_t sync_period_ms,
+    std::size_t write_threshold)
+    : d_filename(filename),
+      d_write_threshold(write_threshold),
+      d_sync_period_ms(sync_period_ms)
+{
+    d_fd = ::open(d_filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0666);
+    if (d_fd < 0)
+        {
+            LOG(WARNING) << "Cannot open " << d_filename << " for writing: " << std::strerror(errno);
+            return;
+        }
+    // Room for the text queued while the writer thread is busy with the previous block
+    d_pending.reserve(2 * d_write_threshold);
+    d_writing.reserve(2 * d_write_threshold);
+    d_thread = std::thread(&Rinex_Async_Writer::run, this);
+}
+
+
+Rinex_Async_Writer::~Rinex_Async_Writer()
+{
+    if (d_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_cv_pending.notify_one();
+            d_thread.join();
+        }
+    if (d_fd >= 0)
+        {
+            ::close(d_fd);
+        }
+}
+
+
+void Rinex_Async_Writer::write(const std::string& text)
+{
+    if (d_fd < 0 || text.empty())
+        {
+            return;
+        }
+    bool wake_up = false;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_pending.append(text);
+        wake_up = d_pending.size() >= d_write_threshold;
+    }
+    if (wake_up)
+        {
+            d_cv_pending.notify_one();
+        }
+}
+
+
+void Rinex_Async_Writer::execute(std::function<void()> command)
+{
+    if (d_fd < 0)
+        {
+            // no writer thread, and nothing queued
+            command();
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_pending_commands.emplace_back(d_pending.size(), std::move(command));
+    }
+    d_cv_pending.notify_one();
+}
+
+
+void Rinex_Async_Writer::flush()
+{
+    if (d_fd < 0)
+        {
+            return;
+        }
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if (d_pending.empty() && d_pending_commands.empty() && !d_writing_busy)
+        {
+            return;
+        }
+    d_flush_requested = true;
+    d_cv_pending.notify_one();
+    d_cv_written.wait(lock, [this] { return d_pending.empty() && d_pending_commands.empty() && !d_writing_busy; });
+}
+
+
+uint64_t Rinex_Async_Writer::bytes_written()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_bytes_written;
+}
+
+
+void Rinex_Async_Writer::run()
+{
+    const auto sync_period = std::chrono::milliseconds(d_sync_period_ms);
+    auto next_sync = std::chrono::steady_clock::now() + sync_period;
+    bool unsynced = false;
+
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cv_pending.wait_until(lock, next_sync, [this] { return d_stop || d_flush_requested || !d_pending_commands.empty() || d_pending.size() >= d_write_threshold; });
+            const auto now = std::chrono::steady_clock::now();
+            const bool sync_due = now >= next_sync;
+            const bool stop = d_stop;
+            d_writing.swap(d_pending);
+            d_running_commands.swap(d_pending_commands);
+            d_flush_requested = false;
+            d_writing_busy = true;
+            lock.unlock();
+
+            // Each command runs once the text queued before it is in the file
+            std::size_t written = 0;
+            std::size_t position = 0;
+            for (auto& command : d_running_commands)
+                {
+                    if (command.first > position)
+                        {
+                            written += write_to_file(d_writing.data() + position, command.first - position);
+                            position = command.first;
+                        }
+                    command.second();
+                    unsynced = true;
+                }
+            if (d_writing.size() > position)
+                {
+                    written += write_to_file(d_writing.data() + position, d_writing.size() - position);
+                    unsynced = true;
+                }
+            if (unsynced && (sync_due || stop))
+                {
+                    if (::fsync(d_fd) != 0)
+                        {
+                            LOG(WARNING) << "Error syncing " << d_filename << ": " << std::strerror(errno);
+                        }
+                    unsynced = false;
+                }
+
+            lock.lock();
+            d_bytes_written += written;
+            d_writing.clear();
+            d_running_commands.clear();
+            d_writing_busy = false;
+            if (sync_due)
+                {
+                    next_sync = now + sync_period;
+                }
+            d_cv_written.notify_all();
+            if (stop && d_pending.empty() && d_pending_commands.empty())
+                {
+                    break;
+                }
+        }
+}
+
+
+std::size_t Rinex_Async_Writer::write_to_file(const char* data, std::size_t size)
+{
+    std::size_t remaining = size;
+    while (remaining > 0)
+        {
+            const ssize_t written = ::write(d_fd, data, remaining);
+            if (written < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    LOG(WARNING) << "Error writing to " << d_filename << ": " << std::strerror(errno);
+                    break;
+                }
+            data += written;
+            remaining -= static_cast<std::size_t>(written);
+        }
+    return size - remaining;
+}
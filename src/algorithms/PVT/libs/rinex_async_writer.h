@@ -0,0 +1,154 @@
+/*!
+ * \file rinex_async_writer.h
+ * \brief Background writer of RINEX records, and the reusable buffer in which
+ * they are formatted
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RINEX_ASYNC_WRITER_H
+#define GNSS_SDR_RINEX_ASYNC_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Stream buffer that appends the formatted text to a string. Clearing
+ * it keeps the allocated memory, so a buffer used for every epoch stops
+ * allocating once it has grown to the size of the largest epoch.
+ */
+class Rinex_Text_Buffer : public std::streambuf
+{
+public:
+    explicit Rinex_Text_Buffer(std::size_t capacity = 16384)
+    {
+        d_text.reserve(capacity);
+    }
+
+    inline const std::string& str() const { return d_text; }
+    inline bool empty() const { return d_text.empty(); }
+    inline void clear() { d_text.clear(); }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                d_text.push_back(traits_type::to_char_type(c));
+            }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type* s, std::streamsize n) override
+    {
+        d_text.append(s, static_cast<std::size_t>(n));
+        return n;
+    }
+
+private:
+    std::string d_text;
+};
+
+
+/*!
+ * \brief Appends text to a file from a background thread.
+ *
+ * The text handed to write() is copied into a pending buffer, and the calling
+ * thread returns without touching the file. The writer thread writes the
+ * pending text in a single call when it exceeds \p write_threshold bytes, when
+ * flush() is called, or after \p sync_period_ms milliseconds, and then calls
+ * fsync() so the file is on disk at least once per period. The file is opened
+ * in append mode, so other streams can keep writing to it, as long as they
+ * call flush() before doing so, and commands queued with execute() can
+ * rewrite it in place.
+ */
+class Rinex_Async_Writer
+{
+public:
+    explicit Rinex_Async_Writer(const std::string& filename,
+        uint32_t sync_period_ms = 1000,
+        std::size_t write_threshold = 65536);
+
+    /*!
+     * \brief Writes all the pending text, syncs the file and closes it.
+     */
+    ~Rinex_Async_Writer();
+
+    Rinex_Async_Writer(const Rinex_Async_Writer&) = delete;
+    Rinex_Async_Writer& operator=(const Rinex_Async_Writer&) = delete;
+
+    /*!
+     * \brief Queues \p text to be appended to the file. Never waits for the
+     * disk.
+     */
+    void write(const std::string& text);
+
+    /*!
+     * \brief Queues \p command to be run by the writer thread once the text
+     * queued before it is in the file. The command can rewrite the file, as
+     * long as it keeps the same name and inode (e.g., by truncating it).
+     * Never waits for the disk.
+     */
+    void execute(std::function<void()> command);
+
+    /*!
+     * \brief Waits until all the queued text has been written to the file,
+     * and all the queued commands have been run.
+     */
+    void flush();
+
+    inline bool is_open() const { return d_fd >= 0; }
+
+    uint64_t bytes_written();  //!< Bytes successfully written to the file so far
+
+private:
+    void run();
+    std::size_t write_to_file(const char* data, std::size_t size);  // called without holding d_mutex
+
+    using Command = std::pair<std::size_t, std::function<void()>>;  // position in the text, command
+
+    std::string d_pending;                    // written by the callers of write()
+    std::string d_writing;                    // owned by the writer thread
+    std::vector<Command> d_pending_commands;  // written by the callers of execute()
+    std::vector<Command> d_running_commands;  // owned by the writer thread
+    std::mutex d_mutex;
+    std::condition_variable d_cv_pending;  // wakes up the writer thread
+    std::condition_variable d_cv_written;  // wakes up the callers of flush()
+    std::thread d_thread;
+    std::string d_filename;
+    uint64_t d_bytes_written{0};
+    std::size_t d_write_threshold;
+    uint32_t d_sync_period_ms;
+    int d_fd{-1};
+    bool d_flush_requested{false};
+    bool d_writing_busy{false};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RINEX_ASYNC_WRITER_H
@@ -30,6 +30,7 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
@@ -58,7 +59,8 @@
 
 Rinex_Printer::Rinex_Printer(int32_t conf_version,
     const std::string& base_path,
-    const std::string& base_name) : d_fake_cnav_iode(1),
+    const std::string& base_name) : d_obs_stream(&d_obs_buffer),
+                                    d_fake_cnav_iode(1),
                                     d_numberTypesObservations(4),
                                     d_rinex_header_updated(false),
                                     d_rinex_header_written(false),
@@ -194,6 +196,7 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
     Rinex_Printer::navMixFile.open(navMixfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::navGloFile.open(navGlofilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::navBdsFile.open(navBdsfilename, std::ios::out | std::ios::in | std::ios::app);
+    d_obs_writer = std::make_unique<Rinex_Async_Writer>(obsfilename);
 
     if (!Rinex_Printer::navFile.is_open() or !Rinex_Printer::obsFile.is_open() or
         !Rinex_Printer::sbsFile.is_open() or !Rinex_Printer::navGalFile.is_open() or
@@ -218,6 +221,8 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
 Rinex_Printer::~Rinex_Printer()
 {
     DLOG(INFO) << "RINEX printer destructor called.";
+    // write the observation epochs still queued
+    d_obs_writer.reset();
     // close RINEX files
     const auto posn = navFile.tellp();
     const auto poso = obsFile.tellp();
@@ -782,6 +787,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 default:
                     break;
                 }
+            if (d_rinex_header_written)
+                {
+                    // The header must be in the file before d_obs_writer appends the first epoch
+                    obsFile.flush();
+                }
         }
     if (d_rinex_header_written)  // The header is already written, we can now log the navigation message data
         {
@@ -799,7 +809,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 1:  // GPS L1 C/A only
                             if (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -812,7 +822,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 3:  // GPS L5
                             if (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
@@ -824,7 +834,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 4:  // Galileo E1B only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -836,7 +846,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 5:  // Galileo E5a only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -848,7 +858,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 6:  // Galileo E5b only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -860,7 +870,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 7:  // GPS L1 C/A + GPS L2C
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -872,7 +882,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 8:  // L1+L5
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and ((pvt_solver->gps_cnav_utc_model.A0 != 0) or (pvt_solver->gps_utc_model.A0 != 0)))
                                         {
                                             if (pvt_solver->gps_cnav_utc_model.A0 != 0)
@@ -892,7 +902,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 9:  // GPS L1 C/A + Galileo E1B
                             if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -904,7 +914,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 13:  // L5+E5a
                             if ((gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0) and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -916,7 +926,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 14:  // Galileo E1B + Galileo E5a
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -928,7 +938,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 15:  // Galileo E1B + Galileo E5b
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -940,7 +950,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 23:  // GLONASS L1 C/A only
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C");
+                                    log_rinex_obs(d_obs_stream, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
@@ -952,7 +962,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 24:  // GLONASS L2 C/A only
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "2C");
+                                    log_rinex_obs(d_obs_stream, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "2C");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
@@ -964,7 +974,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 25:  // GLONASS L1 C/A + GLONASS L2 C/A
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C 2C");
+                                    log_rinex_obs(d_obs_stream, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C 2C");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
@@ -976,7 +986,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 26:  // GPS L1 C/A + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -988,7 +998,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 27:  // Galileo E1B + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1000,7 +1010,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 28:  // GPS L2C + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
@@ -1012,7 +1022,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 29:  // GPS L1 C/A + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1024,7 +1034,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 30:  // Galileo E1B + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1036,7 +1046,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 31:  // GPS L2C + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
@@ -1048,7 +1058,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 32:  // L1+E1+L5+E5a
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and ((pvt_solver->gps_cnav_utc_model.A0 != 0) or (pvt_solver->gps_utc_model.A0 != 0)) and (pvt_solver->galileo_utc_model.A0 != 0))
                                         {
                                             if (pvt_solver->gps_cnav_utc_model.A0 != 0)
@@ -1068,7 +1078,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 33:  // L1+E1+E5a
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0) and (pvt_solver->galileo_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1080,7 +1090,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 101:  // Galileo E1B + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1092,7 +1102,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 102:  // Galileo E5a + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1104,7 +1114,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 103:  // Galileo E5b + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1116,7 +1126,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 104:  // Galileo E1B + Galileo E5a + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1128,7 +1138,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 105:  // Galileo E1B + Galileo E5b + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
+                                    log_rinex_obs(d_obs_stream, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1140,7 +1150,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 106:  // GPS L1 C/A + Galileo E1B + Galileo E6B
                             if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1152,7 +1162,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 500:  // BDS B1I only
                             if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B1");
+                                    log_rinex_obs(d_obs_stream, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B1");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->beidou_dnav_utc_model.A0_UTC != 0))
                                 {
@@ -1164,7 +1174,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 600:  // BDS B3I only
                             if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B3");
+                                    log_rinex_obs(d_obs_stream, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B3");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->beidou_dnav_utc_model.A0_UTC != 0))
                                 {
@@ -1177,7 +1187,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                 {
@@ -1191,7 +1201,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                                 (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(d_obs_stream, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0) and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1203,6 +1213,12 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         default:
                             break;
                         }
+                    // Hand the epoch to the writer thread, so the disk is never accessed from here
+                    if (!d_obs_buffer.empty())
+                        {
+                            d_obs_writer->write(d_obs_buffer.str());
+                            d_obs_buffer.clear();
+                        }
                 }
         }
 }
@@ -9550,266 +9566,103 @@ void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)),
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)), const Gps_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
     std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    if (d_version == 2)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (d_version == 2)
-                        {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-
-                    if (d_version == 3)
-                        {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+            line_aux += std::string(54, ' ');
         }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    else
         {
-            out << data[i] << '\n';
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+            line_aux += std::string(36, ' ');
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    insert_obs_header_line(line_aux);
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)), const Gps_CNAV_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
     std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+    line_aux += std::string(36, ' ');
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    insert_obs_header_line(line_aux);
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model& galileo_utc_model) const
+void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)), const Galileo_Utc_Model& galileo_utc_model) const
 {
-    std::vector<std::string> data;
     std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+    line_aux += std::string(36, ' ');
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    insert_obs_header_line(line_aux);
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)), const Beidou_Dnav_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
     std::string line_aux;
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+    line_aux += std::string(36, ' ');
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    insert_obs_header_line(line_aux);
+}
 
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
 
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+void Rinex_Printer::insert_obs_header_line(const std::string& line) const
+{
+    // The file is rewritten by the writer thread, after the epochs already
+    // queued, so the PVT block does not wait for the disk
+    const std::string filename = obsfilename;
+    d_obs_writer->execute([filename, line]() {
+        std::vector<std::string> data;
+        std::string line_str;
+        bool inserted = false;
+        std::ifstream in(filename);
+        while (std::getline(in, line_str))
+            {
+                data.push_back(line_str);
+                if (!inserted)
+                    {
+                        if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                            {
+                                data.push_back(line);
+                                inserted = true;
+                            }
+                        else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                            {
+                                inserted = true;  // not in the header, do not look for it in the epochs
+                            }
+                    }
+            }
+        in.close();
+        std::ofstream out(filename, std::ios::out | std::ios::trunc);
+        for (const auto& data_line : data)
+            {
+                out << data_line << '\n';
+            }
+    });
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Glonass_Gnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_bands) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -10066,7 +9919,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10411,7 +10264,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10669,7 +10522,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10922,7 +10775,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -11175,7 +11028,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -11302,7 +11155,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
 {
     if (eph_cnav.i_0 > 0.0)
         {
@@ -11538,7 +11391,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands) const
 {
     // RINEX observations timestamps are Galileo timestamps.
     // See https://gage.upc.edu/sites/default/files/gLAB/HTML/Observation_Rinex_v3.01.html
@@ -11784,7 +11637,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12056,7 +11909,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12350,7 +12203,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12676,7 +12529,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Beidou_Dnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& bds_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Beidou_Dnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& bds_bands) const
 {
     std::string line;
 
@@ -38,12 +38,18 @@
 #ifndef GNSS_SDR_RINEX_PRINTER_H
 #define GNSS_SDR_RINEX_PRINTER_H
 
+#include "rinex_async_writer.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <array>
+#include <cstddef>  // for size_t
 #include <cstdint>  // for int32_t
+#include <cstdio>   // for snprintf
 #include <cstdlib>  // for strtol, strtod
 #include <fstream>  // for fstream
 #include <iomanip>  // for setprecision
 #include <map>      // for map
+#include <memory>   // for unique_ptr
+#include <ostream>  // for ostream
 #include <sstream>  // for stringstream
 #include <string>   // for string
 #include <vector>
@@ -354,7 +360,7 @@ private:
     /*
      * Writes GPS L1 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables) const;
@@ -362,7 +368,7 @@ private:
     /*
      * Writes GPS L2 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables) const;
@@ -370,7 +376,7 @@ private:
     /*
      * Writes dual frequency GPS L1 and L2 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& eph,
         const Gps_CNAV_Ephemeris& eph_cnav,
         double obs_time,
@@ -381,7 +387,7 @@ private:
      * Writes Galileo observables into the RINEX file.
      * Example: galileo_bands("1B"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Galileo_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -390,7 +396,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Galileo_Ephemeris& galileo_eph,
         double gps_obs_time,
@@ -399,7 +405,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         const Galileo_Ephemeris& galileo_eph,
         double gps_obs_time,
@@ -408,7 +414,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Gps_CNAV_Ephemeris& gps_cnav_eph,
         const Galileo_Ephemeris& galileo_eph,
@@ -420,7 +426,7 @@ private:
      * Writes GLONASS GNAV observables into the RINEX file.
      * Example: glonass_bands("1C"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Glonass_Gnav_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -429,7 +435,7 @@ private:
     /*
      * Writes Mixed GPS L1 C/A - GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double gps_obs_time,
@@ -438,7 +444,7 @@ private:
     /*
      * Writes Mixed GPS L2C - GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double gps_obs_time,
@@ -447,7 +453,7 @@ private:
     /*
      * Writes Mixed Galileo/GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Galileo_Ephemeris& galileo_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double galileo_obs_time,
@@ -456,7 +462,7 @@ private:
     /*
      * Writes BDS B1I observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Beidou_Dnav_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -775,6 +781,12 @@ private:
     void update_obs_header(std::fstream& out,
         const Beidou_Dnav_Utc_Model& utc_model) const;
 
+    /*
+     * Queues the insertion of a record after the TIME OF FIRST OBS record
+     * of the observation file header
+     */
+    void insert_obs_header_line(const std::string& line) const;
+
     /*
      * Generation of RINEX signal strength indicators
      */
@@ -983,6 +995,13 @@ private:
 
     inline std::string asFixWidthString(int x, int width, char fill_digit) const;
 
+    /*
+     * Formats a double with the %.*e (scientific) or %.*f conversion of
+     * printf, which gives the same text as a std::ostream with the same
+     * precision and floatfield, without the cost of creating a stream.
+     */
+    inline std::string formatDouble(double x, int precision, bool scientific) const;
+
     std::map<std::string, std::string> satelliteSystem;  // GPS, GLONASS, SBAS payload, Galileo or Beidou
     std::map<std::string, std::string> observationType;  // PSEUDORANGE, CARRIER_PHASE, DOPPLER, SIGNAL_STRENGTH
     std::map<std::string, std::string> observationCode;  // GNSS observation descriptors
@@ -995,6 +1014,10 @@ private:
     std::fstream navBdsFile;  // Output file stream for RINEX Galileo navigation data file
     std::fstream navMixFile;  // Output file stream for RINEX Mixed navigation data file
 
+    Rinex_Text_Buffer d_obs_buffer;                    // Observation epochs of the current annotation
+    std::ostream d_obs_stream;                         // Formats into d_obs_buffer
+    std::unique_ptr<Rinex_Async_Writer> d_obs_writer;  // Appends the observation epochs to obsfilename
+
     std::string navfilename;                      // Name of RINEX navigation file for GPS L1
     std::string obsfilename;                      // Name of RINEX observation file
     std::string sbsfilename;                      // Name of RINEX SBAS file
@@ -1082,7 +1105,6 @@ inline std::string Rinex_Printer::doub2sci(double d,
     bool showSign,
     bool checkSwitch) const
 {
-    std::string toReturn;
     int16_t exponentLength = expLen;
 
     /* Validate the assumptions regarding the input arguments */
@@ -1096,9 +1118,6 @@ inline std::string Rinex_Printer::doub2sci(double d,
             exponentLength = 3;
         }
 
-    std::stringstream c;
-    c.setf(std::ios::scientific, std::ios::floatfield);
-
     // length - 3 for special characters ('.', 'e', '+' or '-')
     // - exponentlength (e04)
     // - 1 for the digit before the decimal (2.)
@@ -1110,10 +1129,7 @@ inline std::string Rinex_Printer::doub2sci(double d,
             expSize = 1;
         }
 
-    c.precision(length - 3 - exponentLength - 1 - expSize);
-    c << d;
-    c >> toReturn;
-    return toReturn;
+    return formatDouble(d, static_cast<int>(length - 3 - exponentLength - 1 - expSize), true);
 }
 
 
@@ -1224,9 +1240,29 @@ inline std::string asString(long double x, std::string::size_type precision)
 
 inline std::string Rinex_Printer::asString(double x, std::string::size_type precision) const
 {
-    std::ostringstream ss;
-    ss << std::fixed << std::setprecision(precision) << x;
-    return ss.str();
+    return formatDouble(x, static_cast<int>(precision), false);
+}
+
+
+inline std::string Rinex_Printer::formatDouble(double x, int precision, bool scientific) const
+{
+    std::array<char, 64> buffer{};
+    int length = scientific ? std::snprintf(buffer.data(), buffer.size(), "%.*e", precision, x)
+                            : std::snprintf(buffer.data(), buffer.size(), "%.*f", precision, x);
+    if (length < 0)
+        {
+            return std::string();
+        }
+    if (static_cast<std::size_t>(length) < buffer.size())
+        {
+            return std::string(buffer.data(), length);
+        }
+    // Only huge numbers in fixed notation do not fit in the buffer
+    std::string toReturn(length + 1, '\0');
+    length = scientific ? std::snprintf(&toReturn[0], toReturn.size(), "%.*e", precision, x)
+                        : std::snprintf(&toReturn[0], toReturn.size(), "%.*f", precision, x);
+    toReturn.resize(length);
+    return toReturn;
 }
 
 
@@ -15,6 +15,7 @@
  */
 
 #include "rtcm.h"
+#include "Beidou_B1I.h"
 #include "GLONASS_L1_L2_CA.h"
 #include "GPS_L1_CA.h"
 #include "GPS_L2C.h"
@@ -24,7 +25,6 @@
 #include "Galileo_FNAV.h"
 #include "Galileo_INAV.h"
 #include <boost/algorithm/string.hpp>  // for to_upper_copy
-#include <boost/crc.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/exception/diagnostic_information.hpp>
@@ -123,49 +123,48 @@ bool Rtcm::is_server_running() const
 //
 // *****************************************************************************************************
 
-std::string Rtcm::add_CRC(const std::string& message_without_crc) const
+// Qualcomm CRC-24Q, computed byte-wise with a lookup table
+static uint32_t crc24q(const uint8_t* data, std::size_t length)
 {
-    // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
+    static const std::array<uint32_t, 256> crc_table = []() {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i << 16U;
+                for (int32_t bit = 0; bit < 8; bit++)
+                    {
+                        crc <<= 1U;
+                        if (crc & 0x1000000U)
+                            {
+                                crc ^= 0x1864CFBU;
+                            }
+                    }
+                table[i] = crc & 0xFFFFFFU;
+            }
+        return table;
+    }();
 
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    const auto crc_frame = std::bitset<24>(CRC_RTCM.checksum());
-
-    // 3) Builds the complete message
-    const std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
+    uint32_t crc = 0;
+    for (std::size_t i = 0; i < length; i++)
+        {
+            crc = ((crc << 8U) & 0xFFFFFFU) ^ crc_table[((crc >> 16U) ^ data[i]) & 0xFFU];
+        }
+    return crc;
 }
 
 
 bool Rtcm::check_CRC(const std::string& message) const
 {
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM_CHECK;
-    // Convert message to binary
-    const std::string message_bin = Rtcm::binary_data_to_bin(message);
-    // Check CRC
-    const std::string crc = message_bin.substr(message_bin.length() - 24, 24);
-    const auto read_crc = std::bitset<24>(crc);
-    const std::string msg_without_crc = message_bin.substr(0, message_bin.length() - 24);
-
-    boost::dynamic_bitset<uint8_t> frame_bits(msg_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    CRC_RTCM_CHECK.process_bytes(bytes.data(), bytes.size());
-    const auto computed_crc = std::bitset<24>(CRC_RTCM_CHECK.checksum());
-    if (read_crc == computed_crc)
+    if (message.length() < 3)
         {
-            return true;
+            return false;
         }
-
-    return false;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(message.data());
+    const std::size_t length = message.length() - 3;
+    const uint32_t read_crc = (static_cast<uint32_t>(bytes[length]) << 16U) |
+                              (static_cast<uint32_t>(bytes[length + 1]) << 8U) |
+                              static_cast<uint32_t>(bytes[length + 2]);
+    return read_crc == crc24q(bytes, length);
 }
 
 
@@ -397,19 +396,22 @@ int64_t Rtcm::hex_to_int(const std::string& s) const
 }
 
 
-std::string Rtcm::build_message(const std::string& data) const
+std::string Rtcm::build_message(const Rtcm_Bit_Writer& data) const
 {
-    const uint32_t msg_length_bits = data.length();
-    const uint32_t msg_length_bytes = std::ceil(static_cast<float>(msg_length_bits) / 8.0);
-    const auto message_length = std::bitset<10>(msg_length_bytes);
-    const uint32_t zeros_to_fill = 8 * msg_length_bytes - msg_length_bits;
-    const std::string b(zeros_to_fill, '0');
-    const std::string msg_content = data + b;
-    const std::string msg_without_crc = preamble.to_string() +
-                                        reserved_field.to_string() +
-                                        message_length.to_string() +
-                                        msg_content;
-    return Rtcm::add_CRC(msg_without_crc);
+    // The writer already fills the last byte with zeros
+    const std::size_t msg_length_bytes = data.bytes().size();
+    std::string msg;
+    msg.reserve(msg_length_bytes + 6);
+    msg.push_back(static_cast<char>(preamble.to_ulong()));
+    msg.push_back(static_cast<char>((reserved_field.to_ulong() << 2U) | ((msg_length_bytes >> 8U) & 0x3U)));
+    msg.push_back(static_cast<char>(msg_length_bytes & 0xFFU));
+    msg.append(reinterpret_cast<const char*>(data.bytes().data()), msg_length_bytes);
+
+    const uint32_t crc = crc24q(reinterpret_cast<const uint8_t*>(msg.data()), msg.size());
+    msg.push_back(static_cast<char>((crc >> 16U) & 0xFFU));
+    msg.push_back(static_cast<char>((crc >> 8U) & 0xFFU));
+    msg.push_back(static_cast<char>(crc & 0xFFU));
+    return msg;
 }
 
 
@@ -426,8 +428,8 @@ std::string Rtcm::build_message(const std::string& data) const
 //
 // ********************************************************
 
-std::bitset<64> Rtcm::get_MT1001_4_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
-    uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free)
+void Rtcm::append_MT1001_4_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free, Rtcm_Bit_Writer& data)
 {
     const uint32_t reference_station_id = ref_id;  // Max: 4095
     const std::map<int32_t, Gnss_Synchro>& observables_ = observables;
@@ -442,20 +444,17 @@ std::bitset<64> Rtcm::get_MT1001_4_header(uint32_t msg_number, double obs_time,
     Rtcm::set_DF007(divergence_free_smoothing_indicator);
     Rtcm::set_DF008(smoothing_interval);
 
-    const std::string header = DF002.to_string() +
-                               DF003.to_string() +
-                               DF004.to_string() +
-                               DF005.to_string() +
-                               DF006.to_string() +
-                               DF007.to_string() +
-                               DF008.to_string();
-
-    std::bitset<64> header_msg(header);
-    return header_msg;
+    data.append(DF002);
+    data.append(DF003);
+    data.append(DF004);
+    data.append(DF005);
+    data.append(DF006);
+    data.append(DF007);
+    data.append(DF008);
 }
 
 
-std::bitset<58> Rtcm::get_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::append_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchro);
@@ -464,14 +463,11 @@ std::bitset<58> Rtcm::get_MT1001_sat_content(const Gps_Ephemeris& eph, double ob
     Rtcm::set_DF012(gnss_synchro);
     Rtcm::set_DF013(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string();
-
-    std::bitset<58> content_msg(content);
-    return content_msg;
+    data.append(DF009);
+    data.append(DF010);
+    data.append(DF011);
+    data.append(DF012);
+    data.append(DF013);
 }
 
 
@@ -498,15 +494,14 @@ std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, co
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1001, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1001_4_header(1001, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (observables_iter = observablesL1.cbegin();
          observables_iter != observablesL1.cend();
          observables_iter++)
         {
-            const std::bitset<58> content = Rtcm::get_MT1001_sat_content(gps_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1001_sat_content(gps_eph, obs_time, observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -547,15 +542,14 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1002, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1001_4_header(1002, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (observables_iter = observablesL1.cbegin();
          observables_iter != observablesL1.cend();
          observables_iter++)
         {
-            const std::bitset<74> content = Rtcm::get_MT1002_sat_content(gps_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1002_sat_content(gps_eph, obs_time, observables_iter->second, data);
         }
 
     const std::string msg = build_message(data);
@@ -567,7 +561,7 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
 }
 
 
-std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::append_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchro);
@@ -576,16 +570,13 @@ std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double ob
     Rtcm::set_DF012(gnss_synchro);
     Rtcm::set_DF013(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF014.to_string() +
-                                DF015.to_string();
-
-    std::bitset<74> content_msg(content);
-    return content_msg;
+    data.append(DF009);
+    data.append(DF010);
+    data.append(DF011);
+    data.append(DF012);
+    data.append(DF013);
+    data.append(DF014);
+    data.append(DF015);
 }
 
 
@@ -650,15 +641,14 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1003, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1001_4_header(1003, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (common_observables_iter = common_observables.cbegin();
          common_observables_iter != common_observables.cend();
          common_observables_iter++)
         {
-            std::bitset<101> content = Rtcm::get_MT1003_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1003_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -670,7 +660,7 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
 }
 
 
-std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::append_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchroL1);
@@ -683,18 +673,15 @@ std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const
     Rtcm::set_DF018(gnss_synchroL1, gnss_synchroL2);
     Rtcm::set_DF019(ephL2, obs_time, gnss_synchroL2);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF016_.to_string() +
-                                DF017.to_string() +
-                                DF018.to_string() +
-                                DF019.to_string();
-
-    std::bitset<101> content_msg(content);
-    return content_msg;
+    data.append(DF009);
+    data.append(DF010);
+    data.append(DF011);
+    data.append(DF012);
+    data.append(DF013);
+    data.append(DF016_);
+    data.append(DF017);
+    data.append(DF018);
+    data.append(DF019);
 }
 
 
@@ -759,15 +746,14 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1004, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1001_4_header(1004, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (common_observables_iter = common_observables.cbegin();
          common_observables_iter != common_observables.cend();
          common_observables_iter++)
         {
-            std::bitset<125> content = Rtcm::get_MT1004_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1004_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -779,7 +765,7 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
 }
 
 
-std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::append_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchroL1);
@@ -795,21 +781,18 @@ std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const
     Rtcm::set_DF019(ephL2, obs_time, gnss_synchroL2);
     Rtcm::set_DF020(gnss_synchroL2);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF014.to_string() +
-                                DF015.to_string() +
-                                DF016_.to_string() +
-                                DF017.to_string() +
-                                DF018.to_string() +
-                                DF019.to_string() +
-                                DF020.to_string();
-
-    std::bitset<125> content_msg(content);
-    return content_msg;
+    data.append(DF009);
+    data.append(DF010);
+    data.append(DF011);
+    data.append(DF012);
+    data.append(DF013);
+    data.append(DF014);
+    data.append(DF015);
+    data.append(DF016_);
+    data.append(DF017);
+    data.append(DF018);
+    data.append(DF019);
+    data.append(DF020);
 }
 
 
@@ -829,7 +812,7 @@ std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const
    Expected output: D3 00 13 3E D7 D3 02 02 98 0E DE EF 34 B4 BD 62
                     AC 09 41 98 6F 33 36 0B 98
  */
-std::bitset<152> Rtcm::get_MT1005_test()
+void Rtcm::append_MT1005_test(Rtcm_Bit_Writer& data)
 {
     const uint32_t mt1005 = 1005;
     const uint32_t reference_station_id = 2003;  // Max: 4095
@@ -853,22 +836,19 @@ std::bitset<152> Rtcm::get_MT1005_test()
     DF364 = std::bitset<2>("00");  // Quarter Cycle Indicator
     Rtcm::set_DF027(ECEF_Z);
 
-    const std::string message = DF002.to_string() +
-                                DF003.to_string() +
-                                DF021.to_string() +
-                                DF022.to_string() +
-                                DF023.to_string() +
-                                DF024.to_string() +
-                                DF141.to_string() +
-                                DF025.to_string() +
-                                DF142.to_string() +
-                                DF001_.to_string() +
-                                DF026.to_string() +
-                                DF364.to_string() +
-                                DF027.to_string();
-
-    std::bitset<152> test_msg(message);
-    return test_msg;
+    data.append(DF002);
+    data.append(DF003);
+    data.append(DF021);
+    data.append(DF022);
+    data.append(DF023);
+    data.append(DF024);
+    data.append(DF141);
+    data.append(DF025);
+    data.append(DF142);
+    data.append(DF001_);
+    data.append(DF026);
+    data.append(DF364);
+    data.append(DF027);
 }
 
 
@@ -891,19 +871,20 @@ std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, do
     DF364 = std::bitset<2>(quarter_cycle_indicator);
     Rtcm::set_DF027(ecef_z);
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF021.to_string() +
-                             DF022.to_string() +
-                             DF023.to_string() +
-                             DF024.to_string() +
-                             DF141.to_string() +
-                             DF025.to_string() +
-                             DF142.to_string() +
-                             DF001_.to_string() +
-                             DF026.to_string() +
-                             DF364.to_string() +
-                             DF027.to_string();
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF003);
+    data.append(DF021);
+    data.append(DF022);
+    data.append(DF023);
+    data.append(DF024);
+    data.append(DF141);
+    data.append(DF025);
+    data.append(DF142);
+    data.append(DF001_);
+    data.append(DF026);
+    data.append(DF364);
+    data.append(DF027);
 
     std::string msg = build_message(data);
     if (server_is_running)
@@ -982,8 +963,9 @@ int32_t Rtcm::read_MT1005(const std::string& message, uint32_t& ref_id, double&
 
 std::string Rtcm::print_MT1005_test()
 {
-    std::bitset<152> mt1005 = get_MT1005_test();
-    return Rtcm::build_message(mt1005.to_string());
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1005_test(data);
+    return Rtcm::build_message(data);
 }
 
 // ********************************************************
@@ -1012,20 +994,21 @@ std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, do
     Rtcm::set_DF027(ecef_z);
     Rtcm::set_DF028(height);
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF021.to_string() +
-                             DF022.to_string() +
-                             DF023.to_string() +
-                             DF024.to_string() +
-                             DF141.to_string() +
-                             DF025.to_string() +
-                             DF142.to_string() +
-                             DF001_.to_string() +
-                             DF026.to_string() +
-                             DF364.to_string() +
-                             DF027.to_string() +
-                             DF028.to_string();
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF003);
+    data.append(DF021);
+    data.append(DF022);
+    data.append(DF023);
+    data.append(DF024);
+    data.append(DF141);
+    data.append(DF025);
+    data.append(DF142);
+    data.append(DF001_);
+    data.append(DF026);
+    data.append(DF364);
+    data.append(DF027);
+    data.append(DF028);
 
     std::string msg = build_message(data);
     if (server_is_running)
@@ -1054,14 +1037,6 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
             len = 31;
         }
     DF029 = std::bitset<8>(len);
-
-    std::string DF030_str_;
-    for (char c : ant_descriptor)
-        {
-            const auto character = std::bitset<8>(c);
-            DF030_str_ += character.to_string();
-        }
-
     Rtcm::set_DF031(antenna_setup_id);
 
     std::string ant_sn(antenna_serial_number);
@@ -1073,21 +1048,21 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
         }
     DF032 = std::bitset<8>(len2);
 
-    std::string DF033_str_;
+    Rtcm_Bit_Writer data;
+    data.append(DF002_);
+    data.append(DF003);
+    data.append(DF029);
+    for (char c : ant_descriptor)
+        {
+            data.append(static_cast<uint8_t>(c), 8);  // DF030
+        }
+    data.append(DF031);
+    data.append(DF032);
     for (char c : ant_sn)
         {
-            const auto character = std::bitset<8>(c);
-            DF033_str_ += character.to_string();
+            data.append(static_cast<uint8_t>(c), 8);  // DF033
         }
 
-    const std::string data = DF002_.to_string() +
-                             DF003.to_string() +
-                             DF029.to_string() +
-                             DF030_str_ +
-                             DF031.to_string() +
-                             DF032.to_string() +
-                             DF033_str_;
-
     std::string msg = build_message(data);
     if (server_is_running)
         {
@@ -1102,8 +1077,8 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
 //   MESSAGE TYPE 1009 (GLONASS L1 Basic RTK Observables)
 //
 // ********************************************************
-std::bitset<61> Rtcm::get_MT1009_12_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
-    uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free)
+void Rtcm::append_MT1009_12_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free, Rtcm_Bit_Writer& data)
 {
     const uint32_t reference_station_id = ref_id;  // Max: 4095
     const std::map<int32_t, Gnss_Synchro>& observables_ = observables;
@@ -1118,20 +1093,17 @@ std::bitset<61> Rtcm::get_MT1009_12_header(uint32_t msg_number, double obs_time,
     Rtcm::set_DF036(divergence_free_smoothing_indicator);
     Rtcm::set_DF037(smoothing_interval);
 
-    const std::string header = DF002.to_string() +
-                               DF003.to_string() +
-                               DF034.to_string() +
-                               DF005.to_string() +
-                               DF035.to_string() +
-                               DF036.to_string() +
-                               DF037.to_string();
-
-    std::bitset<61> header_msg(header);
-    return header_msg;
+    data.append(DF002);
+    data.append(DF003);
+    data.append(DF034);
+    data.append(DF005);
+    data.append(DF035);
+    data.append(DF036);
+    data.append(DF037);
 }
 
 
-std::bitset<64> Rtcm::get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::append_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchro);
@@ -1141,15 +1113,12 @@ std::bitset<64> Rtcm::get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph,
     Rtcm::set_DF042(gnss_synchro);
     Rtcm::set_DF043(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string();
-
-    std::bitset<64> content_msg(content);
-    return content_msg;
+    data.append(DF038);
+    data.append(DF039);
+    data.append(DF040);
+    data.append(DF041);
+    data.append(DF042);
+    data.append(DF043);
 }
 
 
@@ -1176,15 +1145,14 @@ std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1009, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1009_12_header(1009, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (observables_iter = observablesL1.begin();
          observables_iter != observablesL1.end();
          observables_iter++)
         {
-            const std::bitset<64> content = Rtcm::get_MT1009_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1009_sat_content(glonass_gnav_eph, obs_time, observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -1225,15 +1193,14 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1010, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1009_12_header(1010, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (observables_iter = observablesL1.begin();
          observables_iter != observablesL1.end();
          observables_iter++)
         {
-            const std::bitset<79> content = Rtcm::get_MT1010_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1010_sat_content(glonass_gnav_eph, obs_time, observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -1245,7 +1212,7 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
 }
 
 
-std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::append_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchro);
@@ -1257,17 +1224,14 @@ std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph,
     Rtcm::set_DF044(gnss_synchro);
     Rtcm::set_DF045(gnss_synchro);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF044.to_string() +
-                                DF045.to_string();
-
-    std::bitset<79> content_msg(content);
-    return content_msg;
+    data.append(DF038);
+    data.append(DF039);
+    data.append(DF040);
+    data.append(DF041);
+    data.append(DF042);
+    data.append(DF043);
+    data.append(DF044);
+    data.append(DF045);
 }
 
 
@@ -1332,15 +1296,14 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1011, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1009_12_header(1011, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (common_observables_iter = common_observables.begin();
          common_observables_iter != common_observables.end();
          common_observables_iter++)
         {
-            const std::bitset<107> content = Rtcm::get_MT1011_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1011_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -1352,7 +1315,7 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
 }
 
 
-std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::append_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchroL1);
@@ -1366,19 +1329,16 @@ std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL
     Rtcm::set_DF048(gnss_synchroL1, gnss_synchroL2);
     Rtcm::set_DF049(ephL2, obs_time, gnss_synchroL2);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF046_.to_string() +
-                                DF047.to_string() +
-                                DF048.to_string() +
-                                DF049.to_string();
-
-    std::bitset<107> content_msg(content);
-    return content_msg;
+    data.append(DF038);
+    data.append(DF039);
+    data.append(DF040);
+    data.append(DF041);
+    data.append(DF042);
+    data.append(DF043);
+    data.append(DF046_);
+    data.append(DF047);
+    data.append(DF048);
+    data.append(DF049);
 }
 
 
@@ -1443,15 +1403,14 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1012, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MT1009_12_header(1012, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free, data);
 
     for (common_observables_iter = common_observables.begin();
          common_observables_iter != common_observables.end();
          common_observables_iter++)
         {
-            const std::bitset<130> content = Rtcm::get_MT1012_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::append_MT1012_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second, data);
         }
 
     std::string msg = build_message(data);
@@ -1463,7 +1422,7 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
 }
 
 
-std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::append_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchroL1);
@@ -1480,22 +1439,19 @@ std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL
     Rtcm::set_DF049(ephL2, obs_time, gnss_synchroL2);
     Rtcm::set_DF050(gnss_synchroL2);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF044.to_string() +
-                                DF045.to_string() +
-                                DF046_.to_string() +
-                                DF047.to_string() +
-                                DF048.to_string() +
-                                DF049.to_string() +
-                                DF050.to_string();
-
-    std::bitset<130> content_msg(content);
-    return content_msg;
+    data.append(DF038);
+    data.append(DF039);
+    data.append(DF040);
+    data.append(DF041);
+    data.append(DF042);
+    data.append(DF043);
+    data.append(DF044);
+    data.append(DF045);
+    data.append(DF046_);
+    data.append(DF047);
+    data.append(DF048);
+    data.append(DF049);
+    data.append(DF050);
 }
 
 
@@ -1541,41 +1497,42 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
     Rtcm::set_DF103(gps_eph);
     Rtcm::set_DF137(gps_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF009.to_string() +
-                             DF076.to_string() +
-                             DF077.to_string() +
-                             DF078.to_string() +
-                             DF079.to_string() +
-                             DF071.to_string() +
-                             DF081.to_string() +
-                             DF082.to_string() +
-                             DF083.to_string() +
-                             DF084.to_string() +
-                             DF085.to_string() +
-                             DF086.to_string() +
-                             DF087.to_string() +
-                             DF088.to_string() +
-                             DF089.to_string() +
-                             DF090.to_string() +
-                             DF091.to_string() +
-                             DF092.to_string() +
-                             DF093.to_string() +
-                             DF094.to_string() +
-                             DF095.to_string() +
-                             DF096.to_string() +
-                             DF097.to_string() +
-                             DF098.to_string() +
-                             DF099.to_string() +
-                             DF100.to_string() +
-                             DF101.to_string() +
-                             DF102.to_string() +
-                             DF103.to_string() +
-                             DF137.to_string();
-
-    if (data.length() != 488)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.length() << ")";
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF009);
+    data.append(DF076);
+    data.append(DF077);
+    data.append(DF078);
+    data.append(DF079);
+    data.append(DF071);
+    data.append(DF081);
+    data.append(DF082);
+    data.append(DF083);
+    data.append(DF084);
+    data.append(DF085);
+    data.append(DF086);
+    data.append(DF087);
+    data.append(DF088);
+    data.append(DF089);
+    data.append(DF090);
+    data.append(DF091);
+    data.append(DF092);
+    data.append(DF093);
+    data.append(DF094);
+    data.append(DF095);
+    data.append(DF096);
+    data.append(DF097);
+    data.append(DF098);
+    data.append(DF099);
+    data.append(DF100);
+    data.append(DF101);
+    data.append(DF102);
+    data.append(DF103);
+    data.append(DF137);
+
+    if (data.size() != 488)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.size() << ")";
         }
 
     std::string msg = build_message(data);
@@ -1766,47 +1723,48 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
     Rtcm::set_DF135(glonass_gnav_utc_model);
     Rtcm::set_DF136(glonass_gnav_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF038.to_string() +
-                             DF040.to_string() +
-                             DF104.to_string() +
-                             DF105.to_string() +
-                             DF106.to_string() +
-                             DF107.to_string() +
-                             DF108.to_string() +
-                             DF109.to_string() +
-                             DF110.to_string() +
-                             DF111.to_string() +
-                             DF112.to_string() +
-                             DF113.to_string() +
-                             DF114.to_string() +
-                             DF115.to_string() +
-                             DF116.to_string() +
-                             DF117.to_string() +
-                             DF118.to_string() +
-                             DF119.to_string() +
-                             DF120.to_string() +
-                             DF121.to_string() +
-                             DF122.to_string() +
-                             DF123.to_string() +
-                             DF124.to_string() +
-                             DF125.to_string() +
-                             DF126.to_string() +
-                             DF127.to_string() +
-                             DF128.to_string() +
-                             DF129.to_string() +
-                             DF130.to_string() +
-                             DF131.to_string() +
-                             DF132.to_string() +
-                             DF133.to_string() +
-                             DF134.to_string() +
-                             DF135.to_string() +
-                             DF136.to_string() +
-                             std::bitset<7>().to_string();  // Reserved bits
-
-    if (data.length() != 360)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.length() << ")";
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF038);
+    data.append(DF040);
+    data.append(DF104);
+    data.append(DF105);
+    data.append(DF106);
+    data.append(DF107);
+    data.append(DF108);
+    data.append(DF109);
+    data.append(DF110);
+    data.append(DF111);
+    data.append(DF112);
+    data.append(DF113);
+    data.append(DF114);
+    data.append(DF115);
+    data.append(DF116);
+    data.append(DF117);
+    data.append(DF118);
+    data.append(DF119);
+    data.append(DF120);
+    data.append(DF121);
+    data.append(DF122);
+    data.append(DF123);
+    data.append(DF124);
+    data.append(DF125);
+    data.append(DF126);
+    data.append(DF127);
+    data.append(DF128);
+    data.append(DF129);
+    data.append(DF130);
+    data.append(DF131);
+    data.append(DF132);
+    data.append(DF133);
+    data.append(DF134);
+    data.append(DF135);
+    data.append(DF136);
+    data.append(std::bitset<7>());  // Reserved bits
+
+    if (data.size() != 360)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.size() << ")";
         }
 
     std::string msg = build_message(data);
@@ -1996,7 +1954,6 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
 
     uint32_t i = 0;
     bool first = true;
-    std::string text_binary;
     for (char c : message)
         {
             if (isgraph(c) || c == ' ')
@@ -2016,20 +1973,22 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
                             first = false;
                         }
                 }
-            const auto character = std::bitset<8>(c);
-            text_binary += character.to_string();
         }
 
     const auto DF138_ = std::bitset<7>(i);
     const auto DF139_ = std::bitset<8>(message.length());
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF051.to_string() +
-                             DF052.to_string() +
-                             DF138_.to_string() +
-                             DF139_.to_string() +
-                             text_binary;
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF003);
+    data.append(DF051);
+    data.append(DF052);
+    data.append(DF138_);
+    data.append(DF139_);
+    for (char c : message)
+        {
+            data.append(static_cast<uint8_t>(c), 8);
+        }
 
     std::string msg = build_message(data);
     if (server_is_running)
@@ -2080,39 +2039,40 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
     const uint32_t seven_zero = 0;
     const auto DF001_ = std::bitset<7>(seven_zero);
 
-    const std::string data = DF002.to_string() +
-                             DF252.to_string() +
-                             DF289.to_string() +
-                             DF290.to_string() +
-                             DF291.to_string() +
-                             DF292.to_string() +
-                             DF293.to_string() +
-                             DF294.to_string() +
-                             DF295.to_string() +
-                             DF296.to_string() +
-                             DF297.to_string() +
-                             DF298.to_string() +
-                             DF299.to_string() +
-                             DF300.to_string() +
-                             DF301.to_string() +
-                             DF302.to_string() +
-                             DF303.to_string() +
-                             DF304.to_string() +
-                             DF305.to_string() +
-                             DF306.to_string() +
-                             DF307.to_string() +
-                             DF308.to_string() +
-                             DF309.to_string() +
-                             DF310.to_string() +
-                             DF311.to_string() +
-                             DF312.to_string() +
-                             DF314.to_string() +
-                             DF315.to_string() +
-                             DF001_.to_string();
-
-    if (data.length() != 496)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.length() << ")";
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF252);
+    data.append(DF289);
+    data.append(DF290);
+    data.append(DF291);
+    data.append(DF292);
+    data.append(DF293);
+    data.append(DF294);
+    data.append(DF295);
+    data.append(DF296);
+    data.append(DF297);
+    data.append(DF298);
+    data.append(DF299);
+    data.append(DF300);
+    data.append(DF301);
+    data.append(DF302);
+    data.append(DF303);
+    data.append(DF304);
+    data.append(DF305);
+    data.append(DF306);
+    data.append(DF307);
+    data.append(DF308);
+    data.append(DF309);
+    data.append(DF310);
+    data.append(DF311);
+    data.append(DF312);
+    data.append(DF314);
+    data.append(DF315);
+    data.append(DF001_);
+
+    if (data.size() != 496)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.size() << ")";
         }
 
     std::string msg = build_message(data);
@@ -2254,7 +2214,7 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -2262,6 +2222,7 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -2289,7 +2250,8 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
             msg_number = 1071;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2297,13 +2259,12 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_1_content_sat_data(observables, data);
+    Rtcm::append_MSM_1_content_signal_data(observables, data);
 
-    const std::string signal_data = Rtcm::get_MSM_1_content_signal_data(observables);
-
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
 
     if (server_is_running)
         {
@@ -2314,7 +2275,7 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_header(uint32_t msg_number,
+void Rtcm::append_MSM_header(uint32_t msg_number,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id,
@@ -2322,7 +2283,8 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     uint32_t external_clock_indicator,
     int32_t smooth_int,
     bool divergence_free,
-    bool more_messages)
+    bool more_messages,
+    Rtcm_Bit_Writer& data)
 {
     // Find first element in observables block and define type of message
     auto observables_iter = observables.begin();
@@ -2341,40 +2303,38 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
 
-    std::string header = DF002.to_string() + DF003.to_string();
+    data.append(DF002);
+    data.append(DF003);
     // GNSS Epoch Time Specific to each constellation
     if ((sys == "R"))
         {
             // GLONASS Epoch Time
             Rtcm::set_DF034(obs_time);
-            header += DF034.to_string();
+            data.append(DF034);
         }
     else
         {
-            // GPS, Galileo Epoch Time
+            // GPS, Galileo and BeiDou Epoch Time (DF004, DF248 and DF427
+            // have the same format)
             Rtcm::set_DF004(obs_time);
-            header += DF004.to_string();
+            data.append(DF004);
         }
 
-    header = header + DF393.to_string() +
-             DF409.to_string() +
-             DF001_.to_string() +
-             DF411.to_string() +
-             DF417.to_string() +
-             DF412.to_string() +
-             DF418.to_string() +
-             DF394.to_string() +
-             DF395.to_string() +
-             Rtcm::set_DF396(observables);
-
-    return header;
+    data.append(DF393);
+    data.append(DF409);
+    data.append(DF001_);
+    data.append(DF411);
+    data.append(DF417);
+    data.append(DF412);
+    data.append(DF418);
+    data.append(DF394);
+    data.append(DF395);
+    Rtcm::append_DF396(observables, data);
 }
 
 
-std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::append_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data)
 {
-    std::string sat_data;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2404,16 +2364,13 @@ std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            sat_data += DF398.to_string();
+            data.append(DF398);
         }
-
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::append_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2434,10 +2391,8 @@ std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Syn
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
-            signal_data += DF400.to_string();
+            data.append(DF400);
         }
-
-    return signal_data;
 }
 
 
@@ -2452,7 +2407,7 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -2460,6 +2415,7 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -2487,7 +2443,8 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
             msg_number = 1072;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2495,13 +2452,12 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_1_content_sat_data(observables, data);
+    Rtcm::append_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, data);
 
-    const std::string signal_data = Rtcm::get_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
-
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2511,18 +2467,14 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::append_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables)
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2543,15 +2495,20 @@ std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF401);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
-            Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF401.to_string();
-            second_data_type += DF402.to_string();
-            third_data_type += DF420.to_string();
+            data.append(DF402);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type;
-    return signal_data;
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
+            Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF420);
+        }
 }
 
 
@@ -2566,7 +2523,7 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -2574,6 +2531,7 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -2601,7 +2559,8 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
             msg_number = 1073;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2609,13 +2568,12 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_1_content_sat_data(observables, data);
+    Rtcm::append_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, data);
 
-    const std::string signal_data = Rtcm::get_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
-
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2625,19 +2583,14 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::append_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables)
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2658,17 +2611,26 @@ std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF400);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF401);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
-            Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
+            data.append(DF402);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return signal_data;
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
+            Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF420);
+        }
 }
 
 
@@ -2683,7 +2645,7 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -2691,6 +2653,7 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -2712,13 +2675,19 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         {
             LOG(WARNING) << "MSM messages for observables from different systems are not defined";  // print two messages?
         }
+    if ((msg_number == 0) && !observables.empty() && (observables.cbegin()->second.System == 'C'))
+        {
+            // BeiDou observables do not need an ephemeris
+            msg_number = 1124;
+        }
     if (msg_number == 0)
         {
             LOG(WARNING) << "Invalid ephemeris provided";
             msg_number = 1074;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2726,13 +2695,12 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
-
-    const std::string signal_data = Rtcm::get_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_4_content_sat_data(observables, data);
+    Rtcm::append_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, data);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2742,12 +2710,8 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::append_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2776,29 +2740,25 @@ std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
+            data.append(DF397);
+        }
+
+    for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
+        {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            first_data_type += DF397.to_string();
-            second_data_type += DF398.to_string();
+            data.append(DF398);
         }
-    sat_data = first_data_type + second_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::append_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables)
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2819,19 +2779,32 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF400);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF401);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
+            data.append(DF402);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
+            data.append(DF420);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
+            Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF403);
+        }
 }
 
 
@@ -2846,7 +2819,7 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -2854,6 +2827,7 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -2881,7 +2855,8 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
             msg_number = 1075;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2889,13 +2864,12 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_5_content_sat_data(observables, data);
+    Rtcm::append_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, data);
 
-    const std::string signal_data = Rtcm::get_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
-
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2905,14 +2879,8 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::append_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2941,34 +2909,35 @@ std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
+            data.append(DF397);
+        }
+
+    for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
+        {
+            data.append(0, 4);  // reserved
+        }
+    for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
+        {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
+            data.append(DF398);
+        }
+
+    for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
+        {
             Rtcm::set_DF399(ordered_by_PRN_pos.at(nsat).second);
-            auto reserved = std::bitset<4>("0000");
-            first_data_type += DF397.to_string();
-            second_data_type += reserved.to_string();
-            third_data_type += DF398.to_string();
-            fourth_data_type += DF399.to_string();
+            data.append(DF399);
         }
-    sat_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::append_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables)
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2989,21 +2958,38 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF400);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF401);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
+            data.append(DF402);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF420);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
-            sixth_data_type += DF404.to_string();
+            data.append(DF403);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
+            Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF404);
+        }
 }
 
 
@@ -3018,7 +3004,7 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -3026,6 +3012,7 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -3053,7 +3040,8 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3061,13 +3049,12 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
-
-    const std::string signal_data = Rtcm::get_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_4_content_sat_data(observables, data);
+    Rtcm::append_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, data);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3077,20 +3064,14 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::append_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables)
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -3111,19 +3092,32 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF405);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF406(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF406);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
+            data.append(DF407);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
+            data.append(DF420);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
+            Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF408);
+        }
 }
 
 
@@ -3138,7 +3132,7 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
     const Galileo_Ephemeris& gal_eph,
     const Glonass_Gnav_Ephemeris& glo_gnav_eph,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables,
+    const std::map<int32_t, Gnss_Synchro>& all_observables,
     uint32_t ref_id,
     uint32_t clock_steering_indicator,
     uint32_t external_clock_indicator,
@@ -3146,6 +3140,7 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
     bool divergence_free,
     bool more_messages)
 {
+    const std::map<int32_t, Gnss_Synchro> observables = Rtcm::msm_observables(all_observables);
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
         {
@@ -3167,13 +3162,19 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         {
             LOG(WARNING) << "MSM messages for observables from different systems are not defined";  // print two messages?
         }
+    if ((msg_number == 0) && !observables.empty() && (observables.cbegin()->second.System == 'C'))
+        {
+            // BeiDou observables do not need an ephemeris
+            msg_number = 1127;
+        }
     if (msg_number == 0)
         {
             LOG(WARNING) << "Invalid ephemeris provided";
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::append_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3181,13 +3182,12 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         external_clock_indicator,
         smooth_int,
         divergence_free,
-        more_messages);
-
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
-
-    const std::string signal_data = Rtcm::get_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+        more_messages,
+        data);
+    Rtcm::append_MSM_5_content_sat_data(observables, data);
+    Rtcm::append_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, data);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3197,21 +3197,14 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::append_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
-    const std::map<int32_t, Gnss_Synchro>& observables)
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    Rtcm_Bit_Writer& data)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
-
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -3232,21 +3225,38 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF405);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF406(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF406);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
+            data.append(DF407);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF420);
+        }
+
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
-            sixth_data_type += DF404.to_string();
+            data.append(DF408);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
+    for (uint32_t cell = 0; cell < Ncells; cell++)
+        {
+            Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
+            data.append(DF404);
+        }
 }
 
 
@@ -3283,6 +3293,21 @@ std::vector<std::pair<int32_t, Gnss_Synchro>> Rtcm::sort_by_PRN_mask(const std::
 }
 
 
+std::map<int32_t, Gnss_Synchro> Rtcm::msm_observables(const std::map<int32_t, Gnss_Synchro>& observables) const
+{
+    // The satellite mask (DF394) only has room for PRNs 1 to 64
+    std::map<int32_t, Gnss_Synchro> msm_observables_;
+    for (const auto& observable : observables)
+        {
+            if ((observable.second.PRN > 0) && (observable.second.PRN <= 64))
+                {
+                    msm_observables_.insert(observable);
+                }
+        }
+    return msm_observables_;
+}
+
+
 std::vector<std::pair<int32_t, Gnss_Synchro>> Rtcm::sort_by_signal(const std::vector<std::pair<int32_t, Gnss_Synchro>>& synchro_map) const
 {
     std::vector<std::pair<int32_t, Gnss_Synchro>>::const_iterator synchro_map_iter;
@@ -5062,7 +5087,12 @@ int32_t Rtcm::set_DF394(const std::map<int32_t, Gnss_Synchro>& gnss_synchro)
          gnss_synchro_iter != gnss_synchro.cend();
          gnss_synchro_iter++)
         {
-            mask_position = 64 - gnss_synchro_iter->second.PRN;
+            const uint32_t prn = gnss_synchro_iter->second.PRN;
+            if ((prn == 0) || (prn > 64))
+                {
+                    continue;  // not representable in the satellite mask
+                }
+            mask_position = 64 - prn;
             DF394.set(mask_position, true);
         }
     return 0;
@@ -5130,68 +5160,88 @@ int32_t Rtcm::set_DF395(const std::map<int32_t, Gnss_Synchro>& gnss_synchro)
                     mask_position = 32 - 8;
                     DF395.set(mask_position, true);
                 }
+            if ((sig == "B1") && (sys == "C"))
+                {
+                    // B1I, "2I" in Table 3.5-106
+                    mask_position = 32 - 2;
+                    DF395.set(mask_position, true);
+                }
         }
 
     return 0;
 }
 
 
-std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::append_DF396(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data)
 {
-    std::string DF396;
-    std::map<int32_t, Gnss_Synchro>::const_iterator observables_iter;
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
-    uint32_t num_signals = DF395.count();
-    uint32_t num_satellites = DF394.count();
+    const uint32_t num_signals = DF395.count();
+    const uint32_t num_satellites = DF394.count();
 
     if ((num_signals == 0) || (num_satellites == 0))
         {
-            std::string s("");
-            return s;
+            return;
         }
-    std::vector<std::vector<bool>> matrix(num_signals, std::vector<bool>());
 
-    std::string sig;
+    // Bitmap of the satellites (bit PRN - 1) observed in each signal mask
+    // position. Only GPS, Galileo and BeiDou signals are included.
+    std::array<uint64_t, 32> sats_in_signal{};
     std::vector<uint32_t> list_of_sats;
     std::vector<int> list_of_signals;
 
-    for (observables_iter = observables.cbegin();
-         observables_iter != observables.cend();
-         observables_iter++)
+    for (const auto& observable : observables)
         {
-            list_of_sats.push_back(observables_iter->second.PRN);
-
-            const std::string sig_(observables_iter->second.Signal);
-            sig = sig_.substr(0, 2);
-
-            const std::string sys(&observables_iter->second.System, 1);
-
-            if ((sig == "1C") && (sys == "G"))
-                {
-                    list_of_signals.push_back(32 - 2);
-                }
-            if ((sig == "2S") && (sys == "G"))
+            const Gnss_Synchro& gnss_synchro = observable.second;
+            if ((gnss_synchro.PRN == 0) || (gnss_synchro.PRN > 64))
                 {
-                    list_of_signals.push_back(32 - 15);
+                    continue;  // not in the satellite mask either
                 }
+            list_of_sats.push_back(gnss_synchro.PRN);
 
-            if ((sig == "5X") && (sys == "G"))
+            const char* sig = gnss_synchro.Signal;
+            int mask_position = 0;
+            if (gnss_synchro.System == 'G')
                 {
-                    list_of_signals.push_back(32 - 24);
+                    if (sig[0] == '1' && sig[1] == 'C')
+                        {
+                            mask_position = 32 - 2;
+                        }
+                    else if (sig[0] == '2' && sig[1] == 'S')
+                        {
+                            mask_position = 32 - 15;
+                        }
+                    else if (sig[0] == '5' && sig[1] == 'X')
+                        {
+                            mask_position = 32 - 24;
+                        }
                 }
-            if ((sig == "1B") && (sys == "E"))
+            else if (gnss_synchro.System == 'E')
                 {
-                    list_of_signals.push_back(32 - 4);
+                    if (sig[0] == '1' && sig[1] == 'B')
+                        {
+                            mask_position = 32 - 4;
+                        }
+                    else if (sig[0] == '5' && sig[1] == 'X')
+                        {
+                            mask_position = 32 - 24;
+                        }
+                    else if (sig[0] == '7' && sig[1] == 'X')
+                        {
+                            mask_position = 32 - 16;
+                        }
                 }
-
-            if ((sig == "5X") && (sys == "E"))
+            else if (gnss_synchro.System == 'C')
                 {
-                    list_of_signals.push_back(32 - 24);
+                    if (sig[0] == 'B' && sig[1] == '1')
+                        {
+                            mask_position = 32 - 2;
+                        }
                 }
-            if ((sig == "7X") && (sys == "E"))
+            if (mask_position != 0)
                 {
-                    list_of_signals.push_back(32 - 16);
+                    list_of_signals.push_back(mask_position);
+                    sats_in_signal[mask_position] |= uint64_t(1) << (gnss_synchro.PRN - 1);
                 }
         }
 
@@ -5202,75 +5252,17 @@ std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
     std::reverse(list_of_signals.begin(), list_of_signals.end());
     list_of_signals.erase(std::unique(list_of_signals.begin(), list_of_signals.end()), list_of_signals.end());
 
-    // fill the matrix
-    bool value;
-
-    for (uint32_t row = 0; row < num_signals; row++)
-        {
-            for (uint32_t sat = 0; sat < num_satellites; sat++)
-                {
-                    value = false;
-                    for (observables_iter = observables.cbegin();
-                         observables_iter != observables.cend();
-                         observables_iter++)
-                        {
-                            const std::string sig_(observables_iter->second.Signal);
-                            sig = sig_.substr(0, 2);
-                            const std::string sys(&observables_iter->second.System, 1);
-
-                            if ((sig == "1C") && (sys == "G") && (list_of_signals.at(row) == 32 - 2) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "2S") && (sys == "G") && (list_of_signals.at(row) == 32 - 15) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "5X") && (sys == "G") && (list_of_signals.at(row) == 32 - 24) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "1B") && (sys == "E") && (list_of_signals.at(row) == 32 - 4) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "5X") && (sys == "E") && (list_of_signals.at(row) == 32 - 24) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "7X") && (sys == "E") && (list_of_signals.at(row) == 32 - 16) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-                        }
-                    matrix[row].push_back(value);
-                }
-        }
-
-    // write the matrix column-wise
-    DF396.clear();
-    for (uint32_t col = 0; col < num_satellites; col++)
+    // write the matrix column-wise. Rows of signals not in the list (GLONASS)
+    // are left empty
+    for (uint32_t sat = 0; sat < num_satellites; sat++)
         {
+            const uint64_t sat_bit = uint64_t(1) << (list_of_sats.at(sat) - 1);
             for (uint32_t row = 0; row < num_signals; row++)
                 {
-                    std::string ss;
-                    if (matrix[row].at(col))
-                        {
-                            ss = "1";
-                        }
-                    else
-                        {
-                            ss = "0";
-                        }
-                    DF396 += ss;
+                    const bool value = !list_of_signals.empty() && (sats_in_signal[list_of_signals.at(row)] & sat_bit) != 0;
+                    data.append(value ? 1 : 0, 1);
                 }
         }
-    return DF396;
 }
 
 
@@ -5339,6 +5331,10 @@ int32_t Rtcm::set_DF399(const Gnss_Synchro& gnss_synchro)
         {
             lambda = SPEED_OF_LIGHT_M_S / GALILEO_E5B_FREQ_HZ;
         }
+    if (sig == "B1")
+        {
+            lambda = SPEED_OF_LIGHT_M_S / BEIDOU_B1I_FREQ_HZ;
+        }
 
     double rough_phase_range_rate_ms = std::round(-gnss_synchro.Carrier_Doppler_hz * lambda);
     if (rough_phase_range_rate_ms < -8191)
@@ -5416,6 +5412,10 @@ int32_t Rtcm::set_DF401(const Gnss_Synchro& gnss_synchro)
             // TODO Need to add slot number and freq number to gnss_syncro
             lambda = SPEED_OF_LIGHT_M_S / (GLONASS_L2_CA_FREQ_HZ);
         }
+    if ((sig == "B1") && (sys == "C"))
+        {
+            lambda = SPEED_OF_LIGHT_M_S / BEIDOU_B1I_FREQ_HZ;
+        }
 
     double phrng_m = (gnss_synchro.Carrier_phase_rads / TWO_PI) * lambda - rough_range_m;
 
@@ -5515,6 +5515,10 @@ int32_t Rtcm::set_DF404(const Gnss_Synchro& gnss_synchro)
             // TODO Need to add slot number and freq number to gnss syncro
             lambda = SPEED_OF_LIGHT_M_S / (GLONASS_L2_CA_FREQ_HZ);
         }
+    if ((sig_ == "B1") && (sys_ == "C"))
+        {
+            lambda = SPEED_OF_LIGHT_M_S / BEIDOU_B1I_FREQ_HZ;
+        }
     const double rough_phase_range_rate = std::round(-gnss_synchro.Carrier_Doppler_hz * lambda);
     const double phrr = (-gnss_synchro.Carrier_Doppler_hz * lambda - rough_phase_range_rate);
 
@@ -5592,6 +5596,10 @@ int32_t Rtcm::set_DF406(const Gnss_Synchro& gnss_synchro)
             // TODO Need to add slot number and freq number to gnss syncro
             lambda = SPEED_OF_LIGHT_M_S / (GLONASS_L2_CA_FREQ_HZ);
         }
+    if ((sig_ == "B1") && (sys_ == "C"))
+        {
+            lambda = SPEED_OF_LIGHT_M_S / BEIDOU_B1I_FREQ_HZ;
+        }
     phrng_m = (gnss_synchro.Carrier_phase_rads / TWO_PI) * lambda - rough_range_m;
 
     /* Subtract phase - pseudorange integer cycle offset */
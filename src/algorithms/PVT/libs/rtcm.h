@@ -58,6 +58,58 @@ using b_io_context = boost::asio::io_service;
 #endif
 
 
+/*!
+ * \brief Packs the data fields of a RTCM message, most significant bit
+ * first, into a byte buffer. The last byte is padded with zeros.
+ */
+class Rtcm_Bit_Writer
+{
+public:
+    Rtcm_Bit_Writer() = default;
+
+    /*!
+     * \brief Appends the \p nbits least significant bits of \p value
+     * (up to 64)
+     */
+    inline void append(uint64_t value, uint32_t nbits)
+    {
+        while (nbits > 0)
+            {
+                const uint32_t used = d_nbits & 7U;
+                if (used == 0)
+                    {
+                        d_bytes.push_back(0);
+                    }
+                const uint32_t n = std::min(8U - used, nbits);
+                const auto chunk = static_cast<uint8_t>((value >> (nbits - n)) & ((1U << n) - 1U));
+                d_bytes.back() |= static_cast<uint8_t>(chunk << (8U - used - n));
+                nbits -= n;
+                d_nbits += n;
+            }
+    }
+
+    template <std::size_t N>
+    inline void append(const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "RTCM data fields are at most 64 bits long");
+        append(field.to_ullong(), N);
+    }
+
+    inline void clear()
+    {
+        d_bytes.clear();
+        d_nbits = 0;
+    }
+
+    inline std::size_t size() const { return d_nbits; }                   //!< Number of bits written
+    inline const std::vector<uint8_t>& bytes() const { return d_bytes; }  //!< Written bits, padded to a whole byte
+
+private:
+    std::vector<uint8_t> d_bytes;
+    std::size_t d_nbits{0};
+};
+
+
 /*!
  * \brief This class implements the generation and reading of some Message Types
  * defined in the RTCM 3.2 Standard, plus some utilities to handle messages.
@@ -72,10 +124,10 @@ using b_io_context = boost::asio::io_service;
  *   MSM1 (message types 1071, 1091)
  *   MSM2 (message types 1072, 1092)
  *   MSM3 (message types 1073, 1093)
- *   MSM4 (message types 1074, 1094)
+ *   MSM4 (message types 1074, 1084, 1094, 1124)
  *   MSM5 (message types 1075, 1095)
  *   MSM6 (message types 1076, 1096)
- *   MSM7 (message types 1077, 1097)
+ *   MSM7 (message types 1077, 1087, 1097, 1127)
  *
  * RTCM 3 message format (size in bits):
  *   +----------+--------+-----------+--------------------+----------+
@@ -375,20 +427,21 @@ private:
     //
     // Generation of messages content
     //
-    std::bitset<64> get_MT1001_4_header(uint32_t msg_number,
+    void append_MT1001_4_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
         uint32_t smooth_int,
         bool sync_flag,
-        bool divergence_free);
+        bool divergence_free,
+        Rtcm_Bit_Writer& data);
 
-    std::bitset<58> get_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
-    std::bitset<74> get_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
-    std::bitset<101> get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
-    std::bitset<125> get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void append_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data);
+    void append_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data);
+    void append_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data);
+    void append_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data);
 
-    std::bitset<152> get_MT1005_test();
+    void append_MT1005_test(Rtcm_Bit_Writer& data);
 
     /*!
      * \brief Generates contents of message header for types 1009, 1010, 1011 and 1012. GLONASS RTK Message
@@ -399,15 +452,16 @@ private:
      * \param ref_id
      * \param smooth_int
      * \param divergence_free
-     * \return Returns the message header content as set of bits
+     * \param data Writer where the message header is appended
      */
-    std::bitset<61> get_MT1009_12_header(uint32_t msg_number,
+    void append_MT1009_12_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
         uint32_t smooth_int,
         bool sync_flag,
-        bool divergence_free);
+        bool divergence_free,
+        Rtcm_Bit_Writer& data);
 
     /*!
      * \brief Get the contents of the satellite specific portion of a type 1009 Message (GLONASS Basic RTK, L1 Only)
@@ -416,9 +470,9 @@ private:
      * \param ephGNAV Ephemeris for GLONASS GNAV in L1 satellites
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchro Information generated by channels while processing the satellite
-     * \return Returns the message content as set of bits
+     * \param data Writer where the message content is appended
      */
-    std::bitset<64> get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void append_MT1009_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data);
     /*!
      * \brief Get the contents of the satellite specific portion of a type 1010 Message (GLONASS Extended RTK, L1 Only)
      * \details Contents generated for each satellite. See table 3.5-12
@@ -426,9 +480,9 @@ private:
      * \param ephGNAV Ephemeris for GLONASS GNAV in L1 satellites
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchro Information generated by channels while processing the satellite
-     * \return Returns the message content as set of bits
+     * \param data Writer where the message content is appended
      */
-    std::bitset<79> get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void append_MT1010_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro, Rtcm_Bit_Writer& data);
     /*!
      * \brief Get the contents of the satellite specific portion of a type 1011 Message (GLONASS Basic RTK, L1 & L2)
      * \details Contents generated for each satellite. See table 3.5-13
@@ -438,9 +492,9 @@ private:
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchroL1 Information generated by channels while processing the GLONASS GNAV L1 satellite
      * \param gnss_synchroL2 Information generated by channels while processing the GLONASS GNAV L2 satellite
-     * \return Returns the message content as set of bits
+     * \param data Writer where the message content is appended
      */
-    std::bitset<107> get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void append_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data);
     /*!
      * \brief Get the contents of the satellite specific portion of a type 1012 Message (GLONASS Extended RTK, L1 & L2)
      * \details Contents generated for each satellite. See table 3.5-14
@@ -450,11 +504,11 @@ private:
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchroL1 Information generated by channels while processing the GLONASS GNAV L1 satellite
      * \param gnss_synchroL2 Information generated by channels while processing the GLONASS GNAV L2 satellite
-     * \return Returns the message content as set of bits
+     * \param data Writer where the message content is appended
      */
-    std::bitset<130> get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void append_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2, Rtcm_Bit_Writer& data);
 
-    std::string get_MSM_header(uint32_t msg_number,
+    void append_MSM_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -462,19 +516,20 @@ private:
         uint32_t external_clock_indicator,
         int32_t smooth_int,
         bool divergence_free,
-        bool more_messages);
+        bool more_messages,
+        Rtcm_Bit_Writer& data);
 
-    std::string get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void append_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
 
-    std::string get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void append_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
+    void append_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);
 
     //
     // Utilities
@@ -483,6 +538,7 @@ private:
     static std::map<std::string, int> gps_signal_map;
     std::vector<std::pair<int32_t, Gnss_Synchro>> sort_by_signal(const std::vector<std::pair<int32_t, Gnss_Synchro>>& synchro_map) const;
     std::vector<std::pair<int32_t, Gnss_Synchro>> sort_by_PRN_mask(const std::vector<std::pair<int32_t, Gnss_Synchro>>& synchro_map) const;
+    std::map<int32_t, Gnss_Synchro> msm_observables(const std::map<int32_t, Gnss_Synchro>& observables) const;  // observables with a PRN in the satellite mask
     boost::posix_time::ptime compute_GPS_time(const Gps_Ephemeris& eph, double obs_time) const;
     boost::posix_time::ptime compute_GPS_time(const Gps_CNAV_Ephemeris& eph, double obs_time) const;
     boost::posix_time::ptime compute_Galileo_time(const Galileo_Ephemeris& eph, double obs_time) const;
@@ -958,8 +1014,7 @@ private:
     //
     std::bitset<8> preamble;
     std::bitset<6> reserved_field;
-    std::string add_CRC(const std::string& m) const;
-    std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
+    std::string build_message(const Rtcm_Bit_Writer& data) const;  // adds the header and the CRC
 
     //
     // Data Fields
@@ -1412,7 +1467,7 @@ private:
     std::bitset<32> DF395;
     int32_t set_DF395(const std::map<int32_t, Gnss_Synchro>& gnss_synchro);
 
-    std::string set_DF396(const std::map<int32_t, Gnss_Synchro>& observables);
+    void append_DF396(const std::map<int32_t, Gnss_Synchro>& observables, Rtcm_Bit_Writer& data);  // variable length cell mask
 
     std::bitset<8> DF397;
     int32_t set_DF397(const Gnss_Synchro& gnss_synchro);
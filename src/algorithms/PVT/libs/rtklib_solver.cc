@@ -38,20 +38,95 @@
 #include "rtklib_solution.h"
 #include <glog/logging.h>
 #include <matio.h>
+#include <algorithm>
 #include <exception>
 #include <utility>
 #include <vector>
 
 
+namespace
+{
+// Fields that identify an ephemeris. A change in any of them means that its
+// RTKLIB representation has to be computed again.
+std::array<double, 4> ephemeris_id(const Gps_Ephemeris &eph)
+{
+    return {{static_cast<double>(eph.toe), static_cast<double>(eph.IODE_SF2), static_cast<double>(eph.IODC), static_cast<double>(eph.WN)}};
+}
+
+
+std::array<double, 4> ephemeris_id(const Gps_CNAV_Ephemeris &eph)
+{
+    return {{static_cast<double>(eph.toe1), static_cast<double>(eph.toe2), static_cast<double>(eph.toc), static_cast<double>(eph.WN)}};
+}
+
+
+std::array<double, 4> ephemeris_id(const Galileo_Ephemeris &eph)
+{
+    return {{static_cast<double>(eph.toe), static_cast<double>(eph.IOD_ephemeris), static_cast<double>(eph.toc), static_cast<double>(eph.WN)}};
+}
+
+
+std::array<double, 4> ephemeris_id(const Beidou_Dnav_Ephemeris &eph)
+{
+    return {{static_cast<double>(eph.toe), eph.AODE, eph.AODC, static_cast<double>(eph.WN)}};
+}
+
+
+std::array<double, 4> ephemeris_id(const Glonass_Gnav_Ephemeris &eph)
+{
+    return {{eph.d_t_b, eph.d_N_T, eph.d_yr, eph.d_tau_n}};
+}
+
+
+// Returns the RTKLIB ephemeris of a satellite, converting it only if the cache
+// does not hold a conversion of the same ephemeris
+template <typename Entry, typename Ephemeris, typename F>
+auto rtklib_cached(std::vector<Entry> &cache, const Ephemeris &eph, F convert) -> decltype(convert())
+{
+    if (eph.PRN >= cache.size())
+        {
+            return convert();
+        }
+    Entry &entry = cache[eph.PRN];
+    const std::array<double, 4> id = ephemeris_id(eph);
+    if (!entry.valid || entry.source_id != id)
+        {
+            entry.eph = convert();
+            entry.source_id = id;
+            entry.valid = true;
+        }
+    return entry.eph;
+}
+
+
+template <typename Entry>
+void invalidate_rtklib_eph(std::vector<Entry> &cache, uint32_t prn)
+{
+    if (prn < cache.size())
+        {
+            cache[prn].valid = false;
+        }
+}
+}  // namespace
+
+
 Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
     const std::string &dump_filename,
     bool flag_dump_to_file,
-    bool flag_dump_to_mat) : d_rtk(rtk),
+    bool flag_dump_to_mat) : d_gps_eph_rtklib(MAXPRNGPS + 1),
+                             d_gps_cnav_eph_rtklib(MAXPRNGPS + 1),
+                             d_galileo_eph_rtklib(MAXPRNGAL + 1),
+                             d_beidou_eph_rtklib(MAXPRNBDS + 1),
+                             d_glonass_geph_rtklib(MAXPRNGLO + 1),
+                             d_eph_data(MAXOBS),
+                             d_geph_data(MAXOBS),
+                             d_rtk(rtk),
                              d_dump_filename(dump_filename),
                              d_flag_dump_enabled(flag_dump_to_file),
                              d_flag_dump_mat_enabled(flag_dump_to_mat)
 {
     this->set_averaging_flag(false);
+    update_wavelengths(0, MAXSAT, d_gal_e5_is_e5b);
 
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
@@ -379,6 +454,155 @@ Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
 }
 
 
+void Rtklib_Solver::store_ephemeris(const Gps_Ephemeris &eph)
+{
+    gps_ephemeris_map[eph.PRN] = eph;
+    invalidate_rtklib_eph(d_gps_eph_rtklib, eph.PRN);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Gps_CNAV_Ephemeris &eph)
+{
+    gps_cnav_ephemeris_map[eph.PRN] = eph;
+    invalidate_rtklib_eph(d_gps_cnav_eph_rtklib, eph.PRN);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Galileo_Ephemeris &eph)
+{
+    galileo_ephemeris_map[eph.PRN] = eph;
+    invalidate_rtklib_eph(d_galileo_eph_rtklib, eph.PRN);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Glonass_Gnav_Ephemeris &eph)
+{
+    glonass_gnav_ephemeris_map[eph.PRN] = eph;
+    invalidate_rtklib_eph(d_glonass_geph_rtklib, eph.PRN);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Beidou_Dnav_Ephemeris &eph)
+{
+    beidou_dnav_ephemeris_map[eph.PRN] = eph;
+    invalidate_rtklib_eph(d_beidou_eph_rtklib, eph.PRN);
+}
+
+
+void Rtklib_Solver::update_nav_models()
+{
+    // Models that are not valid are left at zero
+    std::fill_n(d_nav_data.ion_gps, 8, 0.0);
+    std::fill_n(d_nav_data.ion_gal, 4, 0.0);
+    std::fill_n(d_nav_data.ion_cmp, 8, 0.0);
+    std::fill_n(d_nav_data.utc_gps, 4, 0.0);
+    std::fill_n(d_nav_data.utc_glo, 4, 0.0);
+    std::fill_n(d_nav_data.utc_gal, 4, 0.0);
+    std::fill_n(d_nav_data.utc_cmp, 4, 0.0);
+    d_nav_data.leaps = 0;
+    if (gps_iono.valid)
+        {
+            d_nav_data.ion_gps[0] = gps_iono.alpha0;
+            d_nav_data.ion_gps[1] = gps_iono.alpha1;
+            d_nav_data.ion_gps[2] = gps_iono.alpha2;
+            d_nav_data.ion_gps[3] = gps_iono.alpha3;
+            d_nav_data.ion_gps[4] = gps_iono.beta0;
+            d_nav_data.ion_gps[5] = gps_iono.beta1;
+            d_nav_data.ion_gps[6] = gps_iono.beta2;
+            d_nav_data.ion_gps[7] = gps_iono.beta3;
+        }
+    if (!(gps_iono.valid) and gps_cnav_iono.valid)
+        {
+            d_nav_data.ion_gps[0] = gps_cnav_iono.alpha0;
+            d_nav_data.ion_gps[1] = gps_cnav_iono.alpha1;
+            d_nav_data.ion_gps[2] = gps_cnav_iono.alpha2;
+            d_nav_data.ion_gps[3] = gps_cnav_iono.alpha3;
+            d_nav_data.ion_gps[4] = gps_cnav_iono.beta0;
+            d_nav_data.ion_gps[5] = gps_cnav_iono.beta1;
+            d_nav_data.ion_gps[6] = gps_cnav_iono.beta2;
+            d_nav_data.ion_gps[7] = gps_cnav_iono.beta3;
+        }
+    if (galileo_iono.ai0 != 0.0)
+        {
+            d_nav_data.ion_gal[0] = galileo_iono.ai0;
+            d_nav_data.ion_gal[1] = galileo_iono.ai1;
+            d_nav_data.ion_gal[2] = galileo_iono.ai2;
+            d_nav_data.ion_gal[3] = 0.0;
+        }
+    if (beidou_dnav_iono.valid)
+        {
+            d_nav_data.ion_cmp[0] = beidou_dnav_iono.alpha0;
+            d_nav_data.ion_cmp[1] = beidou_dnav_iono.alpha1;
+            d_nav_data.ion_cmp[2] = beidou_dnav_iono.alpha2;
+            d_nav_data.ion_cmp[3] = beidou_dnav_iono.alpha3;
+            d_nav_data.ion_cmp[4] = beidou_dnav_iono.beta0;
+            d_nav_data.ion_cmp[5] = beidou_dnav_iono.beta0;
+            d_nav_data.ion_cmp[6] = beidou_dnav_iono.beta0;
+            d_nav_data.ion_cmp[7] = beidou_dnav_iono.beta3;
+        }
+    if (gps_utc_model.valid)
+        {
+            d_nav_data.utc_gps[0] = gps_utc_model.A0;
+            d_nav_data.utc_gps[1] = gps_utc_model.A1;
+            d_nav_data.utc_gps[2] = gps_utc_model.tot;
+            d_nav_data.utc_gps[3] = gps_utc_model.WN_T;
+            d_nav_data.leaps = gps_utc_model.DeltaT_LS;
+        }
+    if (!(gps_utc_model.valid) and gps_cnav_utc_model.valid)
+        {
+            d_nav_data.utc_gps[0] = gps_cnav_utc_model.A0;
+            d_nav_data.utc_gps[1] = gps_cnav_utc_model.A1;
+            d_nav_data.utc_gps[2] = gps_cnav_utc_model.tot;
+            d_nav_data.utc_gps[3] = gps_cnav_utc_model.WN_T;
+            d_nav_data.leaps = gps_cnav_utc_model.DeltaT_LS;
+        }
+    if (glonass_gnav_utc_model.valid)
+        {
+            d_nav_data.utc_glo[0] = glonass_gnav_utc_model.d_tau_c;  // ??
+            d_nav_data.utc_glo[1] = 0.0;                             // ??
+            d_nav_data.utc_glo[2] = 0.0;                             // ??
+            d_nav_data.utc_glo[3] = 0.0;                             // ??
+        }
+    if (galileo_utc_model.A0 != 0.0)
+        {
+            d_nav_data.utc_gal[0] = galileo_utc_model.A0;
+            d_nav_data.utc_gal[1] = galileo_utc_model.A1;
+            d_nav_data.utc_gal[2] = galileo_utc_model.tot;
+            d_nav_data.utc_gal[3] = galileo_utc_model.WNot;
+            d_nav_data.leaps = galileo_utc_model.Delta_tLS;
+        }
+    if (beidou_dnav_utc_model.valid)
+        {
+            d_nav_data.utc_cmp[0] = beidou_dnav_utc_model.A0_UTC;
+            d_nav_data.utc_cmp[1] = beidou_dnav_utc_model.A1_UTC;
+            d_nav_data.utc_cmp[2] = 0.0;  // ??
+            d_nav_data.utc_cmp[3] = 0.0;  // ??
+            d_nav_data.leaps = beidou_dnav_utc_model.DeltaT_LS;
+        }
+}
+
+
+void Rtklib_Solver::update_wavelengths(int first_sat, int last_sat, bool gal_e5_is_e5b)
+{
+    /* update carrier wave length using native function call in RTKlib */
+    for (int i = first_sat; i < last_sat; i++)
+        {
+            for (int j = 0; j < NFREQ; j++)
+                {
+                    if (j == 2 && gal_e5_is_e5b)
+                        {
+                            // frq = 4 corresponds to E5B in that function
+                            d_nav_data.lam[i][j] = satwavelen(i + 1, 4, &d_nav_data);
+                        }
+                    else
+                        {
+                            d_nav_data.lam[i][j] = satwavelen(i + 1, j, &d_nav_data);
+                        }
+                }
+        }
+}
+
+
 bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
     std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
@@ -399,8 +623,25 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
     d_obs_data.fill({});
-    std::vector<eph_t> eph_data(MAXOBS);
-    std::vector<geph_t> geph_data(MAXOBS);
+
+    // Conversions done with other settings are no longer valid
+    if (d_gps_eph_pre_2009 != this->is_pre_2009())
+        {
+            d_gps_eph_pre_2009 = this->is_pre_2009();
+            for (auto &entry : d_gps_eph_rtklib)
+                {
+                    entry.valid = false;
+                }
+        }
+    if (d_glonass_geph_tau_c != gnav_utc.d_tau_c || d_glonass_geph_tau_gps != gnav_utc.d_tau_gps)
+        {
+            d_glonass_geph_tau_c = gnav_utc.d_tau_c;
+            d_glonass_geph_tau_gps = gnav_utc.d_tau_gps;
+            for (auto &entry : d_glonass_geph_rtklib)
+                {
+                    entry.valid = false;
+                }
+        }
 
     // Workaround for NAV/CNAV clash problem
     bool gps_dual_band = false;
@@ -453,7 +694,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                        d_eph_data[valid_obs] = rtklib_cached(d_galileo_eph_rtklib, galileo_ephemeris_iter->second, [&]() { return eph_to_rtklib(galileo_ephemeris_iter->second); });
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -478,7 +719,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -492,7 +733,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E5 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_cached(d_galileo_eph_rtklib, galileo_ephemeris_iter->second, [&]() { return eph_to_rtklib(galileo_ephemeris_iter->second); });
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -527,7 +768,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                 if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(gps_ephemeris_iter->second, this->is_pre_2009());
+                                        d_eph_data[valid_obs] = rtklib_cached(d_gps_eph_rtklib, gps_ephemeris_iter->second, [&]() { return eph_to_rtklib(gps_ephemeris_iter->second, d_gps_eph_pre_2009); });
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -557,12 +798,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L2 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (d_eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                d_eph_data[i] = rtklib_cached(d_gps_cnav_eph_rtklib, gps_cnav_ephemeris_iter->second, [&]() { return eph_to_rtklib(gps_cnav_ephemeris_iter->second); });
                                                                 d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                                     gnss_observables_iter->second,
-                                                                    eph_data[i].week,
+                                                                    d_eph_data[i].week,
                                                                     1);  // Band 2 (L2)
                                                                 break;
                                                             }
@@ -573,7 +814,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L2 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_cached(d_gps_cnav_eph_rtklib, gps_cnav_ephemeris_iter->second, [&]() { return eph_to_rtklib(gps_cnav_ephemeris_iter->second); });
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -605,9 +846,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L5 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (d_eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                d_eph_data[i] = rtklib_cached(d_gps_cnav_eph_rtklib, gps_cnav_ephemeris_iter->second, [&]() { return eph_to_rtklib(gps_cnav_ephemeris_iter->second); });
                                                                 d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i],
                                                                     gnss_observables_iter->second,
                                                                     gps_cnav_ephemeris_iter->second.WN,
@@ -620,7 +861,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L5 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_cached(d_gps_cnav_eph_rtklib, gps_cnav_ephemeris_iter->second, [&]() { return eph_to_rtklib(gps_cnav_ephemeris_iter->second); });
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -651,7 +892,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                 if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                        d_geph_data[glo_valid_obs] = rtklib_cached(d_glonass_geph_rtklib, glonass_gnav_ephemeris_iter->second, [&]() { return eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc); });
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -675,7 +916,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_L1_obs = false;
                                         for (int i = 0; i < glo_valid_obs; i++)
                                             {
-                                                if (geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
+                                                if (d_geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
                                                     {
                                                         d_obs_data[i + valid_obs] = insert_obs_to_rtklib(d_obs_data[i + valid_obs],
                                                             gnss_observables_iter->second,
@@ -689,7 +930,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert GLONASS GNAV L2 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                                d_geph_data[glo_valid_obs] = rtklib_cached(d_glonass_geph_rtklib, glonass_gnav_ephemeris_iter->second, [&]() { return eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc); });
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 obsd_t newobs{};
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -717,7 +958,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                        d_eph_data[valid_obs] = rtklib_cached(d_beidou_eph_rtklib, beidou_ephemeris_iter->second, [&]() { return eph_to_rtklib(beidou_ephemeris_iter->second); });
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -740,7 +981,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_B1I_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -754,7 +995,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert BeiDou B3I obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_cached(d_beidou_eph_rtklib, beidou_ephemeris_iter->second, [&]() { return eph_to_rtklib(beidou_ephemeris_iter->second); });
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -789,109 +1030,25 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     if ((valid_obs + glo_valid_obs) > 3)
         {
             int result = 0;
-            nav_t nav_data{};
-            nav_data.eph = eph_data.data();
-            nav_data.geph = geph_data.data();
-            nav_data.n = valid_obs;
-            nav_data.ng = glo_valid_obs;
-            if (gps_iono.valid)
-                {
-                    nav_data.ion_gps[0] = gps_iono.alpha0;
-                    nav_data.ion_gps[1] = gps_iono.alpha1;
-                    nav_data.ion_gps[2] = gps_iono.alpha2;
-                    nav_data.ion_gps[3] = gps_iono.alpha3;
-                    nav_data.ion_gps[4] = gps_iono.beta0;
-                    nav_data.ion_gps[5] = gps_iono.beta1;
-                    nav_data.ion_gps[6] = gps_iono.beta2;
-                    nav_data.ion_gps[7] = gps_iono.beta3;
-                }
-            if (!(gps_iono.valid) and gps_cnav_iono.valid)
-                {
-                    nav_data.ion_gps[0] = gps_cnav_iono.alpha0;
-                    nav_data.ion_gps[1] = gps_cnav_iono.alpha1;
-                    nav_data.ion_gps[2] = gps_cnav_iono.alpha2;
-                    nav_data.ion_gps[3] = gps_cnav_iono.alpha3;
-                    nav_data.ion_gps[4] = gps_cnav_iono.beta0;
-                    nav_data.ion_gps[5] = gps_cnav_iono.beta1;
-                    nav_data.ion_gps[6] = gps_cnav_iono.beta2;
-                    nav_data.ion_gps[7] = gps_cnav_iono.beta3;
-                }
-            if (galileo_iono.ai0 != 0.0)
-                {
-                    nav_data.ion_gal[0] = galileo_iono.ai0;
-                    nav_data.ion_gal[1] = galileo_iono.ai1;
-                    nav_data.ion_gal[2] = galileo_iono.ai2;
-                    nav_data.ion_gal[3] = 0.0;
-                }
-            if (beidou_dnav_iono.valid)
-                {
-                    nav_data.ion_cmp[0] = beidou_dnav_iono.alpha0;
-                    nav_data.ion_cmp[1] = beidou_dnav_iono.alpha1;
-                    nav_data.ion_cmp[2] = beidou_dnav_iono.alpha2;
-                    nav_data.ion_cmp[3] = beidou_dnav_iono.alpha3;
-                    nav_data.ion_cmp[4] = beidou_dnav_iono.beta0;
-                    nav_data.ion_cmp[5] = beidou_dnav_iono.beta0;
-                    nav_data.ion_cmp[6] = beidou_dnav_iono.beta0;
-                    nav_data.ion_cmp[7] = beidou_dnav_iono.beta3;
-                }
-            if (gps_utc_model.valid)
-                {
-                    nav_data.utc_gps[0] = gps_utc_model.A0;
-                    nav_data.utc_gps[1] = gps_utc_model.A1;
-                    nav_data.utc_gps[2] = gps_utc_model.tot;
-                    nav_data.utc_gps[3] = gps_utc_model.WN_T;
-                    nav_data.leaps = gps_utc_model.DeltaT_LS;
-                }
-            if (!(gps_utc_model.valid) and gps_cnav_utc_model.valid)
-                {
-                    nav_data.utc_gps[0] = gps_cnav_utc_model.A0;
-                    nav_data.utc_gps[1] = gps_cnav_utc_model.A1;
-                    nav_data.utc_gps[2] = gps_cnav_utc_model.tot;
-                    nav_data.utc_gps[3] = gps_cnav_utc_model.WN_T;
-                    nav_data.leaps = gps_cnav_utc_model.DeltaT_LS;
-                }
-            if (glonass_gnav_utc_model.valid)
-                {
-                    nav_data.utc_glo[0] = glonass_gnav_utc_model.d_tau_c;  // ??
-                    nav_data.utc_glo[1] = 0.0;                             // ??
-                    nav_data.utc_glo[2] = 0.0;                             // ??
-                    nav_data.utc_glo[3] = 0.0;                             // ??
-                }
-            if (galileo_utc_model.A0 != 0.0)
-                {
-                    nav_data.utc_gal[0] = galileo_utc_model.A0;
-                    nav_data.utc_gal[1] = galileo_utc_model.A1;
-                    nav_data.utc_gal[2] = galileo_utc_model.tot;
-                    nav_data.utc_gal[3] = galileo_utc_model.WNot;
-                    nav_data.leaps = galileo_utc_model.Delta_tLS;
-                }
-            if (beidou_dnav_utc_model.valid)
+            d_nav_data.eph = d_eph_data.data();
+            d_nav_data.geph = d_geph_data.data();
+            d_nav_data.n = valid_obs;
+            d_nav_data.ng = glo_valid_obs;
+            update_nav_models();
+
+            // The wavelengths of GLONASS satellites depend on the frequency
+            // channels in d_geph_data, the rest only on the Galileo E5 band
+            if (gal_e5_is_e5b != d_gal_e5_is_e5b)
                 {
-                    nav_data.utc_cmp[0] = beidou_dnav_utc_model.A0_UTC;
-                    nav_data.utc_cmp[1] = beidou_dnav_utc_model.A1_UTC;
-                    nav_data.utc_cmp[2] = 0.0;  // ??
-                    nav_data.utc_cmp[3] = 0.0;  // ??
-                    nav_data.leaps = beidou_dnav_utc_model.DeltaT_LS;
+                    d_gal_e5_is_e5b = gal_e5_is_e5b;
+                    update_wavelengths(0, MAXSAT, d_gal_e5_is_e5b);
                 }
-
-            /* update carrier wave length using native function call in RTKlib */
-            for (int i = 0; i < MAXSAT; i++)
+            else
                 {
-                    for (int j = 0; j < NFREQ; j++)
-                        {
-                            if (j == 2 && gal_e5_is_e5b)
-                                {
-                                    // frq = 4 corresponds to E5B in that function
-                                    nav_data.lam[i][j] = satwavelen(i + 1, 4, &nav_data);
-                                }
-                            else
-                                {
-                                    nav_data.lam[i][j] = satwavelen(i + 1, j, &nav_data);
-                                }
-                        }
+                    update_wavelengths(NSATGPS, NSATGPS + NSATGLO, d_gal_e5_is_e5b);
                 }
 
-            result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &nav_data);
+            result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &d_nav_data);
 
             if (result == 0)
                 {
@@ -992,7 +1149,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     // TOW
                     d_monitor_pvt.TOW_at_current_symbol_ms = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
                     // WEEK
-                    d_monitor_pvt.week = adjgpsweek(nav_data.eph[0].week, this->is_pre_2009());
+                    d_monitor_pvt.week = adjgpsweek(d_nav_data.eph[0].week, this->is_pre_2009());
                     // PVT GPS time
                     d_monitor_pvt.RX_time = gnss_observables_map.cbegin()->second.RX_time;
                     // User clock offset [s]
@@ -1058,7 +1215,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     tmp_uint32 = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
                                     // WEEK
-                                    tmp_uint32 = adjgpsweek(nav_data.eph[0].week, this->is_pre_2009());
+                                    tmp_uint32 = adjgpsweek(d_nav_data.eph[0].week, this->is_pre_2009());
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
                                     // PVT GPS time
                                     tmp_double = gnss_observables_map.cbegin()->second.RX_time;
@@ -61,6 +61,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -80,6 +81,16 @@ public:
 
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
 
+    /*!
+     * \brief Stores an ephemeris in its map. Its RTKLIB representation is
+     * computed again the next time the satellite is observed.
+     */
+    void store_ephemeris(const Gps_Ephemeris& eph);
+    void store_ephemeris(const Gps_CNAV_Ephemeris& eph);
+    void store_ephemeris(const Galileo_Ephemeris& eph);
+    void store_ephemeris(const Glonass_Gnav_Ephemeris& eph);
+    void store_ephemeris(const Beidou_Dnav_Ephemeris& eph);
+
     double get_hdop() const override;
     double get_vdop() const override;
     double get_pdop() const override;
@@ -89,6 +100,9 @@ public:
     sol_t pvt_sol{};
     std::array<ssat_t, MAXSAT> pvt_ssat{};
 
+    // The RTKLIB representation of the ephemerides is cached. An entry is
+    // converted again when the reference time, issue of data or week of the
+    // ephemeris in the map changes, so the maps may also be written directly.
     std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;            //!< Map storing new Galileo_Ephemeris
     std::map<int, Gps_Ephemeris> gps_ephemeris_map;                    //!< Map storing new GPS_Ephemeris
     std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;          //!< Map storing new GPS_CNAV_Ephemeris
@@ -115,6 +129,30 @@ public:
 
 private:
     bool save_matfile() const;
+    void update_nav_models();                                                  // copies the iono and UTC models to d_nav_data
+    void update_wavelengths(int first_sat, int last_sat, bool gal_e5_is_e5b);  // d_nav_data.lam of satellites [first_sat, last_sat)
+
+    // RTKLIB representation of an ephemeris, along with the fields of the
+    // converted ephemeris that identify it
+    template <typename T>
+    struct Rtklib_Eph_Entry
+    {
+        T eph{};
+        std::array<double, 4> source_id{};
+        bool valid{false};
+    };
+
+    // RTKLIB representation of the ephemerides in the maps, indexed by PRN
+    std::vector<Rtklib_Eph_Entry<eph_t>> d_gps_eph_rtklib;
+    std::vector<Rtklib_Eph_Entry<eph_t>> d_gps_cnav_eph_rtklib;
+    std::vector<Rtklib_Eph_Entry<eph_t>> d_galileo_eph_rtklib;
+    std::vector<Rtklib_Eph_Entry<eph_t>> d_beidou_eph_rtklib;
+    std::vector<Rtklib_Eph_Entry<geph_t>> d_glonass_geph_rtklib;
+
+    // Navigation data passed to RTKLIB, kept between epochs
+    nav_t d_nav_data{};
+    std::vector<eph_t> d_eph_data;
+    std::vector<geph_t> d_geph_data;
 
     std::array<obsd_t, MAXOBS> d_obs_data{};
     std::array<double, 4> d_dop{};
@@ -122,8 +160,12 @@ private:
     Monitor_Pvt d_monitor_pvt{};
     std::string d_dump_filename;
     std::ofstream d_dump_file;
+    double d_glonass_geph_tau_c{0.0};  // GLONASS UTC model used to convert d_glonass_geph_rtklib
+    double d_glonass_geph_tau_gps{0.0};
     bool d_flag_dump_enabled;
     bool d_flag_dump_mat_enabled;
+    bool d_gps_eph_pre_2009{false};  // week rollover flag used to convert d_gps_eph_rtklib
+    bool d_gal_e5_is_e5b{false};     // Galileo E5 band used to compute d_nav_data.lam
 };
 
 
@@ -20,6 +20,7 @@
 #include "acq_conf.h"
 #include "configuration_interface.h"
 #include "galileo_e1_signal_replica.h"
+#include "gnss_code_cache.h"
 #include "gnss_sdr_flags.h"
 #include <boost/math/distributions/exponential.hpp>
 #include <glog/logging.h>
@@ -152,41 +153,24 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
     bool cboc = configuration_->property(
         "Acquisition" + std::to_string(channel_) + ".cboc", false);
 
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
-
+    std::array<char, 3> Signal_{};
     if (acquire_pilot_ == true)
         {
             // set local signal generator to Galileo E1 pilot component (1C)
-            std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-            if (acq_parameters_.use_automatic_resampler)
-                {
-                    galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
-                }
-            else
-                {
-                    galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
-                }
+            Signal_ = {{'1', 'C', '\0'}};
         }
     else
         {
-            std::array<char, 3> Signal_{};
             Signal_[0] = gnss_synchro_->Signal[0];
             Signal_[1] = gnss_synchro_->Signal[1];
             Signal_[2] = '\0';
-            if (acq_parameters_.use_automatic_resampler)
-                {
-                    galileo_e1_code_gen_complex_sampled(code, Signal_,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
-                }
-            else
-                {
-                    galileo_e1_code_gen_complex_sampled(code, Signal_,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
-                }
         }
 
+    const uint32_t prn = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const own::span<const std::complex<float>> code = Gnss_Code_Cache::instance().complex_code(std::string(Signal_.data()) + (cboc ? "_CBOC" : ""), prn, fs, code_length_,
+        [Signal_, cboc, prn, fs](own::span<std::complex<float>> dest) { galileo_e1_code_gen_complex_sampled(dest, Signal_, cboc, prn, static_cast<int32_t>(fs), 0, false); });
+
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_ / 4; i++)
         {
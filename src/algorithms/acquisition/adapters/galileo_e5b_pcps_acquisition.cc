@@ -20,6 +20,7 @@
 #include "Galileo_E5b.h"
 #include "acq_conf.h"
 #include "configuration_interface.h"
+#include "gnss_code_cache.h"
 #include "galileo_e5_signal_replica.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
@@ -143,7 +144,6 @@ void GalileoE5bPcpsAcquisition::init()
 
 void GalileoE5bPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
     std::array<char, 3> signal_{};
     signal_[0] = '7';
     signal_[2] = '\0';
@@ -161,14 +161,10 @@ void GalileoE5bPcpsAcquisition::set_local_code()
             signal_[1] = 'I';
         }
 
-    if (acq_parameters_.use_automatic_resampler)
-        {
-            galileo_e5_b_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, acq_parameters_.resampled_fs, 0);
-        }
-    else
-        {
-            galileo_e5_b_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, fs_in_, 0);
-        }
+    const uint32_t prn = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const own::span<const std::complex<float>> code = Gnss_Code_Cache::instance().complex_code(signal_.data(), prn, fs, code_length_,
+        [prn, signal_, fs](own::span<std::complex<float>> dest) { galileo_e5_b_code_gen_complex_sampled(dest, prn, signal_, static_cast<int32_t>(fs), 0); });
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
         {
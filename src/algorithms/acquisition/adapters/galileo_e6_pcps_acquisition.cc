@@ -19,6 +19,7 @@
 #include "Galileo_E6.h"
 #include "acq_conf.h"
 #include "configuration_interface.h"
+#include "gnss_code_cache.h"
 #include "galileo_e6_signal_replica.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
@@ -147,18 +148,10 @@ void GalileoE6PcpsAcquisition::init()
 
 void GalileoE6PcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
-
-    if (acq_parameters_.use_automatic_resampler)
-        {
-            galileo_e6_b_code_gen_complex_sampled(code,
-                gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0);
-        }
-    else
-        {
-            galileo_e6_b_code_gen_complex_sampled(code,
-                gnss_synchro_->PRN, fs_in_, 0);
-        }
+    const uint32_t prn = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const own::span<const std::complex<float>> code = Gnss_Code_Cache::instance().complex_code("E6B", prn, fs, code_length_,
+        [prn, fs](own::span<std::complex<float>> dest) { galileo_e6_b_code_gen_complex_sampled(dest, prn, static_cast<int32_t>(fs), 0); });
 
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
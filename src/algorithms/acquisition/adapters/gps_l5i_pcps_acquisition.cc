@@ -21,6 +21,7 @@
 #include "GPS_L5.h"
 #include "acq_conf.h"
 #include "configuration_interface.h"
+#include "gnss_code_cache.h"
 #include "gnss_sdr_flags.h"
 #include "gps_l5_signal_replica.h"
 #include <glog/logging.h>
@@ -150,16 +151,10 @@ void GpsL5iPcpsAcquisition::init()
 
 void GpsL5iPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
-
-    if (acq_parameters_.use_automatic_resampler)
-        {
-            gps_l5i_code_gen_complex_sampled(code, gnss_synchro_->PRN, acq_parameters_.resampled_fs);
-        }
-    else
-        {
-            gps_l5i_code_gen_complex_sampled(code, gnss_synchro_->PRN, fs_in_);
-        }
+    const uint32_t prn = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const own::span<const std::complex<float>> code = Gnss_Code_Cache::instance().complex_code("L5I", prn, fs, code_length_,
+        [prn, fs](own::span<std::complex<float>> dest) { gps_l5i_code_gen_complex_sampled(dest, prn, static_cast<int32_t>(fs)); });
 
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < num_codes_; i++)
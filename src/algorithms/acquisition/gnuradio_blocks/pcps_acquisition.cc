@@ -22,9 +22,11 @@
 #include "pcps_acquisition.h"
 #include "GLONASS_L1_L2_CA.h"  // for GLONASS_PRN
 #include "MATH_CONSTANTS.h"    // for TWO_PI
+#include "gnss_block_profiler.h"
 #include "gnss_frequencies.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
 #include <boost/math/special_functions/gamma.hpp>
 #include <gnuradio/io_signature.h>
@@ -72,6 +74,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_consumed_samples(conf_.sampled_ms * conf_.samples_per_ms * (conf_.bit_transition_flag ? 2.0 : 1.0)),
       d_num_doppler_bins(0U),
       d_num_doppler_bins_step2(conf_.num_doppler_bins_step2),
+      d_num_doppler_workers(std::max(conf_.doppler_workers, 1U)),
       d_dump_channel(conf_.dump_channel),
       d_buffer_count(0U),
       d_active(false),
@@ -80,6 +83,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_use_CFAR_algorithm_flag(conf_.use_CFAR_algorithm_flag),
       d_dump(conf_.dump)
 {
+    d_profiler_stats = Gnss_Block_Profiler::instance().register_block(this->name(), static_cast<uint32_t>(this->unique_id()));
     this->message_port_register_out(pmt::mp("events"));
 
     if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
@@ -109,11 +113,25 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     // }
 
     d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
-    d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+    d_table_cache = acq_table_cache();
+    d_fft_codes = std::make_shared<const Acq_Code_Spectrum>(d_fft_size);
     d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
     d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
     d_ifft = gnss_fft_rev_make_unique(d_fft_size);
 
+    // Additional workers for the Doppler search, each one with its own FFT plans and scratch buffer
+    if (d_num_doppler_workers > 1)
+        {
+            d_doppler_workers = std::vector<Doppler_Worker>(d_num_doppler_workers - 1);
+            for (auto& worker : d_doppler_workers)
+                {
+                    worker.fft_if = gnss_fft_fwd_make_unique(d_fft_size);
+                    worker.ifft = gnss_fft_rev_make_unique(d_fft_size);
+                    worker.tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
+                }
+            d_doppler_worker_pool = std::make_unique<Acq_Worker_Pool>(d_num_doppler_workers);
+        }
+
     d_grid = arma::fmat();
     d_narrow_grid = arma::fmat();
 
@@ -132,6 +150,11 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
             d_data_buffer_sc = volk_gnsssdr::vector<lv_16sc_t>(d_consumed_samples);
         }
 
+    if (d_acq_parameters.use_shared_engine)
+        {
+            d_shared_engine = acq_shared_engine();
+        }
+
     if (d_dump)
         {
             std::string dump_path;
@@ -175,37 +198,44 @@ void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 
 void pcps_acquisition::set_local_code(std::complex<float>* code)
 {
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     // This will check if it's fdma, if yes will update the intermediate frequency and the doppler grid
     if (is_fdma())
         {
             update_grid_doppler_wipeoffs();
         }
-    // COD
-    // Here we want to create a buffer that looks like this:
-    // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
-    // where c_i is the local code and there are L zeros and L chips
-    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
-    if (d_acq_parameters.bit_transition_flag)
-        {
-            const int32_t offset = d_fft_size / 2;
-            std::fill_n(d_fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
-            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * offset);
-        }
-    else
-        {
-            if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
-                {
-                    memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_consumed_samples);
-                }
-            else
-                {
-                    std::fill_n(d_fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
-                    memcpy(d_fft_if->get_inbuf() + d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
-                }
-        }
+    const int64_t fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const std::string key = std::string(d_gnss_synchro->Signal) + "_" + std::to_string(d_gnss_synchro->PRN) + "_" +
+                            std::to_string(fs) + "_" + std::to_string(d_fft_size) + (d_acq_parameters.bit_transition_flag ? "_bt" : "");
+
+    // The FFT of the local code is computed only if no other channel did it before for the same code
+    d_fft_codes = d_table_cache->get_code_spectrum(key, own::span<const gr_complex>(code, d_consumed_samples), d_fft_size, [this, code](Acq_Code_Spectrum& fft_codes) {
+        // COD
+        // Here we want to create a buffer that looks like this:
+        // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
+        // where c_i is the local code and there are L zeros and L chips
+        if (d_acq_parameters.bit_transition_flag)
+            {
+                const int32_t offset = d_fft_size / 2;
+                std::fill_n(d_fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
+                memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * offset);
+            }
+        else
+            {
+                if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
+                    {
+                        memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_consumed_samples);
+                    }
+                else
+                    {
+                        std::fill_n(d_fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
+                        memcpy(d_fft_if->get_inbuf() + d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
+                    }
+            }
 
-    d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+        d_fft_if->execute();  // We need the FFT of local code
+        volk_32fc_conjugate_32fc(fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    });
 }
 
 
@@ -261,11 +291,8 @@ void pcps_acquisition::init()
 
     d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(d_acq_parameters.doppler_max) - static_cast<int32_t>(-d_acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
 
-    // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs.empty())
-        {
-            d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
-        }
+    // Create the carrier Doppler wipeoff signals. The wide grid is shared
+    // with other channels (see update_grid_doppler_wipeoffs)
     if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()))
         {
             d_grid_doppler_wipeoffs_step_two = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins_step2, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
@@ -281,7 +308,10 @@ void pcps_acquisition::init()
             std::fill(d_magnitude_grid[doppler_index].begin(), d_magnitude_grid[doppler_index].end(), 0.0);
         }
 
-    update_grid_doppler_wipeoffs();
+    {
+        gr::thread::scoped_lock lock(d_setlock);  // the wipeoffs are also replaced by set_doppler_center
+        update_grid_doppler_wipeoffs();
+    }
     d_worker_active = false;
 
     if (d_dump)
@@ -295,11 +325,84 @@ void pcps_acquisition::init()
 
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    // Must be called with d_setlock held
+    // Channels with the same sampling rate, FFT size and Doppler grid share the same wipeoffs
+    const int64_t fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const int32_t first_doppler = d_doppler_bias - static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center;
+    const std::string grid_key = std::to_string(fs) + "_" + std::to_string(d_fft_size) + "_" + std::to_string(first_doppler) + "_" +
+                                 std::to_string(d_doppler_step) + "_" + std::to_string(d_num_doppler_bins);
+    if (d_acq_parameters.frequency_domain_doppler)
+        {
+            update_grid_doppler_residuals(grid_key);
+        }
+    else
+        {
+            d_grid_doppler_wipeoffs = d_table_cache->get_wipeoffs("td_" + grid_key, d_num_doppler_bins, d_fft_size, [this](Acq_Wipeoff_Table& wipeoffs) {
+                for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                    {
+                        const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
+                        update_local_carrier(wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+                    }
+            });
+        }
+    if (d_shared_engine)
+        {
+            // Channels with the same Doppler wipeoffs and input block size produce the same input spectra
+            d_shared_engine_key = grid_key + "_" + std::to_string(d_consumed_samples) + (d_acq_parameters.frequency_domain_doppler ? "_fd" : "_td");
+        }
+}
+
+
+void pcps_acquisition::update_grid_doppler_residuals(const std::string& grid_key)
+{
+    // Each Doppler bin f is split as f = m * fs / fft_size + r, with 0 <= r < fs / fft_size.
+    // Since FFT(x .* exp(-j 2 pi f n / fs))[k] = FFT(x .* exp(-j 2 pi r n / fs))[k + m],
+    // only one forward FFT per distinct residual r is needed, and each Doppler bin is
+    // obtained by circularly shifting the spectrum of its residual by m bins.
+    const double fs = static_cast<double>(d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const double fft_bin_hz = fs / static_cast<double>(d_fft_size);
+    std::vector<double> residuals;
+    d_doppler_bin_residual = std::vector<uint32_t>(d_num_doppler_bins);
+    d_doppler_bin_shift = std::vector<uint32_t>(d_num_doppler_bins);
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
-            const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+            const double doppler = static_cast<double>(d_doppler_bias - static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + static_cast<int32_t>(d_doppler_step * doppler_index));
+            const double fft_bins = doppler / fft_bin_hz;
+            double shift = std::floor(fft_bins);
+            if (std::abs(fft_bins - std::round(fft_bins)) < 1e-6)
+                {
+                    shift = std::round(fft_bins);
+                }
+            const double residual = doppler - shift * fft_bin_hz;
+            auto it = std::find_if(residuals.begin(), residuals.end(), [residual](double r) { return std::abs(r - residual) < 1e-3; });
+            if (it == residuals.end())
+                {
+                    residuals.push_back(residual);
+                    it = residuals.end() - 1;
+                }
+            d_doppler_bin_residual[doppler_index] = static_cast<uint32_t>(it - residuals.begin());
+            const auto n = static_cast<int64_t>(d_fft_size);
+            d_doppler_bin_shift[doppler_index] = static_cast<uint32_t>(((static_cast<int64_t>(shift) % n) + n) % n);
+        }
+
+    if (residuals.size() * 2 > d_num_doppler_bins)
+        {
+            LOG(WARNING) << "Channel " << d_channel << ": the Doppler step (" << d_doppler_step
+                         << " Hz) is not a divisor of the FFT bin spacing (" << fft_bin_hz
+                         << " Hz), the frequency-domain Doppler search needs " << residuals.size()
+                         << " forward FFTs for " << d_num_doppler_bins << " Doppler bins";
+        }
+
+    if (!d_residual_spectra or d_residual_spectra->num_doppler_bins() != residuals.size())
+        {
+            d_residual_spectra = std::make_shared<Acq_Input_Spectra>(0ULL, own::span<const gr_complex>(), static_cast<uint32_t>(residuals.size()), d_fft_size);
         }
+    d_grid_doppler_wipeoffs = d_table_cache->get_wipeoffs("fd_" + grid_key, residuals.size(), d_fft_size, [this, &residuals](Acq_Wipeoff_Table& wipeoffs) {
+        for (size_t residual_index = 0; residual_index < residuals.size(); residual_index++)
+            {
+                update_local_carrier(wipeoffs[residual_index], static_cast<float>(residuals[residual_index]));
+            }
+    });
 }
 
 
@@ -598,10 +701,121 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
 }
 
 
+void pcps_acquisition::compute_input_spectra(uint32_t worker_index, const gr_complex* in, const Acq_Wipeoff_Table& wipeoffs, Acq_Input_Spectra& spectra)
+{
+    // In the frequency-domain Doppler search, the wipeoffs only hold the residual frequencies
+    gnss_fft_complex_fwd* fft_if = (worker_index == 0 ? d_fft_if.get() : d_doppler_workers[worker_index - 1].fft_if.get());
+    for (uint32_t doppler_index = worker_index; doppler_index < spectra.num_doppler_bins(); doppler_index += d_num_doppler_workers)
+        {
+            // Remove Doppler
+            volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, wipeoffs[doppler_index].data(), d_fft_size);
+
+            // Compute the FFT of the carrier wiped--off incoming signal
+            fft_if->execute();
+            memcpy(spectra.bin(doppler_index), fft_if->get_outbuf(), sizeof(gr_complex) * d_fft_size);
+        }
+}
+
+
+void pcps_acquisition::search_doppler_bins(uint32_t worker_index,
+    const gr_complex* in,
+    const Acq_Input_Spectra* spectra,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& wipeoffs,
+    const Acq_Code_Spectrum& fft_codes,
+    const std::vector<uint32_t>& doppler_bin_residual,
+    const std::vector<uint32_t>& doppler_bin_shift,
+    uint32_t num_doppler_bins,
+    arma::fmat& dump_grid,
+    int32_t effective_fft_size)
+{
+    // Each worker owns its FFT plans and scratch buffer, and processes
+    // the Doppler bins doppler_index = worker_index (mod number of workers)
+    gnss_fft_complex_fwd* fft_if = (worker_index == 0 ? d_fft_if.get() : d_doppler_workers[worker_index - 1].fft_if.get());
+    gnss_fft_complex_rev* ifft = (worker_index == 0 ? d_ifft.get() : d_doppler_workers[worker_index - 1].ifft.get());
+    float* tmp_buffer = (worker_index == 0 ? d_tmp_buffer.data() : d_doppler_workers[worker_index - 1].tmp_buffer.data());
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+
+    for (uint32_t doppler_index = worker_index; doppler_index < num_doppler_bins; doppler_index += d_num_doppler_workers)
+        {
+            if (spectra == nullptr)
+                {
+                    // Remove Doppler
+                    volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, wipeoffs[doppler_index].data(), d_fft_size);
+
+                    // Perform the FFT-based convolution  (parallel time search)
+                    // Compute the FFT of the carrier wiped--off incoming signal
+                    fft_if->execute();
+
+                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), fft_if->get_outbuf(), fft_codes.data(), d_fft_size);
+                }
+            else if (d_acq_parameters.frequency_domain_doppler)
+                {
+                    // Circularly shift the spectrum of the residual frequency by the integer number
+                    // of FFT bins of this Doppler bin, and multiply it with the local FFT'd code reference
+                    const gr_complex* residual_spectrum = spectra->bin(doppler_bin_residual[doppler_index]);
+                    const uint32_t shift = doppler_bin_shift[doppler_index];
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), residual_spectrum + shift, fft_codes.data(), d_fft_size - shift);
+                    if (shift > 0)
+                        {
+                            volk_32fc_x2_multiply_32fc(ifft->get_inbuf() + d_fft_size - shift, residual_spectrum, fft_codes.data() + d_fft_size - shift, shift);
+                        }
+                }
+            else
+                {
+                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), spectra->bin(doppler_index), fft_codes.data(), d_fft_size);
+                }
+
+            // Compute the inverse FFT
+            ifft->execute();
+
+            // Compute squared magnitude (and accumulate in case of non-coherent integration)
+            if (d_num_noncoherent_integrations_counter == 1)
+                {
+                    volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), ifft->get_outbuf() + offset, effective_fft_size);
+                }
+            else
+                {
+                    volk_32fc_magnitude_squared_32f(tmp_buffer, ifft->get_outbuf() + offset, effective_fft_size);
+                    volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), tmp_buffer, effective_fft_size);
+                }
+
+            // Record results to file if required
+            if (d_dump and d_channel == d_dump_channel)
+                {
+                    memcpy(dump_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                }
+        }
+}
+
+
+void pcps_acquisition::run_doppler_workers(const Acq_Worker_Pool::Task& task)
+{
+    if (d_doppler_worker_pool)
+        {
+            d_doppler_worker_pool->run(task);
+        }
+    else
+        {
+            task(0);
+        }
+}
+
+
 void pcps_acquisition::acquisition_core(uint64_t samp_count)
 {
     gr::thread::scoped_lock lk(d_setlock);
 
+    // The tables shared with other channels and the residual frequency tables
+    // may be replaced by set_local_code or set_doppler_center once the lock is
+    // released, keep the current ones
+    const std::shared_ptr<const Acq_Wipeoff_Table> grid_doppler_wipeoffs = d_grid_doppler_wipeoffs;
+    const std::shared_ptr<const Acq_Code_Spectrum> fft_codes = d_fft_codes;
+    const std::shared_ptr<Acq_Input_Spectra> residual_spectra = d_residual_spectra;
+    const std::vector<uint32_t> doppler_bin_residual = d_doppler_bin_residual;
+    const std::vector<uint32_t> doppler_bin_shift = d_doppler_bin_shift;
+
     // Initialize acquisition algorithm
     int32_t doppler = 0;
     uint32_t indext = 0U;
@@ -638,38 +852,27 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Doppler frequency grid loop
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            std::shared_ptr<const Acq_Input_Spectra> spectra;
+            if (d_shared_engine)
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // Compute the inverse FFT
-                    d_ifft->execute();
-
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
-                        }
+                    // The Doppler-shifted input spectra are computed only by the first
+                    // channel searching this block, the rest of channels reuse them
+                    const auto num_spectra = static_cast<uint32_t>(d_acq_parameters.frequency_domain_doppler ? grid_doppler_wipeoffs->size() : d_num_doppler_bins);
+                    spectra = d_shared_engine->get_spectra(d_shared_engine_key, samp_count,
+                        own::span<const gr_complex>(in, d_consumed_samples), num_spectra, d_fft_size,
+                        [this, in, &grid_doppler_wipeoffs](Acq_Input_Spectra& input_spectra) {
+                            run_doppler_workers([this, in, &grid_doppler_wipeoffs, &input_spectra](uint32_t worker_index) { compute_input_spectra(worker_index, in, *grid_doppler_wipeoffs, input_spectra); });
+                        });
+                }
+            else if (d_acq_parameters.frequency_domain_doppler)
+                {
+                    // One forward FFT per residual frequency instead of one per Doppler bin
+                    run_doppler_workers([this, in, &grid_doppler_wipeoffs, &residual_spectra](uint32_t worker_index) { compute_input_spectra(worker_index, in, *grid_doppler_wipeoffs, *residual_spectra); });
+                    spectra = residual_spectra;
                 }
+            run_doppler_workers([this, in, &spectra, &grid_doppler_wipeoffs, &fft_codes, &doppler_bin_residual, &doppler_bin_shift, effective_fft_size](uint32_t worker_index) {
+                search_doppler_bins(worker_index, in, spectra.get(), *grid_doppler_wipeoffs, *fft_codes, doppler_bin_residual, doppler_bin_shift, d_num_doppler_bins, d_grid, effective_fft_size);
+            });
 
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
@@ -697,37 +900,10 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index].data(), d_fft_size);
+            run_doppler_workers([this, in, &fft_codes, &doppler_bin_residual, &doppler_bin_shift, effective_fft_size](uint32_t worker_index) {
+                search_doppler_bins(worker_index, in, nullptr, d_grid_doppler_wipeoffs_step_two, *fft_codes, doppler_bin_residual, doppler_bin_shift, d_num_doppler_bins_step2, d_narrow_grid, effective_fft_size);
+            });
 
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            memcpy(d_narrow_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
-                        }
-                }
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
@@ -897,6 +1073,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
     gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items)
 {
+    const Gnss_Block_Timer profiler_timer(d_profiler_stats.get(), this->nitems_read(0), ninput_items[0]);
     /*
      * By J.Arribas, L.Esteve and M.Molina
      * Acquisition strategy (Kay Borre book + CFAR threshold):
@@ -946,6 +1123,19 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
             }
         case 1:
             {
+                if (d_shared_engine and d_buffer_count == 0U)
+                    {
+                        // Start the dwell at a block boundary, so that channels searching
+                        // at the same time get the same samples and can share their spectra
+                        const auto misalignment = static_cast<uint32_t>(d_sample_counter % d_consumed_samples);
+                        if (misalignment != 0U)
+                            {
+                                const uint32_t skip = std::min(static_cast<uint32_t>(ninput_items[0]), d_consumed_samples - misalignment);
+                                d_sample_counter += static_cast<uint64_t>(skip);
+                                consume_each(skip);
+                                break;
+                            }
+                    }
                 uint32_t buff_increment;
                 if (d_cshort)
                     {
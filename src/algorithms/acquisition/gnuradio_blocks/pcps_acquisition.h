@@ -43,6 +43,9 @@
 #endif
 
 #include "acq_conf.h"
+#include "acq_shared_engine.h"
+#include "acq_table_cache.h"
+#include "acq_worker_pool.h"
 #include "channel_fsm.h"
 #include "gnss_sdr_fft.h"
 #include <armadillo>
@@ -59,6 +62,7 @@
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if HAS_STD_SPAN
 #include <span>
@@ -76,6 +80,7 @@ namespace own = gsl;
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Gnss_Synchro;
 class pcps_acquisition;
 
@@ -221,6 +226,19 @@ private:
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
+    void update_grid_doppler_residuals(const std::string& grid_key);
+    void compute_input_spectra(uint32_t worker_index, const gr_complex* in, const Acq_Wipeoff_Table& wipeoffs, Acq_Input_Spectra& spectra);
+    void search_doppler_bins(uint32_t worker_index,
+        const gr_complex* in,
+        const Acq_Input_Spectra* spectra,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& wipeoffs,
+        const Acq_Code_Spectrum& fft_codes,
+        const std::vector<uint32_t>& doppler_bin_residual,
+        const std::vector<uint32_t>& doppler_bin_shift,
+        uint32_t num_doppler_bins,
+        arma::fmat& dump_grid,
+        int32_t effective_fft_size);
+    void run_doppler_workers(const Acq_Worker_Pool::Task& task);
     void acquisition_core(uint64_t samp_count);
     void send_negative_acquisition();
     void send_positive_acquisition();
@@ -231,18 +249,33 @@ private:
     float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
     float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
 
+    struct Doppler_Worker
+    {
+        std::unique_ptr<gnss_fft_complex_fwd> fft_if;
+        std::unique_ptr<gnss_fft_complex_rev> ifft;
+        volk_gnsssdr::vector<float> tmp_buffer;
+    };
+
     volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_magnitude_grid;
     volk_gnsssdr::vector<float> d_tmp_buffer;
     volk_gnsssdr::vector<std::complex<float>> d_input_signal;
-    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
-    volk_gnsssdr::vector<std::complex<float>> d_fft_codes;
     volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
     volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
+    std::vector<uint32_t> d_doppler_bin_residual;
+    std::vector<uint32_t> d_doppler_bin_shift;
 
     std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
     std::unique_ptr<gnss_fft_complex_rev> d_ifft;
     std::weak_ptr<ChannelFsm> d_channel_fsm;
+    std::shared_ptr<Acq_Shared_Engine> d_shared_engine;
+    std::shared_ptr<Acq_Table_Cache> d_table_cache;
+    std::shared_ptr<const Acq_Wipeoff_Table> d_grid_doppler_wipeoffs;
+    std::shared_ptr<const Acq_Code_Spectrum> d_fft_codes;
+    std::shared_ptr<Acq_Input_Spectra> d_residual_spectra;
+    std::unique_ptr<Acq_Worker_Pool> d_doppler_worker_pool;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
+    std::vector<Doppler_Worker> d_doppler_workers;
 
     Acq_Conf d_acq_parameters;
     Gnss_Synchro* d_gnss_synchro;
@@ -251,6 +284,7 @@ private:
 
     std::queue<Gnss_Synchro> d_monitor_queue;
     std::string d_dump_filename;
+    std::string d_shared_engine_key;
 
     int64_t d_dump_number;
     uint64_t d_sample_counter;
@@ -273,6 +307,7 @@ private:
     uint32_t d_consumed_samples;
     uint32_t d_num_doppler_bins;
     uint32_t d_num_doppler_bins_step2;
+    uint32_t d_num_doppler_workers;
     uint32_t d_dump_channel;
     uint32_t d_buffer_count;
 
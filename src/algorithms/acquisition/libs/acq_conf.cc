@@ -76,6 +76,14 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
         }
     make_2_steps = configuration->property(role + ".make_two_steps", make_2_steps);
     blocking_on_standby = configuration->property(role + ".blocking_on_standby", blocking_on_standby);
+    use_shared_engine = configuration->property(role + ".use_shared_engine", use_shared_engine);
+    frequency_domain_doppler = configuration->property(role + ".frequency_domain_doppler", frequency_domain_doppler);
+    doppler_workers = configuration->property(role + ".doppler_workers", doppler_workers);
+    if (doppler_workers == 0)
+        {
+            LOG(WARNING) << "Parameter doppler_workers should be at least 1. Setting it to 1";
+            doppler_workers = 1;
+        }
 
     if (pfa <= 0.0)
         {
@@ -62,6 +62,7 @@ public:
     uint32_t num_doppler_bins_step2{4U};
     uint32_t resampler_latency_samples{0U};
     uint32_t dump_channel{0U};
+    uint32_t doppler_workers{1U};
     int32_t doppler_max{5000};
     int32_t doppler_min{-5000};
 
@@ -73,6 +74,8 @@ public:
     bool make_2_steps{false};
     bool use_automatic_resampler{false};
     bool enable_monitor_output{false};
+    bool use_shared_engine{false};
+    bool frequency_domain_doppler{false};
 
 private:
     void SetDerivedParams();
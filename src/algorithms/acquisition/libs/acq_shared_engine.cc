@@ -0,0 +1,139 @@
+/*!
+ * \file acq_shared_engine.cc
+ * \brief Process-wide engine that shares the Doppler-shifted input spectra of
+ * a sample block among all the PCPS acquisition channels searching it.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_shared_engine.h"
+#include <algorithm>  // for copy
+#include <cstring>    // for memcmp
+
+
+Acq_Input_Spectra::Acq_Input_Spectra(uint64_t sample_stamp,
+    own::span<const std::complex<float>> input,
+    uint32_t num_doppler_bins,
+    uint32_t fft_size) : d_input(input.begin(), input.end()),
+                         d_spectra(static_cast<size_t>(num_doppler_bins) * fft_size),
+                         d_sample_stamp(sample_stamp),
+                         d_num_doppler_bins(num_doppler_bins),
+                         d_fft_size(fft_size)
+{
+}
+
+
+bool Acq_Input_Spectra::matches(uint64_t sample_stamp, own::span<const std::complex<float>> input) const
+{
+    if (sample_stamp != d_sample_stamp or input.size() != d_input.size())
+        {
+            return false;
+        }
+    // The sample stamp alone is not enough: channels fed by different
+    // signal conditioners can share a stamp, so compare the samples too.
+    return std::memcmp(input.data(), d_input.data(), input.size() * sizeof(std::complex<float>)) == 0;
+}
+
+
+std::shared_ptr<const Acq_Input_Spectra> Acq_Shared_Engine::get_spectra(const std::string& group_key,
+    uint64_t sample_stamp,
+    own::span<const std::complex<float>> input,
+    uint32_t num_doppler_bins,
+    uint32_t fft_size,
+    const Spectra_Builder& builder)
+{
+    std::shared_ptr<Acq_Input_Spectra> spectra;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto& latest = d_latest[group_key];
+        if (latest and latest->num_doppler_bins() == num_doppler_bins and latest->d_fft_size == fft_size and latest->matches(sample_stamp, input))
+            {
+                spectra = latest;
+                d_hits++;
+            }
+        else
+            {
+                spectra = std::make_shared<Acq_Input_Spectra>(sample_stamp, input, num_doppler_bins, fft_size);
+                latest = spectra;
+                owner = true;
+            }
+    }
+
+    if (owner)
+        {
+            try
+                {
+                    builder(*spectra);
+                }
+            catch (...)
+                {
+                    // Do not hand the unfinished spectra to any other channel
+                    {
+                        std::lock_guard<std::mutex> lock(d_mutex);
+                        auto it = d_latest.find(group_key);
+                        if (it != d_latest.end() and it->second == spectra)
+                            {
+                                d_latest.erase(it);
+                            }
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(spectra->d_mutex);
+                        spectra->d_failed = true;
+                    }
+                    spectra->d_cv.notify_all();
+                    throw;
+                }
+            {
+                std::lock_guard<std::mutex> lock(spectra->d_mutex);
+                spectra->d_ready = true;
+            }
+            spectra->d_cv.notify_all();
+        }
+    else
+        {
+            bool failed = false;
+            {
+                std::unique_lock<std::mutex> lock(spectra->d_mutex);
+                spectra->d_cv.wait(lock, [&spectra] { return spectra->d_ready or spectra->d_failed; });
+                failed = spectra->d_failed;
+            }
+            if (failed)
+                {
+                    // The channel that was computing them gave up, try again
+                    return get_spectra(group_key, sample_stamp, input, num_doppler_bins, fft_size, builder);
+                }
+        }
+    return spectra;
+}
+
+
+uint64_t Acq_Shared_Engine::hits() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_hits;
+}
+
+
+std::shared_ptr<Acq_Shared_Engine> acq_shared_engine()
+{
+    static std::mutex instance_mutex;
+    static std::weak_ptr<Acq_Shared_Engine> instance;
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    auto engine = instance.lock();
+    if (!engine)
+        {
+            engine = std::make_shared<Acq_Shared_Engine>();
+            instance = engine;
+        }
+    return engine;
+}
@@ -0,0 +1,145 @@
+/*!
+ * \file acq_shared_engine.h
+ * \brief Process-wide engine that shares the Doppler-shifted input spectra of
+ * a sample block among all the PCPS acquisition channels searching it.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SHARED_ENGINE_H
+#define GNSS_SDR_ACQ_SHARED_ENGINE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Doppler-shifted spectra of one block of input samples.
+ *
+ * Bin i holds FFT(input .* wipeoff_i), that is, the forward FFT of the
+ * carrier wiped-off input for the i-th Doppler bin of the search grid. In the
+ * frequency-domain Doppler search, bin i is the spectrum for the i-th residual
+ * frequency, from which the Doppler bins are obtained by circular shifts.
+ */
+class Acq_Input_Spectra
+{
+public:
+    Acq_Input_Spectra(uint64_t sample_stamp, own::span<const std::complex<float>> input, uint32_t num_doppler_bins, uint32_t fft_size);
+
+    inline const std::complex<float>* bin(uint32_t doppler_index) const
+    {
+        return d_spectra.data() + static_cast<size_t>(doppler_index) * d_fft_size;
+    }
+
+    inline std::complex<float>* bin(uint32_t doppler_index)
+    {
+        return d_spectra.data() + static_cast<size_t>(doppler_index) * d_fft_size;
+    }
+
+    inline uint32_t num_doppler_bins() const
+    {
+        return d_num_doppler_bins;
+    }
+
+    /*!
+     * \brief Returns true if the spectra were computed from the very same input block.
+     */
+    bool matches(uint64_t sample_stamp, own::span<const std::complex<float>> input) const;
+
+private:
+    friend class Acq_Shared_Engine;
+    volk_gnsssdr::vector<std::complex<float>> d_input;
+    volk_gnsssdr::vector<std::complex<float>> d_spectra;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    uint64_t d_sample_stamp;
+    uint32_t d_num_doppler_bins;
+    uint32_t d_fft_size;
+    bool d_ready{false};
+    bool d_failed{false};  // the builder threw an exception
+};
+
+
+/*!
+ * \brief Computes the Doppler-shifted input spectra once per block and
+ * shares them among all the channels that search the same block with the
+ * same Doppler grid.
+ *
+ * Channels are grouped by a key that identifies the signal, the sampling
+ * rate, the FFT size and the Doppler grid. The first channel of a group that
+ * requests a given block computes its spectra; any other channel of the group
+ * requesting the same block (same sample stamp and same samples) waits for
+ * them and only performs the code multiplication and the inverse FFT with its
+ * own PRN code. Only the most recent block of each group is kept.
+ */
+class Acq_Shared_Engine
+{
+public:
+    using Spectra_Builder = std::function<void(Acq_Input_Spectra&)>;
+
+    Acq_Shared_Engine() = default;
+
+    /*!
+     * \brief Returns the spectra of the input block, computing them with
+     * builder if no other channel of the group did it before. If builder
+     * throws, the exception is propagated and the channels waiting for those
+     * spectra compute them again.
+     */
+    std::shared_ptr<const Acq_Input_Spectra> get_spectra(const std::string& group_key,
+        uint64_t sample_stamp,
+        own::span<const std::complex<float>> input,
+        uint32_t num_doppler_bins,
+        uint32_t fft_size,
+        const Spectra_Builder& builder);
+
+    /*!
+     * \brief Number of times the spectra were reused instead of computed.
+     */
+    uint64_t hits() const;
+
+private:
+    std::map<std::string, std::shared_ptr<Acq_Input_Spectra>> d_latest;
+    mutable std::mutex d_mutex;
+    uint64_t d_hits{0ULL};
+};
+
+
+/*!
+ * \brief Returns the process-wide shared acquisition engine. The engine lives
+ * as long as some acquisition block holds a reference to it.
+ */
+std::shared_ptr<Acq_Shared_Engine> acq_shared_engine();
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_SHARED_ENGINE_H
@@ -0,0 +1,118 @@
+/*!
+ * \file acq_table_cache.cc
+ * \brief Process-wide cache of Doppler wipeoff tables and local code spectra
+ * shared by the PCPS acquisition channels.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_table_cache.h"
+#include <cstring>  // for memcmp
+
+
+std::shared_ptr<const Acq_Wipeoff_Table> Acq_Table_Cache::get_wipeoffs(const std::string& key,
+    size_t num_rows,
+    size_t row_length,
+    const Wipeoff_Builder& builder)
+{
+    const auto usable = [num_rows, row_length](const std::shared_ptr<const Acq_Wipeoff_Table>& table) {
+        return table and table->size() == num_rows and (num_rows == 0 or table->front().size() == row_length);
+    };
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto it = d_wipeoffs.find(key);
+        if (it != d_wipeoffs.end())
+            {
+                auto table = it->second.lock();
+                if (usable(table))
+                    {
+                        return table;
+                    }
+            }
+    }
+
+    // Built without holding the lock, so that a cold table does not stall
+    // the lookups of other channels
+    auto table = std::make_shared<Acq_Wipeoff_Table>(num_rows, volk_gnsssdr::vector<std::complex<float>>(row_length));
+    builder(*table);
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto& entry = d_wipeoffs[key];
+    auto built_meanwhile = entry.lock();
+    if (usable(built_meanwhile))
+        {
+            return built_meanwhile;  // another channel built the same table first
+        }
+
+    // Forget the tables that are no longer used by any channel
+    for (auto it = d_wipeoffs.begin(); it != d_wipeoffs.end();)
+        {
+            if (it->second.expired() and it->first != key)
+                {
+                    it = d_wipeoffs.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    entry = table;
+    return table;
+}
+
+
+std::shared_ptr<const Acq_Code_Spectrum> Acq_Table_Cache::get_code_spectrum(const std::string& key,
+    own::span<const std::complex<float>> code,
+    size_t fft_size,
+    const Code_Spectrum_Builder& builder)
+{
+    const auto usable = [&code, fft_size](const Code_Entry& entry) {
+        return entry.spectrum and entry.spectrum->size() == fft_size and entry.code.size() == code.size() and
+               std::memcmp(entry.code.data(), code.data(), code.size() * sizeof(std::complex<float>)) == 0;
+    };
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto it = d_code_spectra.find(key);
+        if (it != d_code_spectra.end() and usable(it->second))
+            {
+                return it->second.spectrum;
+            }
+    }
+
+    auto spectrum = std::make_shared<Acq_Code_Spectrum>(fft_size);
+    builder(*spectrum);
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto& entry = d_code_spectra[key];
+    if (usable(entry))
+        {
+            return entry.spectrum;  // another channel built the same spectrum first
+        }
+    entry.code.assign(code.begin(), code.end());
+    entry.spectrum = spectrum;
+    return spectrum;
+}
+
+
+std::shared_ptr<Acq_Table_Cache> acq_table_cache()
+{
+    static std::mutex instance_mutex;
+    static std::weak_ptr<Acq_Table_Cache> instance;
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    auto cache = instance.lock();
+    if (!cache)
+        {
+            cache = std::make_shared<Acq_Table_Cache>();
+            instance = cache;
+        }
+    return cache;
+}
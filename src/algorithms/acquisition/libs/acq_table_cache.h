@@ -0,0 +1,117 @@
+/*!
+ * \file acq_table_cache.h
+ * \brief Process-wide cache of Doppler wipeoff tables and local code spectra
+ * shared by the PCPS acquisition channels.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_TABLE_CACHE_H
+#define GNSS_SDR_ACQ_TABLE_CACHE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+using Acq_Wipeoff_Table = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>;
+using Acq_Code_Spectrum = volk_gnsssdr::vector<std::complex<float>>;
+
+
+/*!
+ * \brief Cache of the read-only tables used by the PCPS acquisition blocks.
+ *
+ * Doppler wipeoff tables only depend on the sampling rate, the FFT size and
+ * the Doppler grid, so all the channels with the same configuration share a
+ * single, reference-counted copy. The table is released when the last channel
+ * using it moves to another grid or is destroyed.
+ *
+ * Conjugated code spectra are keyed by signal, PRN, sampling rate and FFT
+ * size, and are kept for the lifetime of the cache, so a channel that is
+ * reassigned to a PRN already searched by any channel does not need to
+ * compute its FFT again. The time-domain code is stored along with the
+ * spectrum and compared on each lookup, so blocks configured to search
+ * different codes under the same key (e.g. data or pilot components) never
+ * get a wrong spectrum.
+ *
+ * Tables are built without holding the cache lock. Channels asking at the
+ * same time for a table that is not in the cache may build it more than
+ * once, but all of them get the first one stored.
+ */
+class Acq_Table_Cache
+{
+public:
+    using Wipeoff_Builder = std::function<void(Acq_Wipeoff_Table&)>;
+    using Code_Spectrum_Builder = std::function<void(Acq_Code_Spectrum&)>;
+
+    Acq_Table_Cache() = default;
+
+    /*!
+     * \brief Returns the table of num_rows x row_length wipeoffs identified by
+     * key, filling it with builder if no channel is using it.
+     */
+    std::shared_ptr<const Acq_Wipeoff_Table> get_wipeoffs(const std::string& key,
+        size_t num_rows,
+        size_t row_length,
+        const Wipeoff_Builder& builder);
+
+    /*!
+     * \brief Returns the code spectrum (of fft_size elements) identified by
+     * key, filling it with builder if it was not computed before from the same
+     * time-domain code.
+     */
+    std::shared_ptr<const Acq_Code_Spectrum> get_code_spectrum(const std::string& key,
+        own::span<const std::complex<float>> code,
+        size_t fft_size,
+        const Code_Spectrum_Builder& builder);
+
+private:
+    struct Code_Entry
+    {
+        volk_gnsssdr::vector<std::complex<float>> code;
+        std::shared_ptr<const Acq_Code_Spectrum> spectrum;
+    };
+
+    std::map<std::string, std::weak_ptr<const Acq_Wipeoff_Table>> d_wipeoffs;
+    std::map<std::string, Code_Entry> d_code_spectra;
+    std::mutex d_mutex;
+};
+
+
+/*!
+ * \brief Returns the process-wide table cache. The cache lives as long as
+ * some acquisition block holds a reference to it.
+ */
+std::shared_ptr<Acq_Table_Cache> acq_table_cache();
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_TABLE_CACHE_H
@@ -0,0 +1,102 @@
+/*!
+ * \file acq_worker_pool.cc
+ * \brief Pool of persistent threads used to split the Doppler search grid
+ * of an acquisition block among several cores.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_worker_pool.h"
+#include <algorithm>  // for max
+
+
+Acq_Worker_Pool::Acq_Worker_Pool(uint32_t num_workers) : d_num_workers(std::max(num_workers, 1U))
+{
+    d_threads.reserve(d_num_workers - 1);
+    for (uint32_t worker_index = 1; worker_index < d_num_workers; worker_index++)
+        {
+            d_threads.emplace_back(&Acq_Worker_Pool::worker_loop, this, worker_index);
+        }
+}
+
+
+Acq_Worker_Pool::~Acq_Worker_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_start_cv.notify_all();
+    for (auto& thread : d_threads)
+        {
+            if (thread.joinable())
+                {
+                    thread.join();
+                }
+        }
+}
+
+
+void Acq_Worker_Pool::run(const Task& task)
+{
+    if (d_threads.empty())
+        {
+            task(0);
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_task = &task;
+        d_pending = d_num_workers - 1;
+        d_generation++;
+    }
+    d_start_cv.notify_all();
+
+    task(0);
+
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_done_cv.wait(lock, [this] { return d_pending == 0U; });
+    d_task = nullptr;
+}
+
+
+void Acq_Worker_Pool::worker_loop(uint32_t worker_index)
+{
+    uint64_t last_generation = 0ULL;
+    while (true)
+        {
+            const Task* task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_start_cv.wait(lock, [this, last_generation] { return d_stop or d_generation != last_generation; });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                last_generation = d_generation;
+                task = d_task;
+            }
+
+            (*task)(worker_index);
+
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_pending--;
+                last = (d_pending == 0U);
+            }
+            if (last)
+                {
+                    d_done_cv.notify_one();
+                }
+        }
+}
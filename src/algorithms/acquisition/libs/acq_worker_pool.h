@@ -0,0 +1,79 @@
+/*!
+ * \file acq_worker_pool.h
+ * \brief Pool of persistent threads used to split the Doppler search grid
+ * of an acquisition block among several cores.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_WORKER_POOL_H
+#define GNSS_SDR_ACQ_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Fork-join pool of persistent worker threads.
+ *
+ * run() executes the same task on every worker, passing the worker index
+ * (from 0 to size() - 1), and returns when all of them have finished. The
+ * calling thread acts as worker 0, so a pool of size N spawns N - 1 threads.
+ */
+class Acq_Worker_Pool
+{
+public:
+    using Task = std::function<void(uint32_t)>;
+
+    explicit Acq_Worker_Pool(uint32_t num_workers);
+    ~Acq_Worker_Pool();
+
+    Acq_Worker_Pool(const Acq_Worker_Pool&) = delete;
+    Acq_Worker_Pool& operator=(const Acq_Worker_Pool&) = delete;
+
+    /*!
+     * \brief Runs task(worker_index) on all the workers and waits for them.
+     */
+    void run(const Task& task);
+
+    inline uint32_t size() const
+    {
+        return d_num_workers;
+    }
+
+private:
+    void worker_loop(uint32_t worker_index);
+
+    std::vector<std::thread> d_threads;
+    std::mutex d_mutex;
+    std::condition_variable d_start_cv;
+    std::condition_variable d_done_cv;
+    const Task* d_task{nullptr};
+    uint64_t d_generation{0ULL};
+    uint32_t d_pending{0U};
+    uint32_t d_num_workers;
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_WORKER_POOL_H
@@ -44,6 +44,8 @@ PulseBlankingFilter::PulseBlankingFilter(const ConfigurationInterface* configura
     const int n_segments_est = configuration->property(role_ + ".segments_est", default_n_segments_est);
     const int default_n_segments_reset = 5000000;
     const int n_segments_reset = configuration->property(role_ + ".segments_reset", default_n_segments_reset);
+    const float default_noise_update_factor = 0.0;
+    const float noise_update_factor = configuration->property(role_ + ".noise_update_factor", default_noise_update_factor);
     const double default_if = 0.0;
     const double if_aux = configuration->property(role_ + ".if", default_if);
     const double if_ = configuration->property(role_ + ".IF", if_aux);
@@ -58,7 +60,7 @@ PulseBlankingFilter::PulseBlankingFilter(const ConfigurationInterface* configura
         {
             item_size = sizeof(gr_complex);    // output
             input_size_ = sizeof(gr_complex);  // input
-            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset);
+            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset, noise_update_factor);
         }
     else
         {
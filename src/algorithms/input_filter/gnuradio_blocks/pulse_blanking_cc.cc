@@ -20,24 +20,36 @@
 #include <boost/math/distributions/chi_squared.hpp>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
-#include <algorithm>
+#include <algorithm>  // for std::fill_n, std::max, std::min
+#include <array>
+#include <cstring>  // for memcpy
+
+
+namespace
+{
+// Number of partial sums per segment. Independent accumulators allow the
+// compiler to vectorize the reduction without reordering additions.
+constexpr int32_t ENERGY_LANES = 8;
+}  // namespace
 
 
 pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length,
-    int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t n_segments_est, int32_t n_segments_reset, float noise_update_factor)
 {
-    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset));
+    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset, noise_update_factor));
 }
 
 
 pulse_blanking_cc::pulse_blanking_cc(float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset)
+    int32_t n_segments_reset,
+    float noise_update_factor)
     : gr::block("pulse_blanking_cc",
           gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(gr_complex))),
       noise_power_estimation_(0.0),
+      noise_update_factor_(std::min(std::max(noise_update_factor, 0.0F), 1.0F)),
       pfa_(pfa),
       length_(length),
       n_segments_(0),
@@ -50,7 +62,53 @@ pulse_blanking_cc::pulse_blanking_cc(float pfa,
     set_alignment(std::max(1, alignment_multiple));
     boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred_);
     thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
-    zeros_ = volk_gnsssdr::vector<gr_complex>(length_);
+    update_energy_threshold();
+    // Room for the default buffer size of GNU Radio. The vector only grows if
+    // a larger number of items is ever requested.
+    segment_energy_ = volk_gnsssdr::vector<float>(8192 / std::max(length_, 1) + 1);
+}
+
+
+void pulse_blanking_cc::update_energy_threshold()
+{
+    // Compares energies instead of dividing each segment energy by the noise power
+    energy_threshold_ = thres_ * noise_power_estimation_;
+}
+
+
+void pulse_blanking_cc::compute_segment_energies(const gr_complex *in, int32_t n_segments)
+{
+    if (segment_energy_.size() < static_cast<size_t>(n_segments))
+        {
+            segment_energy_.resize(n_segments);
+        }
+    // Energy of a segment = sum of the squares of its real and imaginary
+    // parts, computed in a single pass over the input.
+    const auto *samples = reinterpret_cast<const float *>(in);
+    const int32_t segment_floats = 2 * length_;
+    const int32_t vector_floats = segment_floats - segment_floats % ENERGY_LANES;
+    for (int32_t segment = 0; segment < n_segments; segment++)
+        {
+            const float *x = samples + static_cast<size_t>(segment) * segment_floats;
+            std::array<float, ENERGY_LANES> partial{};
+            for (int32_t i = 0; i < vector_floats; i += ENERGY_LANES)
+                {
+                    for (int32_t lane = 0; lane < ENERGY_LANES; lane++)
+                        {
+                            partial[lane] += x[i + lane] * x[i + lane];
+                        }
+                }
+            float energy = 0.0;
+            for (int32_t i = vector_floats; i < segment_floats; i++)
+                {
+                    energy += x[i] * x[i];
+                }
+            for (const auto p : partial)
+                {
+                    energy += p;
+                }
+            segment_energy_[segment] = energy;
+        }
 }
 
 
@@ -59,40 +117,43 @@ int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_ite
 {
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    auto magnitude = volk_gnsssdr::vector<float>(noutput_items);
-    volk_32fc_magnitude_squared_32f(magnitude.data(), in, noutput_items);
-    int32_t sample_index = 0;
-    float segment_energy;
-    while ((sample_index + length_) < noutput_items)
+    // Only whole segments are processed, and the last sample is always left
+    // for the next call
+    const int32_t n_segments = noutput_items > 0 ? (noutput_items - 1) / length_ : 0;
+    const int32_t processed_items = n_segments * length_;
+    compute_segment_energies(in, n_segments);
+    memcpy(out, in, sizeof(gr_complex) * processed_items);
+    for (int32_t segment = 0; segment < n_segments; segment++)
         {
-            volk_32f_accumulator_s32f(&segment_energy, (magnitude.data() + sample_index), length_);
+            const float segment_energy = segment_energy_[segment];
             if ((n_segments_ < n_segments_est_) && (last_filtered_ == false))
                 {
                     noise_power_estimation_ = (static_cast<float>(n_segments_) * noise_power_estimation_ + segment_energy / static_cast<float>(n_deg_fred_)) / static_cast<float>(n_segments_ + 1);
-                    memcpy(out, in, sizeof(gr_complex) * length_);
+                    update_energy_threshold();
                 }
             else
                 {
-                    if ((segment_energy / noise_power_estimation_) > thres_)
+                    if (segment_energy > energy_threshold_)
                         {
-                            memcpy(out, zeros_.data(), sizeof(gr_complex) * length_);
+                            std::fill_n(out + segment * length_, length_, gr_complex(0.0, 0.0));
                             last_filtered_ = true;
                         }
                     else
                         {
-                            memcpy(out, in, sizeof(gr_complex) * length_);
                             last_filtered_ = false;
+                            if (noise_update_factor_ > 0.0)
+                                {
+                                    noise_power_estimation_ += noise_update_factor_ * (segment_energy / static_cast<float>(n_deg_fred_) - noise_power_estimation_);
+                                    update_energy_threshold();
+                                }
                             if (n_segments_ > n_segments_reset_)
                                 {
                                     n_segments_ = 0;
                                 }
                         }
                 }
-            in += length_;
-            out += length_;
-            sample_index += length_;
             n_segments_++;
         }
-    consume_each(sample_index);
-    return sample_index;
+    consume_each(processed_items);
+    return processed_items;
 }
@@ -39,8 +39,17 @@ pulse_blanking_cc_sptr make_pulse_blanking_cc(
     float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset);
+    int32_t n_segments_reset,
+    float noise_update_factor);
 
+/*!
+ * \brief Blanks the segments of length samples whose energy exceeds the
+ * threshold given by pfa and the noise power estimated over the first
+ * n_segments_est segments. If noise_update_factor is larger than zero, the
+ * noise power (and hence the threshold) keeps being updated afterwards by each
+ * segment that is not blanked, as an exponential moving average with that
+ * weight.
+ */
 class pulse_blanking_cc : public gr::block
 {
 public:
@@ -50,11 +59,15 @@ public:
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
 private:
-    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    volk_gnsssdr::vector<gr_complex> zeros_;
+    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, float noise_update_factor);
+    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, float noise_update_factor);
+    void compute_segment_energies(const gr_complex *in, int32_t n_segments);
+    void update_energy_threshold();
+    volk_gnsssdr::vector<float> segment_energy_;
     float noise_power_estimation_;
     float thres_;
+    float energy_threshold_;
+    float noise_update_factor_;
     float pfa_;
     int32_t length_;
     int32_t n_segments_;
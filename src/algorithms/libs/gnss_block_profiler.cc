@@ -0,0 +1,330 @@
+/*!
+ * \file gnss_block_profiler.cc
+ * \brief Low-overhead profiling of the work calls of GNU Radio blocks
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_block_profiler.h"
+#include <algorithm>  // for std::max, std::remove_if
+#include <iomanip>    // for std::setw, std::setprecision
+#include <sstream>    // for std::stringstream
+#include <utility>    // for std::move
+
+
+// Definitions required by C++11 when the constants are bound to references
+constexpr size_t Gnss_Block_Stats::HISTOGRAM_BINS;
+constexpr size_t Gnss_Block_Stats::TRACE_CAPACITY;
+
+
+Gnss_Block_Stats::Gnss_Block_Stats(std::string name, uint32_t id)
+    : d_trace(TRACE_CAPACITY),
+      d_name(std::move(name)),
+      d_id(id)
+{
+}
+
+
+size_t Gnss_Block_Stats::histogram_bin(uint64_t value)
+{
+    size_t bin = 0;
+    while (value != 0 && bin < HISTOGRAM_BINS - 1)
+        {
+            value >>= 1U;
+            bin++;
+        }
+    return bin;
+}
+
+
+void Gnss_Block_Stats::record(int64_t start_ns, int64_t duration_ns, uint64_t nitems_read, int32_t items_available)
+{
+    const auto duration = static_cast<uint64_t>(std::max<int64_t>(duration_ns, 0));
+    const auto available = static_cast<uint64_t>(std::max(items_available, 0));
+
+    // Items are consumed after the call returns, so they are accounted for at
+    // the next call
+    if (d_calls.load(std::memory_order_relaxed) > 0)
+        {
+            add(d_items, nitems_read - d_last_nitems_read);
+        }
+    d_last_nitems_read = nitems_read;
+
+    add(d_calls, 1);
+    add(d_busy_ns, duration);
+    add(d_items_available, available);
+    add(d_duration_histogram[histogram_bin(duration)], 1);
+    add(d_occupancy_histogram[histogram_bin(available)], 1);
+    if (duration > d_max_ns.load(std::memory_order_relaxed))
+        {
+            d_max_ns.store(duration, std::memory_order_relaxed);
+        }
+
+    const uint64_t head = d_trace_head.load(std::memory_order_relaxed);
+    if (head - d_trace_tail.load(std::memory_order_acquire) < TRACE_CAPACITY)
+        {
+            d_trace[head & (TRACE_CAPACITY - 1)] = Trace_Event{start_ns, duration_ns, items_available};
+            d_trace_head.store(head + 1, std::memory_order_release);
+        }
+    else
+        {
+            add(d_dropped, 1);
+        }
+}
+
+
+void Gnss_Block_Stats::drain(std::vector<Trace_Event>& events)
+{
+    const uint64_t head = d_trace_head.load(std::memory_order_acquire);
+    uint64_t tail = d_trace_tail.load(std::memory_order_relaxed);
+    for (; tail != head; tail++)
+        {
+            events.push_back(d_trace[tail & (TRACE_CAPACITY - 1)]);
+        }
+    d_trace_tail.store(tail, std::memory_order_release);
+}
+
+
+void Gnss_Block_Stats::reset()
+{
+    d_trace_tail.store(d_trace_head.load(std::memory_order_acquire), std::memory_order_release);
+    for (size_t i = 0; i < HISTOGRAM_BINS; i++)
+        {
+            d_duration_histogram[i].store(0, std::memory_order_relaxed);
+            d_occupancy_histogram[i].store(0, std::memory_order_relaxed);
+        }
+    d_calls.store(0, std::memory_order_relaxed);
+    d_items.store(0, std::memory_order_relaxed);
+    d_busy_ns.store(0, std::memory_order_relaxed);
+    d_max_ns.store(0, std::memory_order_relaxed);
+    d_items_available.store(0, std::memory_order_relaxed);
+    d_dropped.store(0, std::memory_order_relaxed);
+}
+
+
+std::array<uint64_t, Gnss_Block_Stats::HISTOGRAM_BINS> Gnss_Block_Stats::duration_histogram() const
+{
+    std::array<uint64_t, HISTOGRAM_BINS> histogram{};
+    for (size_t i = 0; i < HISTOGRAM_BINS; i++)
+        {
+            histogram[i] = d_duration_histogram[i].load(std::memory_order_relaxed);
+        }
+    return histogram;
+}
+
+
+std::array<uint64_t, Gnss_Block_Stats::HISTOGRAM_BINS> Gnss_Block_Stats::occupancy_histogram() const
+{
+    std::array<uint64_t, HISTOGRAM_BINS> histogram{};
+    for (size_t i = 0; i < HISTOGRAM_BINS; i++)
+        {
+            histogram[i] = d_occupancy_histogram[i].load(std::memory_order_relaxed);
+        }
+    return histogram;
+}
+
+
+Gnss_Block_Profiler& Gnss_Block_Profiler::instance()
+{
+    static Gnss_Block_Profiler profiler;
+    return profiler;
+}
+
+
+Gnss_Block_Profiler::~Gnss_Block_Profiler()
+{
+    stop();
+}
+
+
+std::shared_ptr<Gnss_Block_Stats> Gnss_Block_Profiler::register_block(const std::string& name, uint32_t id)
+{
+    auto stats = std::make_shared<Gnss_Block_Stats>(name, id);
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    d_blocks.erase(std::remove_if(d_blocks.begin(), d_blocks.end(),
+                       [](const std::weak_ptr<Gnss_Block_Stats>& block) { return block.expired(); }),
+        d_blocks.end());
+    d_blocks.push_back(stats);
+    return stats;
+}
+
+
+bool Gnss_Block_Profiler::start(const std::string& trace_filename, uint32_t export_period_ms)
+{
+    const std::lock_guard<std::mutex> control_lock(d_control_mutex);
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_enabled.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+    if (!trace_filename.empty())
+        {
+            d_trace_file.open(trace_filename, std::ios::out | std::ios::trunc);
+            if (!d_trace_file.is_open())
+                {
+                    return false;
+                }
+            // JSON array format. The closing bracket is optional, so the file
+            // can be loaded even if the receiver does not stop profiling
+            d_trace_file << std::fixed << std::setprecision(3) << "[\n";
+        }
+    for (const auto& block : live_blocks())
+        {
+            block->reset();
+        }
+    d_named_blocks.clear();
+    d_first_event = true;
+    d_stop_export = false;
+    d_start_ns = now_ns();
+    d_enabled.store(true, std::memory_order_relaxed);
+
+    // The export thread waits for d_mutex before its first export
+    d_export_thread = std::thread(&Gnss_Block_Profiler::export_loop, this, std::max(export_period_ms, 1U));
+    return true;
+}
+
+
+void Gnss_Block_Profiler::stop()
+{
+    const std::lock_guard<std::mutex> control_lock(d_control_mutex);
+    {
+        const std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_enabled.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+        d_enabled.store(false, std::memory_order_relaxed);
+        d_stop_export = true;
+        d_stop_ns = now_ns();
+    }
+    d_cv.notify_one();
+    if (d_export_thread.joinable())
+        {
+            d_export_thread.join();
+        }
+
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    export_trace();
+    if (d_trace_file.is_open())
+        {
+            d_trace_file << "\n]\n";
+            d_trace_file.close();
+        }
+}
+
+
+std::string Gnss_Block_Profiler::report()
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    const int64_t end_ns = d_enabled.load(std::memory_order_relaxed) ? now_ns() : d_stop_ns;
+    const double elapsed_ns = static_cast<double>(std::max<int64_t>(end_ns - d_start_ns, 1));
+
+    std::stringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Profiling " << (d_enabled.load(std::memory_order_relaxed) ? "enabled" : "disabled")
+           << ", " << elapsed_ns / 1e9 << " s\n";
+    report << std::left << std::setw(40) << "Block" << std::right
+           << std::setw(12) << "Calls"
+           << std::setw(12) << "Items/call"
+           << std::setw(12) << "Mean [us]"
+           << std::setw(12) << "P99 [us]"
+           << std::setw(12) << "Max [us]"
+           << std::setw(10) << "Busy [%]"
+           << std::setw(12) << "Queue" << '\n';
+    for (const auto& block : live_blocks())
+        {
+            const uint64_t calls = block->calls();
+            if (calls == 0)
+                {
+                    continue;
+                }
+            // Upper bound of the bin holding the 99th percentile
+            const auto histogram = block->duration_histogram();
+            uint64_t count = 0;
+            size_t p99_bin = 0;
+            while (p99_bin < Gnss_Block_Stats::HISTOGRAM_BINS - 1 && (count + histogram[p99_bin]) * 100 < calls * 99)
+                {
+                    count += histogram[p99_bin];
+                    p99_bin++;
+                }
+            const auto n = static_cast<double>(calls);
+            report << std::left << std::setw(40) << block->name() + " (" + std::to_string(block->id()) + ")" << std::right
+                   << std::setw(12) << calls
+                   << std::setw(12) << static_cast<double>(block->items()) / n
+                   << std::setw(12) << static_cast<double>(block->busy_ns()) / n / 1e3
+                   << std::setw(12) << static_cast<double>(uint64_t(1) << p99_bin) / 1e3
+                   << std::setw(12) << static_cast<double>(block->max_ns()) / 1e3
+                   << std::setw(10) << 100.0 * static_cast<double>(block->busy_ns()) / elapsed_ns
+                   << std::setw(12) << static_cast<double>(block->items_available()) / n << '\n';
+        }
+    return report.str();
+}
+
+
+std::vector<std::shared_ptr<Gnss_Block_Stats>> Gnss_Block_Profiler::live_blocks()
+{
+    std::vector<std::shared_ptr<Gnss_Block_Stats>> blocks;
+    for (const auto& block : d_blocks)
+        {
+            if (auto stats = block.lock())
+                {
+                    blocks.push_back(std::move(stats));
+                }
+        }
+    return blocks;
+}
+
+
+void Gnss_Block_Profiler::export_loop(uint32_t export_period_ms)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop_export)
+        {
+            d_cv.wait_for(lock, std::chrono::milliseconds(export_period_ms), [this] { return d_stop_export; });
+            export_trace();
+        }
+}
+
+
+void Gnss_Block_Profiler::export_trace()
+{
+    const bool write = d_trace_file.is_open();
+    for (const auto& block : live_blocks())
+        {
+            d_events.clear();
+            block->drain(d_events);
+            if (!write)
+                {
+                    continue;
+                }
+            if (d_named_blocks.insert(block->id()).second)
+                {
+                    d_trace_file << (d_first_event ? "" : ",\n")
+                                 << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << block->id()
+                                 << R"(,"args":{"name":")" << block->name() << R"("}})";
+                    d_first_event = false;
+                }
+            for (const auto& event : d_events)
+                {
+                    d_trace_file << (d_first_event ? "" : ",\n")
+                                 << R"({"name":"work","ph":"X","pid":1,"tid":)" << block->id()
+                                 << R"(,"ts":)" << static_cast<double>(event.start_ns - d_start_ns) / 1e3
+                                 << R"(,"dur":)" << static_cast<double>(event.duration_ns) / 1e3
+                                 << R"(,"args":{"items_available":)" << event.items_available << "}}";
+                    d_first_event = false;
+                }
+        }
+    if (write)
+        {
+            d_trace_file.flush();
+        }
+}
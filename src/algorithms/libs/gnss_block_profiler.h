@@ -0,0 +1,224 @@
+/*!
+ * \file gnss_block_profiler.h
+ * \brief Low-overhead profiling of the work calls of GNU Radio blocks
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_BLOCK_PROFILER_H
+#define GNSS_SDR_GNSS_BLOCK_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Work call statistics of one block.
+ *
+ * Each block owns its instance, which is only written by the thread running
+ * the block. Counters are therefore updated with relaxed atomic loads and
+ * stores, without read-modify-write instructions, and can be read at any time
+ * from other threads. Each call is also pushed into a single-producer,
+ * single-consumer ring buffer, which the profiler drains into the trace file.
+ * Calls are dropped and counted if the ring is full.
+ */
+class Gnss_Block_Stats
+{
+public:
+    static constexpr size_t HISTOGRAM_BINS = 32;     // bin i counts values in [2^(i-1), 2^i)
+    static constexpr size_t TRACE_CAPACITY = 4096;  // must be a power of two
+
+    struct Trace_Event
+    {
+        int64_t start_ns;
+        int64_t duration_ns;
+        int32_t items_available;
+    };
+
+    Gnss_Block_Stats(std::string name, uint32_t id);
+
+    /*!
+     * \brief Records a work call. \p nitems_read is the number of items read
+     * by the block before the call, and \p items_available the number of
+     * items waiting in its input buffer.
+     */
+    void record(int64_t start_ns, int64_t duration_ns, uint64_t nitems_read, int32_t items_available);
+
+    /*!
+     * \brief Moves the recorded calls to \p events. Only one thread can drain
+     * the events at a time.
+     */
+    void drain(std::vector<Trace_Event>& events);
+
+    void reset();  //!< Clears the statistics. Calls recorded at the same time may be lost
+
+    inline const std::string& name() const { return d_name; }
+    inline uint32_t id() const { return d_id; }
+    inline uint64_t calls() const { return d_calls.load(std::memory_order_relaxed); }
+    inline uint64_t items() const { return d_items.load(std::memory_order_relaxed); }  //!< Items consumed
+    inline uint64_t busy_ns() const { return d_busy_ns.load(std::memory_order_relaxed); }
+    inline uint64_t max_ns() const { return d_max_ns.load(std::memory_order_relaxed); }
+    inline uint64_t items_available() const { return d_items_available.load(std::memory_order_relaxed); }  //!< Sum over all the calls
+    inline uint64_t dropped() const { return d_dropped.load(std::memory_order_relaxed); }                  //!< Calls not stored in the trace
+
+    std::array<uint64_t, HISTOGRAM_BINS> duration_histogram() const;   //!< Call durations, in ns
+    std::array<uint64_t, HISTOGRAM_BINS> occupancy_histogram() const;  //!< Items waiting at each call
+
+    static size_t histogram_bin(uint64_t value);
+
+private:
+    static inline void add(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    std::vector<Trace_Event> d_trace;
+    std::array<std::atomic<uint64_t>, HISTOGRAM_BINS> d_duration_histogram{};
+    std::array<std::atomic<uint64_t>, HISTOGRAM_BINS> d_occupancy_histogram{};
+    std::string d_name;
+    std::atomic<uint64_t> d_trace_head{0};  // written by the block thread
+    std::atomic<uint64_t> d_trace_tail{0};  // written by the draining thread
+    std::atomic<uint64_t> d_calls{0};
+    std::atomic<uint64_t> d_items{0};
+    std::atomic<uint64_t> d_busy_ns{0};
+    std::atomic<uint64_t> d_max_ns{0};
+    std::atomic<uint64_t> d_items_available{0};
+    std::atomic<uint64_t> d_dropped{0};
+    uint64_t d_last_nitems_read{0};
+    uint32_t d_id;
+};
+
+
+/*!
+ * \brief Process-wide registry of block statistics, which can be switched
+ * on and off at runtime.
+ *
+ * While profiling is enabled, a background thread periodically writes the
+ * recorded work calls to a trace file in the Chrome trace event format, which
+ * can be opened with chrome://tracing or https://ui.perfetto.dev. Each block
+ * is shown as a thread. The file is closed when profiling is disabled.
+ */
+class Gnss_Block_Profiler
+{
+public:
+    static Gnss_Block_Profiler& instance();
+
+    ~Gnss_Block_Profiler();
+
+    /*!
+     * \brief Creates the statistics of a block. The profiler keeps a weak
+     * reference, so the statistics go away with the block.
+     */
+    std::shared_ptr<Gnss_Block_Stats> register_block(const std::string& name, uint32_t id);
+
+    /*!
+     * \brief Clears the statistics and starts profiling, writing the trace
+     * to \p trace_filename every \p export_period_ms milliseconds. If
+     * \p trace_filename is empty, only the statistics are collected.
+     * Returns false if profiling was already enabled or the file cannot be
+     * opened.
+     */
+    bool start(const std::string& trace_filename, uint32_t export_period_ms = 1000);
+
+    void stop();  //!< Stops profiling and closes the trace file. Statistics are kept
+
+    inline bool enabled() const
+    {
+        return d_enabled.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Table with the statistics of all the live blocks.
+     */
+    std::string report();
+
+    static inline int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    Gnss_Block_Profiler() = default;
+
+    std::vector<std::shared_ptr<Gnss_Block_Stats>> live_blocks();  // requires d_mutex
+    void export_loop(uint32_t export_period_ms);
+    void export_trace();  // requires d_mutex
+
+    std::vector<std::weak_ptr<Gnss_Block_Stats>> d_blocks;
+    std::vector<Gnss_Block_Stats::Trace_Event> d_events;
+    std::set<uint32_t> d_named_blocks;
+    std::ofstream d_trace_file;
+    std::mutex d_control_mutex;  // serializes start() and stop()
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::thread d_export_thread;
+    int64_t d_start_ns{0};
+    int64_t d_stop_ns{0};
+    std::atomic<bool> d_enabled{false};
+    bool d_stop_export{false};
+    bool d_first_event{true};
+};
+
+
+/*!
+ * \brief Measures the work call in which it is declared, if profiling is
+ * enabled. When it is not, only a relaxed atomic load is added to the call.
+ */
+class Gnss_Block_Timer
+{
+public:
+    Gnss_Block_Timer(Gnss_Block_Stats* stats, uint64_t nitems_read, int32_t items_available)
+        : d_stats(Gnss_Block_Profiler::instance().enabled() ? stats : nullptr),
+          d_start_ns(d_stats ? Gnss_Block_Profiler::now_ns() : 0),
+          d_nitems_read(nitems_read),
+          d_items_available(items_available)
+    {
+    }
+
+    ~Gnss_Block_Timer()
+    {
+        if (d_stats)
+            {
+                d_stats->record(d_start_ns, Gnss_Block_Profiler::now_ns() - d_start_ns, d_nitems_read, d_items_available);
+            }
+    }
+
+    Gnss_Block_Timer(const Gnss_Block_Timer&) = delete;
+    Gnss_Block_Timer& operator=(const Gnss_Block_Timer&) = delete;
+
+private:
+    Gnss_Block_Stats* d_stats;
+    int64_t d_start_ns;
+    uint64_t d_nitems_read;
+    int32_t d_items_available;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_BLOCK_PROFILER_H
@@ -0,0 +1,78 @@
+/*!
+ * \file gnss_code_cache.cc
+ * \brief Process-wide cache of local PRN code replicas
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_code_cache.h"
+#include <utility>  // for std::move
+
+
+Gnss_Code_Cache& Gnss_Code_Cache::instance()
+{
+    static Gnss_Code_Cache cache;
+    return cache;
+}
+
+
+own::span<const std::complex<float>> Gnss_Code_Cache::complex_code(const std::string& signal,
+    uint32_t prn,
+    int64_t sampling_freq,
+    size_t length,
+    const std::function<void(own::span<std::complex<float>>)>& generator)
+{
+    return get(d_complex_codes, Key(signal, prn, sampling_freq, length), generator);
+}
+
+
+own::span<const float> Gnss_Code_Cache::float_code(const std::string& signal,
+    uint32_t prn,
+    int64_t sampling_freq,
+    size_t length,
+    const std::function<void(own::span<float>)>& generator)
+{
+    return get(d_float_codes, Key(signal, prn, sampling_freq, length), generator);
+}
+
+
+size_t Gnss_Code_Cache::size()
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    return d_complex_codes.size() + d_float_codes.size();
+}
+
+
+template <typename T>
+own::span<const T> Gnss_Code_Cache::get(std::map<Key, std::vector<T>>& codes,
+    const Key& key,
+    const std::function<void(own::span<T>)>& generator)
+{
+    {
+        const std::lock_guard<std::mutex> lock(d_mutex);
+        const auto it = codes.find(key);
+        if (it != codes.cend())
+            {
+                return own::span<const T>(it->second.data(), it->second.size());
+            }
+    }
+
+    // Generate outside the lock, so that channels requesting other replicas
+    // are not blocked. If two channels race for the same replica, the first
+    // one inserted is kept.
+    std::vector<T> code(std::get<3>(key));
+    generator(code);
+
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = codes.emplace(key, std::move(code)).first;
+    return own::span<const T>(it->second.data(), it->second.size());
+}
@@ -0,0 +1,116 @@
+/*!
+ * \file gnss_code_cache.h
+ * \brief Process-wide cache of local PRN code replicas
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CODE_CACHE_H
+#define GNSS_SDR_GNSS_CODE_CACHE_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Thread-safe cache of local code replicas, shared by all the
+ * acquisition and tracking blocks of the receiver.
+ *
+ * Each replica is identified by a signal name, a PRN, a sampling frequency
+ * (0 for one sample per chip) and a length, and it is generated only the first
+ * time it is requested. Replicas are never evicted, so the returned spans
+ * remain valid for the lifetime of the process and can be borrowed by any
+ * channel without copying or locking.
+ */
+class Gnss_Code_Cache
+{
+public:
+    static Gnss_Code_Cache& instance();
+
+    /*!
+     * \brief Returns the complex replica identified by the arguments. If it
+     * is not in the cache yet, a zero-initialized buffer of \p length samples
+     * is filled by \p generator and stored.
+     */
+    own::span<const std::complex<float>> complex_code(const std::string& signal,
+        uint32_t prn,
+        int64_t sampling_freq,
+        size_t length,
+        const std::function<void(own::span<std::complex<float>>)>& generator);
+
+    /*!
+     * \brief Same as above, for real-valued replicas.
+     */
+    own::span<const float> float_code(const std::string& signal,
+        uint32_t prn,
+        int64_t sampling_freq,
+        size_t length,
+        const std::function<void(own::span<float>)>& generator);
+
+    /*!
+     * \brief Number of replicas stored in the cache.
+     */
+    size_t size();
+
+private:
+    using Key = std::tuple<std::string, uint32_t, int64_t, size_t>;
+
+    Gnss_Code_Cache() = default;
+
+    template <typename T>
+    own::span<const T> get(std::map<Key, std::vector<T>>& codes,
+        const Key& key,
+        const std::function<void(own::span<T>)>& generator);
+
+    std::mutex d_mutex;
+    std::map<Key, std::vector<std::complex<float>>> d_complex_codes;
+    std::map<Key, std::vector<float>> d_float_codes;
+};
+
+
+/*!
+ * \brief Returns the real-valued code of the given signal and PRN, with one
+ * sample per chip or subchip, borrowed from the process-wide cache. The code
+ * is generated by \p generator only the first time that any block of the
+ * receiver requests it.
+ */
+inline own::span<const float> cached_float_code(const std::string& signal,
+    uint32_t prn,
+    size_t length,
+    const std::function<void(own::span<float>)>& generator)
+{
+    return Gnss_Code_Cache::instance().float_code(signal, prn, 0, length, generator);
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_CODE_CACHE_H
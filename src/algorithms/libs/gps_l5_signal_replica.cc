@@ -19,141 +19,71 @@
 #include "GPS_L5.h"
 #include <array>
 #include <cmath>
-#include <deque>
 
-std::deque<bool> l5i_xa_shift(const std::deque<bool>& xa)  // GPS-IS-705E Figure 3-4 pp. 15
-{
-    if (xa == std::deque<bool>{true, true, true, true, true, true, true, true, true, true, true, false, true})
-        {
-            return std::deque<bool>{true, true, true, true, true, true, true, true, true, true, true, true, true};
-        }
-    std::deque<bool> out(xa.cbegin(), xa.cend() - 1);
-    out.push_front(xa[12] xor xa[11] xor xa[9] xor xa[8]);
-    return out;
-}
-
-
-std::deque<bool> l5q_xa_shift(const std::deque<bool>& xa)
-{
-    if (xa == std::deque<bool>{true, true, true, true, true, true, true, true, true, true, true, false, true})
-        {
-            return std::deque<bool>{true, true, true, true, true, true, true, true, true, true, true, true, true};
-        }
-    std::deque<bool> out(xa.cbegin(), xa.cend() - 1);
-    out.push_front(xa[12] xor xa[11] xor xa[9] xor xa[8]);
-    return out;
-}
-
-
-std::deque<bool> l5i_xb_shift(const std::deque<bool>& xb)  // GPS-IS-705E Figure 3-5 pp. 16
-{
-    std::deque<bool> out(xb.cbegin(), xb.cend() - 1);
-    out.push_front(xb[12] xor xb[11] xor xb[7] xor xb[6] xor xb[5] xor xb[3] xor xb[2] xor xb[0]);
-    return out;
-}
-
-
-std::deque<bool> l5q_xb_shift(const std::deque<bool>& xb)
-{
-    std::deque<bool> out(xb.cbegin(), xb.cend() - 1);
-    out.push_front(xb[12] xor xb[11] xor xb[7] xor xb[6] xor xb[5] xor xb[3] xor xb[2] xor xb[0]);
-    return out;
-}
-
-
-std::deque<bool> make_l5i_xa()
-{
-    std::deque<bool> xa = {true, true, true, true, true, true, true, true, true, true, true, true, true};
-    std::deque<bool> y(GPS_L5I_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t i = 0; i < GPS_L5I_CODE_LENGTH_CHIPS; i++)
-        {
-            y[i] = xa[12];
-            xa = l5i_xa_shift(xa);
-        }
-    return y;
-}
-
-
-std::deque<bool> make_l5i_xb()
-{
-    std::deque<bool> xb = {true, true, true, true, true, true, true, true, true, true, true, true, true};
-    std::deque<bool> y(GPS_L5I_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t i = 0; i < GPS_L5I_CODE_LENGTH_CHIPS; i++)
-        {
-            y[i] = xb[12];
-            xb = l5i_xb_shift(xb);
-        }
-    return y;
-}
-
-
-std::deque<bool> make_l5q_xa()
-{
-    std::deque<bool> xa = {true, true, true, true, true, true, true, true, true, true, true, true, true};
-    std::deque<bool> y(GPS_L5Q_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t i = 0; i < GPS_L5Q_CODE_LENGTH_CHIPS; i++)
-        {
-            y[i] = xa[12];
-            xa = l5q_xa_shift(xa);
-        }
-    return y;
-}
-
-
-std::deque<bool> make_l5q_xb()
-{
-    std::deque<bool> xb = {true, true, true, true, true, true, true, true, true, true, true, true, true};
-    std::deque<bool> y(GPS_L5Q_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t i = 0; i < GPS_L5Q_CODE_LENGTH_CHIPS; i++)
+namespace
+{
+// The XA and XB sequences are shared by the I5 and Q5 codes of all the PRNs.
+// They are generated once, with 13-bit registers where bit k holds stage k + 1
+// of the shift registers in IS-GPS-705 Figures 3-4 and 3-5.
+struct L5_Xa_Xb
+{
+    std::array<uint8_t, GPS_L5I_CODE_LENGTH_CHIPS> xa{};
+    std::array<uint8_t, GPS_L5I_CODE_LENGTH_CHIPS> xb{};
+
+    L5_Xa_Xb()
+    {
+        constexpr uint32_t all_ones = 0x1FFFU;
+        constexpr uint32_t xa_reset = all_ones & ~(1U << 11U);  // XA is short-cycled after 8190 chips
+        uint32_t reg_xa = all_ones;
+        uint32_t reg_xb = all_ones;
+        uint32_t feedback;
+        for (int32_t i = 0; i < GPS_L5I_CODE_LENGTH_CHIPS; i++)
+            {
+                xa[i] = static_cast<uint8_t>((reg_xa >> 12U) & 1U);
+                xb[i] = static_cast<uint8_t>((reg_xb >> 12U) & 1U);
+                if (reg_xa == xa_reset)
+                    {
+                        reg_xa = all_ones;
+                    }
+                else
+                    {
+                        feedback = (reg_xa >> 12U) ^ (reg_xa >> 11U) ^ (reg_xa >> 9U) ^ (reg_xa >> 8U);
+                        reg_xa = ((reg_xa << 1U) | (feedback & 1U)) & all_ones;
+                    }
+                feedback = (reg_xb >> 12U) ^ (reg_xb >> 11U) ^ (reg_xb >> 7U) ^ (reg_xb >> 6U) ^ (reg_xb >> 5U) ^ (reg_xb >> 3U) ^ (reg_xb >> 2U) ^ reg_xb;
+                reg_xb = ((reg_xb << 1U) | (feedback & 1U)) & all_ones;
+            }
+    }
+};
+
+
+const L5_Xa_Xb& l5_xa_xb()
+{
+    static const L5_Xa_Xb sequences;
+    return sequences;
+}
+
+
+void make_l5(own::span<int32_t> dest, int32_t xb_offset)
+{
+    const L5_Xa_Xb& seq = l5_xa_xb();
+    for (int32_t n = 0; n < GPS_L5I_CODE_LENGTH_CHIPS; n++)
         {
-            y[i] = xb[12];
-            xb = l5q_xb_shift(xb);
+            dest[n] = seq.xa[n] ^ seq.xb[(xb_offset + n) % GPS_L5I_CODE_LENGTH_CHIPS];
         }
-    return y;
 }
+}  // namespace
 
 
 void make_l5i(own::span<int32_t> dest, int32_t prn)
 {
-    const int32_t xb_offset = GPS_L5I_INIT_REG[prn];
-
-    const std::deque<bool> xb = make_l5i_xb();
-    const std::deque<bool> xa = make_l5i_xa();
-    std::deque<bool> xb_shift(GPS_L5I_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t n = 0; n < GPS_L5I_CODE_LENGTH_CHIPS; n++)
-        {
-            xb_shift[n] = xb[(xb_offset + n) % GPS_L5I_CODE_LENGTH_CHIPS];
-        }
-
-    for (int32_t n = 0; n < GPS_L5I_CODE_LENGTH_CHIPS; n++)
-        {
-            dest[n] = xa[n] xor xb_shift[n];
-        }
+    make_l5(dest, GPS_L5I_INIT_REG[prn]);
 }
 
 
 void make_l5q(own::span<int32_t> dest, int32_t prn)
 {
-    const int32_t xb_offset = GPS_L5Q_INIT_REG[prn];
-
-    const std::deque<bool> xb = make_l5q_xb();
-    const std::deque<bool> xa = make_l5q_xa();
-    std::deque<bool> xb_shift(GPS_L5Q_CODE_LENGTH_CHIPS, false);
-
-    for (int32_t n = 0; n < GPS_L5Q_CODE_LENGTH_CHIPS; n++)
-        {
-            xb_shift[n] = xb[(xb_offset + n) % GPS_L5Q_CODE_LENGTH_CHIPS];
-        }
-
-    for (int32_t n = 0; n < GPS_L5Q_CODE_LENGTH_CHIPS; n++)
-        {
-            dest[n] = xa[n] xor xb_shift[n];
-        }
+    make_l5(dest, GPS_L5Q_INIT_REG[prn]);
 }
 
 
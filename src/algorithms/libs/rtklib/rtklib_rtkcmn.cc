@@ -1761,16 +1761,18 @@ gtime_t timeget()
     struct timeval tv
     {
     };
-    struct tm *tt;
+    struct tm tt
+    {
+    };
 
-    if (!gettimeofday(&tv, nullptr) && (tt = gmtime(&tv.tv_sec)))
+    if (!gettimeofday(&tv, nullptr) && gmtime_r(&tv.tv_sec, &tt))
         {
-            ep[0] = tt->tm_year + 1900;
-            ep[1] = tt->tm_mon + 1;
-            ep[2] = tt->tm_mday;
-            ep[3] = tt->tm_hour;
-            ep[4] = tt->tm_min;
-            ep[5] = tt->tm_sec + tv.tv_usec * 1e-6;
+            ep[0] = tt.tm_year + 1900;
+            ep[1] = tt.tm_mon + 1;
+            ep[2] = tt.tm_mday;
+            ep[3] = tt.tm_hour;
+            ep[4] = tt.tm_min;
+            ep[5] = tt.tm_sec + tv.tv_usec * 1e-6;
         }
     time = epoch2time(ep);
 
@@ -2069,11 +2071,12 @@ void time2str(gtime_t t, char *s, int n)
  * args   : gtime_t t        I   gtime_t struct
  *          int    n         I   number of decimals
  * return : time string
- * notes  : not reentrant, do not use multiple in a function
+ * notes  : not reentrant, do not use multiple in a function. The buffer is
+ *          per thread
  *-----------------------------------------------------------------------------*/
 char *time_str(gtime_t t, int n)
 {
-    static char buff[64];
+    static thread_local char buff[64];
     time2str(t, buff, n);
     return buff;
 }
@@ -2548,14 +2551,14 @@ void nut_iau1980(double t, const double *f, double *dpsi, double *deps)
  *                               (NULL: no output)
  * return : none
  * note   : see ref [3] chap 5
- *          not thread-safe
+ *          the last matrix is cached per thread
  *-----------------------------------------------------------------------------*/
 void eci2ecef(gtime_t tutc, const double *erpv, double *U, double *gmst)
 {
     const double ep2000[] = {2000, 1, 1, 12, 0, 0};
-    static gtime_t tutc_;
-    static double U_[9];
-    static double gmst_;
+    static thread_local gtime_t tutc_;
+    static thread_local double U_[9];
+    static thread_local double gmst_;
     gtime_t tgps;
     double eps;
     double ze;
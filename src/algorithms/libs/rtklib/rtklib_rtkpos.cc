@@ -1870,15 +1870,15 @@ int ddres(rtk_t *rtk, const nav_t *nav, double dt, const double *x,
 double intpres(gtime_t time, const obsd_t *obs, int n, const nav_t *nav,
     rtk_t *rtk, double *y)
 {
-    static obsd_t obsb[MAXOBS];
-    static double yb[MAXOBS * NFREQ * 2];
-    static double rs[MAXOBS * 6];
-    static double dts[MAXOBS * 2];
-    static double var[MAXOBS];
-    static double e[MAXOBS * 3];
-    static double azel[MAXOBS * 2];
-    static int nb = 0;
-    static int svh[MAXOBS * 2];
+    static thread_local obsd_t obsb[MAXOBS];
+    static thread_local double yb[MAXOBS * NFREQ * 2];
+    static thread_local double rs[MAXOBS * 6];
+    static thread_local double dts[MAXOBS * 2];
+    static thread_local double var[MAXOBS];
+    static thread_local double e[MAXOBS * 3];
+    static thread_local double azel[MAXOBS * 2];
+    static thread_local int nb = 0;
+    static thread_local int svh[MAXOBS * 2];
     prcopt_t *opt = &rtk->opt;
     double tt = timediff(time, obs[0].time);
     double ttb;
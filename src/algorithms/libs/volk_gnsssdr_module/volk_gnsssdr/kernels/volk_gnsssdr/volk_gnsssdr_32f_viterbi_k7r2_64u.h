@@ -0,0 +1,459 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbi_k7r2_64u.h
+ * \brief VOLK_GNSSSDR kernel: add-compare-select step of a K=7, rate 1/2 Viterbi decoder.
+ * \author agent, 2026. agent(at)local
+ *
+ * VOLK_GNSSSDR kernel that runs the add-compare-select operations of a
+ * Viterbi decoder for convolutional codes of constraint length 7 and rate 1/2,
+ * as the ones used by Galileo, GPS L2C/L5 and SBAS, over a block of soft
+ * symbols.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_viterbi_k7r2_64u
+ *
+ * \b Overview
+ *
+ * Goes through num_points sections of the trellis of a K=7, rate 1/2
+ * convolutional code, updating the 64 path metrics and storing the survivor
+ * decisions of each section.
+ *
+ * The state of the encoder holds its last six input bits, with the newest
+ * one in the least significant bit, so states i and i + 32 move to states
+ * 2 * i (input bit 0) and 2 * i + 1 (input bit 1). Both generator polynomials
+ * must tap the current and the oldest input bits, as all the codes used in
+ * GNSS do.
+ *
+ * Soft symbols are positive for a transmitted 1, and metrics are
+ * correlations, so the best path has the largest metric. Before each section,
+ * the metrics are shifted so that the one of state 0 is zero.
+ *
+ * Bit i of each decision word (i < 32) is set if the survivor path of state
+ * 2 * i comes from state i + 32 instead of state i, and bit 32 + i is set if
+ * the survivor path of state 2 * i + 1 comes from state i + 32.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_viterbi_k7r2_64u(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li metrics: Path metrics of the 64 states before the first section.
+ * \li symbols: Soft symbols, two per section.
+ * \li branch_table: Expected symbols of the branch from state i with input bit 0:
+ * branch_table[i] for the first polynomial, branch_table[32 + i] for the second one.
+ * Values are 1.0 for a 1 and -1.0 for a 0 (or for a 1 on an inverted output).
+ * \li num_points: Number of trellis sections.
+ *
+ * \b Outputs
+ * \li decisions: Survivor decisions, one word per section.
+ * \li metrics: Path metrics of the 64 states after the last section.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbi_k7r2_64u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbi_k7r2_64u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <inttypes.h>
+#include <string.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_viterbi_k7r2_64u_generic(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points)
+{
+    float buffer[64];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    float norm, s0, s1, branch, low, high, m0, m1;
+    uint64_t decision;
+    unsigned int n, i;
+
+    for (n = 0; n < num_points; n++)
+        {
+            norm = old_metrics[0];
+            s0 = symbols[2 * n];
+            s1 = symbols[2 * n + 1];
+            decision = 0;
+            for (i = 0; i < 32; i++)
+                {
+                    branch = (branch_table[i] < 0.0F ? -s0 : s0) + (branch_table[32 + i] < 0.0F ? -s1 : s1);
+                    low = old_metrics[i] - norm;
+                    high = old_metrics[i + 32] - norm;
+                    // input bit 0
+                    m0 = low + branch;
+                    m1 = high - branch;
+                    if (m1 > m0)
+                        {
+                            new_metrics[2 * i] = m1;
+                            decision |= (uint64_t)1 << i;
+                        }
+                    else
+                        {
+                            new_metrics[2 * i] = m0;
+                        }
+                    // input bit 1
+                    m0 = low - branch;
+                    m1 = high + branch;
+                    if (m1 > m0)
+                        {
+                            new_metrics[2 * i + 1] = m1;
+                            decision |= (uint64_t)1 << (32 + i);
+                        }
+                    else
+                        {
+                            new_metrics[2 * i + 1] = m0;
+                        }
+                }
+            decisions[n] = decision;
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r2_64u_u_sse(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float buffer[64];
+    const __m128 sign_bit = _mm_set1_ps(-0.0F);
+    __m128 sign0[8], sign1[8];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    __m128 norm, s0, s1, branch, low, high, m0, m1, even, odd, even_decision, odd_decision;
+    uint64_t even_bits, odd_bits;
+    unsigned int n, k;
+
+    for (k = 0; k < 8; k++)
+        {
+            sign0[k] = _mm_and_ps(_mm_loadu_ps(branch_table + 4 * k), sign_bit);
+            sign1[k] = _mm_and_ps(_mm_loadu_ps(branch_table + 32 + 4 * k), sign_bit);
+        }
+
+    for (n = 0; n < num_points; n++)
+        {
+            norm = _mm_set1_ps(old_metrics[0]);
+            s0 = _mm_set1_ps(symbols[2 * n]);
+            s1 = _mm_set1_ps(symbols[2 * n + 1]);
+            even_bits = 0;
+            odd_bits = 0;
+            for (k = 0; k < 8; k++)
+                {
+                    branch = _mm_add_ps(_mm_xor_ps(s0, sign0[k]), _mm_xor_ps(s1, sign1[k]));
+                    low = _mm_sub_ps(_mm_loadu_ps(old_metrics + 4 * k), norm);
+                    high = _mm_sub_ps(_mm_loadu_ps(old_metrics + 32 + 4 * k), norm);
+                    m0 = _mm_add_ps(low, branch);
+                    m1 = _mm_sub_ps(high, branch);
+                    even_decision = _mm_cmpgt_ps(m1, m0);
+                    even = _mm_max_ps(m0, m1);
+                    m0 = _mm_sub_ps(low, branch);
+                    m1 = _mm_add_ps(high, branch);
+                    odd_decision = _mm_cmpgt_ps(m1, m0);
+                    odd = _mm_max_ps(m0, m1);
+                    _mm_storeu_ps(new_metrics + 8 * k, _mm_unpacklo_ps(even, odd));
+                    _mm_storeu_ps(new_metrics + 8 * k + 4, _mm_unpackhi_ps(even, odd));
+                    even_bits |= (uint64_t)_mm_movemask_ps(even_decision) << (4 * k);
+                    odd_bits |= (uint64_t)_mm_movemask_ps(odd_decision) << (4 * k);
+                }
+            decisions[n] = even_bits | (odd_bits << 32);
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r2_64u_a_sse(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float buffer[64];
+    const __m128 sign_bit = _mm_set1_ps(-0.0F);
+    __m128 sign0[8], sign1[8];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    __m128 norm, s0, s1, branch, low, high, m0, m1, even, odd, even_decision, odd_decision;
+    uint64_t even_bits, odd_bits;
+    unsigned int n, k;
+
+    for (k = 0; k < 8; k++)
+        {
+            sign0[k] = _mm_and_ps(_mm_load_ps(branch_table + 4 * k), sign_bit);
+            sign1[k] = _mm_and_ps(_mm_load_ps(branch_table + 32 + 4 * k), sign_bit);
+        }
+
+    for (n = 0; n < num_points; n++)
+        {
+            norm = _mm_set1_ps(old_metrics[0]);
+            s0 = _mm_set1_ps(symbols[2 * n]);
+            s1 = _mm_set1_ps(symbols[2 * n + 1]);
+            even_bits = 0;
+            odd_bits = 0;
+            for (k = 0; k < 8; k++)
+                {
+                    branch = _mm_add_ps(_mm_xor_ps(s0, sign0[k]), _mm_xor_ps(s1, sign1[k]));
+                    low = _mm_sub_ps(_mm_load_ps(old_metrics + 4 * k), norm);
+                    high = _mm_sub_ps(_mm_load_ps(old_metrics + 32 + 4 * k), norm);
+                    m0 = _mm_add_ps(low, branch);
+                    m1 = _mm_sub_ps(high, branch);
+                    even_decision = _mm_cmpgt_ps(m1, m0);
+                    even = _mm_max_ps(m0, m1);
+                    m0 = _mm_sub_ps(low, branch);
+                    m1 = _mm_add_ps(high, branch);
+                    odd_decision = _mm_cmpgt_ps(m1, m0);
+                    odd = _mm_max_ps(m0, m1);
+                    _mm_store_ps(new_metrics + 8 * k, _mm_unpacklo_ps(even, odd));
+                    _mm_store_ps(new_metrics + 8 * k + 4, _mm_unpackhi_ps(even, odd));
+                    even_bits |= (uint64_t)_mm_movemask_ps(even_decision) << (4 * k);
+                    odd_bits |= (uint64_t)_mm_movemask_ps(odd_decision) << (4 * k);
+                }
+            decisions[n] = even_bits | (odd_bits << 32);
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r2_64u_u_avx(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32)
+    float buffer[64];
+    const __m256 sign_bit = _mm256_set1_ps(-0.0F);
+    __m256 sign0[4], sign1[4];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    __m256 norm, s0, s1, branch, low, high, m0, m1, even, odd, even_decision, odd_decision;
+    uint64_t even_bits, odd_bits;
+    unsigned int n, k;
+
+    for (k = 0; k < 4; k++)
+        {
+            sign0[k] = _mm256_and_ps(_mm256_loadu_ps(branch_table + 8 * k), sign_bit);
+            sign1[k] = _mm256_and_ps(_mm256_loadu_ps(branch_table + 32 + 8 * k), sign_bit);
+        }
+
+    for (n = 0; n < num_points; n++)
+        {
+            norm = _mm256_set1_ps(old_metrics[0]);
+            s0 = _mm256_set1_ps(symbols[2 * n]);
+            s1 = _mm256_set1_ps(symbols[2 * n + 1]);
+            even_bits = 0;
+            odd_bits = 0;
+            for (k = 0; k < 4; k++)
+                {
+                    branch = _mm256_add_ps(_mm256_xor_ps(s0, sign0[k]), _mm256_xor_ps(s1, sign1[k]));
+                    low = _mm256_sub_ps(_mm256_loadu_ps(old_metrics + 8 * k), norm);
+                    high = _mm256_sub_ps(_mm256_loadu_ps(old_metrics + 32 + 8 * k), norm);
+                    m0 = _mm256_add_ps(low, branch);
+                    m1 = _mm256_sub_ps(high, branch);
+                    even_decision = _mm256_cmp_ps(m1, m0, _CMP_GT_OQ);
+                    even = _mm256_max_ps(m0, m1);
+                    m0 = _mm256_sub_ps(low, branch);
+                    m1 = _mm256_add_ps(high, branch);
+                    odd_decision = _mm256_cmp_ps(m1, m0, _CMP_GT_OQ);
+                    odd = _mm256_max_ps(m0, m1);
+                    // Unpacking works within lanes, put the states of the first lane first
+                    m0 = _mm256_unpacklo_ps(even, odd);
+                    m1 = _mm256_unpackhi_ps(even, odd);
+                    _mm256_storeu_ps(new_metrics + 16 * k, _mm256_permute2f128_ps(m0, m1, 0x20));
+                    _mm256_storeu_ps(new_metrics + 16 * k + 8, _mm256_permute2f128_ps(m0, m1, 0x31));
+                    even_bits |= (uint64_t)_mm256_movemask_ps(even_decision) << (8 * k);
+                    odd_bits |= (uint64_t)_mm256_movemask_ps(odd_decision) << (8 * k);
+                }
+            decisions[n] = even_bits | (odd_bits << 32);
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r2_64u_a_avx(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32)
+    float buffer[64];
+    const __m256 sign_bit = _mm256_set1_ps(-0.0F);
+    __m256 sign0[4], sign1[4];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    __m256 norm, s0, s1, branch, low, high, m0, m1, even, odd, even_decision, odd_decision;
+    uint64_t even_bits, odd_bits;
+    unsigned int n, k;
+
+    for (k = 0; k < 4; k++)
+        {
+            sign0[k] = _mm256_and_ps(_mm256_load_ps(branch_table + 8 * k), sign_bit);
+            sign1[k] = _mm256_and_ps(_mm256_load_ps(branch_table + 32 + 8 * k), sign_bit);
+        }
+
+    for (n = 0; n < num_points; n++)
+        {
+            norm = _mm256_set1_ps(old_metrics[0]);
+            s0 = _mm256_set1_ps(symbols[2 * n]);
+            s1 = _mm256_set1_ps(symbols[2 * n + 1]);
+            even_bits = 0;
+            odd_bits = 0;
+            for (k = 0; k < 4; k++)
+                {
+                    branch = _mm256_add_ps(_mm256_xor_ps(s0, sign0[k]), _mm256_xor_ps(s1, sign1[k]));
+                    low = _mm256_sub_ps(_mm256_load_ps(old_metrics + 8 * k), norm);
+                    high = _mm256_sub_ps(_mm256_load_ps(old_metrics + 32 + 8 * k), norm);
+                    m0 = _mm256_add_ps(low, branch);
+                    m1 = _mm256_sub_ps(high, branch);
+                    even_decision = _mm256_cmp_ps(m1, m0, _CMP_GT_OQ);
+                    even = _mm256_max_ps(m0, m1);
+                    m0 = _mm256_sub_ps(low, branch);
+                    m1 = _mm256_add_ps(high, branch);
+                    odd_decision = _mm256_cmp_ps(m1, m0, _CMP_GT_OQ);
+                    odd = _mm256_max_ps(m0, m1);
+                    // Unpacking works within lanes, put the states of the first lane first
+                    m0 = _mm256_unpacklo_ps(even, odd);
+                    m1 = _mm256_unpackhi_ps(even, odd);
+                    _mm256_store_ps(new_metrics + 16 * k, _mm256_permute2f128_ps(m0, m1, 0x20));
+                    _mm256_store_ps(new_metrics + 16 * k + 8, _mm256_permute2f128_ps(m0, m1, 0x31));
+                    even_bits |= (uint64_t)_mm256_movemask_ps(even_decision) << (8 * k);
+                    odd_bits |= (uint64_t)_mm256_movemask_ps(odd_decision) << (8 * k);
+                }
+            decisions[n] = even_bits | (odd_bits << 32);
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r2_64u_neon(uint64_t* decisions, float* metrics, const float* symbols, const float* branch_table, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float buffer[64];
+    __VOLK_ATTR_ALIGNED(16)
+    const uint32_t weights[4] = {1, 2, 4, 8};
+    const uint32x4_t bit_weights = vld1q_u32(weights);
+    const uint32x4_t sign_bit = vdupq_n_u32(0x80000000);
+    uint32x4_t sign0[8], sign1[8];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    float32x4_t norm, branch, low, high, m0, m1;
+    float32x4x2_t states;
+    uint32x4_t s0, s1, even_decision, odd_decision;
+    uint32x2_t bits;
+    uint64_t even_bits, odd_bits;
+    unsigned int n, k;
+
+    for (k = 0; k < 8; k++)
+        {
+            sign0[k] = vandq_u32(vreinterpretq_u32_f32(vld1q_f32(branch_table + 4 * k)), sign_bit);
+            sign1[k] = vandq_u32(vreinterpretq_u32_f32(vld1q_f32(branch_table + 32 + 4 * k)), sign_bit);
+        }
+
+    for (n = 0; n < num_points; n++)
+        {
+            norm = vdupq_n_f32(old_metrics[0]);
+            s0 = vreinterpretq_u32_f32(vdupq_n_f32(symbols[2 * n]));
+            s1 = vreinterpretq_u32_f32(vdupq_n_f32(symbols[2 * n + 1]));
+            even_bits = 0;
+            odd_bits = 0;
+            for (k = 0; k < 8; k++)
+                {
+                    branch = vaddq_f32(vreinterpretq_f32_u32(veorq_u32(s0, sign0[k])), vreinterpretq_f32_u32(veorq_u32(s1, sign1[k])));
+                    low = vsubq_f32(vld1q_f32(old_metrics + 4 * k), norm);
+                    high = vsubq_f32(vld1q_f32(old_metrics + 32 + 4 * k), norm);
+                    m0 = vaddq_f32(low, branch);
+                    m1 = vsubq_f32(high, branch);
+                    even_decision = vcgtq_f32(m1, m0);
+                    states.val[0] = vbslq_f32(even_decision, m1, m0);
+                    m0 = vsubq_f32(low, branch);
+                    m1 = vaddq_f32(high, branch);
+                    odd_decision = vcgtq_f32(m1, m0);
+                    states.val[1] = vbslq_f32(odd_decision, m1, m0);
+                    vst2q_f32(new_metrics + 8 * k, states);
+                    // Gather the four decisions of each vector in four bits
+                    even_decision = vandq_u32(even_decision, bit_weights);
+                    odd_decision = vandq_u32(odd_decision, bit_weights);
+                    bits = vpadd_u32(vpadd_u32(vget_low_u32(even_decision), vget_high_u32(even_decision)),
+                        vpadd_u32(vget_low_u32(odd_decision), vget_high_u32(odd_decision)));
+                    even_bits |= (uint64_t)vget_lane_u32(bits, 0) << (4 * k);
+                    odd_bits |= (uint64_t)vget_lane_u32(bits, 1) << (4 * k);
+                }
+            decisions[n] = even_bits | (odd_bits << 32);
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbi_k7r2_64u_H */
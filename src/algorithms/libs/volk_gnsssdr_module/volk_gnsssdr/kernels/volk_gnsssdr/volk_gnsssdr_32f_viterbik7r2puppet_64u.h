@@ -0,0 +1,146 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbik7r2puppet_64u.h
+ * \brief VOLK_GNSSSDR puppet for the K=7, rate 1/2 Viterbi decoder kernel.
+ * \author agent, 2026. agent(at)local
+ *
+ * VOLK_GNSSSDR puppet for integrating the Viterbi decoder kernel into the test
+ * system, with the code of the Galileo navigation messages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbik7r2puppet_64u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbik7r2puppet_64u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_viterbi_k7r2_64u.h"
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <inttypes.h>
+
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_init(float* metrics, float* branch_table)
+{
+    // Galileo polynomials 171 and 133 (octal), with the newest bit in the
+    // least significant position and the second output inverted
+    const unsigned int g1 = 0x4F;
+    const unsigned int g2 = 0x6D;
+    unsigned int i, p1, p2;
+
+    for (i = 0; i < 32; i++)
+        {
+            p1 = (2 * i) & g1;
+            p2 = (2 * i) & g2;
+            p1 ^= p1 >> 4;
+            p1 ^= p1 >> 2;
+            p1 ^= p1 >> 1;
+            p2 ^= p2 >> 4;
+            p2 ^= p2 >> 2;
+            p2 ^= p2 >> 1;
+            branch_table[i] = (p1 & 1) ? 1.0F : -1.0F;
+            branch_table[32 + i] = (p2 & 1) ? -1.0F : 1.0F;
+        }
+    for (i = 0; i < 64; i++)
+        {
+            metrics[i] = -1.0e4F;
+        }
+    metrics[0] = 0.0F;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_generic(uint64_t* decisions, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float metrics[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float branch_table[64];
+    volk_gnsssdr_32f_viterbik7r2puppet_64u_init(metrics, branch_table);
+    volk_gnsssdr_32f_viterbi_k7r2_64u_generic(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_u_sse(uint64_t* decisions, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float metrics[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float branch_table[64];
+    volk_gnsssdr_32f_viterbik7r2puppet_64u_init(metrics, branch_table);
+    volk_gnsssdr_32f_viterbi_k7r2_64u_u_sse(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_SSE
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_a_sse(uint64_t* decisions, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float metrics[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float branch_table[64];
+    volk_gnsssdr_32f_viterbik7r2puppet_64u_init(metrics, branch_table);
+    volk_gnsssdr_32f_viterbi_k7r2_64u_a_sse(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_u_avx(uint64_t* decisions, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32)
+    float metrics[64];
+    __VOLK_ATTR_ALIGNED(32)
+    float branch_table[64];
+    volk_gnsssdr_32f_viterbik7r2puppet_64u_init(metrics, branch_table);
+    volk_gnsssdr_32f_viterbi_k7r2_64u_u_avx(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_a_avx(uint64_t* decisions, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32)
+    float metrics[64];
+    __VOLK_ATTR_ALIGNED(32)
+    float branch_table[64];
+    volk_gnsssdr_32f_viterbik7r2puppet_64u_init(metrics, branch_table);
+    volk_gnsssdr_32f_viterbi_k7r2_64u_a_avx(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+
+static inline void volk_gnsssdr_32f_viterbik7r2puppet_64u_neon(uint64_t* decisions, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float metrics[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float branch_table[64];
+    volk_gnsssdr_32f_viterbik7r2puppet_64u_init(metrics, branch_table);
+    volk_gnsssdr_32f_viterbi_k7r2_64u_neon(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbik7r2puppet_64u_H */
@@ -0,0 +1,267 @@
+/*!
+ * \file volk_gnsssdr_32u_s32f_unpack1bit_32fc.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 1-bit complex samples stored in 32-bit words.
+ * \author agent, 2026. agent(at)local
+ *
+ * VOLK_GNSSSDR kernel that unpacks 1-bit complex samples, stored in the two
+ * least significant bits of 32-bit words, into 32-bit float complex values.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32u_s32f_unpack1bit_32fc
+ *
+ * \b Overview
+ *
+ * Unpacks a vector of 32-bit words, each one holding a 1-bit complex sample
+ * in its two least significant bits (bit 0: real part, bit 1: imaginary
+ * part), into a vector of complex floats. A set bit is mapped to +scale and
+ * a cleared bit to -scale. The other bits of the words are ignored.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32u_s32f_unpack1bit_32fc(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Vector of packed samples.
+ * \li scale: Magnitude of the real and imaginary parts of the output samples.
+ * \li num_points: Number of complex samples.
+ *
+ * \b Outputs
+ * \li result: Vector of unpacked complex samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32u_s32f_unpack1bit_32fc_H
+#define INCLUDED_volk_gnsssdr_32u_s32f_unpack1bit_32fc_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <inttypes.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32u_s32f_unpack1bit_32fc_generic(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points)
+{
+    const float levels[2] = {-scale, scale};
+    float* out = (float*)result;
+    unsigned int n;
+
+    for (n = 0; n < num_points; n++)
+        {
+            *out++ = levels[packed[n] & 1U];
+            *out++ = levels[(packed[n] >> 1) & 1U];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack1bit_32fc_u_sse2(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float levels[2] = {-scale, scale};
+    const __m128i real_bit = _mm_set1_epi32(1);
+    const __m128i imag_bit = _mm_set1_epi32(2);
+    const __m128 sign_bit = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+    const __m128 negative = _mm_set1_ps(-scale);
+    const uint32_t* in = packed;
+    float* out = (float*)result;
+    __m128i words;
+    __m128 real, imag;
+    unsigned int n;
+
+    for (n = 0; n < sse_iters; n++)
+        {
+            words = _mm_loadu_si128((const __m128i*)in);
+            // Flip the sign of -scale where the bit is set
+            real = _mm_xor_ps(negative, _mm_and_ps(sign_bit, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(words, real_bit), real_bit))));
+            imag = _mm_xor_ps(negative, _mm_and_ps(sign_bit, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(words, imag_bit), imag_bit))));
+            _mm_storeu_ps(out, _mm_unpacklo_ps(real, imag));
+            _mm_storeu_ps(out + 4, _mm_unpackhi_ps(real, imag));
+            in += 4;
+            out += 8;
+        }
+
+    for (n = sse_iters * 4; n < num_points; n++)
+        {
+            *out++ = levels[packed[n] & 1U];
+            *out++ = levels[(packed[n] >> 1) & 1U];
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack1bit_32fc_a_sse2(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float levels[2] = {-scale, scale};
+    const __m128i real_bit = _mm_set1_epi32(1);
+    const __m128i imag_bit = _mm_set1_epi32(2);
+    const __m128 sign_bit = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+    const __m128 negative = _mm_set1_ps(-scale);
+    const uint32_t* in = packed;
+    float* out = (float*)result;
+    __m128i words;
+    __m128 real, imag;
+    unsigned int n;
+
+    for (n = 0; n < sse_iters; n++)
+        {
+            words = _mm_load_si128((const __m128i*)in);
+            // Flip the sign of -scale where the bit is set
+            real = _mm_xor_ps(negative, _mm_and_ps(sign_bit, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(words, real_bit), real_bit))));
+            imag = _mm_xor_ps(negative, _mm_and_ps(sign_bit, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(words, imag_bit), imag_bit))));
+            _mm_store_ps(out, _mm_unpacklo_ps(real, imag));
+            _mm_store_ps(out + 4, _mm_unpackhi_ps(real, imag));
+            in += 4;
+            out += 8;
+        }
+
+    for (n = sse_iters * 4; n < num_points; n++)
+        {
+            *out++ = levels[packed[n] & 1U];
+            *out++ = levels[(packed[n] >> 1) & 1U];
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack1bit_32fc_u_avx2(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 8;
+    const float levels[2] = {-scale, scale};
+    const __m256i real_bit = _mm256_set1_epi32(1);
+    const __m256i imag_bit = _mm256_set1_epi32(2);
+    const __m256 sign_bit = _mm256_castsi256_ps(_mm256_set1_epi32((int)0x80000000));
+    const __m256 negative = _mm256_set1_ps(-scale);
+    const uint32_t* in = packed;
+    float* out = (float*)result;
+    __m256i words;
+    __m256 real, imag, low, high;
+    unsigned int n;
+
+    for (n = 0; n < avx2_iters; n++)
+        {
+            words = _mm256_loadu_si256((const __m256i*)in);
+            // Flip the sign of -scale where the bit is set
+            real = _mm256_xor_ps(negative, _mm256_and_ps(sign_bit, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(words, real_bit), real_bit))));
+            imag = _mm256_xor_ps(negative, _mm256_and_ps(sign_bit, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(words, imag_bit), imag_bit))));
+            // Unpacking works within lanes, put the samples of the first lane first
+            low = _mm256_unpacklo_ps(real, imag);
+            high = _mm256_unpackhi_ps(real, imag);
+            _mm256_storeu_ps(out, _mm256_permute2f128_ps(low, high, 0x20));
+            _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(low, high, 0x31));
+            in += 8;
+            out += 16;
+        }
+
+    for (n = avx2_iters * 8; n < num_points; n++)
+        {
+            *out++ = levels[packed[n] & 1U];
+            *out++ = levels[(packed[n] >> 1) & 1U];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack1bit_32fc_a_avx2(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 8;
+    const float levels[2] = {-scale, scale};
+    const __m256i real_bit = _mm256_set1_epi32(1);
+    const __m256i imag_bit = _mm256_set1_epi32(2);
+    const __m256 sign_bit = _mm256_castsi256_ps(_mm256_set1_epi32((int)0x80000000));
+    const __m256 negative = _mm256_set1_ps(-scale);
+    const uint32_t* in = packed;
+    float* out = (float*)result;
+    __m256i words;
+    __m256 real, imag, low, high;
+    unsigned int n;
+
+    for (n = 0; n < avx2_iters; n++)
+        {
+            words = _mm256_load_si256((const __m256i*)in);
+            // Flip the sign of -scale where the bit is set
+            real = _mm256_xor_ps(negative, _mm256_and_ps(sign_bit, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(words, real_bit), real_bit))));
+            imag = _mm256_xor_ps(negative, _mm256_and_ps(sign_bit, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(words, imag_bit), imag_bit))));
+            // Unpacking works within lanes, put the samples of the first lane first
+            low = _mm256_unpacklo_ps(real, imag);
+            high = _mm256_unpackhi_ps(real, imag);
+            _mm256_store_ps(out, _mm256_permute2f128_ps(low, high, 0x20));
+            _mm256_store_ps(out + 8, _mm256_permute2f128_ps(low, high, 0x31));
+            in += 8;
+            out += 16;
+        }
+
+    for (n = avx2_iters * 8; n < num_points; n++)
+        {
+            *out++ = levels[packed[n] & 1U];
+            *out++ = levels[(packed[n] >> 1) & 1U];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32u_s32f_unpack1bit_32fc_neon(lv_32fc_t* result, const uint32_t* packed, const float scale, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    const float levels[2] = {-scale, scale};
+    const uint32x4_t real_bit = vdupq_n_u32(1);
+    const uint32x4_t imag_bit = vdupq_n_u32(2);
+    const float32x4_t positive = vdupq_n_f32(scale);
+    const float32x4_t negative = vdupq_n_f32(-scale);
+    const uint32_t* in = packed;
+    float* out = (float*)result;
+    uint32x4_t words;
+    float32x4x2_t samples;
+    unsigned int n;
+
+    for (n = 0; n < neon_iters; n++)
+        {
+            words = vld1q_u32(in);
+            samples.val[0] = vbslq_f32(vtstq_u32(words, real_bit), positive, negative);
+            samples.val[1] = vbslq_f32(vtstq_u32(words, imag_bit), positive, negative);
+            vst2q_f32(out, samples);
+            in += 4;
+            out += 8;
+        }
+
+    for (n = neon_iters * 4; n < num_points; n++)
+        {
+            *out++ = levels[packed[n] & 1U];
+            *out++ = levels[(packed[n] >> 1) & 1U];
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32u_s32f_unpack1bit_32fc_H */
@@ -0,0 +1,449 @@
+/*!
+ * \file volk_gnsssdr_8u_s8i_unpack2bit_16i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 2-bit samples packed into bytes.
+ * \author agent, 2026. agent(at)local
+ *
+ * VOLK_GNSSSDR kernel that unpacks 2-bit signed samples, four per byte, into
+ * 16-bit integers, with the sample and byte orders given by a single parameter.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_s8i_unpack2bit_16i
+ *
+ * \b Overview
+ *
+ * Unpacks a vector of bytes, each one holding four 2-bit samples in two's
+ * complement, into a vector of 16-bit integers. Each 2-bit value s is mapped
+ * to 2 * s + 1, so the output levels are -3, -1, 1 and 3.
+ *
+ * Counting the samples from the two least significant bits of the first byte,
+ * the n-th output is the (n XOR order)-th packed sample. Hence, the two least
+ * significant bits of order select the order of the samples in each byte
+ * (0: least significant bits first, 3: most significant bits first, 1 and 2:
+ * the same with swapped I and Q samples), and the next four bits reverse the
+ * bytes of the items of the packed stream (order = (item_size - 1) << 2 for
+ * items of 2, 4, 8 or 16 bytes stored with the opposite endianness).
+ * Bytes of a trailing incomplete item are not reordered.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_s8i_unpack2bit_16i(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Vector of packed samples, with at least (num_points + 3) / 4 bytes.
+ * \li order: Sample order, as described above. Only its six least significant bits are used.
+ * \li num_points: Number of output samples.
+ *
+ * \b Outputs
+ * \li result: Vector of unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_s8i_unpack2bit_16i_H
+#define INCLUDED_volk_gnsssdr_8u_s8i_unpack2bit_16i_H
+
+#include <inttypes.h>
+#include <string.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(int16_t* result, const uint8_t* packed, const char order, unsigned int first_point, unsigned int num_points)
+{
+    static const int16_t levels[4] = {1, 3, -3, -1};
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const unsigned int byte_xor = ((unsigned char)order >> 2) & 15U;
+    const unsigned int num_bytes = (num_points + 3) / 4;
+    const unsigned int shift0 = 2 * (0 ^ field_xor);
+    const unsigned int shift1 = 2 * (1 ^ field_xor);
+    const unsigned int shift2 = 2 * (2 ^ field_xor);
+    const unsigned int shift3 = 2 * (3 ^ field_xor);
+    unsigned int item_size = 1;
+    unsigned int swapped_bytes;
+    unsigned int byte;
+    unsigned int value;
+    unsigned int n;
+
+    while (item_size <= byte_xor)
+        {
+            item_size <<= 1;
+        }
+    swapped_bytes = num_bytes - num_bytes % item_size;
+
+    // first_point is a multiple of 4
+    for (n = first_point; n + 4 <= num_points; n += 4)
+        {
+            byte = n / 4;
+            if (byte < swapped_bytes)
+                {
+                    byte ^= byte_xor;
+                }
+            value = packed[byte];
+            result[n] = levels[(value >> shift0) & 3];
+            result[n + 1] = levels[(value >> shift1) & 3];
+            result[n + 2] = levels[(value >> shift2) & 3];
+            result[n + 3] = levels[(value >> shift3) & 3];
+        }
+    for (; n < num_points; n++)
+        {
+            byte = n / 4;
+            if (byte < swapped_bytes)
+                {
+                    byte ^= byte_xor;
+                }
+            result[n] = levels[(packed[byte] >> (2 * ((n % 4) ^ field_xor))) & 3];
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_generic(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    static const int16_t levels[4] = {1, 3, -3, -1};
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const unsigned int byte_xor = ((unsigned char)order >> 2) & 15U;
+    const unsigned int num_bytes = (num_points + 3) / 4;
+    int16_t table[256][4];
+    unsigned int item_size = 1;
+    unsigned int swapped_bytes;
+    unsigned int byte;
+    unsigned int value;
+    unsigned int k;
+    unsigned int n;
+
+    // Output samples of each possible byte
+    for (value = 0; value < 256; value++)
+        {
+            for (k = 0; k < 4; k++)
+                {
+                    table[value][k] = levels[(value >> (2 * (k ^ field_xor))) & 3];
+                }
+        }
+
+    while (item_size <= byte_xor)
+        {
+            item_size <<= 1;
+        }
+    swapped_bytes = num_bytes - num_bytes % item_size;
+
+    for (n = 0; n + 4 <= num_points; n += 4)
+        {
+            byte = n / 4;
+            if (byte < swapped_bytes)
+                {
+                    byte ^= byte_xor;
+                }
+            memcpy(&result[n], table[packed[byte]], sizeof(table[0]));
+        }
+
+    volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(result, packed, order, n, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_u_ssse3(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 64;
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const char byte_xor = (char)(((unsigned char)order >> 2) & 15U);
+    const __m128i levels = _mm_setr_epi8(1, 3, -3, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask = _mm_set1_epi8(3);
+    const __m128i byte_order = _mm_xor_si128(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(2 * (0 ^ field_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(2 * (1 ^ field_xor)));
+    const __m128i shift2 = _mm_cvtsi32_si128((int)(2 * (2 ^ field_xor)));
+    const __m128i shift3 = _mm_cvtsi32_si128((int)(2 * (3 ^ field_xor)));
+    const uint8_t* in = packed;
+    int16_t* out = result;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bytes, s0, s1, s2, s3, s01, s23, r0, r1, r2, r3;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), byte_order);
+            s0 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift0), mask));
+            s1 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift1), mask));
+            s2 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift2), mask));
+            s3 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift3), mask));
+
+            s01 = _mm_unpacklo_epi8(s0, s1);
+            s23 = _mm_unpacklo_epi8(s2, s3);
+            r0 = _mm_unpacklo_epi16(s01, s23);
+            r1 = _mm_unpackhi_epi16(s01, s23);
+            s01 = _mm_unpackhi_epi8(s0, s1);
+            s23 = _mm_unpackhi_epi8(s2, s3);
+            r2 = _mm_unpacklo_epi16(s01, s23);
+            r3 = _mm_unpackhi_epi16(s01, s23);
+
+            // Sign extension
+            _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(r0, _mm_cmpgt_epi8(zero, r0)));
+            _mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(r0, _mm_cmpgt_epi8(zero, r0)));
+            _mm_storeu_si128((__m128i*)(out + 16), _mm_unpacklo_epi8(r1, _mm_cmpgt_epi8(zero, r1)));
+            _mm_storeu_si128((__m128i*)(out + 24), _mm_unpackhi_epi8(r1, _mm_cmpgt_epi8(zero, r1)));
+            _mm_storeu_si128((__m128i*)(out + 32), _mm_unpacklo_epi8(r2, _mm_cmpgt_epi8(zero, r2)));
+            _mm_storeu_si128((__m128i*)(out + 40), _mm_unpackhi_epi8(r2, _mm_cmpgt_epi8(zero, r2)));
+            _mm_storeu_si128((__m128i*)(out + 48), _mm_unpacklo_epi8(r3, _mm_cmpgt_epi8(zero, r3)));
+            _mm_storeu_si128((__m128i*)(out + 56), _mm_unpackhi_epi8(r3, _mm_cmpgt_epi8(zero, r3)));
+            in += 16;
+            out += 64;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(result, packed, order, sse_iters * 64, num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_a_ssse3(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 64;
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const char byte_xor = (char)(((unsigned char)order >> 2) & 15U);
+    const __m128i levels = _mm_setr_epi8(1, 3, -3, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask = _mm_set1_epi8(3);
+    const __m128i byte_order = _mm_xor_si128(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(2 * (0 ^ field_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(2 * (1 ^ field_xor)));
+    const __m128i shift2 = _mm_cvtsi32_si128((int)(2 * (2 ^ field_xor)));
+    const __m128i shift3 = _mm_cvtsi32_si128((int)(2 * (3 ^ field_xor)));
+    const uint8_t* in = packed;
+    int16_t* out = result;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bytes, s0, s1, s2, s3, s01, s23, r0, r1, r2, r3;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            bytes = _mm_shuffle_epi8(_mm_load_si128((const __m128i*)in), byte_order);
+            s0 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift0), mask));
+            s1 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift1), mask));
+            s2 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift2), mask));
+            s3 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift3), mask));
+
+            s01 = _mm_unpacklo_epi8(s0, s1);
+            s23 = _mm_unpacklo_epi8(s2, s3);
+            r0 = _mm_unpacklo_epi16(s01, s23);
+            r1 = _mm_unpackhi_epi16(s01, s23);
+            s01 = _mm_unpackhi_epi8(s0, s1);
+            s23 = _mm_unpackhi_epi8(s2, s3);
+            r2 = _mm_unpacklo_epi16(s01, s23);
+            r3 = _mm_unpackhi_epi16(s01, s23);
+
+            // Sign extension
+            _mm_store_si128((__m128i*)out, _mm_unpacklo_epi8(r0, _mm_cmpgt_epi8(zero, r0)));
+            _mm_store_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(r0, _mm_cmpgt_epi8(zero, r0)));
+            _mm_store_si128((__m128i*)(out + 16), _mm_unpacklo_epi8(r1, _mm_cmpgt_epi8(zero, r1)));
+            _mm_store_si128((__m128i*)(out + 24), _mm_unpackhi_epi8(r1, _mm_cmpgt_epi8(zero, r1)));
+            _mm_store_si128((__m128i*)(out + 32), _mm_unpacklo_epi8(r2, _mm_cmpgt_epi8(zero, r2)));
+            _mm_store_si128((__m128i*)(out + 40), _mm_unpackhi_epi8(r2, _mm_cmpgt_epi8(zero, r2)));
+            _mm_store_si128((__m128i*)(out + 48), _mm_unpacklo_epi8(r3, _mm_cmpgt_epi8(zero, r3)));
+            _mm_store_si128((__m128i*)(out + 56), _mm_unpackhi_epi8(r3, _mm_cmpgt_epi8(zero, r3)));
+            in += 16;
+            out += 64;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(result, packed, order, sse_iters * 64, num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_u_avx2(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 128;
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const char byte_xor = (char)(((unsigned char)order >> 2) & 15U);
+    const __m256i levels = _mm256_setr_epi8(1, 3, -3, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 3, -3, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask = _mm256_set1_epi8(3);
+    // Items are at most 16 bytes long, so the byte reversal does not cross the 128-bit lanes
+    const __m256i byte_order = _mm256_xor_si256(_mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm256_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(2 * (0 ^ field_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(2 * (1 ^ field_xor)));
+    const __m128i shift2 = _mm_cvtsi32_si128((int)(2 * (2 ^ field_xor)));
+    const __m128i shift3 = _mm_cvtsi32_si128((int)(2 * (3 ^ field_xor)));
+    const uint8_t* in = packed;
+    int16_t* out = result;
+    __m256i bytes, s0, s1, s2, s3, s01, s23, r0, r1, r2, r3;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            bytes = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)in), byte_order);
+            s0 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift0), mask));
+            s1 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift1), mask));
+            s2 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift2), mask));
+            s3 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift3), mask));
+
+            s01 = _mm256_unpacklo_epi8(s0, s1);
+            s23 = _mm256_unpacklo_epi8(s2, s3);
+            r0 = _mm256_unpacklo_epi16(s01, s23);
+            r1 = _mm256_unpackhi_epi16(s01, s23);
+            s01 = _mm256_unpackhi_epi8(s0, s1);
+            s23 = _mm256_unpackhi_epi8(s2, s3);
+            r2 = _mm256_unpacklo_epi16(s01, s23);
+            r3 = _mm256_unpackhi_epi16(s01, s23);
+
+            // Unpacking works within lanes, put the samples of the first lane first
+            _mm256_storeu_si256((__m256i*)out, _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r0)));
+            _mm256_storeu_si256((__m256i*)(out + 16), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r1)));
+            _mm256_storeu_si256((__m256i*)(out + 32), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r2)));
+            _mm256_storeu_si256((__m256i*)(out + 48), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r3)));
+            _mm256_storeu_si256((__m256i*)(out + 64), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r0, 1)));
+            _mm256_storeu_si256((__m256i*)(out + 80), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r1, 1)));
+            _mm256_storeu_si256((__m256i*)(out + 96), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r2, 1)));
+            _mm256_storeu_si256((__m256i*)(out + 112), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r3, 1)));
+            in += 32;
+            out += 128;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(result, packed, order, avx2_iters * 128, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_a_avx2(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 128;
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const char byte_xor = (char)(((unsigned char)order >> 2) & 15U);
+    const __m256i levels = _mm256_setr_epi8(1, 3, -3, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 3, -3, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask = _mm256_set1_epi8(3);
+    // Items are at most 16 bytes long, so the byte reversal does not cross the 128-bit lanes
+    const __m256i byte_order = _mm256_xor_si256(_mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm256_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(2 * (0 ^ field_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(2 * (1 ^ field_xor)));
+    const __m128i shift2 = _mm_cvtsi32_si128((int)(2 * (2 ^ field_xor)));
+    const __m128i shift3 = _mm_cvtsi32_si128((int)(2 * (3 ^ field_xor)));
+    const uint8_t* in = packed;
+    int16_t* out = result;
+    __m256i bytes, s0, s1, s2, s3, s01, s23, r0, r1, r2, r3;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            bytes = _mm256_shuffle_epi8(_mm256_load_si256((const __m256i*)in), byte_order);
+            s0 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift0), mask));
+            s1 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift1), mask));
+            s2 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift2), mask));
+            s3 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift3), mask));
+
+            s01 = _mm256_unpacklo_epi8(s0, s1);
+            s23 = _mm256_unpacklo_epi8(s2, s3);
+            r0 = _mm256_unpacklo_epi16(s01, s23);
+            r1 = _mm256_unpackhi_epi16(s01, s23);
+            s01 = _mm256_unpackhi_epi8(s0, s1);
+            s23 = _mm256_unpackhi_epi8(s2, s3);
+            r2 = _mm256_unpacklo_epi16(s01, s23);
+            r3 = _mm256_unpackhi_epi16(s01, s23);
+
+            // Unpacking works within lanes, put the samples of the first lane first
+            _mm256_store_si256((__m256i*)out, _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r0)));
+            _mm256_store_si256((__m256i*)(out + 16), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r1)));
+            _mm256_store_si256((__m256i*)(out + 32), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r2)));
+            _mm256_store_si256((__m256i*)(out + 48), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(r3)));
+            _mm256_store_si256((__m256i*)(out + 64), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r0, 1)));
+            _mm256_store_si256((__m256i*)(out + 80), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r1, 1)));
+            _mm256_store_si256((__m256i*)(out + 96), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r2, 1)));
+            _mm256_store_si256((__m256i*)(out + 112), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(r3, 1)));
+            in += 32;
+            out += 128;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(result, packed, order, avx2_iters * 128, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack2bit_16i_neon(int16_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 64;
+    const unsigned int field_xor = (unsigned char)order & 3U;
+    const uint8_t byte_xor = ((unsigned char)order >> 2) & 15U;
+    const int8_t levels_array[8] = {1, 3, -3, -1, 0, 0, 0, 0};
+    const uint8_t indexes[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const int8x8_t levels = vld1_s8(levels_array);
+    const uint8x16_t mask = vdupq_n_u8(3);
+    const uint8x16_t byte_order = veorq_u8(vld1q_u8(indexes), vdupq_n_u8(byte_xor));
+    // Shifting by a negative amount shifts to the right
+    const int8x16_t shift0 = vdupq_n_s8((int8_t)(-2 * (int)(0 ^ field_xor)));
+    const int8x16_t shift1 = vdupq_n_s8((int8_t)(-2 * (int)(1 ^ field_xor)));
+    const int8x16_t shift2 = vdupq_n_s8((int8_t)(-2 * (int)(2 ^ field_xor)));
+    const int8x16_t shift3 = vdupq_n_s8((int8_t)(-2 * (int)(3 ^ field_xor)));
+    const uint8_t* in = packed;
+    int16_t* out = result;
+    uint8x16_t bytes, fields;
+    uint8x8x2_t table;
+    int8x16x4_t samples;
+    int16x8x4_t wide_samples;
+    unsigned int i;
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            bytes = vld1q_u8(in);
+            table.val[0] = vget_low_u8(bytes);
+            table.val[1] = vget_high_u8(bytes);
+            bytes = vcombine_u8(vtbl2_u8(table, vget_low_u8(byte_order)), vtbl2_u8(table, vget_high_u8(byte_order)));
+
+            fields = vandq_u8(vshlq_u8(bytes, shift0), mask);
+            samples.val[0] = vcombine_s8(vtbl1_s8(levels, vreinterpret_s8_u8(vget_low_u8(fields))), vtbl1_s8(levels, vreinterpret_s8_u8(vget_high_u8(fields))));
+            fields = vandq_u8(vshlq_u8(bytes, shift1), mask);
+            samples.val[1] = vcombine_s8(vtbl1_s8(levels, vreinterpret_s8_u8(vget_low_u8(fields))), vtbl1_s8(levels, vreinterpret_s8_u8(vget_high_u8(fields))));
+            fields = vandq_u8(vshlq_u8(bytes, shift2), mask);
+            samples.val[2] = vcombine_s8(vtbl1_s8(levels, vreinterpret_s8_u8(vget_low_u8(fields))), vtbl1_s8(levels, vreinterpret_s8_u8(vget_high_u8(fields))));
+            fields = vandq_u8(vshlq_u8(bytes, shift3), mask);
+            samples.val[3] = vcombine_s8(vtbl1_s8(levels, vreinterpret_s8_u8(vget_low_u8(fields))), vtbl1_s8(levels, vreinterpret_s8_u8(vget_high_u8(fields))));
+
+            wide_samples.val[0] = vmovl_s8(vget_low_s8(samples.val[0]));
+            wide_samples.val[1] = vmovl_s8(vget_low_s8(samples.val[1]));
+            wide_samples.val[2] = vmovl_s8(vget_low_s8(samples.val[2]));
+            wide_samples.val[3] = vmovl_s8(vget_low_s8(samples.val[3]));
+            vst4q_s16(out, wide_samples);
+            wide_samples.val[0] = vmovl_s8(vget_high_s8(samples.val[0]));
+            wide_samples.val[1] = vmovl_s8(vget_high_s8(samples.val[1]));
+            wide_samples.val[2] = vmovl_s8(vget_high_s8(samples.val[2]));
+            wide_samples.val[3] = vmovl_s8(vget_high_s8(samples.val[3]));
+            vst4q_s16(out + 32, wide_samples);
+            in += 16;
+            out += 64;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack2bit_16i_scalar(result, packed, order, neon_iters * 64, num_points);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_s8i_unpack2bit_16i_H */
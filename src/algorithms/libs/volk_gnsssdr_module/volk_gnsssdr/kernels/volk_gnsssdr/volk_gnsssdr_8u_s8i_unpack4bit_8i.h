@@ -0,0 +1,354 @@
+/*!
+ * \file volk_gnsssdr_8u_s8i_unpack4bit_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 4-bit samples packed into bytes.
+ * \author agent, 2026. agent(at)local
+ *
+ * VOLK_GNSSSDR kernel that unpacks 4-bit signed samples, two per byte, into
+ * 8-bit integers, with the sample and byte orders given by a single parameter.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_s8i_unpack4bit_8i
+ *
+ * \b Overview
+ *
+ * Unpacks a vector of bytes, each one holding two 4-bit samples in two's
+ * complement, into a vector of 8-bit integers. Each 4-bit value s is mapped
+ * to 2 * s + 1, so the output levels are -15, -13, ..., 13 and 15.
+ *
+ * Counting the samples from the least significant nibble of the first byte,
+ * the n-th output is the (n XOR order)-th packed sample. Hence, the least
+ * significant bit of order selects the order of the samples in each byte
+ * (0: least significant nibble first, 1: most significant nibble first), and
+ * the next four bits reverse the bytes of the items of the packed stream
+ * (order = (item_size - 1) << 1 for items of 2, 4, 8 or 16 bytes stored with
+ * the opposite endianness). Bytes of a trailing incomplete item are not
+ * reordered.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_s8i_unpack4bit_8i(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Vector of packed samples, with at least (num_points + 1) / 2 bytes.
+ * \li order: Sample order, as described above. Only its five least significant bits are used.
+ * \li num_points: Number of output samples.
+ *
+ * \b Outputs
+ * \li result: Vector of unpacked samples.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_s8i_unpack4bit_8i_H
+#define INCLUDED_volk_gnsssdr_8u_s8i_unpack4bit_8i_H
+
+#include <inttypes.h>
+#include <string.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(int8_t* result, const uint8_t* packed, const char order, unsigned int first_point, unsigned int num_points)
+{
+    static const int8_t levels[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const unsigned int byte_xor = ((unsigned char)order >> 1) & 15U;
+    const unsigned int num_bytes = (num_points + 1) / 2;
+    const unsigned int shift0 = 4 * (0 ^ nibble_xor);
+    const unsigned int shift1 = 4 * (1 ^ nibble_xor);
+    unsigned int item_size = 1;
+    unsigned int swapped_bytes;
+    unsigned int byte;
+    unsigned int value;
+    unsigned int n;
+
+    while (item_size <= byte_xor)
+        {
+            item_size <<= 1;
+        }
+    swapped_bytes = num_bytes - num_bytes % item_size;
+
+    // first_point is a multiple of 2
+    for (n = first_point; n + 2 <= num_points; n += 2)
+        {
+            byte = n / 2;
+            if (byte < swapped_bytes)
+                {
+                    byte ^= byte_xor;
+                }
+            value = packed[byte];
+            result[n] = levels[(value >> shift0) & 15];
+            result[n + 1] = levels[(value >> shift1) & 15];
+        }
+    for (; n < num_points; n++)
+        {
+            byte = n / 2;
+            if (byte < swapped_bytes)
+                {
+                    byte ^= byte_xor;
+                }
+            result[n] = levels[(packed[byte] >> (4 * ((n % 2) ^ nibble_xor))) & 15];
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_generic(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    static const int8_t levels[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const unsigned int byte_xor = ((unsigned char)order >> 1) & 15U;
+    const unsigned int num_bytes = (num_points + 1) / 2;
+    int8_t table[256][2];
+    unsigned int item_size = 1;
+    unsigned int swapped_bytes;
+    unsigned int byte;
+    unsigned int value;
+    unsigned int k;
+    unsigned int n;
+
+    // Output samples of each possible byte
+    for (value = 0; value < 256; value++)
+        {
+            for (k = 0; k < 2; k++)
+                {
+                    table[value][k] = levels[(value >> (4 * (k ^ nibble_xor))) & 15];
+                }
+        }
+
+    while (item_size <= byte_xor)
+        {
+            item_size <<= 1;
+        }
+    swapped_bytes = num_bytes - num_bytes % item_size;
+
+    for (n = 0; n + 2 <= num_points; n += 2)
+        {
+            byte = n / 2;
+            if (byte < swapped_bytes)
+                {
+                    byte ^= byte_xor;
+                }
+            memcpy(&result[n], table[packed[byte]], sizeof(table[0]));
+        }
+
+    volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(result, packed, order, n, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_u_ssse3(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 32;
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const char byte_xor = (char)(((unsigned char)order >> 1) & 15U);
+    const __m128i levels = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1);
+    const __m128i mask = _mm_set1_epi8(15);
+    const __m128i byte_order = _mm_xor_si128(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(4 * (0 ^ nibble_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(4 * (1 ^ nibble_xor)));
+    const uint8_t* in = packed;
+    int8_t* out = result;
+    __m128i bytes, s0, s1;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), byte_order);
+            s0 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift0), mask));
+            s1 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift1), mask));
+            _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(s0, s1));
+            _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi8(s0, s1));
+            in += 16;
+            out += 32;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(result, packed, order, sse_iters * 32, num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_a_ssse3(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 32;
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const char byte_xor = (char)(((unsigned char)order >> 1) & 15U);
+    const __m128i levels = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1);
+    const __m128i mask = _mm_set1_epi8(15);
+    const __m128i byte_order = _mm_xor_si128(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(4 * (0 ^ nibble_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(4 * (1 ^ nibble_xor)));
+    const uint8_t* in = packed;
+    int8_t* out = result;
+    __m128i bytes, s0, s1;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            bytes = _mm_shuffle_epi8(_mm_load_si128((const __m128i*)in), byte_order);
+            s0 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift0), mask));
+            s1 = _mm_shuffle_epi8(levels, _mm_and_si128(_mm_srl_epi16(bytes, shift1), mask));
+            _mm_store_si128((__m128i*)out, _mm_unpacklo_epi8(s0, s1));
+            _mm_store_si128((__m128i*)(out + 16), _mm_unpackhi_epi8(s0, s1));
+            in += 16;
+            out += 32;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(result, packed, order, sse_iters * 32, num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_u_avx2(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 64;
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const char byte_xor = (char)(((unsigned char)order >> 1) & 15U);
+    const __m256i levels = _mm256_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1,
+        1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1);
+    const __m256i mask = _mm256_set1_epi8(15);
+    // Items are at most 16 bytes long, so the byte reversal does not cross the 128-bit lanes
+    const __m256i byte_order = _mm256_xor_si256(_mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm256_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(4 * (0 ^ nibble_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(4 * (1 ^ nibble_xor)));
+    const uint8_t* in = packed;
+    int8_t* out = result;
+    __m256i bytes, s0, s1, r0, r1;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            bytes = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)in), byte_order);
+            s0 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift0), mask));
+            s1 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift1), mask));
+            r0 = _mm256_unpacklo_epi8(s0, s1);
+            r1 = _mm256_unpackhi_epi8(s0, s1);
+
+            // Unpacking works within lanes, put the samples of the first lane first
+            _mm256_storeu_si256((__m256i*)out, _mm256_permute2x128_si256(r0, r1, 0x20));
+            _mm256_storeu_si256((__m256i*)(out + 32), _mm256_permute2x128_si256(r0, r1, 0x31));
+            in += 32;
+            out += 64;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(result, packed, order, avx2_iters * 64, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_a_avx2(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 64;
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const char byte_xor = (char)(((unsigned char)order >> 1) & 15U);
+    const __m256i levels = _mm256_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1,
+        1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1);
+    const __m256i mask = _mm256_set1_epi8(15);
+    // Items are at most 16 bytes long, so the byte reversal does not cross the 128-bit lanes
+    const __m256i byte_order = _mm256_xor_si256(_mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm256_set1_epi8(byte_xor));
+    const __m128i shift0 = _mm_cvtsi32_si128((int)(4 * (0 ^ nibble_xor)));
+    const __m128i shift1 = _mm_cvtsi32_si128((int)(4 * (1 ^ nibble_xor)));
+    const uint8_t* in = packed;
+    int8_t* out = result;
+    __m256i bytes, s0, s1, r0, r1;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            bytes = _mm256_shuffle_epi8(_mm256_load_si256((const __m256i*)in), byte_order);
+            s0 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift0), mask));
+            s1 = _mm256_shuffle_epi8(levels, _mm256_and_si256(_mm256_srl_epi16(bytes, shift1), mask));
+            r0 = _mm256_unpacklo_epi8(s0, s1);
+            r1 = _mm256_unpackhi_epi8(s0, s1);
+
+            // Unpacking works within lanes, put the samples of the first lane first
+            _mm256_store_si256((__m256i*)out, _mm256_permute2x128_si256(r0, r1, 0x20));
+            _mm256_store_si256((__m256i*)(out + 32), _mm256_permute2x128_si256(r0, r1, 0x31));
+            in += 32;
+            out += 64;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(result, packed, order, avx2_iters * 64, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_s8i_unpack4bit_8i_neon(int8_t* result, const uint8_t* packed, const char order, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 32;
+    const unsigned int nibble_xor = (unsigned char)order & 1U;
+    const uint8_t byte_xor = ((unsigned char)order >> 1) & 15U;
+    const int8_t levels_array[16] = {1, 3, 5, 7, 9, 11, 13, 15, -15, -13, -11, -9, -7, -5, -3, -1};
+    const uint8_t indexes[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const uint8x16_t mask = vdupq_n_u8(15);
+    const uint8x16_t byte_order = veorq_u8(vld1q_u8(indexes), vdupq_n_u8(byte_xor));
+    // Shifting by a negative amount shifts to the right
+    const int8x16_t shift0 = vdupq_n_s8((int8_t)(-4 * (int)(0 ^ nibble_xor)));
+    const int8x16_t shift1 = vdupq_n_s8((int8_t)(-4 * (int)(1 ^ nibble_xor)));
+    const uint8_t* in = packed;
+    int8_t* out = result;
+    uint8x16_t bytes, fields;
+    uint8x8x2_t table;
+    int8x8x2_t levels;
+    int8x16x2_t samples;
+    unsigned int i;
+
+    levels.val[0] = vld1_s8(levels_array);
+    levels.val[1] = vld1_s8(levels_array + 8);
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            bytes = vld1q_u8(in);
+            table.val[0] = vget_low_u8(bytes);
+            table.val[1] = vget_high_u8(bytes);
+            bytes = vcombine_u8(vtbl2_u8(table, vget_low_u8(byte_order)), vtbl2_u8(table, vget_high_u8(byte_order)));
+
+            fields = vandq_u8(vshlq_u8(bytes, shift0), mask);
+            samples.val[0] = vcombine_s8(vtbl2_s8(levels, vreinterpret_s8_u8(vget_low_u8(fields))), vtbl2_s8(levels, vreinterpret_s8_u8(vget_high_u8(fields))));
+            fields = vandq_u8(vshlq_u8(bytes, shift1), mask);
+            samples.val[1] = vcombine_s8(vtbl2_s8(levels, vreinterpret_s8_u8(vget_low_u8(fields))), vtbl2_s8(levels, vreinterpret_s8_u8(vget_high_u8(fields))));
+
+            vst2q_s8(out, samples);
+            in += 16;
+            out += 32;
+        }
+
+    volk_gnsssdr_8u_s8i_unpack4bit_8i_scalar(result, packed, order, neon_iters * 32, num_points);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_s8i_unpack4bit_8i_H */
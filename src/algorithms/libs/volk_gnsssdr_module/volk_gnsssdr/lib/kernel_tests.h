@@ -63,6 +63,10 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_multiply_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_s8ic_multiply_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8u_x2_multiply_8u, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8u_s8i_unpack2bit_8i, test_params))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8u_s8i_unpack2bit_16i, test_params))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8u_s8i_unpack4bit_8i, test_params))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_32u_s32f_unpack1bit_32fc, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_64f_accumulator_64f, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_sincos_32fc, test_params_inacc))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_index_max_32u, test_params))
@@ -87,6 +91,7 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_x2_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn, test_params_inacc))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn, test_params_inacc));
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_high_dynamic_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_viterbik7r2puppet_64u, volk_gnsssdr_32f_viterbi_k7r2_64u, test_params))
 
     return test_cases;
 }
@@ -16,9 +16,8 @@
  */
 
 #include "hybrid_observables_gs.h"
-#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
-#include "gnss_circular_deque.h"
-#include "gnss_frequencies.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include "gnss_block_profiler.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
@@ -26,13 +25,12 @@
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
-#include <algorithm>  // for std::min
+#include <algorithm>  // for std::min, std::max
 #include <array>
 #include <cmath>      // for round
 #include <cstdlib>    // for size_t, llabs
 #include <exception>  // for exception
 #include <iostream>   // for cerr, cout
-#include <limits>     // for numeric_limits
 #include <utility>    // for move
 
 #if PMT_USES_BOOST_ANY
@@ -60,6 +58,8 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
           gr::io_signature::make(conf_.nchannels_in, conf_.nchannels_in, sizeof(Gnss_Synchro)),
           gr::io_signature::make(conf_.nchannels_out, conf_.nchannels_out, sizeof(Gnss_Synchro))),
       d_conf(conf_),
+      d_epoch_data(conf_.nchannels_out),
+      d_epoch(conf_.nchannels_out),
       d_dump_filename(conf_.dump_filename),
       d_smooth_filter_M(static_cast<double>(conf_.smoothing_factor)),
       d_T_rx_step_s(static_cast<double>(conf_.observable_interval_ms) / 1000.0),
@@ -74,6 +74,7 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
       d_dump(conf_.dump),
       d_dump_mat(conf_.dump_mat && d_dump)
 {
+    d_profiler_stats = Gnss_Block_Profiler::instance().register_block(this->name(), static_cast<uint32_t>(this->unique_id()));
     // PVT input message port
     this->message_port_register_in(pmt::mp("pvt_to_observables"));
     this->set_msg_handler(pmt::mp("pvt_to_observables"),
@@ -90,29 +91,12 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
     // Send Channel status to gnss_flowgraph
     this->message_port_register_out(pmt::mp("status"));
 
-    d_gnss_synchro_history = std::make_unique<Gnss_circular_deque<Gnss_Synchro>>(1000, d_nchannels_out);
+    d_gnss_synchro_history = std::make_unique<Obs_History>(1000, d_nchannels_out);
+    d_history_cursor = std::vector<uint32_t>(d_nchannels_out, 0U);
 
     d_Rx_clock_buffer.set_capacity(std::min(std::max(200U / d_T_rx_step_ms, 3U), 10U));
     d_Rx_clock_buffer.clear();
 
-    d_channel_last_pll_lock = std::vector<bool>(d_nchannels_out, false);
-    d_channel_last_pseudorange_smooth = std::vector<double>(d_nchannels_out, 0.0);
-    d_channel_last_carrier_phase_rads = std::vector<double>(d_nchannels_out, 0.0);
-
-    d_mapStringValues["1C"] = evGPS_1C;
-    d_mapStringValues["2S"] = evGPS_2S;
-    d_mapStringValues["L5"] = evGPS_L5;
-    d_mapStringValues["1B"] = evGAL_1B;
-    d_mapStringValues["5X"] = evGAL_5X;
-    d_mapStringValues["E6"] = evGAL_E6;
-    d_mapStringValues["7X"] = evGAL_7X;
-    d_mapStringValues["1G"] = evGLO_1G;
-    d_mapStringValues["2G"] = evGLO_2G;
-    d_mapStringValues["B1"] = evBDS_B1;
-    d_mapStringValues["B2"] = evBDS_B2;
-    d_mapStringValues["B3"] = evBDS_B3;
-
-
     d_SourceTagTimestamps = std::vector<std::queue<GnssTime>>(d_nchannels_out);
 
     set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
@@ -222,6 +206,7 @@ void hybrid_observables_gs::msg_handler_pvt_to_observables(const pmt::pmt_t &msg
                     for (uint32_t n = 0; n < d_nchannels_out; n++)
                         {
                             d_gnss_synchro_history->clear(n);
+                            d_history_cursor[n] = 0U;
                         }
 
                     LOG(INFO) << "Corrected new RX Time offset: " << static_cast<int>(round(new_rx_clock_offset_s * 1000.0)) << "[ms]";
@@ -377,26 +362,101 @@ double hybrid_observables_gs::compute_T_rx_s(const Gnss_Synchro &a) const
 }
 
 
-bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock) const
+int32_t hybrid_observables_gs::find_nearest_trk_obs(uint32_t ch, uint64_t rx_clock)
 {
-    int32_t nearest_element = -1;
-    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
+    // The history of each channel is sorted by Tracking_sample_counter, and
+    // rx_clock advances by one observable interval between calls, so the
+    // search starts from the element found in the previous call and gallops
+    // away from it. The cost is logarithmic in the distance to that element,
+    // which is constant in steady state.
+    const auto size = static_cast<int64_t>(d_gnss_synchro_history->size(ch));
+    if (size == 0)
+        {
+            return -1;
+        }
+    const auto sample_counter = [this, ch](int64_t i) {
+        return d_gnss_synchro_history->sample_counter(ch, static_cast<uint32_t>(i));
+    };
+
+    // Find the last element not after rx_clock (lower) and the first one
+    // after it (upper). lower = -1 and upper = size stand for none.
+    int64_t lower;
+    int64_t upper;
+    int64_t step = 1;
+    const int64_t cursor = std::min(static_cast<int64_t>(d_history_cursor[ch]), size - 1);
+    if (sample_counter(cursor) <= rx_clock)
+        {
+            lower = cursor;
+            upper = cursor + 1;
+            while (upper < size and sample_counter(upper) <= rx_clock)
+                {
+                    lower = upper;
+                    step *= 2;
+                    upper = lower + step;
+                }
+            upper = std::min(upper, size);
+        }
+    else
+        {
+            upper = cursor;
+            lower = cursor - 1;
+            while (lower >= 0 and sample_counter(lower) > rx_clock)
+                {
+                    upper = lower;
+                    step *= 2;
+                    lower = upper - step;
+                }
+            lower = std::max(lower, static_cast<int64_t>(-1));
+        }
+    while (upper - lower > 1)
         {
-            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
+            const int64_t middle = lower + (upper - lower) / 2;
+            if (sample_counter(middle) <= rx_clock)
+                {
+                    lower = middle;
+                }
+            else
                 {
-                    old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
+                    upper = middle;
                 }
         }
 
-    if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
+    int64_t nearest_element;
+    if (lower < 0)
         {
+            nearest_element = upper;
+        }
+    else
+        {
+            // In case of repeated sample counters, keep the oldest one
+            while (lower > 0 and sample_counter(lower - 1) == sample_counter(lower))
+                {
+                    lower--;
+                }
+            if (upper == size or (rx_clock - sample_counter(lower)) <= (sample_counter(upper) - rx_clock))
+                {
+                    nearest_element = lower;
+                }
+            else
+                {
+                    nearest_element = upper;
+                }
+        }
+    d_history_cursor[ch] = static_cast<uint32_t>(nearest_element);
+    return static_cast<int32_t>(nearest_element);
+}
+
+
+bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock)
+{
+    const int32_t nearest_element = find_nearest_trk_obs(ch, rx_clock);
+    if (nearest_element != -1)
+        {
+            const int64_t old_abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->sample_counter(ch, nearest_element)));
             if ((static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs)) < d_T_rx_step_s)
                 {
                     int32_t neighbor_element;
-                    if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
+                    if (rx_clock > d_gnss_synchro_history->sample_counter(ch, nearest_element))
                         {
                             neighbor_element = nearest_element + 1;
                         }
@@ -408,17 +468,17 @@ bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint3
                         {
                             int32_t t1_idx;
                             int32_t t2_idx;
-                            if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
+                            if (rx_clock > d_gnss_synchro_history->sample_counter(ch, nearest_element))
                                 {
-                                    // std::cout << "S1= " << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter << '\n';
+                                    // std::cout << "S1= " << d_gnss_synchro_history->sample_counter(ch, nearest_element)
+                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->sample_counter(ch, neighbor_element) << '\n';
                                     t1_idx = nearest_element;
                                     t2_idx = neighbor_element;
                                 }
                             else
                                 {
-                                    // std::cout << "inv S1= " << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter << '\n';
+                                    // std::cout << "inv S1= " << d_gnss_synchro_history->sample_counter(ch, neighbor_element)
+                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->sample_counter(ch, nearest_element) << '\n';
                                     t1_idx = neighbor_element;
                                     t2_idx = nearest_element;
                                 }
@@ -429,34 +489,34 @@ bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint3
                             // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
                             const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
 
-                            const double time_factor = (T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time) /
-                                                       (d_gnss_synchro_history->get(ch, t2_idx).RX_time -
-                                                           d_gnss_synchro_history->get(ch, t1_idx).RX_time);
+                            const double time_factor = (T_rx_s - d_gnss_synchro_history->rx_time(ch, t1_idx)) /
+                                                       (d_gnss_synchro_history->rx_time(ch, t2_idx) -
+                                                           d_gnss_synchro_history->rx_time(ch, t1_idx));
 
                             // CARRIER PHASE INTERPOLATION
-                            interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_phase_rads - d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads) * time_factor;
+                            interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->carrier_phase_rads(ch, t1_idx) + (d_gnss_synchro_history->carrier_phase_rads(ch, t2_idx) - d_gnss_synchro_history->carrier_phase_rads(ch, t1_idx)) * time_factor;
                             // CARRIER DOPPLER INTERPOLATION
-                            interpolated_obs.Carrier_Doppler_hz = d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_Doppler_hz - d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz) * time_factor;
+                            interpolated_obs.Carrier_Doppler_hz = d_gnss_synchro_history->carrier_doppler_hz(ch, t1_idx) + (d_gnss_synchro_history->carrier_doppler_hz(ch, t2_idx) - d_gnss_synchro_history->carrier_doppler_hz(ch, t1_idx)) * time_factor;
                             // TOW INTERPOLATION
                             // check TOW rollover
-                            if ((d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms - d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) > 0)
+                            if ((d_gnss_synchro_history->tow_ms(ch, t2_idx) - d_gnss_synchro_history->tow_ms(ch, t1_idx)) > 0)
                                 {
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
+                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->tow_ms(ch, t1_idx)) + (static_cast<double>(d_gnss_synchro_history->tow_ms(ch, t2_idx)) - static_cast<double>(d_gnss_synchro_history->tow_ms(ch, t1_idx))) * time_factor;
                                 }
                             else
                                 {
                                     // TOW rollover situation
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms + 604800000) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
+                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->tow_ms(ch, t1_idx)) + (static_cast<double>(d_gnss_synchro_history->tow_ms(ch, t2_idx) + 604800000) - static_cast<double>(d_gnss_synchro_history->tow_ms(ch, t1_idx))) * time_factor;
                                 }
 
                             // LOG(INFO) << "Channel " << ch << " int idx: " << t1_idx << " TOW Int: " << interpolated_obs.interp_TOW_ms
-                            //           << " TOW p1 : " << d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms
+                            //           << " TOW p1 : " << d_gnss_synchro_history->tow_ms(ch, t1_idx)
                             //           << " TOW p2: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms
+                            //           << d_gnss_synchro_history->tow_ms(ch, t2_idx)
                             //           << " t2-t1: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).RX_time - d_gnss_synchro_history->get(ch, t1_idx).RX_time
+                            //           << d_gnss_synchro_history->rx_time(ch, t2_idx) - d_gnss_synchro_history->rx_time(ch, t1_idx)
                             //           << " trx - t1: "
-                            //           << T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time;
+                            //           << T_rx_s - d_gnss_synchro_history->rx_time(ch, t1_idx);
                             // std::cout << "Rx samplestamp: " << T_rx_s << " Channel " << ch << " interp buff idx " << nearest_element
                             //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
                             return true;
@@ -482,29 +542,16 @@ void hybrid_observables_gs::forecast(int noutput_items __attribute__((unused)),
 }
 
 
-void hybrid_observables_gs::update_TOW(const std::vector<Gnss_Synchro> &data)
+void hybrid_observables_gs::update_TOW()
 {
     // 1. Set the TOW using the minimum TOW in the observables.
     //    this will be the receiver time.
     // 2. If the TOW is set, it must be incremented by the desired receiver time step.
     //    the time step must match the observables timer block (connected to the las input channel)
-    std::vector<Gnss_Synchro>::const_iterator it;
     if (!d_T_rx_TOW_set)
         {
-            // int32_t TOW_ref = std::numeric_limits<uint32_t>::max();
-            uint32_t TOW_ref = 0U;
-            for (it = data.cbegin(); it != data.cend(); it++)
-                {
-                    if (it->Flag_valid_word)
-                        {
-                            if (it->TOW_at_current_symbol_ms > TOW_ref)
-                                {
-                                    TOW_ref = it->TOW_at_current_symbol_ms;
-                                    d_T_rx_TOW_set = true;
-                                }
-                        }
-                }
-            d_T_rx_TOW_ms = TOW_ref;
+            d_T_rx_TOW_ms = d_epoch.max_valid_tow_ms();
+            d_T_rx_TOW_set = d_T_rx_TOW_ms > 0U;
             // align the receiver clock to integer multiple of d_T_rx_step_ms
             if (d_T_rx_TOW_ms % d_T_rx_step_ms)
                 {
@@ -523,107 +570,6 @@ void hybrid_observables_gs::update_TOW(const std::vector<Gnss_Synchro> &data)
 }
 
 
-void hybrid_observables_gs::compute_pranges(std::vector<Gnss_Synchro> &data) const
-{
-    // std::cout.precision(17);
-    // std::cout << " d_T_rx_TOW_ms: " << static_cast<double>(d_T_rx_TOW_ms) << '\n';
-    std::vector<Gnss_Synchro>::iterator it;
-    const auto current_T_rx_TOW_ms = static_cast<double>(d_T_rx_TOW_ms);
-    const double current_T_rx_TOW_s = current_T_rx_TOW_ms / 1000.0;
-    for (it = data.begin(); it != data.end(); it++)
-        {
-            if (it->Flag_valid_word)
-                {
-                    double traveltime_ms = current_T_rx_TOW_ms - it->interp_TOW_ms;
-                    if (fabs(traveltime_ms) > 302400)  // check TOW roll over
-                        {
-                            traveltime_ms = 604800000.0 + current_T_rx_TOW_ms - it->interp_TOW_ms;
-                        }
-                    it->RX_time = current_T_rx_TOW_s;
-                    it->Pseudorange_m = traveltime_ms * SPEED_OF_LIGHT_M_MS;
-                    it->Flag_valid_pseudorange = true;
-                    // debug code
-                    // std::cout << "[" << it->Channel_ID << "] interp_TOW_ms: " << it->interp_TOW_ms << '\n';
-                    // std::cout << "[" << it->Channel_ID << "] Diff d_T_rx_TOW_ms - interp_TOW_ms: " << static_cast<double>(d_T_rx_TOW_ms) - it->interp_TOW_ms << '\n';
-                }
-            else
-                {
-                    it->RX_time = current_T_rx_TOW_s;
-                }
-        }
-}
-
-
-void hybrid_observables_gs::smooth_pseudoranges(std::vector<Gnss_Synchro> &data)
-{
-    std::vector<Gnss_Synchro>::iterator it;
-    for (it = data.begin(); it != data.end(); it++)
-        {
-            if (it->Flag_valid_pseudorange)
-                {
-                    // 0. get wavelength for the current signal
-                    double wavelength_m = 0;
-                    switch (d_mapStringValues[it->Signal])
-                        {
-                        case evGPS_1C:
-                        case evSBAS_1C:
-                        case evGAL_1B:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1;
-                            break;
-                        case evGPS_L5:
-                        case evGAL_5X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ5;
-                            break;
-                        case evGAL_E6:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ6;
-                            break;
-                        case evGAL_7X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ7;
-                            break;
-                        case evGPS_2S:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2;
-                            break;
-                        case evBDS_B3:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ3_BDS;
-                            break;
-                        case evGLO_1G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_GLO;
-                            break;
-                        case evGLO_2G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_GLO;
-                            break;
-                        case evBDS_B1:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_BDS;
-                            break;
-                        case evBDS_B2:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_BDS;
-                            break;
-                        default:
-                            break;
-                        }
-
-                    // todo: propagate the PLL lock status in Gnss_Synchro
-                    // 1. check if last PLL lock status was false and initialize last d_channel_last_pseudorange_smooth
-                    if (d_channel_last_pll_lock[it->Channel_ID] == true)
-                        {
-                            // 2. Compute the smoothed pseudorange for this channel
-                            // Hatch filter algorithm (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
-                            const double r_sm = d_channel_last_pseudorange_smooth[it->Channel_ID];
-                            const double factor = ((d_smooth_filter_M - 1.0) / d_smooth_filter_M);
-                            it->Pseudorange_m = factor * r_sm + (1.0 / d_smooth_filter_M) * it->Pseudorange_m + wavelength_m * (factor / TWO_PI) * (it->Carrier_phase_rads - d_channel_last_carrier_phase_rads[it->Channel_ID]);
-                        }
-                    d_channel_last_pseudorange_smooth[it->Channel_ID] = it->Pseudorange_m;
-                    d_channel_last_carrier_phase_rads[it->Channel_ID] = it->Carrier_phase_rads;
-                    d_channel_last_pll_lock[it->Channel_ID] = it->Flag_valid_pseudorange;
-                }
-            else
-                {
-                    d_channel_last_pll_lock[it->Channel_ID] = false;
-                }
-        }
-}
-
-
 void hybrid_observables_gs::set_tag_timestamp_in_sdr_timeframe(const std::vector<Gnss_Synchro> &data, uint64_t rx_clock)
 {
     // it transforms the HW sample tag timestamp from a relative samplestamp (from receiver start)
@@ -677,6 +623,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
+    const Gnss_Block_Timer profiler_timer(d_profiler_stats.get(), this->nitems_read(d_nchannels_in - 1), ninput_items[d_nchannels_in - 1]);
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
 
@@ -750,14 +697,20 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                             if (d_gnss_synchro_history->size(n) > 0)
                                 {
                                     // Check if the last Gnss_Synchro comes from the same satellite as the previous ones
-                                    if (d_gnss_synchro_history->front(n).PRN != in[n][m].PRN)
+                                    if (d_gnss_synchro_history->prn(n) != in[n][m].PRN)
                                         {
                                             d_gnss_synchro_history->clear(n);
-                                            // LOG(INFO) << "Channel " << d_gnss_synchro_history->front(n).Channel_ID << " changed satellite to PRN " << in[n][m].PRN;
+                                            d_history_cursor[n] = 0U;
+                                            // LOG(INFO) << "Channel " << n << " changed satellite to PRN " << in[n][m].PRN;
                                         }
                                 }
-                            d_gnss_synchro_history->push_back(n, in[n][m]);
-                            d_gnss_synchro_history->back(n).RX_time = compute_T_rx_s(in[n][m]);
+                            const uint32_t history_size = d_gnss_synchro_history->size(n);
+                            d_gnss_synchro_history->push_back(n, in[n][m], compute_T_rx_s(in[n][m]));
+                            if (d_gnss_synchro_history->size(n) == history_size and d_history_cursor[n] > 0)
+                                {
+                                    // The oldest observable was overwritten, the cursor moves with the rest
+                                    d_history_cursor[n]--;
+                                }
                         }
                 }
             consume(n, ninput_items[n]);
@@ -765,11 +718,10 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
 
     if (d_Rx_clock_buffer.size() == d_Rx_clock_buffer.capacity())
         {
-            std::vector<Gnss_Synchro> epoch_data(d_nchannels_out);
             int32_t n_valid = 0;
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
-                    Gnss_Synchro interpolated_gnss_synchro{};
+                    Gnss_Synchro &interpolated_gnss_synchro = d_epoch_data[n];
                     if (!interp_trk_obs(interpolated_gnss_synchro, n, d_Rx_clock_buffer.front()))
                         {
                             // Produce an empty observation
@@ -784,37 +736,42 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                         {
                             n_valid++;
                         }
-                    epoch_data[n] = interpolated_gnss_synchro;
                 }
+            d_epoch.load(d_epoch_data);
 
             if (d_T_rx_TOW_set)
                 {
-                    update_TOW(epoch_data);
+                    update_TOW();
                 }
             else
                 {
                     if (n_valid > 0)
                         {
-                            update_TOW(epoch_data);
+                            update_TOW();
                         }
                 }
 
             if (n_valid > 0)
                 {
-                    compute_pranges(epoch_data);
-                    set_tag_timestamp_in_sdr_timeframe(epoch_data, d_Rx_clock_buffer.front());
+                    d_epoch.compute_pranges(d_T_rx_TOW_ms);
                 }
 
             // Carrier smoothing (optional)
             if (d_conf.enable_carrier_smoothing == true)
                 {
-                    smooth_pseudoranges(epoch_data);
+                    d_epoch.smooth_pseudoranges(d_smooth_filter_M);
+                }
+            d_epoch.store(d_epoch_data);
+
+            if (n_valid > 0)
+                {
+                    set_tag_timestamp_in_sdr_timeframe(d_epoch_data, d_Rx_clock_buffer.front());
                 }
 
             // output the observables set to the PVT block
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
-                    out[n][0] = epoch_data[n];
+                    out[n][0] = d_epoch_data[n];
                 }
             // report channel status every second
             d_T_status_report_timer_ms += d_T_rx_step_ms;
@@ -822,7 +779,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                 {
                     for (uint32_t n = 0; n < d_nchannels_out; n++)
                         {
-                            const std::shared_ptr<Gnss_Synchro> gnss_synchro_sptr = std::make_shared<Gnss_Synchro>(epoch_data[n]);
+                            const std::shared_ptr<Gnss_Synchro> gnss_synchro_sptr = std::make_shared<Gnss_Synchro>(d_epoch_data[n]);
                             // publish valid gnss_synchro to the gnss_flowgraph channel status monitor
                             this->message_port_pub(pmt::mp("status"), pmt::make_any(gnss_synchro_sptr));
                         }
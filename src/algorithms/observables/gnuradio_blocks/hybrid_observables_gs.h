@@ -23,13 +23,14 @@
 #include "gnss_block_interface.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
 #include "obs_conf.h"
+#include "obs_epoch.h"
+#include "obs_history.h"
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
 #include <gnuradio/block.h>           // for block
 #include <gnuradio/types.h>           // for gr_vector_int
 #include <cstddef>                    // for size_t
 #include <cstdint>                    // for int32_t
 #include <fstream>                    // for std::ofstream
-#include <map>                        // for std::map
 #include <memory>                     // for std::shared, std:unique_ptr
 #include <queue>
 #include <string>    // for std::string
@@ -43,12 +44,10 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Gnss_Synchro;
 class hybrid_observables_gs;
 
-template <class T>
-class Gnss_circular_deque;
-
 using hybrid_observables_gs_sptr = gnss_shared_ptr<hybrid_observables_gs>;
 
 hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf& conf_);
@@ -73,44 +72,26 @@ private:
 
     void msg_handler_pvt_to_observables(const pmt::pmt_t& msg);
     double compute_T_rx_s(const Gnss_Synchro& a) const;
-    bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock) const;
-    void update_TOW(const std::vector<Gnss_Synchro>& data);
-    void compute_pranges(std::vector<Gnss_Synchro>& data) const;
-    void smooth_pseudoranges(std::vector<Gnss_Synchro>& data);
+    int32_t find_nearest_trk_obs(uint32_t ch, uint64_t rx_clock);
+    bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock);
+    void update_TOW();
 
     void set_tag_timestamp_in_sdr_timeframe(const std::vector<Gnss_Synchro>& data, uint64_t rx_clock);
     int32_t save_matfile() const;
 
     Obs_Conf d_conf;
 
-    enum StringValue_
-    {
-        evGPS_1C,
-        evGPS_2S,
-        evGPS_L5,
-        evSBAS_1C,
-        evGAL_1B,
-        evGAL_5X,
-        evGAL_E6,
-        evGAL_7X,
-        evGLO_1G,
-        evGLO_2G,
-        evBDS_B1,
-        evBDS_B2,
-        evBDS_B3
-    };
-    std::map<std::string, StringValue_> d_mapStringValues;
-
-    std::unique_ptr<Gnss_circular_deque<Gnss_Synchro>> d_gnss_synchro_history;  // Tracking observable history
+    std::unique_ptr<Obs_History> d_gnss_synchro_history;  // Tracking observable history
+    std::vector<uint32_t> d_history_cursor;                // Per channel, index of the last interpolated observable
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     boost::circular_buffer<uint64_t> d_Rx_clock_buffer;  // time history
 
     std::vector<std::queue<GnssTime>> d_SourceTagTimestamps;
     std::queue<GnssTime> d_TimeChannelTagTimestamps;
 
-    std::vector<bool> d_channel_last_pll_lock;
-    std::vector<double> d_channel_last_pseudorange_smooth;
-    std::vector<double> d_channel_last_carrier_phase_rads;
+    std::vector<Gnss_Synchro> d_epoch_data;  // Interpolated observables of the current output epoch
+    Obs_Epoch d_epoch;                       // Cross-channel computations on d_epoch_data
 
     std::string d_dump_filename;
 
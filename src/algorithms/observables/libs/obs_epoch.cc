@@ -0,0 +1,183 @@
+/*!
+ * \file obs_epoch.cc
+ * \brief Structure-of-arrays view of the observables of all the channels at
+ * one output epoch, and the cross-channel computations done on it.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_epoch.h"
+#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, SPEED_OF_LIGHT_M_MS, TWO_PI
+#include "gnss_frequencies.h"
+#include <algorithm>  // for std::copy, std::max
+#include <cmath>      // for std::fabs
+
+
+Obs_Epoch::Obs_Epoch(uint32_t nchann)
+    : d_rx_time(nchann, 0.0),
+      d_interp_tow_ms(nchann, 0.0),
+      d_carrier_phase_rads(nchann, 0.0),
+      d_pseudorange_m(nchann, 0.0),
+      d_candidate_m(nchann, 0.0),
+      d_wavelength_m(nchann, carrier_wavelength_m("")),
+      d_tow_ms(nchann, 0U),
+      d_signal(nchann, 0U),
+      d_valid_word(nchann, 0U),
+      d_valid_pseudorange(nchann, 0U),
+      d_last_pseudorange_smooth(nchann, 0.0),
+      d_last_carrier_phase_rads(nchann, 0.0),
+      d_last_pll_lock(nchann, 0U),
+      d_nchannels(nchann)
+{
+}
+
+
+void Obs_Epoch::load(const std::vector<Gnss_Synchro>& data)
+{
+    for (uint32_t ch = 0; ch < d_nchannels; ch++)
+        {
+            const Gnss_Synchro& obs = data[ch];
+            d_rx_time[ch] = obs.RX_time;
+            d_interp_tow_ms[ch] = obs.interp_TOW_ms;
+            d_carrier_phase_rads[ch] = obs.Carrier_phase_rads;
+            d_pseudorange_m[ch] = obs.Pseudorange_m;
+            d_tow_ms[ch] = obs.TOW_at_current_symbol_ms;
+            d_valid_word[ch] = obs.Flag_valid_word;
+            d_valid_pseudorange[ch] = obs.Flag_valid_pseudorange;
+            const auto signal = static_cast<uint16_t>(static_cast<uint8_t>(obs.Signal[0]) | (static_cast<uint8_t>(obs.Signal[1]) << 8));
+            if (signal != d_signal[ch])
+                {
+                    d_signal[ch] = signal;
+                    d_wavelength_m[ch] = carrier_wavelength_m(obs.Signal);
+                }
+        }
+}
+
+
+void Obs_Epoch::store(std::vector<Gnss_Synchro>& data) const
+{
+    for (uint32_t ch = 0; ch < d_nchannels; ch++)
+        {
+            Gnss_Synchro& obs = data[ch];
+            obs.RX_time = d_rx_time[ch];
+            obs.Pseudorange_m = d_pseudorange_m[ch];
+            obs.Flag_valid_pseudorange = d_valid_pseudorange[ch];
+        }
+}
+
+
+uint32_t Obs_Epoch::max_valid_tow_ms() const
+{
+    uint32_t TOW_ref = 0U;
+    for (uint32_t ch = 0; ch < d_nchannels; ch++)
+        {
+            TOW_ref = std::max(TOW_ref, d_tow_ms[ch] * d_valid_word[ch]);
+        }
+    return TOW_ref;
+}
+
+
+void Obs_Epoch::compute_pranges(uint32_t T_rx_TOW_ms)
+{
+    // The candidate values are computed for all the channels, and then selected
+    // in a separate loop, so that both loops can be vectorized.
+    const auto current_T_rx_TOW_ms = static_cast<double>(T_rx_TOW_ms);
+    const double current_T_rx_TOW_s = current_T_rx_TOW_ms / 1000.0;
+    for (uint32_t ch = 0; ch < d_nchannels; ch++)
+        {
+            // check TOW roll over
+            const double rollover_ms = std::fabs(current_T_rx_TOW_ms - d_interp_tow_ms[ch]) > 302400 ? 604800000.0 : 0.0;
+            d_candidate_m[ch] = (rollover_ms + current_T_rx_TOW_ms - d_interp_tow_ms[ch]) * SPEED_OF_LIGHT_M_MS;
+            d_rx_time[ch] = current_T_rx_TOW_s;
+        }
+    // Byte stores may alias any member, so the loops work on local copies
+    const uint32_t nchannels = d_nchannels;
+    const uint8_t* valid_word = d_valid_word.data();
+    uint8_t* valid_pseudorange = d_valid_pseudorange.data();
+    const double* candidate = d_candidate_m.data();
+    double* pseudorange_m = d_pseudorange_m.data();
+    for (uint32_t ch = 0; ch < nchannels; ch++)
+        {
+            const double candidate_m = candidate[ch];
+            const double last_pseudorange_m = pseudorange_m[ch];
+            pseudorange_m[ch] = valid_word[ch] ? candidate_m : last_pseudorange_m;
+        }
+    for (uint32_t ch = 0; ch < nchannels; ch++)
+        {
+            valid_pseudorange[ch] |= valid_word[ch];
+        }
+}
+
+
+void Obs_Epoch::smooth_pseudoranges(double smooth_filter_M)
+{
+    // Hatch filter algorithm (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
+    // The filter of a channel is restarted after an epoch without a valid pseudorange.
+    const double factor = ((smooth_filter_M - 1.0) / smooth_filter_M);
+    for (uint32_t ch = 0; ch < d_nchannels; ch++)
+        {
+            d_candidate_m[ch] = factor * d_last_pseudorange_smooth[ch] + (1.0 / smooth_filter_M) * d_pseudorange_m[ch] + d_wavelength_m[ch] * (factor / TWO_PI) * (d_carrier_phase_rads[ch] - d_last_carrier_phase_rads[ch]);
+        }
+    const uint32_t nchannels = d_nchannels;
+    const uint8_t* valid_pseudorange = d_valid_pseudorange.data();
+    const double* candidate = d_candidate_m.data();
+    const double* carrier_phase_rads = d_carrier_phase_rads.data();
+    double* pseudorange_m = d_pseudorange_m.data();
+    double* last_pseudorange_smooth = d_last_pseudorange_smooth.data();
+    double* last_carrier_phase_rads = d_last_carrier_phase_rads.data();
+    uint8_t* last_pll_lock = d_last_pll_lock.data();
+    for (uint32_t ch = 0; ch < nchannels; ch++)
+        {
+            const double smoothed_m = candidate[ch];
+            const double raw_m = pseudorange_m[ch];
+            pseudorange_m[ch] = (valid_pseudorange[ch] & last_pll_lock[ch]) ? smoothed_m : raw_m;
+        }
+    for (uint32_t ch = 0; ch < nchannels; ch++)
+        {
+            const double filtered_m = pseudorange_m[ch];
+            const double last_smooth_m = last_pseudorange_smooth[ch];
+            const double phase_rads = carrier_phase_rads[ch];
+            const double last_phase_rads = last_carrier_phase_rads[ch];
+            last_pseudorange_smooth[ch] = valid_pseudorange[ch] ? filtered_m : last_smooth_m;
+            last_carrier_phase_rads[ch] = valid_pseudorange[ch] ? phase_rads : last_phase_rads;
+        }
+    std::copy(valid_pseudorange, valid_pseudorange + nchannels, last_pll_lock);
+}
+
+
+double Obs_Epoch::carrier_wavelength_m(const char* signal)
+{
+    switch (signal[0] == '\0' ? 0 : (signal[0] << 8) | signal[1])
+        {
+        case ('L' << 8) | '5':  // GPS L5
+        case ('5' << 8) | 'X':  // Galileo E5a
+            return SPEED_OF_LIGHT_M_S / FREQ5;
+        case ('E' << 8) | '6':  // Galileo E6
+            return SPEED_OF_LIGHT_M_S / FREQ6;
+        case ('7' << 8) | 'X':  // Galileo E5b
+            return SPEED_OF_LIGHT_M_S / FREQ7;
+        case ('2' << 8) | 'S':  // GPS L2C
+            return SPEED_OF_LIGHT_M_S / FREQ2;
+        case ('B' << 8) | '3':  // BeiDou B3I
+            return SPEED_OF_LIGHT_M_S / FREQ3_BDS;
+        case ('1' << 8) | 'G':  // GLONASS L1 C/A
+            return SPEED_OF_LIGHT_M_S / FREQ1_GLO;
+        case ('2' << 8) | 'G':  // GLONASS L2 C/A
+            return SPEED_OF_LIGHT_M_S / FREQ2_GLO;
+        case ('B' << 8) | '1':  // BeiDou B1I
+            return SPEED_OF_LIGHT_M_S / FREQ1_BDS;
+        case ('B' << 8) | '2':  // BeiDou B2I
+            return SPEED_OF_LIGHT_M_S / FREQ2_BDS;
+        default:  // GPS L1 C/A, SBAS L1 and Galileo E1
+            return SPEED_OF_LIGHT_M_S / FREQ1;
+        }
+}
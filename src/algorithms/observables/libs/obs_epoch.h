@@ -0,0 +1,99 @@
+/*!
+ * \file obs_epoch.h
+ * \brief Structure-of-arrays view of the observables of all the channels at
+ * one output epoch, and the cross-channel computations done on it.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_EPOCH_H
+#define GNSS_SDR_OBS_EPOCH_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Observables of all the channels at one output epoch.
+ *
+ * The fields used to compute the receiver time, the pseudoranges and the
+ * carrier smoothing are gathered from the interpolated Gnss_Synchro objects
+ * into one contiguous array per field. The computations are then done for
+ * all the channels at once, in loops without data-dependent branches that
+ * the compiler can vectorize, and the results are scattered back.
+ *
+ * The carrier wavelength of each channel is only looked up when its signal
+ * changes, and the Hatch filter state of each channel is kept between epochs.
+ * No memory is allocated after construction.
+ */
+class Obs_Epoch
+{
+public:
+    explicit Obs_Epoch(uint32_t nchann);  //!< nchann = number of channels
+
+    void load(const std::vector<Gnss_Synchro>& data);   //!< Gathers the fields of the interpolated observables of all the channels
+    void store(std::vector<Gnss_Synchro>& data) const;  //!< Writes RX_time, Pseudorange_m and Flag_valid_pseudorange back
+
+    /*!
+     * \brief Highest TOW at current symbol among the channels with a valid
+     * word, or 0 if there is none.
+     */
+    uint32_t max_valid_tow_ms() const;
+
+    /*!
+     * \brief Sets the receiver time of all the channels and computes the
+     * pseudoranges of the channels with a valid word, taking into account
+     * the week rollover.
+     */
+    void compute_pranges(uint32_t T_rx_TOW_ms);
+
+    /*!
+     * \brief Carrier smoothing (Hatch filter) of the valid pseudoranges, with
+     * a smoothing factor \p smooth_filter_M.
+     */
+    void smooth_pseudoranges(double smooth_filter_M);
+
+    /*!
+     * \brief Carrier wavelength, in meters, of a signal code (e.g. "1C").
+     */
+    static double carrier_wavelength_m(const char* signal);
+
+private:
+    std::vector<double> d_rx_time;
+    std::vector<double> d_interp_tow_ms;
+    std::vector<double> d_carrier_phase_rads;
+    std::vector<double> d_pseudorange_m;
+    std::vector<double> d_candidate_m;  // scratch, to keep data-dependent selections out of the arithmetic loops
+    std::vector<double> d_wavelength_m;
+    std::vector<uint32_t> d_tow_ms;
+    std::vector<uint16_t> d_signal;  // the two characters of the signal code of each channel
+    std::vector<uint8_t> d_valid_word;
+    std::vector<uint8_t> d_valid_pseudorange;
+
+    // Hatch filter state
+    std::vector<double> d_last_pseudorange_smooth;
+    std::vector<double> d_last_carrier_phase_rads;
+    std::vector<uint8_t> d_last_pll_lock;
+
+    uint32_t d_nchannels;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_EPOCH_H
@@ -0,0 +1,67 @@
+/*!
+ * \file obs_history.cc
+ * \brief Structure-of-arrays history of the tracking observables of each
+ * channel, used by the observables block.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_history.h"
+#include <algorithm>  // for max
+
+
+Obs_History::Obs_History(uint32_t max_size, uint32_t nchann)
+    : d_first(nchann, 0U),
+      d_size(nchann, 0U),
+      d_prn(nchann, 0U),
+      d_max_size(std::max(max_size, 1U))
+{
+    const size_t slots = static_cast<size_t>(nchann) * d_max_size;
+    d_sample_counter = std::vector<uint64_t>(slots, 0ULL);
+    d_rx_time = std::vector<double>(slots, 0.0);
+    d_carrier_phase_rads = std::vector<double>(slots, 0.0);
+    d_carrier_doppler_hz = std::vector<double>(slots, 0.0);
+    d_tow_ms = std::vector<uint32_t>(slots, 0U);
+    d_obs = std::vector<Gnss_Synchro>(slots);
+}
+
+
+void Obs_History::push_back(uint32_t ch, const Gnss_Synchro& obs, double rx_time)
+{
+    uint32_t pos = d_size[ch];
+    if (pos == d_max_size)
+        {
+            // Overwrite the oldest element
+            pos--;
+            d_first[ch] = (d_first[ch] + 1 == d_max_size) ? 0U : d_first[ch] + 1;
+        }
+    else
+        {
+            d_size[ch]++;
+        }
+    const uint32_t index = slot(ch, pos);
+    d_sample_counter[index] = obs.Tracking_sample_counter;
+    d_rx_time[index] = rx_time;
+    d_carrier_phase_rads[index] = obs.Carrier_phase_rads;
+    d_carrier_doppler_hz[index] = obs.Carrier_Doppler_hz;
+    d_tow_ms[index] = obs.TOW_at_current_symbol_ms;
+    d_obs[index] = obs;
+    d_obs[index].RX_time = rx_time;
+    d_prn[ch] = obs.PRN;
+}
+
+
+void Obs_History::clear(uint32_t ch)
+{
+    d_first[ch] = 0U;
+    d_size[ch] = 0U;
+}
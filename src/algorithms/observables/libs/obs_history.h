@@ -0,0 +1,122 @@
+/*!
+ * \file obs_history.h
+ * \brief Structure-of-arrays history of the tracking observables of each
+ * channel, used by the observables block.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_HISTORY_H
+#define GNSS_SDR_OBS_HISTORY_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Per-channel circular history of tracking observables.
+ *
+ * The fields read when searching and interpolating the history (sample
+ * counter, receiver time, carrier phase, Doppler and TOW) are stored in
+ * contiguous arrays, one slot per element, so a search only brings those
+ * 36 bytes per element into the cache instead of a full Gnss_Synchro. The
+ * complete Gnss_Synchro objects are kept in a separate array, which is only
+ * read for the element selected at each output epoch.
+ *
+ * Like Gnss_circular_deque, pushing an element into a full channel
+ * overwrites its oldest element.
+ */
+class Obs_History
+{
+public:
+    Obs_History(uint32_t max_size, uint32_t nchann);  //!< nchann = number of channels; max_size = channel capacity
+
+    void push_back(uint32_t ch, const Gnss_Synchro& obs, double rx_time);  //!< Inserts an element, with its receiver time, at the end of the history
+    void clear(uint32_t ch);                                               //!< Removes all the elements of a channel. Capacity is not modified
+
+    inline uint32_t size(uint32_t ch) const  //!< Number of elements in a channel
+    {
+        return d_size[ch];
+    }
+
+    inline uint32_t prn(uint32_t ch) const  //!< PRN of the elements in a channel, if it is not empty
+    {
+        return d_prn[ch];
+    }
+
+    inline uint64_t sample_counter(uint32_t ch, uint32_t pos) const
+    {
+        return d_sample_counter[slot(ch, pos)];
+    }
+
+    inline double rx_time(uint32_t ch, uint32_t pos) const
+    {
+        return d_rx_time[slot(ch, pos)];
+    }
+
+    inline double carrier_phase_rads(uint32_t ch, uint32_t pos) const
+    {
+        return d_carrier_phase_rads[slot(ch, pos)];
+    }
+
+    inline double carrier_doppler_hz(uint32_t ch, uint32_t pos) const
+    {
+        return d_carrier_doppler_hz[slot(ch, pos)];
+    }
+
+    inline uint32_t tow_ms(uint32_t ch, uint32_t pos) const
+    {
+        return d_tow_ms[slot(ch, pos)];
+    }
+
+    inline const Gnss_Synchro& get(uint32_t ch, uint32_t pos) const  //!< Returns the full element, without bound checking
+    {
+        return d_obs[slot(ch, pos)];
+    }
+
+private:
+    inline uint32_t slot(uint32_t ch, uint32_t pos) const
+    {
+        uint32_t index = d_first[ch] + pos;
+        if (index >= d_max_size)
+            {
+                index -= d_max_size;
+            }
+        return ch * d_max_size + index;
+    }
+
+    // Hot fields
+    std::vector<uint64_t> d_sample_counter;
+    std::vector<double> d_rx_time;
+    std::vector<double> d_carrier_phase_rads;
+    std::vector<double> d_carrier_doppler_hz;
+    std::vector<uint32_t> d_tow_ms;
+
+    // Cold copy of the full observables
+    std::vector<Gnss_Synchro> d_obs;
+
+    std::vector<uint32_t> d_first;
+    std::vector<uint32_t> d_size;
+    std::vector<uint32_t> d_prn;
+    uint32_t d_max_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_HISTORY_H
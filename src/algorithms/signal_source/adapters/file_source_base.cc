@@ -29,6 +29,7 @@
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
+#include "mmap_file_source.h"
 #include <glog/logging.h>
 #include <algorithm>  // for std::max
 #include <cmath>      // for ceil, floor
@@ -55,6 +56,7 @@ FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std:
       seconds_to_skip_(configuration->property(role_ + ".seconds_to_skip"s, 0.0)),
       is_complex_(false),
       repeat_(configuration->property(role_ + ".repeat"s, false)),
+      use_mmap_(configuration->property(role_ + ".use_mmap"s, false)),
       enable_throttle_control_(configuration->property(role_ + ".enable_throttle_control"s, false)),
       dump_(configuration->property(role_ + ".dump"s, false))
 {
@@ -135,6 +137,7 @@ void FileSourceBase::init()
     DLOG(INFO) << "Item type " << item_type_;
     DLOG(INFO) << "Item size " << item_size_;
     DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Use mmap " << use_mmap_;
 
     DLOG(INFO) << "Dump " << dump_;
     DLOG(INFO) << "Dump filename " << dump_filename_;
@@ -465,7 +468,7 @@ gnss_shared_ptr<gr::block> FileSourceBase::throttle() const { return throttle_;
 gnss_shared_ptr<gr::block> FileSourceBase::sink() const { return sink_; }
 
 
-gr::blocks::file_source::sptr FileSourceBase::create_file_source()
+gnss_shared_ptr<gr::block> FileSourceBase::create_file_source()
 {
     auto item_tuple = itemTypeToSize();
     item_size_ = std::get<0>(item_tuple);
@@ -476,14 +479,24 @@ gr::blocks::file_source::sptr FileSourceBase::create_file_source()
             // TODO: why are we manually seeking, instead of passing the samples_to_skip to the file_source factory?
             auto samples_to_skip = samplesToSkip();
 
-            file_source_ = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
-
-            if (samples_to_skip > 0)
+            if (use_mmap_)
                 {
-                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
-                    if (!file_source_->seek(samples_to_skip, SEEK_SET))
+                    // The samples to skip are an offset in the mapping
+                    LOG(INFO) << "Mapping the input file, skipping " << samples_to_skip << " samples";
+                    file_source_ = make_mmap_file_source(item_size(), filename(), samples_to_skip, repeat());
+                }
+            else
+                {
+                    auto file_source = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
+                    file_source_ = file_source;
+
+                    if (samples_to_skip > 0)
                         {
-                            LOG(ERROR) << "Error skipping bytes!";
+                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
+                            if (!file_source->seek(samples_to_skip, SEEK_SET))
+                                {
+                                    LOG(ERROR) << "Error skipping bytes!";
+                                }
                         }
                 }
         }
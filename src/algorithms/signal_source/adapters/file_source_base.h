@@ -58,6 +58,8 @@ class ConfigurationInterface;
 //!
 //!   .repeat   - whether to rewind and continue at end of file (default false)
 //!
+//!   .use_mmap - whether to read the file through a memory mapping instead of file reads (default false)
+//!
 //! (probably abstracted to the base class)
 //!
 //!   .dump     - whether to archive input data
@@ -134,7 +136,7 @@ protected:
 
     // The methods create the various blocks, if enabled, and return access to them. The created
     // object is also held in this class
-    gr::blocks::file_source::sptr create_file_source();
+    gnss_shared_ptr<gr::block> create_file_source();
     gr::blocks::throttle::sptr create_throttle();
     gnss_shared_ptr<gr::block> create_valve();
     gr::blocks::file_sink::sptr create_sink();
@@ -152,7 +154,7 @@ protected:
     virtual void post_disconnect_hook(gr::top_block_sptr top_block);
 
 private:
-    gr::blocks::file_source::sptr file_source_;
+    gnss_shared_ptr<gr::block> file_source_;
     gr::blocks::throttle::sptr throttle_;
     gr::blocks::file_sink::sptr sink_;
 
@@ -177,6 +179,7 @@ private:
     double seconds_to_skip_;
     bool is_complex_;  // a misnomer; if I/Q are interleaved as integer values
     bool repeat_;
+    bool use_mmap_;
     bool enable_throttle_control_;
     bool dump_;
 };
@@ -20,6 +20,7 @@
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
+#include "mmap_file_source.h"
 #include <glog/logging.h>
 #include <exception>
 #include <fstream>
@@ -51,6 +52,7 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
 
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     repeat_ = configuration->property(role + ".repeat", false);
+    use_mmap_ = configuration->property(role + ".use_mmap", false);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
 
     const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
@@ -95,8 +97,6 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
-
                     if (seconds_to_skip > 0)
                         {
                             samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
@@ -111,12 +111,23 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
                             samples_to_skip += header_size;
                         }
 
-                    if (samples_to_skip > 0)
+                    if (use_mmap_)
+                        {
+                            // The samples to skip are an offset in the mapping
+                            LOG(INFO) << "Mapping input file #" << n << ", skipping " << samples_to_skip << " samples";
+                            file_source_vec_.push_back(make_mmap_file_source(item_size_, filename_vec_.at(n), samples_to_skip, repeat_));
+                        }
+                    else
                         {
-                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
-                            if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                            auto file_source = gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_);
+                            file_source_vec_.push_back(file_source);
+                            if (samples_to_skip > 0)
                                 {
-                                    LOG(INFO) << "Error skipping bytes!";
+                                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
+                                    if (not file_source->seek(samples_to_skip, SEEK_SET))
+                                        {
+                                            LOG(INFO) << "Error skipping bytes!";
+                                        }
                                 }
                         }
                 }
@@ -214,6 +225,7 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
     DLOG(INFO) << "Item type " << item_type_;
     DLOG(INFO) << "Item size " << item_size_;
     DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Use mmap " << use_mmap_;
 
     if (in_streams_ > 0)
         {
@@ -91,7 +91,7 @@ public:
     }
 
 private:
-    std::vector<gr::blocks::file_source::sptr> file_source_vec_;
+    std::vector<gnss_shared_ptr<gr::block>> file_source_vec_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr sink_;
     std::vector<gr::blocks::throttle::sptr> throttle_vec_;
@@ -104,6 +104,7 @@ private:
     uint32_t in_streams_;
     uint32_t out_streams_;
     bool repeat_;
+    bool use_mmap_;
     // Throttle control
     bool enable_throttle_control_;
 };
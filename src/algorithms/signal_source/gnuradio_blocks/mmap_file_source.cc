@@ -0,0 +1,164 @@
+/*!
+ * \file mmap_file_source.cc
+ * \brief GNU Radio block that reads samples from a memory-mapped file
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>   // for std::min
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <fcntl.h>     // for open
+#include <stdexcept>   // for std::runtime_error
+#include <sys/mman.h>  // for mmap, madvise, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close, sysconf
+
+
+namespace
+{
+// Files up to this size are entirely read into memory when mapped. Longer
+// captures rely on the read-ahead window, so the receiver starts right away
+constexpr size_t MMAP_POPULATE_MAX_BYTES = 256 * 1024 * 1024;
+
+// Amount of the file requested in advance, and released once delivered
+constexpr size_t MMAP_WINDOW_BYTES = 16 * 1024 * 1024;
+}  // namespace
+
+
+mmap_file_source_sptr make_mmap_file_source(size_t item_size,
+    const std::string &filename,
+    uint64_t offset_items,
+    bool repeat)
+{
+    return mmap_file_source_sptr(new mmap_file_source(item_size, filename, offset_items, repeat));
+}
+
+
+mmap_file_source::mmap_file_source(size_t item_size,
+    const std::string &filename,
+    uint64_t offset_items,
+    bool repeat)
+    : gr::sync_block("mmap_file_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, item_size)),
+      d_data(nullptr),
+      d_map_size(0),
+      d_item_size(item_size),
+      d_first_byte(offset_items * item_size),
+      d_end_byte(0),
+      d_read_byte(0),
+      d_advised_byte(0),
+      d_released_byte(0),
+      d_page_size(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+      d_repeat(repeat)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            throw std::runtime_error("mmap_file_source: cannot open " + filename + ": " + std::strerror(errno));
+        }
+    struct stat file_status
+    {
+    };
+    if (fstat(fd, &file_status) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("mmap_file_source: cannot stat " + filename + ": " + std::strerror(errno));
+        }
+    d_map_size = static_cast<size_t>(file_status.st_size);
+    if (d_map_size < d_first_byte + d_item_size)
+        {
+            close(fd);
+            throw std::runtime_error("mmap_file_source: " + filename + " has no samples after the requested offset");
+        }
+
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (d_map_size <= MMAP_POPULATE_MAX_BYTES)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+    void *data = mmap(nullptr, d_map_size, PROT_READ, flags, fd, 0);
+    close(fd);  // the mapping keeps its own reference to the file
+    if (data == MAP_FAILED)
+        {
+            throw std::runtime_error("mmap_file_source: cannot map " + filename + ": " + std::strerror(errno));
+        }
+    d_data = static_cast<const uint8_t *>(data);
+    if (madvise(data, d_map_size, MADV_SEQUENTIAL) != 0)
+        {
+            LOG(WARNING) << "mmap_file_source: madvise(MADV_SEQUENTIAL) failed for " << filename;
+        }
+
+    // Only whole items are delivered
+    d_end_byte = d_first_byte + ((d_map_size - d_first_byte) / d_item_size) * d_item_size;
+    d_read_byte = d_first_byte;
+    d_advised_byte = d_first_byte - d_first_byte % d_page_size;
+    d_released_byte = d_advised_byte;
+    advise_window(d_read_byte);
+    DLOG(INFO) << "Mapped " << d_map_size << " bytes of " << filename << ", starting at byte " << d_first_byte;
+}
+
+
+mmap_file_source::~mmap_file_source()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<uint8_t *>(d_data), d_map_size);
+        }
+}
+
+
+void mmap_file_source::advise_window(size_t offset_bytes)
+{
+    auto *base = const_cast<uint8_t *>(d_data);
+    if (offset_bytes + MMAP_WINDOW_BYTES / 2 > d_advised_byte && d_advised_byte < d_map_size)
+        {
+            const size_t length = std::min(MMAP_WINDOW_BYTES, d_map_size - d_advised_byte);
+            madvise(base + d_advised_byte, length, MADV_WILLNEED);
+            d_advised_byte += length;
+        }
+    const size_t consumed_page = offset_bytes - offset_bytes % d_page_size;
+    if (consumed_page >= d_released_byte + MMAP_WINDOW_BYTES)
+        {
+            madvise(base + d_released_byte, consumed_page - d_released_byte, MADV_DONTNEED);
+            d_released_byte = consumed_page;
+        }
+}
+
+
+int mmap_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    if (d_read_byte == d_end_byte)
+        {
+            if (!d_repeat)
+                {
+                    return WORK_DONE;
+                }
+            d_read_byte = d_first_byte;
+            d_advised_byte = d_first_byte - d_first_byte % d_page_size;
+            d_released_byte = d_advised_byte;
+        }
+
+    const size_t items = std::min(static_cast<size_t>(noutput_items), (d_end_byte - d_read_byte) / d_item_size);
+    memcpy(output_items[0], d_data + d_read_byte, items * d_item_size);
+    d_read_byte += items * d_item_size;
+    advise_window(d_read_byte);
+    return static_cast<int>(items);
+}
@@ -0,0 +1,96 @@
+/*!
+ * \file mmap_file_source.h
+ * \brief GNU Radio block that reads samples from a memory-mapped file
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SOURCE_H
+#define GNSS_SDR_MMAP_FILE_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class mmap_file_source;
+
+using mmap_file_source_sptr = gnss_shared_ptr<mmap_file_source>;
+
+/*!
+ * \brief Returns a source of items of item_size bytes read from filename,
+ * starting at item offset_items. If repeat is true, the source goes back to
+ * offset_items when it reaches the end of the file. Throws
+ * std::runtime_error if the file cannot be mapped.
+ */
+mmap_file_source_sptr make_mmap_file_source(
+    size_t item_size,
+    const std::string &filename,
+    uint64_t offset_items,
+    bool repeat);
+
+/*!
+ * \brief Drop-in replacement of gr::blocks::file_source that maps the whole
+ * file in memory instead of reading it with a system call per buffer.
+ *
+ * The samples are copied straight from the page cache into the output buffer
+ * of the block. The kernel is told that the file is read sequentially, pages
+ * ahead of the read position are requested in advance and pages already
+ * delivered are released, so the resident memory does not grow with the file
+ * size.
+ */
+class mmap_file_source : public gr::sync_block
+{
+public:
+    ~mmap_file_source();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend mmap_file_source_sptr make_mmap_file_source(
+        size_t item_size,
+        const std::string &filename,
+        uint64_t offset_items,
+        bool repeat);
+
+    mmap_file_source(size_t item_size,
+        const std::string &filename,
+        uint64_t offset_items,
+        bool repeat);
+
+    void advise_window(size_t offset_bytes);
+
+    const uint8_t *d_data;
+    size_t d_map_size;
+    size_t d_item_size;
+    size_t d_first_byte;
+    size_t d_end_byte;
+    size_t d_read_byte;
+    size_t d_advised_byte;
+    size_t d_released_byte;
+    size_t d_page_size;
+    bool d_repeat;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MMAP_FILE_SOURCE_H
@@ -18,6 +18,7 @@
 
 #include "unpack_2bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 struct byte_2bit_struct
 {
@@ -105,7 +106,9 @@ unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
       big_endian_bytes_(big_endian_bytes),
       big_endian_items_(big_endian_items),
       swap_endian_items_(false),
-      reverse_interleaving_(reverse_interleaving)
+      reverse_interleaving_(reverse_interleaving),
+      swap_endian_items_in_kernel_(false),
+      order_(0)
 {
     bool big_endian_system = systemIsBigEndian();
 
@@ -117,6 +120,27 @@ unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
     bool big_endian_bytes_system = systemBytesAreBigEndian();
 
     swap_endian_bytes_ = (big_endian_bytes_system != big_endian_bytes_);
+
+    // Sample order within each byte, as expected by the unpacking kernel
+    unsigned int order = 0;
+    if (!reverse_interleaving_)
+        {
+            order = swap_endian_bytes_ ? 3 : 0;
+        }
+    else
+        {
+            order = swap_endian_bytes_ ? 2 : 1;
+        }
+
+    // The kernel reverses the bytes of items of up to 16 bytes while
+    // unpacking them. Other item sizes are swapped beforehand.
+    const bool item_size_is_power_of_two = (item_size_ & (item_size_ - 1)) == 0;
+    swap_endian_items_in_kernel_ = swap_endian_items_ && item_size_is_power_of_two && (item_size_ <= 16);
+    if (swap_endian_items_in_kernel_)
+        {
+            order |= static_cast<unsigned int>(item_size_ - 1) << 2;
+        }
+    order_ = static_cast<char>(order);
 }
 
 
@@ -124,87 +148,23 @@ int unpack_2bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    auto const *in = reinterpret_cast<signed char const *>(input_items[0]);
+    auto const *in = reinterpret_cast<uint8_t const *>(input_items[0]);
     auto *out = reinterpret_cast<int8_t *>(output_items[0]);
 
-    size_t ninput_bytes = noutput_items / 4;
-    size_t ninput_items = ninput_bytes / item_size_;
-
-    // Handle endian swap if needed
-    if (swap_endian_items_)
+    // Handle endian swap if the kernel cannot do it
+    if (swap_endian_items_ && !swap_endian_items_in_kernel_)
         {
-            work_buffer_.reserve(ninput_bytes);
-            swapEndianness(in, work_buffer_, item_size_, ninput_items);
+            const size_t ninput_bytes = noutput_items / 4;
+            const size_t ninput_items = ninput_bytes / item_size_;
+            work_buffer_.resize(ninput_bytes);
+            swapEndianness(reinterpret_cast<int8_t const *>(in), work_buffer_, item_size_, ninput_items);
 
-            in = const_cast<signed char const *>(&work_buffer_[0]);
+            in = reinterpret_cast<uint8_t const *>(work_buffer_.data());
         }
 
     // Here the in pointer can be interpreted as a stream of bytes to be
-    // converted. But we now have two possibilities:
-    // 1) The samples in a byte are in big endian order
-    // 2) The samples in a byte are in little endian order
-
-    byte_and_samples raw_byte{};
-    int n = 0;
-
-    if (!reverse_interleaving_)
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                        }
-                }
-        }
-    else
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                        }
-                }
-        }
+    // converted, with the samples in a byte in big or little endian order
+    volk_gnsssdr_8u_s8i_unpack2bit_8i(out, in, order_, noutput_items);
 
     return noutput_items;
 }
@@ -80,6 +80,9 @@ unpack_2bit_samples_sptr make_unpack_2bit_samples(
  * \brief This class takes 2 bit samples that have been packed into bytes or
  * shorts as input and generates a byte for each sample. It generates eight
  * times as much data as is input (every two bits become 16 bits)
+ *
+ * The unpacking, including the swap of the item bytes, is done with a single
+ * call to the volk_gnsssdr_8u_s8i_unpack2bit_8i kernel.
  */
 class unpack_2bit_samples : public gr::sync_interpolator
 {
@@ -109,6 +112,8 @@ private:
     bool swap_endian_items_;
     bool swap_endian_bytes_;
     bool reverse_interleaving_;
+    bool swap_endian_items_in_kernel_;
+    char order_;
 };
 
 
@@ -17,6 +17,8 @@
 
 #include "unpack_intspir_1bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstdint>
 
 
 unpack_intspir_1bit_samples_sptr make_unpack_intspir_1bit_samples()
@@ -37,32 +39,12 @@ int unpack_intspir_1bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const signed int *>(input_items[0]);
-    auto *out = reinterpret_cast<float *>(output_items[0]);
+    const auto *in = reinterpret_cast<const uint32_t *>(input_items[0]);
+    auto *out = reinterpret_cast<lv_32fc_t *>(output_items[0]);
+
+    // Read packed input samples (1 int = 1 complex sample)
+    // For historical reasons, values are float versions of short int limits (32767)
+    volk_gnsssdr_32u_s32f_unpack1bit_32fc(out, in, 32767.0F, noutput_items / 2);
 
-    int n = 0;
-    int channel = 1;
-    for (int i = 0; i < noutput_items / 2; i++)
-        {
-            // Read packed input sample (1 byte = 1 complex sample)
-            // For historical reasons, values are float versions of short int limits (32767)
-            signed int val = in[i];
-            if (((val >> ((channel - 1) * 2)) & 1) == 1)
-                {
-                    out[n++] = static_cast<float>(32767.0);
-                }
-            else
-                {
-                    out[n++] = static_cast<float>(-32767.0);
-                }
-            if (((val >> (2 * channel - 1)) & 1) == 1)
-                {
-                    out[n++] = static_cast<float>(32767.0);
-                }
-            else
-                {
-                    out[n++] = static_cast<float>(-32767.0);
-                }
-        }
     return noutput_items;
 }
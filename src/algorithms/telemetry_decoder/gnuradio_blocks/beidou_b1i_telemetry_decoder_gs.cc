@@ -23,6 +23,7 @@
 #include "beidou_dnav_iono.h"
 #include "beidou_dnav_utc_model.h"
 #include "display.h"
+#include "gnss_block_profiler.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
 #include "gnss_synchro.h"
 #include "tlm_utils.h"
@@ -76,6 +77,7 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
+    d_profiler_stats = Gnss_Block_Profiler::instance().register_block(this->name(), static_cast<uint32_t>(this->unique_id()));
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
     // Ephemeris data port out
@@ -431,9 +433,10 @@ void beidou_b1i_telemetry_decoder_gs::reset()
 }
 
 
-int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
+    const Gnss_Block_Timer profiler_timer(d_profiler_stats.get(), this->nitems_read(0), ninput_items[0]);
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
@@ -41,6 +41,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class beidou_b1i_telemetry_decoder_gs;
 
 using beidou_b1i_telemetry_decoder_gs_sptr = gnss_shared_ptr<beidou_b1i_telemetry_decoder_gs>;
@@ -92,6 +93,7 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     // Satellite Information and logging capacity
     Gnss_Satellite d_satellite;
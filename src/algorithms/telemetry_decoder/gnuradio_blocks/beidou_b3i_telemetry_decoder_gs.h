@@ -39,6 +39,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class beidou_b3i_telemetry_decoder_gs;
 
 using beidou_b3i_telemetry_decoder_gs_sptr =
@@ -91,6 +92,7 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
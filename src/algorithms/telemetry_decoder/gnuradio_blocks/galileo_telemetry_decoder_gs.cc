@@ -29,6 +29,7 @@
 #include "galileo_has_page.h"        // For Galileo_HAS_page
 #include "galileo_iono.h"            // for Galileo_Iono
 #include "galileo_utc_model.h"       // for Galileo_Utc_Model
+#include "gnss_block_profiler.h"
 #include "gnss_sdr_make_unique.h"    // for std::make_unique in C++11
 #include "gnss_synchro.h"            // for Gnss_Synchro
 #include "tlm_crc_stats.h"           // for Tlm_CRC_Stats
@@ -87,6 +88,7 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                       d_enable_reed_solomon_inav(false),
                       d_valid_timetag(false)
 {
+    d_profiler_stats = Gnss_Block_Profiler::instance().register_block(this->name(), static_cast<uint32_t>(this->unique_id()));
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
     // Ephemeris data port out
@@ -105,10 +107,12 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
 
     // Viterbi decoder vars
-    const int32_t nn = 2;                               // Coding rate 1/n
-    const int32_t KK = 7;                               // Constraint Length
-    const std::array<int32_t, 2> g_encoder{{121, 91}};  // Polynomial G1 and G2
+    const int32_t nn = 2;                                // Coding rate 1/n
+    const int32_t KK = 7;                                // Constraint Length
+    const std::array<int32_t, 2> g_encoder{{121, -91}};  // Polynomial G1 and G2, with the NOT gate in G2 (Galileo ICD Figure 13, FEC encoder)
     d_mm = KK - 1;
+    int32_t interleaver_rows = 0;
+    int32_t interleaver_cols = 0;
 
     DLOG(INFO) << "Initializing GALILEO UNIFIED TELEMETRY DECODER";
 
@@ -139,6 +143,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                 d_codelength = static_cast<int32_t>(d_frame_length_symbols);
                 d_datalength = (d_codelength / nn) - d_mm;
                 d_max_symbols_without_valid_frame = GALILEO_INAV_PAGE_SYMBOLS * 30;  // rise alarm 60 seconds without valid tlm
+                interleaver_rows = GALILEO_INAV_INTERLEAVER_ROWS;
+                interleaver_cols = GALILEO_INAV_INTERLEAVER_COLS;
                 if (conf.enable_reed_solomon == true)
                     {
                         d_enable_reed_solomon_inav = true;
@@ -160,6 +166,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                 d_codelength = static_cast<int32_t>(d_frame_length_symbols);
                 d_datalength = (d_codelength / nn) - d_mm;
                 d_max_symbols_without_valid_frame = GALILEO_FNAV_SYMBOLS_PER_PAGE * 5;  // rise alarm 100 seconds without valid tlm
+                interleaver_rows = GALILEO_FNAV_INTERLEAVER_ROWS;
+                interleaver_cols = GALILEO_FNAV_INTERLEAVER_COLS;
                 break;
             }
         case 3:  // CNAV
@@ -174,6 +182,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                 d_codelength = static_cast<int32_t>(d_frame_length_symbols);
                 d_datalength = (d_codelength / nn) - d_mm;
                 d_max_symbols_without_valid_frame = GALILEO_CNAV_SYMBOLS_PER_PAGE * 60;
+                interleaver_rows = GALILEO_CNAV_INTERLEAVER_ROWS;
+                interleaver_cols = GALILEO_CNAV_INTERLEAVER_COLS;
                 break;
             }
         default:
@@ -190,6 +200,18 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
         }
 
     d_page_part_symbols = std::vector<float>(d_frame_length_symbols);
+    d_page_symbols_soft_value = volk_gnsssdr::vector<float>(d_frame_length_symbols);
+    d_page_bits = std::vector<int32_t>(d_frame_length_symbols / nn);
+
+    // The de-interleaved symbol k is read from the received symbol d_deinterleaver_index[k]
+    d_deinterleaver_index = std::vector<int32_t>(d_frame_length_symbols);
+    for (int32_t r = 0; r < interleaver_rows; r++)
+        {
+            for (int32_t c = 0; c < interleaver_cols; c++)
+                {
+                    d_deinterleaver_index[c * interleaver_rows + r] = r * interleaver_cols + c;
+                }
+        }
 
     for (int32_t i = 0; i < d_bits_per_preamble; i++)
         {
@@ -280,14 +302,12 @@ galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
 }
 
 
-void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, const float *in, float *out)
+void galileo_telemetry_decoder_gs::deinterleaver(const float *in, float *out) const
 {
-    for (int32_t r = 0; r < rows; r++)
+    const size_t length = d_deinterleaver_index.size();
+    for (size_t k = 0; k < length; k++)
         {
-            for (int32_t c = 0; c < cols; c++)
-                {
-                    out[c * rows + r] = in[r * cols + c];
-                }
+            out[k] = in[d_deinterleaver_index[k]];
         }
 }
 
@@ -295,28 +315,18 @@ void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, con
 void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    std::vector<float> page_part_symbols_soft_value(frame_length);
-    deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_soft_value.data());
+    deinterleaver(page_part_symbols, d_page_symbols_soft_value.data());
 
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < frame_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_part_symbols_soft_value[i] = -page_part_symbols_soft_value[i];
-                }
-        }
+    // 2. Viterbi decoder (it takes into account the NOT gate in G2 polynomial)
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_part_bits(decoded_length);
-    d_viterbi->decode(page_part_bits, page_part_symbols_soft_value);
+    d_viterbi->decode(d_page_bits.data(), d_page_symbols_soft_value.data());
 
     // 3. Call the Galileo page decoder
     std::string page_String;
     page_String.reserve(decoded_length);
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_part_bits[i] > 0)
+            if (d_page_bits[i] > 0)
                 {
                     page_String.push_back('1');
                 }
@@ -331,7 +341,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
             d_nav_msg_packet.nav_message = page_String;
         }
 
-    if (page_part_bits[0] == 1)
+    if (d_page_bits[0] == 1)
         {
             // DECODE COMPLETE WORD (even + odd) and TEST CRC
             d_inav_nav.split_page(page_String, d_flag_even_word_arrived);
@@ -446,29 +456,18 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
 void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(frame_length);
-    deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
-
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < frame_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_soft_value[i] = -page_symbols_soft_value[i];
-                }
-        }
+    deinterleaver(page_symbols, d_page_symbols_soft_value.data());
 
+    // 2. Viterbi decoder (it takes into account the NOT gate in G2 polynomial)
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    d_viterbi->decode(page_bits, page_symbols_soft_value);
+    d_viterbi->decode(d_page_bits.data(), d_page_symbols_soft_value.data());
 
     // 3. Call the Galileo page decoder
     std::string page_String;
     page_String.reserve(decoded_length);
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_bits[i] > 0)
+            if (d_page_bits[i] > 0)
                 {
                     page_String.push_back('1');
                 }
@@ -519,28 +518,18 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
 void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t page_length)
 {
     // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(page_length);
-    deinterleaver(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
+    deinterleaver(page_symbols, d_page_symbols_soft_value.data());
 
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < page_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_soft_value[i] = -page_symbols_soft_value[i];
-                }
-        }
+    // 2. Viterbi decoder (it takes into account the NOT gate in G2 polynomial)
     const int32_t decoded_length = page_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    d_viterbi->decode(page_bits, page_symbols_soft_value);
+    d_viterbi->decode(d_page_bits.data(), d_page_symbols_soft_value.data());
 
     // 3. Call the Galileo page decoder
     std::string page_String;
     page_String.reserve(decoded_length);
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_bits[i] > 0)
+            if (d_page_bits[i] > 0)
                 {
                     page_String.push_back('1');
                 }
@@ -650,9 +639,10 @@ void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
 }
 
 
-int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
+    const Gnss_Block_Timer profiler_timer(d_profiler_stats.get(), this->nitems_read(0), ninput_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
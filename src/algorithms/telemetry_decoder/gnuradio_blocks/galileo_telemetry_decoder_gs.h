@@ -21,28 +21,30 @@
 #ifndef GNSS_SDR_GALILEO_TELEMETRY_DECODER_GS_H
 #define GNSS_SDR_GALILEO_TELEMETRY_DECODER_GS_H
 
-#include "galileo_cnav_message.h"     // for Galileo_Cnav_Message
-#include "galileo_fnav_message.h"     // for Galileo_Fnav_Message
-#include "galileo_inav_message.h"     // for Galileo_Inav_Message
-#include "gnss_block_interface.h"     // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
-#include "gnss_satellite.h"           // for Gnss_Satellite
-#include "gnss_time.h"                // for GnssTime
-#include "nav_message_packet.h"       // for Nav_Message_Packet
-#include "tlm_conf.h"                 // for Tlm_Conf
-#include <boost/circular_buffer.hpp>  // for boost::circular_buffer
-#include <gnuradio/block.h>           // for block
-#include <gnuradio/types.h>           // for gr_vector_const_void_star
-#include <cstdint>                    // for int32_t, uint32_t
-#include <fstream>                    // for std::ofstream
-#include <memory>                     // for std::unique_ptr
-#include <string>                     // for std::string
-#include <vector>                     // for std::vector
+#include "galileo_cnav_message.h"             // for Galileo_Cnav_Message
+#include "galileo_fnav_message.h"             // for Galileo_Fnav_Message
+#include "galileo_inav_message.h"             // for Galileo_Inav_Message
+#include "gnss_block_interface.h"             // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
+#include "gnss_satellite.h"                   // for Gnss_Satellite
+#include "gnss_time.h"                        // for GnssTime
+#include "nav_message_packet.h"               // for Nav_Message_Packet
+#include "tlm_conf.h"                         // for Tlm_Conf
+#include <boost/circular_buffer.hpp>          // for boost::circular_buffer
+#include <gnuradio/block.h>                   // for block
+#include <gnuradio/types.h>                   // for gr_vector_const_void_star
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>                            // for int32_t, uint32_t
+#include <fstream>                            // for std::ofstream
+#include <memory>                             // for std::unique_ptr
+#include <string>                             // for std::string
+#include <vector>                             // for std::vector
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
 /** \addtogroup Telemetry_Decoder_gnuradio_blocks
  * \{ */
 
+class Gnss_Block_Stats;              // forward declaration
 class Viterbi_Decoder;               // forward declaration
 class Tlm_CRC_Stats;                 // forward declaration
 class galileo_telemetry_decoder_gs;  // forward declaration
@@ -80,7 +82,7 @@ private:
 
     galileo_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf, int frame_type);
 
-    void deinterleaver(int32_t rows, int32_t cols, const float *in, float *out);
+    void deinterleaver(const float *in, float *out) const;
     void decode_INAV_word(float *page_part_symbols, int32_t frame_length);
     void decode_FNAV_word(float *page_symbols, int32_t frame_length);
     void decode_CNAV_word(float *page_symbols, int32_t page_length);
@@ -88,6 +90,9 @@ private:
     std::unique_ptr<Viterbi_Decoder> d_viterbi;
     std::vector<int32_t> d_preamble_samples;
     std::vector<float> d_page_part_symbols;
+    volk_gnsssdr::vector<float> d_page_symbols_soft_value;
+    std::vector<int32_t> d_page_bits;
+    std::vector<int32_t> d_deinterleaver_index;
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
@@ -105,6 +110,7 @@ private:
     GnssTime d_current_timetag{};
 
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     double d_delta_t;  // GPS-GALILEO time offset
 
@@ -42,6 +42,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class glonass_l1_ca_telemetry_decoder_gs;
 
 using glonass_l1_ca_telemetry_decoder_gs_sptr = gnss_shared_ptr<glonass_l1_ca_telemetry_decoder_gs>;
@@ -98,6 +99,7 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
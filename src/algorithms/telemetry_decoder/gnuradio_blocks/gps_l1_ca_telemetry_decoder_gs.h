@@ -41,6 +41,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class gps_l1_ca_telemetry_decoder_gs;
 
 using gps_l1_ca_telemetry_decoder_gs_sptr = gnss_shared_ptr<gps_l1_ca_telemetry_decoder_gs>;
@@ -80,6 +81,7 @@ private:
     Gnss_Satellite d_satellite;
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
 
@@ -42,6 +42,7 @@ extern "C"
  * \{ */
 
 
+class Gnss_Block_Stats;
 class gps_l2c_telemetry_decoder_gs;
 
 using gps_l2c_telemetry_decoder_gs_sptr = gnss_shared_ptr<gps_l2c_telemetry_decoder_gs>;
@@ -82,6 +83,7 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
@@ -37,6 +37,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Viterbi_Decoder_Sbas;
 
 class sbas_l1_telemetry_decoder_gs;
@@ -154,6 +155,8 @@ private:
         void zerropad_front_and_convert_to_bytes(const std::vector<int32_t> &msg_candidate, std::vector<uint8_t> &bytes);
         void zerropad_back_and_convert_to_bytes(const std::vector<int32_t> &msg_candidate, std::vector<uint8_t> &bytes);
     } d_crc_verifier;
+
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
 };
 
 
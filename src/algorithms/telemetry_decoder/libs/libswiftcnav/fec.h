@@ -22,6 +22,8 @@
 #ifndef GNSS_SDR_FEC_H
 #define GNSS_SDR_FEC_H
 
+#include <stdint.h>
+
 /* r=1/2 k=7 convolutional encoder polynomials
  * The NASA-DSN convention is to use V27POLYA inverted, then V27POLYB
  * The CCSDS/NASA-GSFC convention is to use V27POLYB, then V27POLYA inverted
@@ -29,25 +31,24 @@
 #define V27POLYA 0x4f
 #define V27POLYB 0x6d
 
+/* Symbols expected when leaving each of the 32 lower states with an input bit
+ * 0, +1.0 for a 1 and -1.0 for a 0. c0 and c1 are contiguous, as required by
+ * the volk_gnsssdr_32f_viterbi_k7r2_64u kernel.
+ */
 typedef struct
 {
-    unsigned char c0[32];
-    unsigned char c1[32];
+    float c0[32];
+    float c1[32];
 } v27_poly_t;
 
-typedef struct
-{
-    unsigned int w[2];
-} v27_decision_t;
+/* Bit i holds the decision of state 2i, bit 32 + i the one of state 2i + 1 */
+typedef uint64_t v27_decision_t;
 
 /* State info for instance of r=1/2 k=7 Viterbi decoder
  */
 typedef struct
 {
-    unsigned int metrics1[64]; /* Path metric buffer 1 */
-    unsigned int metrics2[64]; /* Path metric buffer 2 */
-    /* Pointers to path metrics, swapped on every bit */
-    unsigned int *old_metrics, *new_metrics;
+    float metrics[64];            /* Path metrics, the higher the better */
     const v27_poly_t *poly;       /* Polynomial to use */
     v27_decision_t *decisions;    /* Beginning of decisions for block */
     unsigned int decisions_index; /* Index of current decision */
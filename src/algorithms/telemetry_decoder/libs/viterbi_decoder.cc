@@ -15,190 +15,89 @@
  */
 
 #include "viterbi_decoder.h"
-#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u
-#include <algorithm>                    // for std::copy
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_viterbi_k7r2_64u
+#include <algorithm>                    // for std::fill
+#include <cstdlib>                      // for std::abs
+#include <stdexcept>                    // for std::invalid_argument
+
 
 Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     int32_t nn,
     int32_t LL,
-    const std::array<int32_t, 2>& g) : d_g(g),
-                                       d_KK(KK),
-                                       d_nn(nn),
-                                       d_LL(LL),
-                                       d_mm(KK - 1),
-                                       d_states(1 << d_mm),       //  2^d_mm
-                                       d_number_symbols(1 << nn)  //  2^d_nn
+    const std::array<int32_t, 2>& g) : d_LL(LL),
+                                       d_mm(KK - 1)
 {
-    d_prev_section = std::vector<float>(d_states, -d_MAXLOG);
-    d_next_section = std::vector<float>(d_states, -d_MAXLOG);
-    d_rec_array = std::vector<float>(d_nn);
-    d_metric_c = std::vector<float>(d_number_symbols);
-    d_prev_bit = std::vector<int32_t>(d_states * (d_LL + d_mm));
-    d_prev_state = std::vector<int32_t>(d_states * (d_LL + d_mm));
-    d_out0 = std::vector<int32_t>(d_states);
-    d_out1 = std::vector<int32_t>(d_states);
-    d_state0 = std::vector<int32_t>(d_states);
-    d_state1 = std::vector<int32_t>(d_states);
-    nsc_transit(d_out0, d_state0, 0);
-    nsc_transit(d_out1, d_state1, 1);
-}
-
-
-void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c)
-{
-    int32_t i;
-    int32_t t;
-    int32_t state;
-    uint32_t max_index;
-    float metric;
-    float max_val;
-
-    d_prev_section[0] = 0.0;  //  start in all-zeros state
-
-    // go through trellis
-    for (t = 0; t < d_LL + d_mm; t++)
+    // The kernel is written for the 64 states and two symbols per bit of
+    // the K=7, rate 1/2 code
+    if (KK != 7 || nn != 2)
         {
-            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + (d_nn - 1), d_rec_array.begin());
-
-            // precompute all possible branch metrics
-            for (i = 0; i < d_number_symbols; i++)
+            throw std::invalid_argument("Viterbi_Decoder only supports K=7, rate 1/2 codes");
+        }
+    const int32_t states = 1 << d_mm;
+    d_metrics = volk_gnsssdr::vector<float>(states);
+    d_branch_table = volk_gnsssdr::vector<float>(states);
+    d_decisions = volk_gnsssdr::vector<uint64_t>(d_LL + d_mm);
+
+    // The kernel keeps the newest bit in the least significant position of
+    // the state, so the polynomials are bit-reversed. Entry i holds the
+    // symbols expected when leaving state i with an input bit 0.
+    for (int32_t p = 0; p < nn; p++)
+        {
+            int32_t reversed = 0;
+            for (int32_t b = 0; b < KK; b++)
                 {
-                    d_metric_c[i] = this->Gamma(i);
+                    reversed |= ((std::abs(g[p]) >> b) & 1) << (KK - 1 - b);
                 }
-
-            // step through all states
-            for (state = 0; state < d_states; state++)
+            for (int32_t state = 0; state < states / 2; state++)
                 {
-                    // hypothesis: info bit is a zero
-                    metric = d_prev_section[state] + d_metric_c[d_out0[state]];
-
-                    // store new metric if more than metric in storage
-                    if (metric > d_next_section[d_state0[state]])
+                    int32_t parity = 0;
+                    for (int32_t word = (2 * state) & reversed; word != 0; word >>= 1)
                         {
-                            d_next_section[d_state0[state]] = metric;
-                            d_prev_state[t * d_states + d_state0[state]] = state;
-                            d_prev_bit[t * d_states + d_state0[state]] = 0;
+                            parity ^= word & 1;
                         }
-
-                    // hypothesis: info bit is a one
-                    metric = d_prev_section[state] + d_metric_c[d_out1[state]];
-
-                    // store new metric if more than metric in storage
-                    if (metric > d_next_section[d_state1[state]])
+                    if (g[p] < 0)
                         {
-                            d_next_section[d_state1[state]] = metric;
-                            d_prev_state[t * d_states + d_state1[state]] = state;
-                            d_prev_bit[t * d_states + d_state1[state]] = 1;
+                            parity ^= 1;
                         }
+                    d_branch_table[p * states / 2 + state] = parity ? 1.0F : -1.0F;
                 }
-
-            // normalize
-            volk_gnsssdr_32f_index_max_32u(&max_index, d_next_section.data(), d_states);
-            max_val = d_next_section[max_index];
-
-            for (state = 0; state < d_states; state++)
-                {
-                    d_prev_section[state] = d_next_section[state] - max_val;
-                    d_next_section[state] = -d_MAXLOG;
-                }
-        }
-
-    // trace-back operation
-    state = 0;
-
-    // tail, no need to output
-    for (t = d_LL + d_mm - 1; t >= d_LL; t--)
-        {
-            state = d_prev_state[t * d_states + state];
-        }
-
-    for (t = d_LL - 1; t >= 0; t--)
-        {
-            output_u_int[t] = d_prev_bit[t * d_states + state];
-            state = d_prev_state[t * d_states + state];
         }
 }
 
 
-void Viterbi_Decoder::reset()
+void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c)
 {
-    d_out0 = std::vector<int32_t>(d_states);
-    d_out1 = std::vector<int32_t>(d_states);
-    d_state0 = std::vector<int32_t>(d_states);
-    d_state1 = std::vector<int32_t>(d_states);
-    nsc_transit(d_out0, d_state0, 0);
-    nsc_transit(d_out1, d_state1, 1);
+    decode(output_u_int.data(), input_c.data());
 }
 
 
-void Viterbi_Decoder::nsc_transit(std::vector<int32_t>& output_p,
-    std::vector<int32_t>& trans_p,
-    int32_t input) const
+void Viterbi_Decoder::decode(int32_t* output_u_int, const float* input_c)
 {
-    int32_t nextstate;
-    int32_t state;
-    const int32_t states = (1 << (d_KK - 1));  // The number of states: 2^d_mm
-
-    // Determine the output and next state for each possible starting state
-    for (state = 0; state < states; state++)
-        {
-            output_p[state] = nsc_enc_bit(&nextstate, input, state);
-            trans_p[state] = nextstate;
-        }
-}
-
+    // start in all-zeros state
+    std::fill(d_metrics.begin(), d_metrics.end(), -d_MAXLOG);
+    d_metrics[0] = 0.0;
 
-float Viterbi_Decoder::Gamma(int32_t symbol) const
-{
-    float rm = 0;
-    int32_t mask = 1;
-    int32_t i;
+    // go through trellis
+    volk_gnsssdr_32f_viterbi_k7r2_64u(d_decisions.data(), d_metrics.data(), input_c, d_branch_table.data(), d_LL + d_mm);
 
-    for (i = 0; i < d_nn; i++)
+    // trace-back operation, the tail bits drive the encoder to the all-zeros state
+    const int32_t half_states = 1 << (d_mm - 1);
+    uint32_t state = 0;
+    uint32_t survivor;
+    for (int32_t t = d_LL + d_mm - 1; t >= 0; t--)
         {
-            if (symbol & mask)
+            if (t < d_LL)
                 {
-                    rm += d_rec_array[d_nn - i - 1];
+                    output_u_int[t] = static_cast<int32_t>(state & 1U);
                 }
-            mask = mask << 1;
-        }
-    return rm;
-}
-
-
-int32_t Viterbi_Decoder::parity_counter(int32_t symbol, int32_t length) const
-{
-    int32_t counter;
-    int32_t temp_parity = 0;
-
-    for (counter = 0; counter < length; counter++)
-        {
-            temp_parity = temp_parity ^ (symbol & 1);
-            symbol = symbol >> 1;
+            survivor = (d_decisions[t] >> ((state & 1U) * 32U + (state >> 1U))) & 1U;
+            state = (state >> 1U) + survivor * half_states;
         }
-    return temp_parity;
 }
 
 
-int32_t Viterbi_Decoder::nsc_enc_bit(int32_t* state_out_p,
-    int32_t input,
-    int32_t state_in) const
+void Viterbi_Decoder::reset()
 {
-    // declare variables
-    int32_t i;
-    int32_t out_ = 0;
-
-    // create a word made up of state and new input
-    const int32_t state = (input << (d_KK - 1)) ^ state_in;
-
-    // AND the word with the generators
-    for (i = 0; i < d_nn; i++)
-        {
-            // update output symbol
-            out_ = (out_ << 1) + parity_counter(state & d_g[i], d_KK);
-        }
-
-    // shift the state to make the new state
-    *state_out_p = state >> 1;
-    return out_;
+    std::fill(d_metrics.begin(), d_metrics.end(), -d_MAXLOG);
+    d_metrics[0] = 0.0;
 }
@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_H
 #define GNSS_SDR_VITERBI_DECODER_H
 
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -29,17 +30,24 @@
 
 
 /*!
- * \brief Class that implements a Viterbi decoder
+ * \brief Class that implements a Viterbi decoder for the K=7, rate 1/2
+ * convolutional codes of the GNSS navigation messages.
+ *
+ * The add-compare-select operations run in the
+ * volk_gnsssdr_32f_viterbi_k7r2_64u kernel, and the survivor decisions are
+ * stored in a buffer allocated at construction time, so decoding a frame does
+ * not allocate memory.
  */
 class Viterbi_Decoder
 {
 public:
     /*!
      * \brief Constructor of a Viterbi decoder
-     * \param[in] KK  Constraint length
-     * \param[in] nn  Coding rate 1/n
+     * \param[in] KK  Constraint length (must be 7)
+     * \param[in] nn  Coding rate 1/n (must be 2)
      * \param[in] LL  Data length
-     * \param[in] g   Polynomial G1 and G2
+     * \param[in] g   Polynomial G1 and G2. A negative value stands for an inverted output.
+     * \throws std::invalid_argument if KK is not 7 or nn is not 2
      */
     Viterbi_Decoder(int32_t KK, int32_t nn, int32_t LL, const std::array<int32_t, 2>& g);
 
@@ -51,78 +59,24 @@ public:
      */
     void decode(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c);
 
+    /*!
+     * \brief Same as above, with LL output bits and nn * (LL + KK - 1) input symbols.
+     */
+    void decode(int32_t* output_u_int, const float* input_c);
+
     /*!
      * \brief Reset internal status
      */
     void reset();
 
 private:
-    /*
-     * Function that creates the transit and output vectors
-     */
-    void nsc_transit(std::vector<int32_t>& output_p,
-        std::vector<int32_t>& trans_p,
-        int32_t input) const;
-
-    /*
-     *  Computes the branch metric used for decoding.
-     *  \return (returned float) The metric between the hypothetical symbol and the received vector
-     *  \param[in] symbol        The hypothetical symbol
-     *
-     */
-    float Gamma(int32_t symbol) const;
-
-    /*
-     * Determines if a symbol has odd (1) or even (0) parity
-     *    Output parameters:
-     * \return (returned int): The symbol's parity = 1 for odd and 0 for even
-     *
-     * \param[in] symbol  The integer-valued symbol
-     * \param[in] length  The highest bit position in the symbol
-     *
-     * This function is used by nsc_enc_bit()
-     */
-    int32_t parity_counter(int32_t symbol, int32_t length) const;
-
-    /*
-     * Convolutionally encodes a single bit using a rate 1/n encoder.
-     * Takes in one input bit at a time, and produces a n-bit output.
-     *
-     * \return (returned int): Computed output
-     *
-     * \param[in]  input     The input data bit (i.e. a 0 or 1).
-     * \param[in]  state_in  The starting state of the encoder (an int from 0 to 2^m-1).
-     * \param[out] state_out_p[]  An integer containing the final state of the encoder
-     *                               (i.e. the state after encoding this bit)
-     *
-     * This function is used by nsc_transit()
-     */
-    int32_t nsc_enc_bit(int32_t* state_out_p,
-        int32_t input,
-        int32_t state_in) const;
-
-    std::vector<float> d_prev_section{};
-    std::vector<float> d_next_section{};
-
-    std::vector<float> d_rec_array{};
-    std::vector<float> d_metric_c{};
-    std::vector<int32_t> d_prev_bit{};
-    std::vector<int32_t> d_prev_state{};
-    std::array<int32_t, 2> d_g{};
-
-    std::vector<int32_t> d_out0;
-    std::vector<int32_t> d_out1;
-    std::vector<int32_t> d_state0;
-    std::vector<int32_t> d_state1;
+    volk_gnsssdr::vector<float> d_metrics;
+    volk_gnsssdr::vector<float> d_branch_table;
+    volk_gnsssdr::vector<uint64_t> d_decisions;
 
     float d_MAXLOG = 1e7;  // Define infinity
-    int32_t d_KK{};
-    int32_t d_nn{};
     int32_t d_LL{};
-
     int32_t d_mm{};
-    int32_t d_states{};
-    int32_t d_number_symbols{};
 };
 
 /** \} */
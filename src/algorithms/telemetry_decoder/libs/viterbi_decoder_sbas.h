@@ -18,9 +18,8 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_SBAS_H
 #define GNSS_SDR_VITERBI_DECODER_SBAS_H
 
-#include <cstddef>  // for size_t
-#include <deque>
-#include <vector>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
@@ -29,11 +28,21 @@
 
 
 /*!
- * \brief Class that implements a Viterbi decoder
+ * \brief Class that implements a continuous Viterbi decoder for the K=7, rate
+ * 1/2 convolutional code of the SBAS navigation message.
+ *
+ * The add-compare-select operations run in the
+ * volk_gnsssdr_32f_viterbi_k7r2_64u kernel. Only the survivor decisions and the
+ * received symbols of the trellis sections not decoded yet are kept, in
+ * buffers that are reused from one call to the next.
  */
 class Viterbi_Decoder_Sbas
 {
 public:
+    /*!
+     * \brief Constructor of a Viterbi decoder
+     * \throws std::invalid_argument if KK is not 7 or nn is not 2
+     */
     Viterbi_Decoder_Sbas(const int g_encoder[], int KK, int nn);
 
     void reset();
@@ -52,59 +61,23 @@ public:
         int nbits_requested, int& nbits_decoded);
 
 private:
-    class Prev
-    {
-    public:
-        int num_states;
-        Prev(int states, int t);
-        Prev(const Prev& prev);
-        Prev& operator=(const Prev& other);
-        ~Prev();
-
-        int get_anchestor_state_of_current_state(int current_state) const;
-        int get_bit_of_current_state(int current_state) const;
-        float get_metric_of_current_state(int current_state) const;
-        int get_t() const;
-        void set_current_state_as_ancestor_of_next_state(int next_state, int current_state);
-        void set_decoded_bit_for_next_state(int next_state, int bit);
-        void set_survivor_branch_metric_of_next_state(int next_state, float metric);
-
-    private:
-        std::vector<float> v_metric;
-        std::vector<int> state;
-        std::vector<int> v_bit;
-        int t;
-        int refcount;
-    };
-
     // operations on the trellis (change decoder state)
-    void init_trellis_state();
-    int do_acs(const double sym[], int nbits);
-    int do_traceback(std::size_t traceback_length);
-    int do_tb_and_decode(int traceback_length, int requested_decoding_length, int state, int output_u_int[], float& indicator_metric);
-
-    // branch metric function
-    float gamma(const float rec_array[], int symbol, int nn);
+    void do_acs(const double sym[], int nsections);
+    int do_tb_and_decode(int traceback_length, int requested_decoding_length, int output_u_int[], float& indicator_metric);
 
-    // trellis generation
-    void nsc_transit(int output_p[], int trans_p[], int input, const int g[], int KK, int nn);
-    int nsc_enc_bit(int state_out_p[], int input, int state_in, const int g[], int KK, int nn);
-    int parity_counter(int symbol, int length);
+    // branch metric of the transition leaving state with the given input bit
+    float survivor_branch_metric(uint32_t state, uint32_t bit, const float sym[]) const;
 
     // trellis state
-    std::deque<Prev> d_trellis_paths;
-    std::vector<float> d_pm_t;
-    std::vector<float> d_metric_c;  /* Set of all possible branch metrics */
-    std::vector<float> d_rec_array; /* Received values for one trellis section */
+    volk_gnsssdr::vector<float> d_metrics;
+    volk_gnsssdr::vector<uint64_t> d_decisions;  // one word per trellis section
+    volk_gnsssdr::vector<float> d_symbols;       // nn symbols per trellis section
 
     // trellis definition
-    std::vector<int> d_out0;
-    std::vector<int> d_state0;
-    std::vector<int> d_out1;
-    std::vector<int> d_state1;
+    volk_gnsssdr::vector<float> d_branch_table;
 
     // measures
-    float d_indicator_metric;
+    float d_indicator_metric{};
 
     // code properties
     int d_KK;
@@ -113,11 +86,9 @@ private:
     // derived code properties
     int d_mm;
     int d_states;
-    int d_number_symbols;
-    bool d_trellis_state_is_initialised;
+    int d_sections{};  // trellis sections not decoded yet
 };
 
-
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_VITERBI_DECODER_SBAS_H
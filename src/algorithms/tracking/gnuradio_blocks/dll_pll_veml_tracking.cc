@@ -36,6 +36,8 @@
 #include "galileo_e1_signal_replica.h"
 #include "galileo_e5_signal_replica.h"
 #include "galileo_e6_signal_replica.h"
+#include "gnss_block_profiler.h"
+#include "gnss_code_cache.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
@@ -125,12 +127,16 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_acc_carrier_phase_initialized(false),
       d_Flag_PLL_180_deg_phase_locked(false)
 {
+    d_profiler_stats = Gnss_Block_Profiler::instance().register_block(this->name(), static_cast<uint32_t>(this->unique_id()));
     // prevent telemetry symbols accumulation in output buffers
-    this->set_max_noutput_items(1);
+    const int32_t integrations_per_call = (d_trk_parameters.multiple_integrations_per_call ? d_trk_parameters.max_integrations_per_call : 1);
+    this->set_max_noutput_items(integrations_per_call);
 
     // Telemetry bit synchronization message port input
     this->message_port_register_out(pmt::mp("events"));
-    this->set_relative_rate(1.0 / static_cast<double>(d_trk_parameters.vector_length));
+    // GNU Radio sizes the input buffer from the relative rate, so it can hold
+    // all the integration intervals of a call
+    this->set_relative_rate(1.0 / static_cast<double>(d_trk_parameters.vector_length * integrations_per_call));
 
     // Telemetry message port input
     this->message_port_register_in(pmt::mp("telemetry_to_trk"));
@@ -529,6 +535,10 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
     // --- Initializations ---
     d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
     d_multicorrelator_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+    if (d_trk_parameters.batch_correlators)
+        {
+            d_batch_correlator = tracking_batch_correlator();
+        }
 
     // CN0 estimation and lock detector buffers
     d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(d_trk_parameters.cn0_samples);
@@ -594,6 +604,7 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
                 }
         }
     d_last_timetag_samplecounter = 0;
+    d_sample_offset_key = pmt::mp("sample_offset");
     d_timetag_waiting = false;
     set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
 }
@@ -653,6 +664,10 @@ void dll_pll_veml_tracking::start_tracking()
     Signal_[1] = d_acquisition_gnss_synchro->Signal[1];
     Signal_[2] = d_acquisition_gnss_synchro->Signal[2];
 
+    // The codes kept in the code cache are borrowed instead of copied
+    const float *tracking_code = d_tracking_code.data();
+    const float *data_code = d_data_code.data();
+
     if (d_systemName == "GPS" and d_signal_type == "1C")
         {
             gps_l1_ca_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
@@ -665,14 +680,14 @@ void dll_pll_veml_tracking::start_tracking()
         {
             if (d_trk_parameters.track_pilot)
                 {
-                    gps_l5q_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
-                    gps_l5i_code_gen_float(d_data_code, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("L5Q", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { gps_l5q_code_gen_float(dest, d_acquisition_gnss_synchro->PRN); }).data();
+                    data_code = cached_float_code("L5I", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { gps_l5i_code_gen_float(dest, d_acquisition_gnss_synchro->PRN); }).data();
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
-                    gps_l5i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("L5I", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { gps_l5i_code_gen_float(dest, d_acquisition_gnss_synchro->PRN); }).data();
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "1B")
@@ -680,21 +695,21 @@ void dll_pll_veml_tracking::start_tracking()
             if (d_trk_parameters.track_pilot)
                 {
                     const std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
-                    galileo_e1_code_gen_sinboc11_float(d_data_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("1C_SINBOC", d_acquisition_gnss_synchro->PRN, d_code_samples_per_chip * d_code_length_chips, [&](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, pilot_signal, d_acquisition_gnss_synchro->PRN); }).data();
+                    data_code = cached_float_code(std::string(Signal_.data()) + "_SINBOC", d_acquisition_gnss_synchro->PRN, d_code_samples_per_chip * d_code_length_chips, [&](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, Signal_, d_acquisition_gnss_synchro->PRN); }).data();
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code(std::string(Signal_.data()) + "_SINBOC", d_acquisition_gnss_synchro->PRN, d_code_samples_per_chip * d_code_length_chips, [&](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, Signal_, d_acquisition_gnss_synchro->PRN); }).data();
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "5X")
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
             const std::array<char, 3> signal_type_ = {{'5', 'X', '\0'}};
-            galileo_e5_a_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            const own::span<const gr_complex> aux_code = Gnss_Code_Cache::instance().complex_code(signal_type_.data(), d_acquisition_gnss_synchro->PRN, 0, d_code_length_chips,
+                [&](own::span<gr_complex> dest) { galileo_e5_a_code_gen_complex_primary(dest, d_acquisition_gnss_synchro->PRN, signal_type_); });
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = GALILEO_E5A_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
@@ -704,7 +719,7 @@ void dll_pll_veml_tracking::start_tracking()
                             d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
@@ -716,9 +731,9 @@ void dll_pll_veml_tracking::start_tracking()
         }
     else if (d_systemName == "Galileo" and d_signal_type == "7X")
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
             const std::array<char, 3> signal_type_ = {{'7', 'X', '\0'}};
-            galileo_e5_b_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            const own::span<const gr_complex> aux_code = Gnss_Code_Cache::instance().complex_code(signal_type_.data(), d_acquisition_gnss_synchro->PRN, 0, d_code_length_chips,
+                [&](own::span<gr_complex> dest) { galileo_e5_b_code_gen_complex_primary(dest, d_acquisition_gnss_synchro->PRN, signal_type_); });
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = GALILEO_E5B_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
@@ -728,7 +743,7 @@ void dll_pll_veml_tracking::start_tracking()
                             d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
@@ -743,14 +758,14 @@ void dll_pll_veml_tracking::start_tracking()
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = galileo_e6_c_secondary_code(d_acquisition_gnss_synchro->PRN);
-                    galileo_e6_b_code_gen_float_primary(d_data_code, d_acquisition_gnss_synchro->PRN);
-                    galileo_e6_c_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    data_code = cached_float_code("E6B", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { galileo_e6_b_code_gen_float_primary(dest, d_acquisition_gnss_synchro->PRN); }).data();
+                    tracking_code = cached_float_code("E6C", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { galileo_e6_c_code_gen_float_primary(dest, d_acquisition_gnss_synchro->PRN); }).data();
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e6_b_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("E6B", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { galileo_e6_b_code_gen_float_primary(dest, d_acquisition_gnss_synchro->PRN); }).data();
                 }
         }
     else if (d_systemName == "Beidou" and d_signal_type == "B1")
@@ -819,7 +834,7 @@ void dll_pll_veml_tracking::start_tracking()
                 }
         }
 
-    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, tracking_code, d_local_code_shift_chips.data());
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -1025,6 +1040,33 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
     d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
+    if (d_batch_correlator)
+        {
+            // Run the correlations along with the ones of the other channels
+            int32_t num_jobs = 1;
+            d_multicorrelator_cpu.fill_correlation_job(d_correlation_jobs[0],
+                d_rem_carr_phase_rad,
+                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                d_trk_parameters.vector_length);
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_correlator_data_cpu.set_input_output_vectors(d_Prompt_Data.data(), input_samples);
+                    d_correlator_data_cpu.fill_correlation_job(d_correlation_jobs[1],
+                        d_rem_carr_phase_rad,
+                        static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                        static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                        d_trk_parameters.vector_length);
+                    num_jobs = 2;
+                }
+            d_batch_correlator->execute(d_correlation_jobs.data(), num_jobs);
+            return;
+        }
+
     d_multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
         d_rem_carr_phase_rad,
         static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
@@ -1410,7 +1452,7 @@ void dll_pll_veml_tracking::log_data()
                     d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
                     d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
                     // PRN start sample stamp
-                    tmp_long_int = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
+                    tmp_long_int = d_step_sample_counter + d_sample_counter_offset + static_cast<uint64_t>(d_current_prn_length_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
                     // accumulated carrier phase
                     tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
@@ -1444,7 +1486,7 @@ void dll_pll_veml_tracking::log_data()
                     // AUX vars (for debug purposes)
                     tmp_float = static_cast<float>(d_rem_code_phase_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
+                    tmp_double = static_cast<double>(d_step_sample_counter + d_sample_counter_offset + d_current_prn_length_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                     // PRN
                     uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
@@ -1711,12 +1753,11 @@ int64_t dll_pll_veml_tracking::uint64diff(uint64_t first, uint64_t second)
 }
 
 
-int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+// Runs the tracking state machine over one integration interval starting at
+// in. Returns true if a Gnss_Synchro object was written to out, and sets
+// consumed_samples to the number of input samples to skip before the next one
+bool dll_pll_veml_tracking::process_integration(const gr_complex *in, int32_t available_samples, Gnss_Synchro *out, int32_t &consumed_samples)
 {
-    gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
     bool loss_of_lock = false;
@@ -1724,7 +1765,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
     if (d_pull_in_transitory == true)
         {
             // if (d_trk_parameters.pull_in_time_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
-            if (d_trk_parameters.pull_in_time_s < (this->nitems_read(0) - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
+            if (d_trk_parameters.pull_in_time_s < (d_step_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
                 {
                     d_pull_in_transitory = false;
                     d_carrier_lock_fail_counter = 0;
@@ -1736,15 +1777,15 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
                 // d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
-                consume_each(ninput_items[0]);
-                return 0;
+                consumed_samples = available_samples;
+                return false;
                 break;
             }
         case 1:  // Pull-in
             {
                 // Signal alignment (skip samples until the incoming signal is aligned with local replica)
                 // const int64_t acq_trk_diff_samples = static_cast<int64_t>(d_sample_counter) - static_cast<int64_t>(d_acq_sample_stamp);
-                const int64_t acq_trk_diff_samples = static_cast<int64_t>(this->nitems_read(0)) - static_cast<int64_t>(d_acq_sample_stamp);
+                const int64_t acq_trk_diff_samples = static_cast<int64_t>(d_step_sample_counter) - static_cast<int64_t>(d_acq_sample_stamp);
                 const double acq_trk_diff_seconds = static_cast<double>(acq_trk_diff_samples) / d_trk_parameters.fs_in;
                 const double delta_trk_to_acq_prn_start_samples = static_cast<double>(acq_trk_diff_samples) - d_acq_code_phase_samples;
 
@@ -1769,8 +1810,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
-                consume_each(samples_offset);  // shift input to perform alignment with local replica
-                return 0;
+                consumed_samples = samples_offset;  // shift input to perform alignment with local replica
+                return false;
             }
         case 2:  // Wide tracking and symbol synchronization
             {
@@ -1793,7 +1834,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
 
                 // fail-safe: check if the secondary code or bit synchronization has not succeeded in a limited time period
                 // if (d_trk_parameters.bit_synchronization_time_limit_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
-                if (d_trk_parameters.bit_synchronization_time_limit_s < (this->nitems_read(0) - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
+                if (d_trk_parameters.bit_synchronization_time_limit_s < (d_step_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
                     {
                         d_carrier_lock_fail_counter = 300000;  // force loss-of-lock condition
                         LOG(INFO) << d_systemName << " " << d_signal_pretty_name << " tracking synchronization time limit reached in channel " << d_channel
@@ -2015,9 +2056,13 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
 
     // time tags
     std::vector<gr::tag_t> tags_vec;
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + d_current_prn_length_samples);
+    this->get_tags_in_range(tags_vec, 0, d_step_sample_counter, d_step_sample_counter + d_current_prn_length_samples);
     for (const auto &it : tags_vec)
         {
+            if (pmt::eq(it.key, d_sample_offset_key))
+                {
+                    continue;  // already handled in general_work()
+                }
             try
                 {
                     if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
@@ -2026,7 +2071,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                             // std::cout << "ch[" << d_acquisition_gnss_synchro->Channel_ID << "] tracking time tag with offset " << it->offset << " vs. nread " << this->nitems_read(0) << " containing ";
                             const auto last_timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
                             d_last_timetag = *last_timetag;
-                            d_last_timetag_samplecounter = it.offset;
+                            d_last_timetag_samplecounter = it.offset + d_sample_counter_offset;
                             d_timetag_waiting = true;
                         }
                     else
@@ -2044,15 +2089,15 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 }
         }
 
-    consume_each(d_current_prn_length_samples);
+    consumed_samples = d_current_prn_length_samples;
     // d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
     if (current_synchro_data.Flag_valid_symbol_output || loss_of_lock)
         {
             current_synchro_data.fs = static_cast<int64_t>(d_trk_parameters.fs_in);
-            current_synchro_data.Tracking_sample_counter = this->nitems_read(0);
+            current_synchro_data.Tracking_sample_counter = d_step_sample_counter + d_sample_counter_offset;
             current_synchro_data.Flag_valid_symbol_output = !loss_of_lock;
             current_synchro_data.Flag_PLL_180_deg_phase_locked = d_Flag_PLL_180_deg_phase_locked;
-            *out[0] = current_synchro_data;
+            *out = current_synchro_data;
 
             // generate new tag associated with gnss-synchro object
 
@@ -2068,13 +2113,51 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     tmp_obj->tow_ms = d_last_timetag.tow_ms + static_cast<int>(intpart);
                     tmp_obj->tow_ms_fraction = d_last_timetag.tow_ms_fraction;
                     tmp_obj->rx_time = static_cast<double>(current_synchro_data.Tracking_sample_counter) / d_trk_parameters.fs_in;
-                    add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+                    add_item_tag(0, d_step_output_counter + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
 
                     // std::cout << "[" << this->nitems_written(0) + 1 << "][diff_time: " << 1000.0 * static_cast<double>(diff_samplecount) / d_trk_parameters.fs_in << "] Sent TimeTag Week: " << d_last_timetag.week << ", TOW: " << d_last_timetag.tow_ms << " [ms], TOW fraction: " << d_last_timetag.tow_ms_fraction << " [ms] \n";
                     d_timetag_waiting = false;
                 }
 
-            return 1;
+            return true;
         }
-    return 0;
+    return false;
+}
+
+int dll_pll_veml_tracking::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    const Gnss_Block_Timer profiler_timer(d_profiler_stats.get(), this->nitems_read(0), ninput_items[0]);
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
+
+    // Samples dropped by a gnss_sdr_sample_gate while the channel was idle.
+    // The gate only opens before a new acquisition, so the offset never
+    // changes in the middle of a tracking operation
+    this->get_tags_in_range(d_sample_offset_tags, 0, this->nitems_read(0), this->nitems_read(0) + ninput_items[0], d_sample_offset_key);
+    if (!d_sample_offset_tags.empty())
+        {
+            d_sample_counter_offset = pmt::to_uint64(d_sample_offset_tags.back().value);
+        }
+
+    const int32_t min_step_samples = static_cast<int32_t>(d_trk_parameters.vector_length) * 2;  // as requested in forecast()
+    int32_t consumed_samples = 0;
+    int produced_items = 0;
+    do
+        {
+            // GNU Radio only updates the item counters when this function returns
+            d_step_sample_counter = this->nitems_read(0) + static_cast<uint64_t>(consumed_samples);
+            d_step_output_counter = this->nitems_written(0) + static_cast<uint64_t>(produced_items);
+            int32_t step_samples = 0;
+            if (process_integration(in + consumed_samples, ninput_items[0] - consumed_samples, out + produced_items, step_samples))
+                {
+                    produced_items++;
+                }
+            consumed_samples += step_samples;
+        }
+    while (d_trk_parameters.multiple_integrations_per_call && produced_items < noutput_items && ninput_items[0] - consumed_samples >= min_step_samples);
+
+    consume_each(consumed_samples);
+    return produced_items;
 }
@@ -22,21 +22,25 @@
 #include "dll_pll_conf.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
-#include "gnss_time.h"                // for timetags produced by File_Timestamp_Signal_Source
-#include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
-#include "tracking_loop_filter.h"     // for DLL filter
+#include "gnss_time.h"                  // for timetags produced by File_Timestamp_Signal_Source
+#include "tracking_FLL_PLL_filter.h"    // for PLL/FLL filter
+#include "tracking_batch_correlator.h"  // for Tracking_Batch_Correlator
+#include "tracking_loop_filter.h"       // for DLL filter
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
 #include <gnuradio/gr_complex.h>              // for gr_complex
 #include <gnuradio/types.h>                   // for gr_vector_int, gr_vector...
 #include <pmt/pmt.h>                          // for pmt_t
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>                              // for array
 #include <cstddef>                            // for size_t
 #include <cstdint>                            // for int32_t
 #include <fstream>                            // for ofstream
+#include <memory>                             // for shared_ptr
 #include <string>                             // for string
 #include <typeinfo>                           // for typeid
 #include <utility>                            // for pair
+#include <vector>                             // for vector
 
 /** \addtogroup Tracking
  * \{ */
@@ -45,6 +49,7 @@
  * \{ */
 
 
+class Gnss_Block_Stats;
 class Gnss_Synchro;
 class dll_pll_veml_tracking;
 
@@ -84,12 +89,18 @@ private:
     void log_data();
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
     bool acquire_secondary();
+    bool process_integration(const gr_complex *in, int32_t available_samples, Gnss_Synchro *out, int32_t &consumed_samples);
     int64_t uint64diff(uint64_t first, uint64_t second);
     int32_t save_matfile() const;
 
     Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;
     Cpu_Multicorrelator_Real_Codes d_correlator_data_cpu;  // for data channel
 
+    // Batched correlations, shared with the other tracking channels
+    std::shared_ptr<Tracking_Batch_Correlator> d_batch_correlator;
+    std::array<Tracking_Correlation_Job, 2> d_correlation_jobs{};
+    std::shared_ptr<Gnss_Block_Stats> d_profiler_stats;
+
     Dll_Pll_Conf d_trk_parameters;
 
     Exponential_Smoother d_cn0_smoother;
@@ -169,6 +180,11 @@ private:
     uint64_t d_acq_sample_stamp;
     GnssTime d_last_timetag{};
     uint64_t d_last_timetag_samplecounter;
+    uint64_t d_step_sample_counter{0ULL};    // input sample at the start of the current integration
+    uint64_t d_step_output_counter{0ULL};    // output item of the current integration
+    uint64_t d_sample_counter_offset{0ULL};  // samples dropped upstream, see gnss_sdr_sample_gate
+    std::vector<gr::tag_t> d_sample_offset_tags;
+    pmt::pmt_t d_sample_offset_key;
     bool d_timetag_waiting;
 
     float *d_prompt_data_shift;
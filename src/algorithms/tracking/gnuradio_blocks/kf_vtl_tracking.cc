@@ -33,6 +33,7 @@
 #include "galileo_e1_signal_replica.h"
 #include "galileo_e5_signal_replica.h"
 #include "galileo_e6_signal_replica.h"
+#include "gnss_code_cache.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
@@ -643,6 +644,10 @@ void kf_vtl_tracking::start_tracking()
     Signal_[1] = d_acquisition_gnss_synchro->Signal[1];
     Signal_[2] = d_acquisition_gnss_synchro->Signal[2];
 
+    // The codes kept in the code cache are borrowed instead of copied
+    const float *tracking_code = d_tracking_code.data();
+    const float *data_code = d_data_code.data();
+
     if (d_systemName == "GPS" and d_signal_type == "1C")
         {
             gps_l1_ca_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
@@ -655,14 +660,14 @@ void kf_vtl_tracking::start_tracking()
         {
             if (d_trk_parameters.track_pilot)
                 {
-                    gps_l5q_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
-                    gps_l5i_code_gen_float(d_data_code, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("L5Q", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { gps_l5q_code_gen_float(dest, d_acquisition_gnss_synchro->PRN); }).data();
+                    data_code = cached_float_code("L5I", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { gps_l5i_code_gen_float(dest, d_acquisition_gnss_synchro->PRN); }).data();
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
-                    gps_l5i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("L5I", d_acquisition_gnss_synchro->PRN, d_code_length_chips, [&](own::span<float> dest) { gps_l5i_code_gen_float(dest, d_acquisition_gnss_synchro->PRN); }).data();
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "1B")
@@ -670,21 +675,21 @@ void kf_vtl_tracking::start_tracking()
             if (d_trk_parameters.track_pilot)
                 {
                     const std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
-                    galileo_e1_code_gen_sinboc11_float(d_data_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code("1C_SINBOC", d_acquisition_gnss_synchro->PRN, d_code_samples_per_chip * d_code_length_chips, [&](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, pilot_signal, d_acquisition_gnss_synchro->PRN); }).data();
+                    data_code = cached_float_code(std::string(Signal_.data()) + "_SINBOC", d_acquisition_gnss_synchro->PRN, d_code_samples_per_chip * d_code_length_chips, [&](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, Signal_, d_acquisition_gnss_synchro->PRN); }).data();
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    tracking_code = cached_float_code(std::string(Signal_.data()) + "_SINBOC", d_acquisition_gnss_synchro->PRN, d_code_samples_per_chip * d_code_length_chips, [&](own::span<float> dest) { galileo_e1_code_gen_sinboc11_float(dest, Signal_, d_acquisition_gnss_synchro->PRN); }).data();
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "5X")
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
             const std::array<char, 3> signal_type_ = {{'5', 'X', '\0'}};
-            galileo_e5_a_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            const own::span<const gr_complex> aux_code = Gnss_Code_Cache::instance().complex_code(signal_type_.data(), d_acquisition_gnss_synchro->PRN, 0, d_code_length_chips,
+                [&](own::span<gr_complex> dest) { galileo_e5_a_code_gen_complex_primary(dest, d_acquisition_gnss_synchro->PRN, signal_type_); });
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = GALILEO_E5A_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
@@ -694,7 +699,7 @@ void kf_vtl_tracking::start_tracking()
                             d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
@@ -706,9 +711,9 @@ void kf_vtl_tracking::start_tracking()
         }
     else if (d_systemName == "Galileo" and d_signal_type == "7X")
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
             const std::array<char, 3> signal_type_ = {{'7', 'X', '\0'}};
-            galileo_e5_b_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            const own::span<const gr_complex> aux_code = Gnss_Code_Cache::instance().complex_code(signal_type_.data(), d_acquisition_gnss_synchro->PRN, 0, d_code_length_chips,
+                [&](own::span<gr_complex> dest) { galileo_e5_b_code_gen_complex_primary(dest, d_acquisition_gnss_synchro->PRN, signal_type_); });
             if (d_trk_parameters.track_pilot)
                 {
                     d_secondary_code_string = GALILEO_E5B_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
@@ -718,7 +723,7 @@ void kf_vtl_tracking::start_tracking()
                             d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
                         }
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, data_code, d_prompt_data_shift);
                 }
             else
                 {
@@ -794,7 +799,7 @@ void kf_vtl_tracking::start_tracking()
                 }
         }
 
-    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, tracking_code, d_local_code_shift_chips.data());
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -842,19 +847,10 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
 {
     // Kalman Filter class variables
     const double Ti = d_correlation_length_ms * 0.001;
-    // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz,carrier_freq_rate_hz, code_freq_chips_s
-    d_F = arma::mat(5, 5);
-    d_F << 1 << 0 << 0 << 0 << Ti << arma::endr
-        << 0 << 1 << 2.0 * GNSS_PI * Ti << GNSS_PI * (Ti * Ti) << 0 << arma::endr
-        << 0 << 0 << 1 << Ti << 0 << arma::endr
-        << 0 << 0 << 0 << 1 << 0 << arma::endr
-        << 0 << 0 << 0 << 0 << 1 << arma::endr;
-
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H = arma::mat(2, 5);
-    d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
-        << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
+    // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz, code_freq_chips_s
+    d_kf.set_model(Ti, B);
 
     // Phase noise variance
     // const double CN0_lin = pow(10.0, d_trk_parameters.expected_cn0_dbhz / 10.0);  // CN0 in Hz
@@ -863,41 +859,23 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
     // const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
 
     // measurement covariance matrix (static)
-    d_R = arma::mat(2, 2);
-    //    d_R << Sigma2_Tau << 0 << arma::endr
-    //      << 0 << Sigma2_Phase << arma::endr;
-
-    d_R << pow(d_trk_parameters.code_disc_sd_chips, 2.0) << 0 << arma::endr
-        << 0 << pow(d_trk_parameters.carrier_disc_sd_rads, 2.0) << arma::endr;
+    d_kf.set_measurement_noise(pow(d_trk_parameters.code_disc_sd_chips, 2.0), pow(d_trk_parameters.carrier_disc_sd_rads, 2.0));
 
     // system covariance matrix (static)
-    d_Q = arma::mat(5, 5);
-    d_Q << pow(d_trk_parameters.code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
-        << 0 << pow(d_trk_parameters.carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
-        << 0 << 0 << pow(d_trk_parameters.carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
-        << 0 << 0 << 0 << pow(d_trk_parameters.carrier_freq_rate_sd_hz_s, 2.0) << 0 << arma::endr
-        << 0 << 0 << 0 << 0 << pow(d_trk_parameters.code_rate_sd_chips_s, 2.0) << arma::endr;
-
-    // initial Kalman covariance matrix
-    d_P_old_old = arma::mat(5, 5);
-
-    d_P_old_old << pow(d_trk_parameters.init_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
-                << 0 << pow(d_trk_parameters.init_carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
-                << 0 << 0 << pow(d_trk_parameters.init_carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
-                << 0 << 0 << 0 << pow(d_trk_parameters.init_carrier_freq_rate_sd_hz_s, 2.0) << 0 << arma::endr
-                << 0 << 0 << 0 << 0 << pow(d_trk_parameters.init_code_rate_sd_chips_s, 2.0) << arma::endr;
-
-    // init state vector
-    d_x_old_old = arma::vec(5);
+    d_kf.set_process_noise({pow(d_trk_parameters.code_phase_sd_chips, 2.0),
+        pow(d_trk_parameters.carrier_phase_sd_rad, 2.0),
+        pow(d_trk_parameters.carrier_freq_sd_hz, 2.0),
+        pow(d_trk_parameters.carrier_freq_rate_sd_hz_s, 2.0),
+        pow(d_trk_parameters.code_rate_sd_chips_s, 2.0)});
+
+    // init state vector and Kalman covariance matrix
     // states: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz_s, code_freq_rate_chips_s
-    d_x_old_old << acq_code_phase_chips << 0 << acq_doppler_hz << 0 << 0 << arma::endr;
-
-    //    std::cout << "F: " << d_F << "\n";
-    //    std::cout << "H: " << d_H << "\n";
-    //    std::cout << "R: " << d_R << "\n";
-    //    std::cout << "Q: " << d_Q << "\n";
-    //    std::cout << "P: " << d_P_old_old << "\n";
-    //    std::cout << "x: " << d_x_old_old << "\n";
+    d_kf.reset({acq_code_phase_chips, 0.0, acq_doppler_hz, 0.0, 0.0},
+        {pow(d_trk_parameters.init_code_phase_sd_chips, 2.0),
+            pow(d_trk_parameters.init_carrier_phase_sd_rad, 2.0),
+            pow(d_trk_parameters.init_carrier_freq_sd_hz, 2.0),
+            pow(d_trk_parameters.init_carrier_freq_rate_sd_hz_s, 2.0),
+            pow(d_trk_parameters.init_code_rate_sd_chips_s, 2.0)});
 }
 
 
@@ -905,29 +883,20 @@ void kf_vtl_tracking::update_kf_narrow_integration_time()
 {
     // Kalman Filter class variables
     const double Ti = d_current_correlation_time_s;
-
-    // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz,carrier_freq_rate_hz, code_freq_chips_s
-    d_F << 1 << 0 << 0 << 0 << Ti << arma::endr
-        << 0 << 1 << 2.0 * GNSS_PI * Ti << GNSS_PI * (Ti * Ti) << 0 << arma::endr
-        << 0 << 0 << 1 << Ti << 0 << arma::endr
-        << 0 << 0 << 0 << 1 << 0 << arma::endr
-        << 0 << 0 << 0 << 0 << 1 << arma::endr;
-
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
-        << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
+    // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz, code_freq_chips_s
+    d_kf.set_model(Ti, B);
 
     // measurement covariance matrix (static)
-    d_R << pow(d_trk_parameters.code_disc_sd_chips, 2.0) << 0 << arma::endr
-        << 0 << pow(d_trk_parameters.carrier_disc_sd_rads, 2.0) << arma::endr;
+    d_kf.set_measurement_noise(pow(d_trk_parameters.code_disc_sd_chips, 2.0), pow(d_trk_parameters.carrier_disc_sd_rads, 2.0));
 
     // system covariance matrix (static)
-    d_Q << pow(d_trk_parameters.narrow_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
-        << 0 << pow(d_trk_parameters.narrow_carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
-        << 0 << 0 << pow(d_trk_parameters.narrow_carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
-        << 0 << 0 << 0 << pow(d_trk_parameters.narrow_carrier_freq_rate_sd_hz_s, 2.0) << 0 << arma::endr
-        << 0 << 0 << 0 << 0 << pow(d_trk_parameters.narrow_code_rate_sd_chips_s, 2.0) << arma::endr;
+    d_kf.set_process_noise({pow(d_trk_parameters.narrow_code_phase_sd_chips, 2.0),
+        pow(d_trk_parameters.narrow_carrier_phase_sd_rad, 2.0),
+        pow(d_trk_parameters.narrow_carrier_freq_sd_hz, 2.0),
+        pow(d_trk_parameters.narrow_carrier_freq_rate_sd_hz_s, 2.0),
+        pow(d_trk_parameters.narrow_code_rate_sd_chips_s, 2.0)});
 }
 
 
@@ -937,9 +906,8 @@ void kf_vtl_tracking::update_kf_cn0(double current_cn0_dbhz)
     const double Ti = d_correlation_length_ms * 0.001;
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H = arma::mat(2, 5);
-    d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
-        << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
+    // The state transition matrix keeps the current integration time
+    d_kf.set_measurement_matrix(Ti, B);
 
     // Phase noise variance
     const double CN0_lin = pow(10.0, current_cn0_dbhz / 10.0);  // CN0 in Hz
@@ -948,9 +916,7 @@ void kf_vtl_tracking::update_kf_cn0(double current_cn0_dbhz)
     const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
 
     // measurement covariance matrix (static)
-    d_R = arma::mat(2, 2);
-    d_R << Sigma2_Tau << 0 << arma::endr
-        << 0 << Sigma2_Phase << arma::endr;
+    d_kf.set_measurement_noise(Sigma2_Tau, Sigma2_Phase);
 }
 
 
@@ -1150,32 +1116,19 @@ void kf_vtl_tracking::run_Kf()
         }
 
     // Kalman loop
-
-    // Prediction
-    d_x_new_old = d_F * d_x_old_old;
-    d_P_new_old = d_F * d_P_old_old * d_F.t() + d_Q;
-
-    // Innovation
-    arma::vec z = {d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI};
-
-    // Measurement update
-    arma::mat K = d_P_new_old * d_H.t() * arma::inv(d_H * d_P_new_old * d_H.t() + d_R);  // Kalman gain
-
-    d_x_new_new = d_x_new_old + K * z;
-
-    d_P_new_new = (arma::eye(5, 5) - K * d_H) * d_P_new_old;
+    d_kf.update(d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI);
 
     // new code phase estimation
-    d_code_error_kf_chips = d_x_new_new(0);
-    d_x_new_new(0) = 0;  // reset error estimation because the NCO corrects the code phase
+    d_code_error_kf_chips = d_kf.state(0);
+    d_kf.set_state(0, 0.0);  // reset error estimation because the NCO corrects the code phase
 
     // new carrier phase estimation
-    d_carrier_phase_kf_rad = d_x_new_new(1);
+    d_carrier_phase_kf_rad = d_kf.state(1);
 
     // New carrier Doppler frequency estimation
-    d_carrier_doppler_kf_hz = d_x_new_new(2);  // d_carrier_loop_filter.get_carrier_error(0, static_cast<float>(d_carr_phase_error_hz), static_cast<float>(d_current_correlation_time_s));
+    d_carrier_doppler_kf_hz = d_kf.state(2);  // d_carrier_loop_filter.get_carrier_error(0, static_cast<float>(d_carr_phase_error_hz), static_cast<float>(d_current_correlation_time_s));
 
-    d_carrier_doppler_rate_kf_hz_s = d_x_new_new(3);
+    d_carrier_doppler_rate_kf_hz_s = d_kf.state(3);
 
     // New code Doppler frequency estimation
     if (d_trk_parameters.carrier_aiding)
@@ -1186,9 +1139,9 @@ void kf_vtl_tracking::run_Kf()
     else
         {
             // use its own KF code rate estimation
-            d_code_freq_kf_chips_s -= d_x_new_new(4);
+            d_code_freq_kf_chips_s -= d_kf.state(4);
         }
-    d_x_new_new(4) = 0;
+    d_kf.set_state(4, 0.0);
     // Experimental: detect Carrier Doppler vs. Code Doppler incoherence and correct the Carrier Doppler
     //    if (d_trk_parameters.enable_doppler_correction == true)
     //        {
@@ -1201,10 +1154,6 @@ void kf_vtl_tracking::run_Kf()
     // correct code and carrier phase
     d_rem_code_phase_samples += d_trk_parameters.fs_in * d_code_error_kf_chips / d_code_freq_kf_chips_s;
     d_rem_carr_phase_rad = d_carrier_phase_kf_rad;
-
-    // prepare data for next KF epoch
-    d_x_old_old = d_x_new_new;
-    d_P_old_old = d_P_new_new;
 }
 
 
@@ -1475,7 +1424,7 @@ void kf_vtl_tracking::log_data()
                     // Carrier estimation
                     tmp_float = static_cast<float>(d_carr_phase_error_disc_hz);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_x_new_new(2));
+                    tmp_float = static_cast<float>(d_kf.state(2));
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // code estimation
                     tmp_float = static_cast<float>(d_code_error_disc_chips);
@@ -21,18 +21,14 @@
 #ifndef GNSS_SDR_KF_VTL_TRACKING_H
 #define GNSS_SDR_KF_VTL_TRACKING_H
 
-#if ARMA_NO_BOUND_CHECKING
-#define ARMA_NO_DEBUG 1
-#endif
-
 #include "cpu_multicorrelator_real_codes.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
 #include "gnss_time.h"  // for timetags produced by File_Timestamp_Signal_Source
 #include "kf_conf.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
+#include "tracking_kalman_filter.h"   // for Tracking_Kalman_Filter
 #include "tracking_loop_filter.h"     // for DLL filter
-#include <armadillo>
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
 #include <gnuradio/gr_complex.h>              // for gr_complex
@@ -116,16 +112,7 @@ private:
     const size_t d_int_type_hash_code = typeid(int).hash_code();
 
     // Kalman Filter class variables
-    arma::mat d_F;
-    arma::mat d_H;
-    arma::mat d_R;
-    arma::mat d_Q;
-    arma::mat d_P_old_old;
-    arma::mat d_P_new_old;
-    arma::mat d_P_new_new;
-    arma::vec d_x_old_old;
-    arma::vec d_x_new_old;
-    arma::vec d_x_new_new;
+    Tracking_Kalman_Filter d_kf;
 
     std::string d_secondary_code_string;
     std::string d_data_secondary_code_string;
@@ -20,6 +20,7 @@
  */
 
 #include "cpu_multicorrelator_real_codes.h"
+#include "tracking_batch_correlator.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <cmath>
 
@@ -144,6 +145,33 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
 }
 
 
+void Cpu_Multicorrelator_Real_Codes::fill_correlation_job(
+    Tracking_Correlation_Job& job,
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples) const
+{
+    job.corr_out = d_corr_out;
+    job.sig_in = d_sig_in;
+    job.local_code = d_local_code_in;
+    job.shifts_chips = d_shifts_chips;
+    job.rem_carrier_phase_rad = rem_carrier_phase_in_rad;
+    job.phase_step_rad = phase_step_rad;
+    job.phase_rate_step_rad = phase_rate_step_rad;
+    job.rem_code_phase_chips = rem_code_phase_chips;
+    job.code_phase_step_chips = code_phase_step_chips;
+    job.code_phase_rate_step_chips = code_phase_rate_step_chips;
+    job.code_length_chips = d_code_length_chips;
+    job.n_correlators = d_n_correlators;
+    job.signal_length_samples = signal_length_samples;
+    job.high_dynamics = d_use_high_dynamics_resampler;
+}
+
+
 bool Cpu_Multicorrelator_Real_Codes::free()
 {
     // Free memory
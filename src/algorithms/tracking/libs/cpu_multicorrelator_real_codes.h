@@ -25,6 +25,8 @@
 
 #include <complex>
 
+struct Tracking_Correlation_Job;
+
 /** \addtogroup Tracking
  * \{ */
 /** \addtogroup Tracking_libs
@@ -46,6 +48,8 @@ public:
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips = 0.0);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    // Describes the operation done by Carrier_wipeoff_multicorrelator_resampler, to be run by Tracking_Batch_Correlator
+    void fill_correlation_job(Tracking_Correlation_Job &job, float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples) const;
     bool free();
 
 private:
@@ -19,6 +19,7 @@
 #include "gnss_sdr_flags.h"
 #include "item_type_helpers.h"
 #include <glog/logging.h>
+#include <algorithm>
 
 
 Dll_Pll_Conf::Dll_Pll_Conf() : carrier_lock_th(FLAGS_carrier_lock_th),
@@ -46,6 +47,9 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     double fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", fs_in);
     fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
     high_dyn = configuration->property(role + ".high_dyn", high_dyn);
+    batch_correlators = configuration->property(role + ".batch_correlators", batch_correlators);
+    multiple_integrations_per_call = configuration->property(role + ".multiple_integrations_per_call", multiple_integrations_per_call);
+    max_integrations_per_call = std::max(configuration->property(role + ".max_integrations_per_call", max_integrations_per_call), 1);
     dump = configuration->property(role + ".dump", dump);
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
     dump_mat = configuration->property(role + ".dump_mat", dump_mat);
@@ -70,6 +70,7 @@ public:
     int32_t cn0_min{0};
     int32_t max_code_lock_fail{0};
     int32_t max_carrier_lock_fail{0};
+    int32_t max_integrations_per_call{20};
     char signal[3]{};
     char system{'G'};
     bool enable_fll_pull_in{false};
@@ -78,6 +79,8 @@ public:
     bool enable_doppler_correction{false};
     bool carrier_aiding{true};
     bool high_dyn{false};
+    bool batch_correlators{false};
+    bool multiple_integrations_per_call{false};
     bool dump{false};
     bool dump_mat{true};
 };
@@ -0,0 +1,161 @@
+/*!
+ * \file tracking_batch_correlator.cc
+ * \brief Carrier wipe-off and multicorrelator kernel that processes the
+ * correlations requested by several tracking channels in a single pass.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_batch_correlator.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for sort, max
+#include <cmath>
+#include <functional>  // for less
+#include <thread>
+
+
+void Tracking_Batch_Correlator::execute(Tracking_Correlation_Job* jobs, int num_jobs)
+{
+    Request request{jobs, num_jobs, false};
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_pending.push_back(&request);
+    while (!request.done)
+        {
+            if (d_combining)
+                {
+                    d_done_cv.wait(lock);
+                    continue;
+                }
+
+            // Become the combiner of all the requests submitted so far
+            d_combining = true;
+            d_batch.swap(d_pending);
+            d_pending.clear();
+            lock.unlock();
+
+            d_batch_jobs.clear();
+            for (const auto* req : d_batch)
+                {
+                    for (int j = 0; j < req->num_jobs; j++)
+                        {
+                            d_batch_jobs.push_back(&req->jobs[j]);
+                        }
+                }
+            correlate(d_batch_jobs.data(), d_batch_jobs.size());
+
+            lock.lock();
+            for (auto* req : d_batch)
+                {
+                    req->done = true;
+                }
+            d_batch.clear();
+            d_combining = false;
+            d_done_cv.notify_all();
+        }
+}
+
+
+void Tracking_Batch_Correlator::correlate(Tracking_Correlation_Job* const* jobs, size_t num_jobs)
+{
+    if (num_jobs == 0)
+        {
+            return;
+        }
+
+    // Jobs reading the same part of the input are processed back to back
+    d_sorted_jobs.assign(jobs, jobs + num_jobs);
+    std::sort(d_sorted_jobs.begin(), d_sorted_jobs.end(), [](const Tracking_Correlation_Job* a, const Tracking_Correlation_Job* b) {
+        return std::less<const std::complex<float>*>()(a->sig_in, b->sig_in);
+    });
+
+    int max_correlators = 0;
+    int max_length = 0;
+    for (const auto* job : d_sorted_jobs)
+        {
+            max_correlators = std::max(max_correlators, job->n_correlators);
+            max_length = std::max(max_length, job->signal_length_samples);
+        }
+
+    // Scratch for the resampled codes, shared by all the jobs of the batch.
+    // Each code starts at an aligned address, as the per-channel buffers do.
+    const size_t alignment = std::max(volk_gnsssdr_get_alignment() / sizeof(float), static_cast<size_t>(1));
+    const size_t stride = (static_cast<size_t>(max_length) + alignment - 1) / alignment * alignment;
+    if (d_code_stride < stride || d_code_pointers.size() < static_cast<size_t>(max_correlators))
+        {
+            d_code_stride = std::max(d_code_stride, stride);
+            const size_t num_codes = std::max(d_code_pointers.size(), static_cast<size_t>(max_correlators));
+            d_codes.resize(num_codes * d_code_stride);
+            d_code_pointers.resize(num_codes);
+            for (size_t n = 0; n < num_codes; n++)
+                {
+                    d_code_pointers[n] = d_codes.data() + n * d_code_stride;
+                }
+        }
+
+    for (const auto* job : d_sorted_jobs)
+        {
+            correlate_job(*job);
+        }
+}
+
+
+void Tracking_Batch_Correlator::correlate_job(const Tracking_Correlation_Job& job)
+{
+    // Same kernels and arguments as
+    // Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler
+    float** codes = d_code_pointers.data();
+    lv_32fc_t phase_offset_as_complex[1];
+    phase_offset_as_complex[0] = lv_cmake(std::cos(job.rem_carrier_phase_rad), -std::sin(job.rem_carrier_phase_rad));
+    if (job.high_dynamics)
+        {
+            volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(codes,
+                job.local_code,
+                job.rem_code_phase_chips,
+                job.code_phase_step_chips,
+                job.code_phase_rate_step_chips,
+                const_cast<float*>(job.shifts_chips),
+                job.code_length_chips,
+                job.n_correlators,
+                job.signal_length_samples);
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(job.corr_out, job.sig_in, std::exp(lv_32fc_t(0.0, -job.phase_step_rad)), std::exp(lv_32fc_t(0.0, -job.phase_rate_step_rad)), phase_offset_as_complex, const_cast<const float**>(codes), job.n_correlators, job.signal_length_samples);
+        }
+    else
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn(codes,
+                job.local_code,
+                job.rem_code_phase_chips,
+                job.code_phase_step_chips,
+                const_cast<float*>(job.shifts_chips),
+                job.code_length_chips,
+                job.n_correlators,
+                job.signal_length_samples);
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(job.corr_out, job.sig_in, std::exp(lv_32fc_t(0.0, -job.phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(codes), job.n_correlators, job.signal_length_samples);
+        }
+}
+
+
+std::shared_ptr<Tracking_Batch_Correlator> tracking_batch_correlator()
+{
+    static std::mutex instance_mutex;
+    static std::vector<std::weak_ptr<Tracking_Batch_Correlator>> instances(std::max(std::thread::hardware_concurrency(), 1U));
+    static size_t next_instance = 0;
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    auto& instance = instances[next_instance];
+    next_instance = (next_instance + 1) % instances.size();
+    auto correlator = instance.lock();
+    if (!correlator)
+        {
+            correlator = std::make_shared<Tracking_Batch_Correlator>();
+            instance = correlator;
+        }
+    return correlator;
+}
@@ -0,0 +1,127 @@
+/*!
+ * \file tracking_batch_correlator.h
+ * \brief Carrier wipe-off and multicorrelator kernel that processes the
+ * correlations requested by several tracking channels in a single pass.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_BATCH_CORRELATOR_H
+#define GNSS_SDR_TRACKING_BATCH_CORRELATOR_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Parameters of one carrier wipe-off and multicorrelator operation,
+ * with the same meaning as in
+ * Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler.
+ */
+struct Tracking_Correlation_Job
+{
+    std::complex<float>* corr_out{nullptr};
+    const std::complex<float>* sig_in{nullptr};
+    const float* local_code{nullptr};
+    const float* shifts_chips{nullptr};
+    float rem_carrier_phase_rad{0.0};
+    float phase_step_rad{0.0};
+    float phase_rate_step_rad{0.0};
+    float rem_code_phase_chips{0.0};
+    float code_phase_step_chips{0.0};
+    float code_phase_rate_step_chips{0.0};
+    int code_length_chips{0};
+    int n_correlators{0};
+    int signal_length_samples{0};
+    bool high_dynamics{false};
+};
+
+
+/*!
+ * \brief Multicorrelator for a batch of tracking channels.
+ *
+ * The jobs of a batch are sorted by input address, so the channels that
+ * correlate the same stretch of the input buffer read it back to back while
+ * it is still in cache. Each job runs the same VOLK_GNSSSDR kernels, with the
+ * same arguments, as Cpu_Multicorrelator_Real_Codes, so the results are
+ * identical to the ones of a per-channel correlator.
+ *
+ * execute() can be called concurrently from the scheduler threads of the
+ * tracking blocks that share the object. The calls are flat-combined: the first caller
+ * takes all the jobs submitted so far and correlates them in one pass, while
+ * the others wait for their results instead of competing for the core.
+ */
+class Tracking_Batch_Correlator
+{
+public:
+    Tracking_Batch_Correlator() = default;
+
+    Tracking_Batch_Correlator(const Tracking_Batch_Correlator&) = delete;
+    Tracking_Batch_Correlator& operator=(const Tracking_Batch_Correlator&) = delete;
+
+    /*!
+     * \brief Runs num_jobs correlations and returns when all their outputs
+     * have been written, possibly by another thread.
+     */
+    void execute(Tracking_Correlation_Job* jobs, int num_jobs);
+
+    /*!
+     * \brief Runs a batch of correlations in the calling thread. Not
+     * thread-safe, it uses the scratch buffers of the object.
+     */
+    void correlate(Tracking_Correlation_Job* const* jobs, size_t num_jobs);
+
+private:
+    struct Request
+    {
+        Tracking_Correlation_Job* jobs;
+        int num_jobs;
+        bool done;
+    };
+
+    void correlate_job(const Tracking_Correlation_Job& job);
+
+    std::vector<Request*> d_pending;
+    std::vector<Request*> d_batch;
+    std::vector<Tracking_Correlation_Job*> d_batch_jobs;
+    std::vector<Tracking_Correlation_Job*> d_sorted_jobs;
+    std::vector<float*> d_code_pointers;
+    volk_gnsssdr::vector<float> d_codes;
+    size_t d_code_stride{0};
+    std::mutex d_mutex;
+    std::condition_variable d_done_cv;
+    bool d_combining{false};
+};
+
+
+/*!
+ * \brief Returns one of the process-wide batch correlators. There is one per
+ * hardware thread and consecutive calls return them in turn, so the channels
+ * are spread evenly among them and several combiners run in parallel. Each one
+ * lives as long as some tracking block holds a reference to it.
+ */
+std::shared_ptr<Tracking_Batch_Correlator> tracking_batch_correlator();
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_BATCH_CORRELATOR_H
@@ -0,0 +1,182 @@
+/*!
+ * \file tracking_kalman_filter.cc
+ * \brief Kalman filter of the code and carrier tracking loops, with the
+ * dimensions of the state-space model fixed at compile time.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_kalman_filter.h"
+#include "MATH_CONSTANTS.h"
+
+static_assert(Tracking_Kalman_Filter::NUM_MEASUREMENTS == 2, "The innovation covariance is inverted as a 2x2 matrix");
+
+
+Tracking_Kalman_Filter::Tracking_Kalman_Filter() = default;
+
+
+void Tracking_Kalman_Filter::set_model(double Ti, double code_carrier_ratio)
+{
+    d_F = State_Matrix{};
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            d_F[i][i] = 1.0;
+        }
+    d_F[0][4] = Ti;
+    d_F[1][2] = 2.0 * GNSS_PI * Ti;
+    d_F[1][3] = GNSS_PI * (Ti * Ti);
+    d_F[2][3] = Ti;
+
+    set_measurement_matrix(Ti, code_carrier_ratio);
+}
+
+
+void Tracking_Kalman_Filter::set_measurement_matrix(double Ti, double code_carrier_ratio)
+{
+    const double B = code_carrier_ratio;
+    d_H = Measurement_Matrix{};
+    d_H[0][0] = 1.0;
+    d_H[0][2] = -B * Ti / 2.0;
+    d_H[0][3] = B * (Ti * Ti) / 6.0;
+    d_H[1][1] = 1.0;
+    d_H[1][2] = -GNSS_PI * Ti;
+    d_H[1][3] = GNSS_PI * (Ti * Ti) / 3.0;
+}
+
+
+void Tracking_Kalman_Filter::set_measurement_noise(double code_variance, double carrier_phase_variance)
+{
+    d_R[0] = code_variance;
+    d_R[1] = carrier_phase_variance;
+}
+
+
+void Tracking_Kalman_Filter::set_process_noise(const State& variances)
+{
+    d_Q = State_Matrix{};
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            d_Q[i][i] = variances[i];
+        }
+}
+
+
+void Tracking_Kalman_Filter::reset(const State& state, const State& variances)
+{
+    d_x = state;
+    d_P = State_Matrix{};
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            d_P[i][i] = variances[i];
+        }
+}
+
+
+void Tracking_Kalman_Filter::update(double code_error_chips, double carrier_phase_error_rad)
+{
+    // Prediction: x = F * x, P = F * P * F' + Q
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            double acc = 0.0;
+            for (size_t k = 0; k < NUM_STATES; k++)
+                {
+                    acc += d_F[i][k] * d_x[k];
+                }
+            d_x_pred[i] = acc;
+        }
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            for (size_t j = 0; j < NUM_STATES; j++)
+                {
+                    double acc = 0.0;
+                    for (size_t k = 0; k < NUM_STATES; k++)
+                        {
+                            acc += d_F[i][k] * d_P[k][j];
+                        }
+                    d_FP[i][j] = acc;
+                }
+        }
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            for (size_t j = 0; j < NUM_STATES; j++)
+                {
+                    double acc = d_Q[i][j];
+                    for (size_t k = 0; k < NUM_STATES; k++)
+                        {
+                            acc += d_FP[i][k] * d_F[j][k];
+                        }
+                    d_P_pred[i][j] = acc;
+                }
+        }
+
+    // Kalman gain: K = P * H' * inv(H * P * H' + R)
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            for (size_t m = 0; m < NUM_MEASUREMENTS; m++)
+                {
+                    double acc = 0.0;
+                    for (size_t k = 0; k < NUM_STATES; k++)
+                        {
+                            acc += d_P_pred[i][k] * d_H[m][k];
+                        }
+                    d_PHt[i][m] = acc;
+                }
+        }
+    std::array<std::array<double, NUM_MEASUREMENTS>, NUM_MEASUREMENTS> S{};
+    for (size_t m = 0; m < NUM_MEASUREMENTS; m++)
+        {
+            for (size_t n = 0; n < NUM_MEASUREMENTS; n++)
+                {
+                    double acc = (m == n) ? d_R[m] : 0.0;
+                    for (size_t k = 0; k < NUM_STATES; k++)
+                        {
+                            acc += d_H[m][k] * d_PHt[k][n];
+                        }
+                    S[m][n] = acc;
+                }
+        }
+    const double inv_det = 1.0 / (S[0][0] * S[1][1] - S[0][1] * S[1][0]);
+    const double S_inv00 = S[1][1] * inv_det;
+    const double S_inv01 = -S[0][1] * inv_det;
+    const double S_inv10 = -S[1][0] * inv_det;
+    const double S_inv11 = S[0][0] * inv_det;
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            d_K[i][0] = d_PHt[i][0] * S_inv00 + d_PHt[i][1] * S_inv10;
+            d_K[i][1] = d_PHt[i][0] * S_inv01 + d_PHt[i][1] * S_inv11;
+        }
+
+    // Measurement update: x = x + K * z, P = (I - K * H) * P
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            d_x[i] = d_x_pred[i] + d_K[i][0] * code_error_chips + d_K[i][1] * carrier_phase_error_rad;
+        }
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            for (size_t j = 0; j < NUM_STATES; j++)
+                {
+                    d_I_KH[i][j] = ((i == j) ? 1.0 : 0.0) - d_K[i][0] * d_H[0][j] - d_K[i][1] * d_H[1][j];
+                }
+        }
+    for (size_t i = 0; i < NUM_STATES; i++)
+        {
+            for (size_t j = 0; j < NUM_STATES; j++)
+                {
+                    double acc = 0.0;
+                    for (size_t k = 0; k < NUM_STATES; k++)
+                        {
+                            acc += d_I_KH[i][k] * d_P_pred[k][j];
+                        }
+                    d_P[i][j] = acc;
+                }
+        }
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file tracking_kalman_filter.h
+ * \brief Kalman filter of the code and carrier tracking loops, with the
+ * dimensions of the state-space model fixed at compile time.
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_KALMAN_FILTER_H
+#define GNSS_SDR_TRACKING_KALMAN_FILTER_H
+
+#include <array>
+#include <cstddef>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Kalman filter used by kf_vtl_tracking.
+ *
+ * The state vector is (code phase [chips], carrier phase [rad], carrier
+ * Doppler [Hz], carrier Doppler rate [Hz/s], code rate [chips/s]), and the
+ * measurements are the code [chips] and carrier phase [rad] discriminator
+ * outputs, which are used directly as innovations.
+ *
+ * All the matrices live in fixed-size arrays inside the object, and the
+ * predict and update steps are written as loops of compile-time length over
+ * them, so an update() call neither allocates memory nor creates temporary
+ * matrices. The innovation covariance is 2x2 and it is inverted in closed
+ * form.
+ */
+class Tracking_Kalman_Filter
+{
+public:
+    static constexpr size_t NUM_STATES = 5;
+    static constexpr size_t NUM_MEASUREMENTS = 2;
+
+    using State = std::array<double, NUM_STATES>;
+
+    Tracking_Kalman_Filter();  //!< Constructor. All the matrices are set to zero
+
+    /*!
+     * \brief Sets the state transition and measurement matrices for a
+     * coherent integration time Ti [s] and a code to carrier frequency ratio
+     * code_carrier_ratio
+     */
+    void set_model(double Ti, double code_carrier_ratio);
+
+    /*!
+     * \brief Sets only the measurement matrix for a coherent integration time
+     * Ti [s], leaving the state transition matrix untouched
+     */
+    void set_measurement_matrix(double Ti, double code_carrier_ratio);
+
+    void set_measurement_noise(double code_variance, double carrier_phase_variance);  //!< Diagonal of the measurement covariance matrix
+    void set_process_noise(const State& variances);                                   //!< Diagonal of the system covariance matrix
+    void reset(const State& state, const State& variances);                           //!< Initial state vector and diagonal of its covariance matrix
+
+    /*!
+     * \brief Runs a prediction and a measurement update step
+     */
+    void update(double code_error_chips, double carrier_phase_error_rad);
+
+    inline double state(size_t index) const
+    {
+        return d_x[index];
+    }
+
+    inline void set_state(size_t index, double value)
+    {
+        d_x[index] = value;
+    }
+
+private:
+    using State_Matrix = std::array<std::array<double, NUM_STATES>, NUM_STATES>;
+    using Measurement_Matrix = std::array<std::array<double, NUM_STATES>, NUM_MEASUREMENTS>;
+    using Gain_Matrix = std::array<std::array<double, NUM_MEASUREMENTS>, NUM_STATES>;
+
+    State_Matrix d_F{};                          // state transition matrix
+    Measurement_Matrix d_H{};                    // measurement matrix
+    State_Matrix d_Q{};                          // system covariance matrix
+    std::array<double, NUM_MEASUREMENTS> d_R{};  // diagonal of the measurement covariance matrix
+    State_Matrix d_P{};                          // state covariance matrix
+    State d_x{};                                 // state vector
+
+    // Intermediate results of update()
+    State_Matrix d_FP{};
+    State_Matrix d_P_pred{};
+    State_Matrix d_I_KH{};
+    Gain_Matrix d_PHt{};
+    Gain_Matrix d_K{};
+    State d_x_pred{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_KALMAN_FILTER_H
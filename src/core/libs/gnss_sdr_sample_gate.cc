@@ -0,0 +1,84 @@
+/*!
+ * \file gnss_sdr_sample_gate.cc
+ * \brief Block that stops forwarding samples to a channel while it is idle
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_gate.h"
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for min
+#include <cstdint>          // for uint64_t
+#include <cstring>          // for memcpy
+
+
+gnss_sdr_sample_gate::gnss_sdr_sample_gate(size_t _size)
+    : gr::block("sample_gate",
+          gr::io_signature::make(1, 1, _size),
+          gr::io_signature::make(1, 1, _size)),
+      sample_offset_key(pmt::mp("sample_offset")),
+      item_size(_size)
+{
+    set_tag_propagation_policy(TPP_DONT);  // tags are forwarded in general_work() with translated offsets
+}
+
+
+gnss_sdr_sample_gate_sptr gnss_sdr_make_sample_gate(size_t _size)
+{
+    gnss_sdr_sample_gate_sptr sample_gate_(new gnss_sdr_sample_gate(_size));
+    return sample_gate_;
+}
+
+
+void gnss_sdr_sample_gate::set_open(bool open_)
+{
+    open.store(open_, std::memory_order_relaxed);
+}
+
+
+bool gnss_sdr_sample_gate::is_open() const
+{
+    return open.load(std::memory_order_relaxed);
+}
+
+
+int gnss_sdr_sample_gate::general_work(int noutput_items,
+    gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    if (!open.load(std::memory_order_relaxed))
+        {
+            offset_pending = true;
+            consume_each(ninput_items[0]);
+            return 0;
+        }
+
+    const int n = std::min(ninput_items[0], noutput_items);
+    const uint64_t dropped_items = nitems_read(0) - nitems_written(0);
+    if (offset_pending)
+        {
+            add_item_tag(0, nitems_written(0), sample_offset_key, pmt::from_uint64(dropped_items));
+            offset_pending = false;
+        }
+    get_tags_in_range(tags, 0, nitems_read(0), nitems_read(0) + n);
+    for (auto &tag : tags)
+        {
+            tag.offset -= dropped_items;
+            add_item_tag(0, tag);
+        }
+    std::memcpy(output_items[0], input_items[0], static_cast<size_t>(n) * item_size);
+    consume_each(n);
+    return n;
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file gnss_sdr_sample_gate.h
+ * \brief Block that stops forwarding samples to a channel while it is idle
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_GATE_H
+#define GNSS_SDR_GNSS_SDR_SAMPLE_GATE_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <pmt/pmt.h>         // for pmt_t
+#include <atomic>
+#include <cstddef>  // for size_t
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+class gnss_sdr_sample_gate;
+
+using gnss_sdr_sample_gate_sptr = gnss_shared_ptr<gnss_sdr_sample_gate>;
+
+gnss_sdr_sample_gate_sptr gnss_sdr_make_sample_gate(size_t _size);
+
+/*!
+ * \brief Forwards the signal conditioner output to a channel only while the
+ * channel is acquiring or tracking.
+ *
+ * While the gate is closed, the input samples are consumed and nothing is
+ * produced, so the acquisition and tracking blocks of an idle channel are not
+ * woken up by the scheduler. The output sample counter therefore falls behind
+ * the input one. When the gate opens again, the number of samples dropped so
+ * far is attached to the first output sample in a "sample_offset" stream tag,
+ * so the tracking block can report absolute sample counters. Other stream tags
+ * are forwarded with their offsets translated to the output stream.
+ *
+ * While open, the samples are copied into the output buffer. GNU Radio gives
+ * each output port its own buffer and cannot make a block's readers share the
+ * buffer of its input. The only copy-free option is to gate inside the
+ * acquisition and tracking blocks, but then they would be scheduled for every
+ * buffer even when idle, which is the cost this block removes. The copy
+ * costs one memcpy per sample for active channels, much less than the
+ * correlations they run on the same samples.
+ */
+class gnss_sdr_sample_gate : public gr::block
+{
+public:
+    ~gnss_sdr_sample_gate() = default;
+
+    void set_open(bool open);  //!< Thread-safe, it can be called while the flowgraph is running
+
+    bool is_open() const;  //!< Thread-safe
+
+    int general_work(int noutput_items,
+        gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend gnss_sdr_sample_gate_sptr gnss_sdr_make_sample_gate(size_t _size);
+
+    explicit gnss_sdr_sample_gate(size_t _size);
+
+    std::vector<gr::tag_t> tags;
+    pmt::pmt_t sample_offset_key;
+    size_t item_size;
+    std::atomic<bool> open{true};
+    bool offset_pending{false};  // True if samples were dropped since the last output
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_SAMPLE_GATE_H
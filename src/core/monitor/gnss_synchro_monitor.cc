@@ -49,6 +49,7 @@ gnss_synchro_monitor::gnss_synchro_monitor(int n_channels,
       d_nchannels(n_channels),
       d_decimation_factor(decimation_factor)
 {
+    d_batch.reserve(n_channels);
     udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf);
 }
 
@@ -69,27 +70,37 @@ int gnss_synchro_monitor::general_work(int noutput_items __attribute__((unused))
     // Get the input buffer pointer
     const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);
 
+    // All the items forwarded in this call are sent as a single batch
+    d_batch.clear();
+
     // Loop through each input stream channel
     for (int channel_index = 0; channel_index < d_nchannels; channel_index++)
         {
             // Loop through each item in each input stream channel
             int count = 0;
+            bool forwarded = false;
             for (int item_index = 0; item_index < ninput_items[channel_index]; item_index++)
                 {
                     // Use the count variable to limit how many items are sent per channel
                     count++;
                     if (count >= d_decimation_factor)
                         {
-                            // Convert to a vector and write to the UDP sink
-                            std::vector<Gnss_Synchro> stocks;
-                            stocks.push_back(in[channel_index][item_index]);
-                            udp_sink_ptr->write_gnss_synchro(stocks);
+                            d_batch.push_back(in[channel_index][item_index]);
                             // Reset count variable
                             count = 0;
-                            // Consume the number of items for the input stream channel
-                            consume(channel_index, ninput_items[channel_index]);
+                            forwarded = true;
                         }
                 }
+            if (forwarded)
+                {
+                    // Consume the number of items for the input stream channel
+                    consume(channel_index, ninput_items[channel_index]);
+                }
+        }
+
+    if (!d_batch.empty())
+        {
+            udp_sink_ptr->write_gnss_synchro(d_batch);
         }
 
     // Not producing any outputs
@@ -21,6 +21,7 @@
 #define GNSS_SDR_GNSS_SYNCHRO_MONITOR_H
 
 #include "gnss_block_interface.h"
+#include "gnss_synchro.h"
 #include "gnss_synchro_udp_sink.h"
 #include <gnuradio/block.h>
 #include <gnuradio/runtime_types.h>  // for gr_vector_void_star
@@ -71,6 +72,7 @@ private:
         const std::vector<std::string>& udp_addresses,
         bool enable_protobuf);
 
+    std::vector<Gnss_Synchro> d_batch;
     int d_nchannels;
     int d_decimation_factor;
     std::unique_ptr<Gnss_Synchro_Udp_Sink> udp_sink_ptr;
@@ -18,13 +18,32 @@
 #include "gnss_synchro_udp_sink.h"
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/vector.hpp>
+#include <algorithm>  // for std::min
 #include <iostream>
 #include <sstream>
+#include <utility>  // for std::move
+#if defined(__linux__)
+#include <sys/socket.h>  // for sendmmsg
+#include <sys/uio.h>     // for iovec
+#endif
+
+
+namespace
+{
+// Batches waiting to be sent. Further batches are dropped, so a slow network
+// never blocks the flowgraph
+constexpr size_t MAX_PENDING_BATCHES = 128;
+
+// Keeps the serialized datagrams well below the maximum UDP payload
+constexpr size_t MAX_SYNCHRO_PER_DATAGRAM = 64;
+}  // namespace
+
 
 Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
     bool enable_protobuf)
-    : socket{io_context},
+    : dropped_batches(0),
+      stop(false),
       use_protobuf(enable_protobuf)
 {
     if (enable_protobuf)
@@ -34,42 +53,169 @@ Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& add
     for (const auto& address : addresses)
         {
             boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
+            sockets.emplace_back(io_context);
+            sockets.back().open(endpoint.protocol(), error);
+            sockets.back().connect(endpoint, error);
+            if (error)
+                {
+                    std::cerr << "Gnss_Synchro_Udp_Sink cannot connect to " << address << ":" << port << ": " << error.message() << '\n';
+                }
         }
+    io_thread = std::thread(&Gnss_Synchro_Udp_Sink::run, this);
 }
 
 
-bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks)
+Gnss_Synchro_Udp_Sink::~Gnss_Synchro_Udp_Sink()
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stop = true;
+    }
+    queue_cv.notify_one();
+    if (io_thread.joinable())
+        {
+            io_thread.join();
+        }
+    if (dropped_batches > 0)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << stocks;
-            outbound_data = archive_stream.str();
+            std::cerr << "Gnss_Synchro_Udp_Sink dropped " << dropped_batches << " batches of Gnss_Synchro objects\n";
         }
-    else
+}
+
+
+bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (pending.size() >= MAX_PENDING_BATCHES)
+            {
+                dropped_batches++;
+                return false;
+            }
+        // Recycle the vectors of already sent batches, so no memory is
+        // allocated in the flowgraph thread once the queue is warmed up
+        if (free_batches.empty())
+            {
+                pending.emplace_back(stocks);
+            }
+        else
+            {
+                pending.push_back(std::move(free_batches.back()));
+                free_batches.pop_back();
+                pending.back().assign(stocks.cbegin(), stocks.cend());
+            }
+    }
+    queue_cv.notify_one();
+    return true;
+}
+
+
+void Gnss_Synchro_Udp_Sink::run()
+{
+    std::vector<std::vector<Gnss_Synchro>> batches;
+    std::vector<std::string> datagrams;
+    while (true)
         {
-            outbound_data = serdes.createProtobuffer(stocks);
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                queue_cv.wait(lock, [this] { return stop || !pending.empty(); });
+                if (pending.empty())
+                    {
+                        return;  // stop requested and nothing left to send
+                    }
+                while (!pending.empty())
+                    {
+                        batches.push_back(std::move(pending.front()));
+                        pending.pop_front();
+                    }
+            }
+
+            datagrams.clear();
+            for (const auto& batch : batches)
+                {
+                    serialize(batch, datagrams);
+                }
+            send_datagrams(datagrams);
+
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                for (auto& batch : batches)
+                    {
+                        free_batches.push_back(std::move(batch));
+                    }
+            }
+            batches.clear();
         }
-    for (const auto& endpoint : endpoints)
+}
+
+
+void Gnss_Synchro_Udp_Sink::serialize(const std::vector<Gnss_Synchro>& stocks, std::vector<std::string>& datagrams)
+{
+    for (size_t first = 0; first < stocks.size(); first += MAX_SYNCHRO_PER_DATAGRAM)
         {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
+            const size_t last = std::min(first + MAX_SYNCHRO_PER_DATAGRAM, stocks.size());
+            chunk.assign(stocks.cbegin() + first, stocks.cbegin() + last);
+            if (use_protobuf == false)
+                {
+                    std::ostringstream archive_stream;
+                    boost::archive::binary_oarchive oa{archive_stream};
+                    oa << chunk;
+                    datagrams.push_back(archive_stream.str());
+                }
+            else
+                {
+                    datagrams.push_back(serdes.createProtobuffer(chunk));
+                }
+        }
+}
+
 
-            try
+void Gnss_Synchro_Udp_Sink::send_datagrams(const std::vector<std::string>& datagrams)
+{
+    if (datagrams.empty())
+        {
+            return;
+        }
+#if defined(__linux__)
+    std::vector<iovec> iovecs(datagrams.size());
+    std::vector<mmsghdr> messages(datagrams.size());
+    for (size_t i = 0; i < datagrams.size(); i++)
+        {
+            iovecs[i].iov_base = const_cast<char*>(datagrams[i].data());
+            iovecs[i].iov_len = datagrams[i].size();
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+    for (auto& socket : sockets)
+        {
+            if (!socket.is_open())
+                {
+                    continue;
+                }
+            size_t sent = 0;
+            while (sent < messages.size())
                 {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
+                    const int result = sendmmsg(socket.native_handle(), &messages[sent], static_cast<unsigned int>(messages.size() - sent), 0);
+                    if (result <= 0)
                         {
-                            std::cerr << "Gnss_Synchro_Udp_Sink sent 0 bytes\n";
+                            // Typically, nobody is listening at the endpoint
+                            break;
                         }
+                    sent += static_cast<size_t>(result);
+                }
+        }
+#else
+    for (auto& socket : sockets)
+        {
+            if (!socket.is_open())
+                {
+                    continue;
                 }
-            catch (boost::system::system_error const& e)
+            for (const auto& datagram : datagrams)
                 {
-                    std::cerr << e.what() << '\n';
-                    return false;
+                    socket.send(boost::asio::buffer(datagram), 0, error);
                 }
         }
-    return true;
+#endif
 }
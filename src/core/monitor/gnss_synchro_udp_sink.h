@@ -22,8 +22,13 @@
 #include "serdes_gnss_synchro.h"
 #include <boost/asio.hpp>
 #include <boost/system/error_code.hpp>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 /** \addtogroup Core
@@ -41,19 +46,41 @@ using b_io_context = boost::asio::io_service;
 /*!
  * \brief This class sends serialized Gnss_Synchro objects
  * over UDP to one or multiple endpoints.
+ *
+ * write_gnss_synchro() only copies the objects into a bounded queue, and
+ * returns false if the queue is full and they were dropped. Serialization and
+ * transmission are done by a dedicated thread, which sends all the datagrams
+ * pending for each endpoint with a single system call through sockets that
+ * are connected once at construction.
  */
 class Gnss_Synchro_Udp_Sink
 {
 public:
     Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf);
+    ~Gnss_Synchro_Udp_Sink();
+
+    Gnss_Synchro_Udp_Sink(const Gnss_Synchro_Udp_Sink&) = delete;
+    Gnss_Synchro_Udp_Sink& operator=(const Gnss_Synchro_Udp_Sink&) = delete;
+
     bool write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks);
 
 private:
+    void run();
+    void serialize(const std::vector<Gnss_Synchro>& stocks, std::vector<std::string>& datagrams);
+    void send_datagrams(const std::vector<std::string>& datagrams);
+
     b_io_context io_context;
-    boost::asio::ip::udp::socket socket;
+    std::vector<boost::asio::ip::udp::socket> sockets;
     boost::system::error_code error;
-    std::vector<boost::asio::ip::udp::endpoint> endpoints;
     Serdes_Gnss_Synchro serdes;
+    std::vector<Gnss_Synchro> chunk;
+    std::deque<std::vector<Gnss_Synchro>> pending;
+    std::vector<std::vector<Gnss_Synchro>> free_batches;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::thread io_thread;
+    uint64_t dropped_batches;
+    bool stop;
     bool use_protobuf;
 };
 
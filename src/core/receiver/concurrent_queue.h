@@ -17,11 +17,15 @@
 #ifndef GNSS_SDR_CONCURRENT_QUEUE_H
 #define GNSS_SDR_CONCURRENT_QUEUE_H
 
+#if USE_LOCK_FREE_QUEUE
+#include "lock_free_queue.h"
+#else
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
 #include <thread>
+#endif
 
 /** \addtogroup Core
  * \{ */
@@ -29,6 +33,20 @@
  * \{ */
 
 
+#if USE_LOCK_FREE_QUEUE
+
+/*!
+ * \brief Thread-safe queue implemented by Lock_Free_Queue, selected at
+ * build time with -DENABLE_LOCK_FREE_QUEUE=ON. Messages must be popped
+ * from a single thread.
+ */
+template <typename Data>
+class Concurrent_Queue : public Lock_Free_Queue<Data>
+{
+};
+
+#else
+
 template <typename Data>
 
 /*!
@@ -100,6 +118,8 @@ private:
     std::condition_variable the_condition_variable;
 };
 
+#endif
+
 
 /** \} */
 /** \} */
@@ -458,6 +458,8 @@ int GNSSFlowgraph::connect_desktop_flowgraph()
             return 1;
         }
 
+    update_channel_gates();
+
     if (connect_observables_to_pvt() != 0)
         {
             return 1;
@@ -942,10 +944,16 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
 
 int GNSSFlowgraph::connect_signal_conditioners_to_channels()
 {
+    const bool use_acq_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
+    const bool gate_idle_channels = configuration_->property("GNSS-SDR.gate_idle_channels", false);
+    if (gate_idle_channels && use_acq_resampler)
+        {
+            LOG(WARNING) << "GNSS-SDR.gate_idle_channels is not compatible with GNSS-SDR.use_acquisition_resampler. Idle channels will not be gated.";
+        }
+    channel_gates_ = std::vector<gnss_sdr_sample_gate_sptr>(channels_count_, nullptr);
     for (int i = 0; i < channels_count_; i++)
         {
             int selected_signal_conditioner_ID = 0;
-            const bool use_acq_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
             const uint32_t fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0);
 
             try
@@ -1061,13 +1069,31 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
                                         channels_.at(i)->get_left_block_acq(), 0);
                                 }
                         }
+                    else if (gate_idle_channels && supports_sample_gate(i))
+                        {
+                            // Acquisition and tracking share the gate, so they see the same sample counters
+                            channel_gates_.at(i) = gnss_sdr_make_sample_gate(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block()->output_signature()->sizeof_stream_item(0));
+                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                channel_gates_.at(i), 0);
+                            top_block_->connect(channel_gates_.at(i), 0,
+                                channels_.at(i)->get_left_block_acq(), 0);
+                            LOG(INFO) << "Channel " << i << " input is gated while the channel is idle";
+                        }
                     else
                         {
                             top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
                                 channels_.at(i)->get_left_block_acq(), 0);
                         }
-                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                        channels_.at(i)->get_left_block_trk(), 0);
+                    if (channel_gates_.at(i) != nullptr)
+                        {
+                            top_block_->connect(channel_gates_.at(i), 0,
+                                channels_.at(i)->get_left_block_trk(), 0);
+                        }
+                    else
+                        {
+                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                channels_.at(i)->get_left_block_trk(), 0);
+                        }
                 }
             catch (const std::exception& e)
                 {
@@ -1772,6 +1798,11 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                         {
                             channels_state_[current_channel] = 1;
                             acq_channels_count_++;
+                            if (current_channel < channel_gates_.size() && channel_gates_[current_channel] != nullptr)
+                                {
+                                    // The control thread calls this method directly, without going through apply_action()
+                                    channel_gates_[current_channel]->set_open(true);
+                                }
                             DLOG(INFO) << "Channel " << current_channel
                                        << " Starting acquisition " << channels_[current_channel]->get_signal().get_satellite()
                                        << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
@@ -1926,6 +1957,38 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
         default:
             break;
         }
+    update_channel_gates();
+}
+
+
+bool GNSSFlowgraph::supports_sample_gate(int channel)
+{
+    // The tracking block must translate its sample counters with the
+    // "sample_offset" tags issued by the gate
+    const gr::basic_block_sptr trk = channels_.at(channel)->get_left_block_trk();
+    return trk != nullptr && trk->name() == "dll_pll_veml_tracking";
+}
+
+
+void GNSSFlowgraph::update_channel_gates()
+{
+    for (size_t n = 0; n < channel_gates_.size(); n++)
+        {
+            if (channel_gates_[n] != nullptr)
+                {
+                    channel_gates_[n]->set_open(channels_state_[n] != 0);
+                }
+        }
+}
+
+
+bool GNSSFlowgraph::channel_receives_samples(unsigned int channel) const
+{
+    if (channel < channel_gates_.size() && channel_gates_[channel] != nullptr)
+        {
+            return channel_gates_[channel]->is_open();
+        }
+    return true;
 }
 
 
@@ -28,6 +28,7 @@
 #include "concurrent_queue.h"
 #include "galileo_e6_has_msg_receiver.h"
 #include "gnss_sdr_sample_counter.h"
+#include "gnss_sdr_sample_gate.h"
 #include "gnss_signal.h"
 #include "pvt_interface.h"
 #include <gnuradio/blocks/null_sink.h>  // for null_sink
@@ -135,6 +136,12 @@ public:
         return running_;
     }
 
+    /*!
+     * \brief Returns true if the channel receives samples, that is, if its
+     * input is not gated or its gate is open
+     */
+    bool channel_receives_samples(unsigned int channel) const;
+
     /*!
      * \brief Sends a GNU Radio asynchronous message from telemetry to PVT
      *
@@ -191,6 +198,9 @@ private:
     int assign_channels();
     void check_signal_conditioners();
 
+    bool supports_sample_gate(int channel);
+    void update_channel_gates();  // Opens the sample gates of the channels in acquisition or tracking, and closes the others
+
     void set_signals_list();
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
                                 // using the configuration parameters (number of channels and max channels in acquisition)
@@ -223,6 +233,7 @@ private:
     std::shared_ptr<GNSSBlockInterface> pvt_;
 
     std::map<std::string, gr::basic_block_sptr> acq_resamplers_;
+    std::vector<gnss_sdr_sample_gate_sptr> channel_gates_;  // nullptr for the channels that are not gated
     std::vector<gr::blocks::null_sink::sptr> null_sinks_;
 
     gr::basic_block_sptr GnssSynchroMonitor_;
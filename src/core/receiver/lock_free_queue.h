@@ -0,0 +1,260 @@
+/*!
+ * \file lock_free_queue.h
+ * \brief Bounded lock-free multiple-producer, single-consumer queue with the
+ * interface of Concurrent_Queue
+ * \author agent, 2026. agent(at)local
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_LOCK_FREE_QUEUE_H
+#define GNSS_SDR_LOCK_FREE_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Bounded lock-free queue for many producers and a single consumer.
+ *
+ * Producers claim a slot of a ring buffer with a single compare-and-swap and
+ * publish it through the sequence number of the slot, as in D. Vyukov's
+ * bounded MPMC queue, so pushing never takes a lock while there is room in
+ * the ring. If the ring is full, messages go to a mutex-protected overflow
+ * queue until the consumer has drained it, so push() never blocks nor drops a
+ * message and the order of the messages of each producer is preserved.
+ *
+ * Only one thread can pop messages at a time. The waiting functions spin for
+ * a short while, then yield and finally park the consumer on a condition
+ * variable, which producers only notify when the consumer is parked.
+ */
+template <typename Data, size_t Capacity = 1024>
+class Lock_Free_Queue
+{
+public:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    Lock_Free_Queue()
+    {
+        for (size_t i = 0; i < Capacity; i++)
+            {
+                d_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+    }
+
+    Lock_Free_Queue(const Lock_Free_Queue&) = delete;
+    Lock_Free_Queue& operator=(const Lock_Free_Queue&) = delete;
+
+    void push(Data const& data)
+    {
+        if (d_overflow_size.load(std::memory_order_acquire) != 0 || !push_to_ring(data))
+            {
+                std::lock_guard<std::mutex> lock(d_overflow_mutex);
+                d_overflow.push(data);
+                d_overflow_size.fetch_add(1, std::memory_order_release);
+            }
+        // Pairs with the fence in park(): either the consumer sees the new
+        // message before parking, or this thread sees the consumer parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (d_consumer_parked.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(d_park_mutex);
+                d_park_condition.notify_one();
+            }
+    }
+
+    bool empty() const
+    {
+        const size_t pos = d_dequeue_pos.load(std::memory_order_relaxed);
+        return d_cells[pos & MASK].sequence.load(std::memory_order_acquire) != pos + 1 && d_overflow_size.load(std::memory_order_acquire) == 0;
+    }
+
+    bool try_pop(Data& popped_value)
+    {
+        if (pop_from_ring(popped_value))
+            {
+                return true;
+            }
+        // Messages in the ring were pushed before the ones in the overflow
+        if (d_overflow_size.load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+        if (d_drained.empty())
+            {
+                // Take all the overflow at once, so the producers contend
+                // for the lock once per batch instead of once per message
+                std::lock_guard<std::mutex> lock(d_overflow_mutex);
+                d_drained.swap(d_overflow);
+            }
+        popped_value = std::move(d_drained.front());
+        d_drained.pop();
+        // Producers keep using the overflow until all of it has been popped
+        d_overflow_size.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void wait_and_pop(Data& popped_value)
+    {
+        while (!spin_and_pop(popped_value) && !park(popped_value, nullptr))
+            {
+            }
+    }
+
+    bool timed_wait_and_pop(Data& popped_value, int wait_ms)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+        return spin_and_pop(popped_value) || park(popped_value, &deadline);
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+    static constexpr int SPIN_ITERATIONS = 64;
+    static constexpr int YIELD_ITERATIONS = 16;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        Data data{};
+    };
+
+    struct Cache_Line_Padding
+    {
+        Cache_Line_Padding() {}  // user-provided, so unused padding is not warned about
+        char bytes[CACHE_LINE_SIZE];
+    };
+
+    bool push_to_ring(Data const& data)
+    {
+        size_t pos = d_enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+            {
+                cell = &d_cells[pos & MASK];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+                if (diff == 0)
+                    {
+                        if (d_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (diff < 0)
+                    {
+                        return false;  // the ring is full
+                    }
+                else
+                    {
+                        pos = d_enqueue_pos.load(std::memory_order_relaxed);
+                    }
+            }
+        cell->data = data;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop_from_ring(Data& popped_value)
+    {
+        const size_t pos = d_dequeue_pos.load(std::memory_order_relaxed);
+        Cell& cell = d_cells[pos & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            {
+                return false;
+            }
+        popped_value = std::move(cell.data);
+        cell.data = Data{};  // release the resources held by the message now
+        cell.sequence.store(pos + Capacity, std::memory_order_release);
+        d_dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool spin_and_pop(Data& popped_value)
+    {
+        for (int i = 0; i < SPIN_ITERATIONS; i++)
+            {
+                if (try_pop(popped_value))
+                    {
+                        return true;
+                    }
+            }
+        for (int i = 0; i < YIELD_ITERATIONS; i++)
+            {
+                std::this_thread::yield();
+                if (try_pop(popped_value))
+                    {
+                        return true;
+                    }
+            }
+        return false;
+    }
+
+    // Blocks until a message arrives or the deadline, if any, expires
+    bool park(Data& popped_value, const std::chrono::steady_clock::time_point* deadline)
+    {
+        std::unique_lock<std::mutex> lock(d_park_mutex);
+        d_consumer_parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool popped = try_pop(popped_value);
+        while (!popped)
+            {
+                if (deadline == nullptr)
+                    {
+                        d_park_condition.wait(lock);
+                    }
+                else if (d_park_condition.wait_until(lock, *deadline) == std::cv_status::timeout)
+                    {
+                        popped = try_pop(popped_value);
+                        break;
+                    }
+                popped = try_pop(popped_value);
+            }
+        d_consumer_parked.store(false, std::memory_order_relaxed);
+        return popped;
+    }
+
+    // The members written by the producers, by the consumer and on the slow
+    // paths are kept at least one cache line apart to avoid false sharing.
+    // Padding is used instead of alignas, which allocations only honour
+    // from C++17 on.
+    std::atomic<size_t> d_enqueue_pos{0};  // producers
+    Cache_Line_Padding d_padding_enqueue;
+    std::array<Cell, Capacity> d_cells;  // producers and consumer
+    Cache_Line_Padding d_padding_cells;
+    std::atomic<size_t> d_dequeue_pos{0};  // consumer
+    std::queue<Data> d_drained;
+    Cache_Line_Padding d_padding_dequeue;
+    std::mutex d_overflow_mutex;  // overflow, when the ring is full
+    std::queue<Data> d_overflow;
+    std::atomic<size_t> d_overflow_size{0};
+    Cache_Line_Padding d_padding_overflow;
+    std::mutex d_park_mutex;  // parked consumer
+    std::condition_variable d_park_condition;
+    std::atomic<bool> d_consumer_parked{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_LOCK_FREE_QUEUE_H
@@ -17,6 +17,7 @@
 
 #include "tcp_cmd_interface.h"
 #include "command_event.h"
+#include "gnss_block_profiler.h"
 #include "pvt_interface.h"
 #include <boost/asio.hpp>
 #include <cmath>      // for isnan
@@ -32,7 +33,8 @@ using b_io_context = boost::asio::io_service;
 #endif
 
 TcpCmdInterface::TcpCmdInterface()
-    : rx_latitude_(0.0),
+    : profiling_output_path_("."),
+      rx_latitude_(0.0),
       rx_longitude_(0.0),
       rx_altitude_(0.0),
       receiver_utc_time_(0),
@@ -53,6 +55,7 @@ void TcpCmdInterface::register_functions()
     functions_["warmstart"] = [&](auto &s) { return TcpCmdInterface::warmstart(s); };
     functions_["coldstart"] = [&](auto &s) { return TcpCmdInterface::coldstart(s); };
     functions_["set_ch_satellite"] = [&](auto &s) { return TcpCmdInterface::set_ch_satellite(s); };
+    functions_["profiling"] = [&](auto &s) { return TcpCmdInterface::profiling(s); };
 #else
     functions_["status"] = std::bind(&TcpCmdInterface::status, this, std::placeholders::_1);
     functions_["standby"] = std::bind(&TcpCmdInterface::standby, this, std::placeholders::_1);
@@ -61,6 +64,7 @@ void TcpCmdInterface::register_functions()
     functions_["warmstart"] = std::bind(&TcpCmdInterface::warmstart, this, std::placeholders::_1);
     functions_["coldstart"] = std::bind(&TcpCmdInterface::coldstart, this, std::placeholders::_1);
     functions_["set_ch_satellite"] = std::bind(&TcpCmdInterface::set_ch_satellite, this, std::placeholders::_1);
+    functions_["profiling"] = std::bind(&TcpCmdInterface::profiling, this, std::placeholders::_1);
 #endif
 }
 
@@ -296,6 +300,52 @@ std::string TcpCmdInterface::set_ch_satellite(const std::vector<std::string> &co
 }
 
 
+std::string TcpCmdInterface::profiling(const std::vector<std::string> &commandLine)
+{
+    // profiling on [trace_file.json] | profiling off | profiling status
+    std::string response;
+    auto &profiler = Gnss_Block_Profiler::instance();
+    if (commandLine.size() > 1 && commandLine.at(1) == "on")
+        {
+            // Remote clients only choose the name of the trace file, which is
+            // written in the directory set in the configuration
+            const std::string trace_filename = commandLine.size() > 2 ? commandLine.at(2) : std::string("gnss-sdr_trace.json");
+            if (trace_filename.find('/') != std::string::npos || trace_filename.find('\\') != std::string::npos || trace_filename.find("..") != std::string::npos)
+                {
+                    response = "ERROR: the trace file name cannot contain a path\n";
+                }
+            else if (profiler.start(profiling_output_path_ + "/" + trace_filename))
+                {
+                    response = "OK\n";
+                }
+            else
+                {
+                    response = "ERROR: profiling already enabled or cannot open " + trace_filename + "\n";
+                }
+        }
+    else if (commandLine.size() > 1 && commandLine.at(1) == "off")
+        {
+            profiler.stop();
+            response = profiler.report() + "OK\n";
+        }
+    else if (commandLine.size() > 1 && commandLine.at(1) == "status")
+        {
+            response = profiler.report();
+        }
+    else
+        {
+            response = "ERROR: please use profiling on [trace_file.json], profiling off or profiling status\n";
+        }
+    return response;
+}
+
+
+void TcpCmdInterface::set_profiling_output_path(const std::string &output_path)
+{
+    profiling_output_path_ = output_path;
+}
+
+
 void TcpCmdInterface::set_msg_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue)
 {
     control_queue_ = std::move(control_queue);
@@ -58,6 +58,11 @@ public:
 
     void set_pvt(std::shared_ptr<PvtInterface> PVT_sptr);
 
+    /*!
+     * \brief sets the directory where the profiling command writes its traces
+     */
+    void set_profiling_output_path(const std::string &output_path);
+
 private:
     std::unordered_map<std::string, std::function<std::string(const std::vector<std::string> &)>>
         functions_;
@@ -68,11 +73,13 @@ private:
     std::string warmstart(const std::vector<std::string> &commandLine);
     std::string coldstart(const std::vector<std::string> &commandLine);
     std::string set_ch_satellite(const std::vector<std::string> &commandLine);
+    std::string profiling(const std::vector<std::string> &commandLine);
 
     void register_functions();
 
     std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
     std::shared_ptr<PvtInterface> PVT_sptr_;
+    std::string profiling_output_path_;
 
     float rx_latitude_;
     float rx_longitude_;
@@ -0,0 +1,82 @@
+/*!
+ * \file benchmark_concurrent_queue.cc
+ * \brief Benchmark for the queue implementations used by the control thread
+ * under contention from several producers
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include "lock_free_queue.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+constexpr int MESSAGES_PER_PRODUCER = 10000;
+
+
+// Emulates many channels reporting their events at once: state.range(0)
+// producers push messages while the control thread pops them
+template <typename Queue>
+void run_producers_and_consumer(benchmark::State& state)
+{
+    const auto num_producers = static_cast<int>(state.range(0));
+    Queue queue;
+    while (state.KeepRunning())
+        {
+            std::vector<std::thread> producers;
+            producers.reserve(num_producers);
+            for (int p = 0; p < num_producers; p++)
+                {
+                    producers.emplace_back([&queue, p]() {
+                        for (int i = 0; i < MESSAGES_PER_PRODUCER; i++)
+                            {
+                                queue.push(p * 100 + i % 100);
+                            }
+                    });
+                }
+            int message = 0;
+            int64_t sum = 0;
+            for (int i = 0; i < num_producers * MESSAGES_PER_PRODUCER; i++)
+                {
+                    queue.timed_wait_and_pop(message, 100);
+                    sum += message;
+                }
+            benchmark::DoNotOptimize(sum);
+            for (auto& producer : producers)
+                {
+                    producer.join();
+                }
+        }
+    state.SetItemsProcessed(state.iterations() * num_producers * MESSAGES_PER_PRODUCER);
+}
+
+
+// Implementation selected at build time with ENABLE_LOCK_FREE_QUEUE
+void bm_concurrent_queue(benchmark::State& state)
+{
+    run_producers_and_consumer<Concurrent_Queue<int>>(state);
+}
+
+
+void bm_lock_free_queue(benchmark::State& state)
+{
+    run_producers_and_consumer<Lock_Free_Queue<int>>(state);
+}
+
+
+BENCHMARK(bm_concurrent_queue)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(bm_lock_free_queue)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+/*!
+ * \file benchmark_kf_tracking.cc
+ * \brief Benchmark for the Kalman filter update of the KF tracking loops
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "tracking_kalman_filter.h"
+#include <armadillo>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+constexpr double KF_TI = 0.001;
+constexpr double KF_B = 1.023e6 / 1575.42e6;
+constexpr int KF_EPOCHS = 1000;  // one second of tracking at 1 kHz
+
+
+std::vector<double> kf_measurements()
+{
+    std::default_random_engine e2(1234);
+    std::normal_distribution<double> dist(0.0, 0.1);
+    std::vector<double> z(2 * KF_EPOCHS);
+    for (auto& element : z)
+        {
+            element = dist(e2);
+        }
+    return z;
+}
+
+
+// Dynamic-size Armadillo implementation, as used in kf_vtl_tracking up to v0.0.16
+void bm_kf_arma_dynamic(benchmark::State& state)
+{
+    const std::vector<double> measurements = kf_measurements();
+    arma::mat F = arma::mat(5, 5);
+    F << 1 << 0 << 0 << 0 << KF_TI << arma::endr
+      << 0 << 1 << 2.0 * GNSS_PI * KF_TI << GNSS_PI * (KF_TI * KF_TI) << 0 << arma::endr
+      << 0 << 0 << 1 << KF_TI << 0 << arma::endr
+      << 0 << 0 << 0 << 1 << 0 << arma::endr
+      << 0 << 0 << 0 << 0 << 1 << arma::endr;
+    arma::mat H = arma::mat(2, 5);
+    H << 1 << 0 << -KF_B * KF_TI / 2.0 << KF_B * (KF_TI * KF_TI) / 6.0 << 0 << arma::endr
+      << 0 << 1 << -GNSS_PI * KF_TI << GNSS_PI * (KF_TI * KF_TI) / 3.0 << 0 << arma::endr;
+    arma::mat R = arma::diagmat(arma::vec({0.01, 0.04}));
+    arma::mat Q = arma::diagmat(arma::vec({1e-4, 1e-3, 2.0, 5.0, 1e-3}));
+    arma::mat P_old_old = arma::diagmat(arma::vec({1.0, 1.0, 100.0, 10.0, 1.0}));
+    arma::vec x_old_old = {0.1, 0.0, 1200.0, 0.0, 0.0};
+    arma::mat P_new_old;
+    arma::mat P_new_new;
+    arma::vec x_new_old;
+    arma::vec x_new_new;
+
+    while (state.KeepRunning())
+        {
+            for (int epoch = 0; epoch < KF_EPOCHS; epoch++)
+                {
+                    x_new_old = F * x_old_old;
+                    P_new_old = F * P_old_old * F.t() + Q;
+                    arma::vec z = {measurements[2 * epoch], measurements[2 * epoch + 1]};
+                    arma::mat K = P_new_old * H.t() * arma::inv(H * P_new_old * H.t() + R);
+                    x_new_new = x_new_old + K * z;
+                    P_new_new = (arma::eye(5, 5) - K * H) * P_new_old;
+                    x_new_new(0) = 0;
+                    x_new_new(4) = 0;
+                    x_old_old = x_new_new;
+                    P_old_old = P_new_new;
+                }
+            benchmark::DoNotOptimize(x_old_old(2));
+        }
+}
+
+
+void bm_kf_fixed_size(benchmark::State& state)
+{
+    const std::vector<double> measurements = kf_measurements();
+    Tracking_Kalman_Filter kf;
+    kf.set_model(KF_TI, KF_B);
+    kf.set_measurement_noise(0.01, 0.04);
+    kf.set_process_noise({1e-4, 1e-3, 2.0, 5.0, 1e-3});
+    kf.reset({0.1, 0.0, 1200.0, 0.0, 0.0}, {1.0, 1.0, 100.0, 10.0, 1.0});
+
+    while (state.KeepRunning())
+        {
+            for (int epoch = 0; epoch < KF_EPOCHS; epoch++)
+                {
+                    kf.update(measurements[2 * epoch], measurements[2 * epoch + 1]);
+                    kf.set_state(0, 0.0);
+                    kf.set_state(4, 0.0);
+                }
+            benchmark::DoNotOptimize(kf.state(2));
+        }
+}
+
+
+BENCHMARK(bm_kf_arma_dynamic);
+BENCHMARK(bm_kf_fixed_size);
+
+BENCHMARK_MAIN();
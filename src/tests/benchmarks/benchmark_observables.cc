@@ -0,0 +1,131 @@
+/*!
+ * \file benchmark_observables.cc
+ * \brief Benchmark for the per-epoch computations of the observables block
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gnss_synchro.h"
+#include "obs_epoch.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr uint32_t OBS_NCHANNELS = 100;
+constexpr uint32_t OBS_T_RX_TOW_MS = 345600000;
+constexpr double OBS_SMOOTHING_FACTOR = 200.0;
+
+
+// Synthetic epoch of a receiver tracking several signals in 100 channels
+std::vector<Gnss_Synchro> obs_epoch_data()
+{
+    const std::array<const char*, 6> signals{"1C", "1B", "L5", "5X", "2S", "B1"};
+    std::default_random_engine e2(1234);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<Gnss_Synchro> data(OBS_NCHANNELS);
+    for (uint32_t n = 0; n < OBS_NCHANNELS; n++)
+        {
+            data[n].Channel_ID = n;
+            data[n].Flag_valid_word = dist(e2) < 0.9;
+            std::strcpy(data[n].Signal, signals[n % signals.size()]);
+            data[n].interp_TOW_ms = OBS_T_RX_TOW_MS - 65.0 - 20.0 * dist(e2);
+            data[n].TOW_at_current_symbol_ms = static_cast<uint32_t>(data[n].interp_TOW_ms);
+            data[n].Carrier_phase_rads = 1.0e6 * dist(e2);
+        }
+    return data;
+}
+
+
+// Per-channel computation on the Gnss_Synchro objects, as done before the
+// introduction of Obs_Epoch
+void bm_observables_per_channel(benchmark::State& state)
+{
+    std::vector<Gnss_Synchro> data = obs_epoch_data();
+    std::map<std::string, double> wavelengths;
+    for (const auto& obs : data)
+        {
+            wavelengths[obs.Signal] = Obs_Epoch::carrier_wavelength_m(obs.Signal);
+        }
+    std::vector<bool> last_pll_lock(OBS_NCHANNELS, false);
+    std::vector<double> last_pseudorange_smooth(OBS_NCHANNELS, 0.0);
+    std::vector<double> last_carrier_phase_rads(OBS_NCHANNELS, 0.0);
+    const double factor = (OBS_SMOOTHING_FACTOR - 1.0) / OBS_SMOOTHING_FACTOR;
+
+    while (state.KeepRunning())
+        {
+            const auto current_T_rx_TOW_ms = static_cast<double>(OBS_T_RX_TOW_MS);
+            for (auto& obs : data)
+                {
+                    obs.RX_time = current_T_rx_TOW_ms / 1000.0;
+                    if (obs.Flag_valid_word)
+                        {
+                            double traveltime_ms = current_T_rx_TOW_ms - obs.interp_TOW_ms;
+                            if (std::fabs(traveltime_ms) > 302400)
+                                {
+                                    traveltime_ms = 604800000.0 + current_T_rx_TOW_ms - obs.interp_TOW_ms;
+                                }
+                            obs.Pseudorange_m = traveltime_ms * SPEED_OF_LIGHT_M_MS;
+                            obs.Flag_valid_pseudorange = true;
+                        }
+                }
+            for (auto& obs : data)
+                {
+                    if (obs.Flag_valid_pseudorange)
+                        {
+                            const double wavelength_m = wavelengths[obs.Signal];
+                            if (last_pll_lock[obs.Channel_ID])
+                                {
+                                    obs.Pseudorange_m = factor * last_pseudorange_smooth[obs.Channel_ID] + (1.0 / OBS_SMOOTHING_FACTOR) * obs.Pseudorange_m + wavelength_m * (factor / TWO_PI) * (obs.Carrier_phase_rads - last_carrier_phase_rads[obs.Channel_ID]);
+                                }
+                            last_pseudorange_smooth[obs.Channel_ID] = obs.Pseudorange_m;
+                            last_carrier_phase_rads[obs.Channel_ID] = obs.Carrier_phase_rads;
+                            last_pll_lock[obs.Channel_ID] = true;
+                        }
+                    else
+                        {
+                            last_pll_lock[obs.Channel_ID] = false;
+                        }
+                }
+            benchmark::DoNotOptimize(data.data());
+        }
+}
+
+
+// Same computation with Obs_Epoch, including the gather and scatter steps
+void bm_observables_obs_epoch(benchmark::State& state)
+{
+    std::vector<Gnss_Synchro> data = obs_epoch_data();
+    Obs_Epoch epoch(OBS_NCHANNELS);
+
+    while (state.KeepRunning())
+        {
+            epoch.load(data);
+            epoch.compute_pranges(OBS_T_RX_TOW_MS);
+            epoch.smooth_pseudoranges(OBS_SMOOTHING_FACTOR);
+            epoch.store(data);
+            benchmark::DoNotOptimize(data.data());
+        }
+}
+
+
+BENCHMARK(bm_observables_per_channel);
+BENCHMARK(bm_observables_obs_epoch);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+/*!
+ * \file benchmark_viterbi.cc
+ * \brief Benchmark for the Viterbi decoders of the telemetry decoders
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_decoder.h"
+#include "viterbi_decoder_sbas.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+constexpr int32_t VITERBI_KK = 7;
+constexpr int32_t VITERBI_NN = 2;
+constexpr int32_t INAV_PAGE_PART_SYMBOLS = 240;
+constexpr int32_t INAV_ROWS = 8;
+constexpr int32_t INAV_COLS = 30;
+constexpr int32_t SBAS_BITS_PER_CALL = 250;  // one SBAS message
+
+
+std::vector<float> viterbi_symbols(int32_t n_symbols)
+{
+    std::default_random_engine e2(1234);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<float> symbols(n_symbols);
+    for (auto& element : symbols)
+        {
+            element = dist(e2);
+        }
+    return symbols;
+}
+
+
+// Deinterleaving and decoding of a Galileo I/NAV page part
+void bm_viterbi_inav_page(benchmark::State& state)
+{
+    const int32_t LL = INAV_PAGE_PART_SYMBOLS / VITERBI_NN - (VITERBI_KK - 1);
+    const std::vector<float> symbols = viterbi_symbols(INAV_PAGE_PART_SYMBOLS);
+    std::vector<int32_t> deinterleaver_index(INAV_PAGE_PART_SYMBOLS);
+    for (int32_t r = 0; r < INAV_ROWS; r++)
+        {
+            for (int32_t c = 0; c < INAV_COLS; c++)
+                {
+                    deinterleaver_index[c * INAV_ROWS + r] = r * INAV_COLS + c;
+                }
+        }
+    std::vector<float> deinterleaved(INAV_PAGE_PART_SYMBOLS);
+    std::vector<int32_t> bits(LL);
+    Viterbi_Decoder vd(VITERBI_KK, VITERBI_NN, LL, {121, -91});
+
+    while (state.KeepRunning())
+        {
+            for (int32_t i = 0; i < INAV_PAGE_PART_SYMBOLS; i++)
+                {
+                    deinterleaved[i] = symbols[deinterleaver_index[i]];
+                }
+            vd.decode(bits.data(), deinterleaved.data());
+            benchmark::DoNotOptimize(bits.data());
+        }
+}
+
+
+// Continuous decoding of the SBAS message, as in sbas_l1_telemetry_decoder_gs
+void bm_viterbi_sbas_continuous(benchmark::State& state)
+{
+    const std::array<int, VITERBI_NN> g_encoder{121, 91};
+    const std::vector<float> float_symbols = viterbi_symbols(VITERBI_NN * SBAS_BITS_PER_CALL);
+    const std::vector<double> symbols(float_symbols.begin(), float_symbols.end());
+    std::vector<int> bits(SBAS_BITS_PER_CALL);
+    int nbits_decoded;
+    Viterbi_Decoder_Sbas vd(g_encoder.data(), VITERBI_KK, VITERBI_NN);
+
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(vd.decode_continuous(symbols.data(), 5 * VITERBI_KK, bits.data(), SBAS_BITS_PER_CALL, nbits_decoded));
+        }
+}
+
+
+BENCHMARK(bm_viterbi_inav_page);
+BENCHMARK(bm_viterbi_sbas_continuous);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+/*!
+ * \file rtklib_test_data.h
+ * \brief GPS L1 C/A ephemerides and observables of the rtklib_test scenario
+ * \author agent, 2026. agent(at)local
+ *
+ * The data are those of src/tests/data/rtklib_test, which are written in a
+ * serialization format that the current classes can no longer read.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTKLIB_TEST_DATA_H
+#define GNSS_SDR_RTKLIB_TEST_DATA_H
+
+#include "GPS_L1_CA.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_synchro.h"
+#include "gps_ephemeris.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+// Ephemerides of the eleven satellites in view, by PRN
+inline std::map<int, Gps_Ephemeris> rtklib_test_gps_ephemerides()
+{
+    // PRN, IODE, Crs, delta_n, M_0, Cuc, ecc, Cus, sqrtA, Cic, OMEGA_0, Cis,
+    // i_0, Crc, omega, OMEGAdot, idot, TGD, af0, af1
+    const std::array<std::array<double, 20>, 11> rows{{
+        {1, 92, 18.3125, 4.864131182016467e-09, 2.0646819893094372, 9.424984455108643e-07, 0.0037308292230591174, 5.764886736869812e-06, 5153.66174697876, -5.4016709327697754e-08, 0.9521672475992009, 1.862645149230957e-08, 0.9613770264234561, 266.96875, 0.44493533370829186, -8.146410759278477e-09, 4.150172871358495e-10, 5.122274160385132e-09, -1.0993797332048416e-05, 3.41060513164848e-13},
+        {2, 55, 22.28125, 5.127713589853177e-09, 2.7592630278205315, 1.1008232831954956e-06, 0.014056962216272948, 6.2640756368637085e-06, 5153.726541519165, -1.862645149230957e-08, 0.9180374463445563, -2.1606683731079102e-07, 0.9399915866969095, 245.46875, -2.3559869035798156, -8.0714076350973e-09, 5.257361847366355e-10, -2.0023435354232788e-08, 0.0005368506535887718, 2.160049916710704e-12},
+        {3, 70, -20.4375, 4.757698177226034e-09, -1.788714929922279, -1.300126314163208e-06, 0.0009703197283670305, 8.264556527137756e-06, 5153.781539916992, 7.82310962677002e-08, 1.9929766061495526, -1.1175870895385742e-08, 0.9590584519483799, 219.59375, -3.0053684240581284, -8.027120076056986e-09, -5.171643991159295e-10, 5.122274160385132e-09, 8.80691222846508e-05, 2.899014361901208e-11},
+        {6, 23, 16.375, 4.7630555432389745e-09, -1.2853107163161652, 9.126961231231689e-07, 0.0005500224651768803, 6.243586540222168e-06, 5153.651662826538, -1.30385160446167e-08, 0.9436242887792469, -1.862645149230957e-09, 0.961292940818096, 258.40625, 2.2919101451999166, -8.080693736186399e-09, 4.793056792911445e-10, 4.6566128730773926e-09, 3.0788127332925797e-05, 8.185452315956353e-12},
+        {9, 47, 112.90625, 4.379110978978185e-09, -2.752538799478002, 5.852431058883667e-06, 0.00021620618645101783, 1.1630356311798096e-05, 5153.694711685181, 1.6763806343078613e-08, 3.037422515719708, -1.1175870895385742e-08, 0.9591605036506715, 156.125, 2.6066225153076434, -7.858541625516435e-09, -3.4644300217020136e-11, 4.656612873077393e-10, -3.1853560358285904e-05, -9.663381206337361e-12},
+        {10, 58, -27.25, 5.270933841265806e-09, -0.8869828188518137, -1.1771917343139648e-06, 0.014453423675149677, 7.905066013336182e-06, 5153.637254714966, 1.4528632164001465e-07, 2.0040851794947927, 2.4028122425079346e-07, 0.9411601129935773, 215.40625, 0.9097321210115622, -8.422136530077853e-09, -5.428797559780475e-10, -2.7939677238464355e-09, -0.00015496835112571716, -1.591615728102624e-12},
+        {12, 106, -117.46875, 3.945164331929943e-09, 1.116317352949972, -6.154179573059082e-06, 0.005058609647676348, 4.524365067481995e-06, 5153.766809463501, -5.4016709327697754e-08, -1.1042502361804079, 4.0978193283081055e-08, 0.9888037487422433, 307.1875, 0.5001544522747959, -7.971760627256592e-09, -4.1823170674361423e-10, -1.1641532182693481e-08, 0.00025487132370471954, 2.728484105318784e-12},
+        {17, 26, -59.125, 3.881947412977236e-09, -1.9425295921889316, -3.0472874641418457e-06, 0.009888449567370115, 1.1829659342765808e-05, 5153.692998886108, 2.0302832126617432e-07, -0.05686909998056713, -7.636845111846924e-08, 0.9712017779723652, 156.53125, -2.0692832923778934, -7.446024442519957e-09, 4.4037548626377143e-10, -1.0710209608078003e-08, -0.0001449338160455227, -2.27373675443232e-12},
+        {20, 117, -25.84375, 5.603804849536556e-09, 0.12862571014283325, -1.5292316675186157e-06, 0.005806698696687817, 7.510185241699219e-06, 5155.786712646484, -2.2351741790771484e-08, 1.9254399411820853, 4.6566128730773926e-08, 0.9260212866521229, 218.03125, 1.233655361280431, -8.548927525717465e-09, -5.164500836475373e-10, -8.381903171539307e-09, 0.00026920950040221214, 4.206412995699792e-12},
+        {23, 41, 120.25, 4.45161399901999e-09, 3.0479458194289757, 6.137415766716003e-06, 0.00967817602213472, 1.1418014764785767e-05, 5153.7016315460205, -6.146728992462158e-08, 3.047481724760427, -1.043081283569336e-07, 0.9502291912828048, 156.0, -2.7167689193017726, -7.780324081727491e-09, -2.750114553309846e-11, -1.955777406692505e-08, -7.567880675196648e-05, -2.728484105318784e-12},
+        {28, 33, -127.75, 4.04302555109967e-09, -1.1660768319862893, -6.370246410369873e-06, 0.01972230232786387, 5.669891834259033e-06, 5153.685489654541, -1.3783574104309082e-07, -1.0800654632103954, 4.3585896492004395e-07, 0.9879615526556815, 284.71875, -1.6904710863575674, -8.178554955356125e-09, -4.446613790741244e-10, -1.1175870895385742e-08, 0.000406486913561821, 2.6147972675971683e-12}
+    }};
+    std::map<int, Gps_Ephemeris> ephemerides;
+    for (const auto& row : rows)
+        {
+            Gps_Ephemeris eph;
+            eph.PRN = static_cast<uint32_t>(row[0]);
+            eph.IODE_SF2 = static_cast<int32_t>(row[1]);
+            eph.IODE_SF3 = eph.IODE_SF2;
+            eph.IODC = eph.IODE_SF2;
+            eph.Crs = row[2];
+            eph.delta_n = row[3];
+            eph.M_0 = row[4];
+            eph.Cuc = row[5];
+            eph.ecc = row[6];
+            eph.Cus = row[7];
+            eph.sqrtA = row[8];
+            eph.Cic = row[9];
+            eph.OMEGA_0 = row[10];
+            eph.Cis = row[11];
+            eph.i_0 = row[12];
+            eph.Crc = row[13];
+            eph.omega = row[14];
+            eph.OMEGAdot = row[15];
+            eph.idot = row[16];
+            eph.TGD = row[17];
+            eph.af0 = row[18];
+            eph.af1 = row[19];
+            eph.toe = 518400;
+            eph.toc = 518400;
+            eph.tow = 518448;
+            eph.WN = 799;
+            eph.SV_accuracy = 2;
+            eph.AODO = 27900;
+            ephemerides[static_cast<int>(eph.PRN)] = eph;
+        }
+    return ephemerides;
+}
+
+
+// Observables of the ten channels, by channel. Epochs other than 0 are
+// extrapolated from the recorded one with the Doppler of each satellite,
+// one second apart.
+inline std::map<int, Gnss_Synchro> rtklib_test_observables(int epoch = 0)
+{
+    // Channel, PRN, TOW_at_current_symbol_ms, Pseudorange_m,
+    // Carrier_phase_rads, Carrier_Doppler_hz, CN0_dB_hz, interp_TOW_ms
+    const std::array<std::array<double, 8>, 10> rows{{
+        {0, 1, 518451424, 22817818.62345151, 835350.8134214109, -2579.14688873291, 59.68983840942383, 518451423.88794976},
+        {1, 3, 518451431, 20751603.37743884, 493910.7066862611, -3125.0906524658203, 51.679893493652344, 518451430.78010195},
+        {2, 28, 518451436, 19249204.35612092, 935704.8228092295, -2929.8425369262695, 52.53761672973633, 518451435.79156566},
+        {4, 23, 518451429, 21225698.987657838, -354128.2755307273, 1092.8175095100912, 52.46849822998047, 518451429.1986892},
+        {5, 2, 518451430, 20862970.901584394, -572184.0060193025, 1833.1964569091797, 48.94462203979492, 518451430.4086199},
+        {6, 17, 518451440, 17961333.78413092, -90981.36598555291, 273.018497467041, 53.89860153198242, 518451440.0874395},
+        {7, 9, 518451430, 20843568.734317552, -704913.853936602, 2300.217311859131, 53.30329132080078, 518451430.47333854},
+        {8, 10, 518451438, 18502279.71436756, -899142.2299776564, 2812.2579498291016, 48.55615234375, 518451438.2830381},
+        {9, 12, 518451427, 21924234.6189942, -928340.5076552029, 3030.1998901367188, 51.7314453125, 518451426.86862516},
+        {10, 6, 518451439, 18380892.27854632, -178723.08377470358, 554.5149574279785, 60.046302795410156, 518451438.687943}
+    }};
+    const double dt = static_cast<double>(epoch);
+    const double lambda = SPEED_OF_LIGHT_M_S / GPS_L1_FREQ_HZ;
+    std::map<int, Gnss_Synchro> observables;
+    for (const auto& row : rows)
+        {
+            Gnss_Synchro obs{};
+            obs.System = 'G';
+            std::memcpy(obs.Signal, "1C", 3);
+            obs.Channel_ID = static_cast<int32_t>(row[0]);
+            obs.PRN = static_cast<uint32_t>(row[1]);
+            obs.TOW_at_current_symbol_ms = static_cast<uint32_t>(row[2] + 1000.0 * dt);
+            obs.Pseudorange_m = row[3] - lambda * row[5] * dt;
+            obs.Carrier_phase_rads = row[4] - TWO_PI * row[5] * dt;
+            obs.Carrier_Doppler_hz = row[5];
+            obs.CN0_dB_hz = row[6];
+            obs.interp_TOW_ms = row[7] + 1000.0 * dt;
+            obs.RX_time = 518451.5 + dt;
+            obs.fs = 2600000;
+            obs.Flag_valid_symbol_output = true;
+            obs.Flag_valid_word = true;
+            obs.Flag_valid_pseudorange = true;
+            observables[obs.Channel_ID] = obs;
+        }
+    return observables;
+}
+
+#endif  // GNSS_SDR_RTKLIB_TEST_DATA_H
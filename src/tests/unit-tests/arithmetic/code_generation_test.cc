@@ -18,7 +18,9 @@
 
 #include "Galileo_E6.h"
 #include "galileo_e6_signal_replica.h"
+#include "gnss_code_cache.h"
 #include "gnss_signal_replica.h"
+#include "gps_l5_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
 #include <array>
 #include <chrono>
@@ -397,3 +399,64 @@ TEST(CodeGenerationTest, GalileoE6BTest)
             ASSERT_FLOAT_EQ(gale6b_code[i].real(), expected_output[i].real());
         }
 }
+
+
+TEST(CodeGenerationTest, CodeCacheTest)
+{
+    // The cache is shared by the whole process, so this test uses signal
+    // names of its own to be independent of the replicas stored by others
+    const uint32_t prn = 7;
+    const int32_t fs = 20460000;
+    const size_t samples_per_code = 20460;
+    std::vector<std::complex<float>> expected(samples_per_code);
+    gps_l5i_code_gen_complex_sampled(expected, prn, fs);
+
+    int generated = 0;
+    auto generator = [&](own::span<std::complex<float>> dest) {
+        generated++;
+        gps_l5i_code_gen_complex_sampled(dest, prn, fs);
+    };
+
+    const own::span<const std::complex<float>> code = Gnss_Code_Cache::instance().complex_code("CodeCacheTest_L5I", prn, fs, samples_per_code, generator);
+    ASSERT_EQ(code.size(), samples_per_code);
+    for (size_t i = 0; i < samples_per_code; i++)
+        {
+            ASSERT_EQ(code[i], expected[i]);
+        }
+
+    // The second request borrows the same replica, without generating it again
+    const own::span<const std::complex<float>> borrowed = Gnss_Code_Cache::instance().complex_code("CodeCacheTest_L5I", prn, fs, samples_per_code, generator);
+    EXPECT_EQ(borrowed.data(), code.data());
+    EXPECT_EQ(generated, 1);
+
+    // Other PRNs get their own replica
+    const own::span<const std::complex<float>> other = Gnss_Code_Cache::instance().complex_code("CodeCacheTest_L5I", prn + 1, fs, samples_per_code,
+        [&](own::span<std::complex<float>> dest) { gps_l5i_code_gen_complex_sampled(dest, prn + 1, fs); });
+    EXPECT_NE(other.data(), code.data());
+}
+
+
+TEST(CodeGenerationTest, CachedFloatCodeTest)
+{
+    const uint32_t prn = 12;
+    const size_t code_length = 10230;
+    std::vector<float> expected(code_length);
+    gps_l5q_code_gen_float(expected, prn);
+
+    int generated = 0;
+    auto generator = [&](own::span<float> dest) {
+        generated++;
+        gps_l5q_code_gen_float(dest, prn);
+    };
+
+    // Tracking channels borrow the replica instead of copying it
+    const own::span<const float> code = cached_float_code("CachedFloatCodeTest_L5Q", prn, code_length, generator);
+    ASSERT_EQ(code.size(), code_length);
+    for (size_t i = 0; i < code_length; i++)
+        {
+            ASSERT_EQ(code[i], expected[i]);
+        }
+    EXPECT_EQ(cached_float_code("CachedFloatCodeTest_L5Q", prn, code_length, generator).data(), code.data());
+    EXPECT_EQ(Gnss_Code_Cache::instance().float_code("CachedFloatCodeTest_L5Q", prn, 0, code_length, generator).data(), code.data());
+    EXPECT_EQ(generated, 1);
+}
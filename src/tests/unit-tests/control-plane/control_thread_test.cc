@@ -250,3 +250,75 @@ TEST_F(ControlThreadTest /*unused*/, StopReceiverProgrammatically /*unused*/)
     stop_receiver_thread.join();
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
 }
+
+
+TEST_F(ControlThreadTest /*unused*/, StartsAcquisitionInGatedChannel /*unused*/)
+{
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("SignalSource.implementation", "File_Signal_Source");
+    std::string path = std::string(TEST_PATH);
+    std::string file = path + "signal_samples/GSoC_CTTC_capture_2012_07_26_4Msps_4ms.dat";
+    const char* file_name = file.c_str();
+    config->set_property("SignalSource.filename", file_name);
+    config->set_property("SignalSource.item_type", "gr_complex");
+    config->set_property("SignalSource.sampling_frequency", "4000000");
+    config->set_property("SignalSource.repeat", "true");
+    config->set_property("SignalConditioner.implementation", "Pass_Through");
+    config->set_property("SignalConditioner.item_type", "gr_complex");
+    config->set_property("Channels_1C.count", "2");
+    config->set_property("Channels_1E.count", "0");
+    config->set_property("Channels.in_acquisition", "1");
+    config->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    config->set_property("Acquisition_1C.threshold", "1");
+    config->set_property("Acquisition_1C.doppler_max", "5000");
+    config->set_property("Acquisition_1C.doppler_min", "-5000");
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+    config->set_property("Tracking_1C.item_type", "gr_complex");
+    config->set_property("TelemetryDecoder_1C.implementation", "GPS_L1_CA_Telemetry_Decoder");
+    config->set_property("TelemetryDecoder_1C.item_type", "gr_complex");
+    config->set_property("Observables.implementation", "Hybrid_Observables");
+    config->set_property("Observables.item_type", "gr_complex");
+    config->set_property("PVT.implementation", "RTKLIB_PVT");
+    config->set_property("PVT.item_type", "gr_complex");
+    config->set_property("GNSS-SDR.internal_fs_sps", "4000000");
+    config->set_property("GNSS-SDR.gate_idle_channels", "true");
+
+    std::shared_ptr<ControlThread> control_thread = std::make_shared<ControlThread>(config);
+    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    // Standby closes all the gates. After the cold start, the control thread
+    // restarts the acquisition by itself while the control queue is empty.
+    control_queue->push(pmt::make_any(command_event_make(300, 10)));
+    control_queue->push(pmt::make_any(command_event_make(300, 11)));
+    control_thread->set_control_queue(control_queue);
+
+    int channels_receiving_samples = -1;
+    std::thread inspect_thread([&] {
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        channels_receiving_samples = 0;
+        for (unsigned int n = 0; n < 2; n++)
+            {
+                if (control_thread->flowgraph()->channel_receives_samples(n))
+                    {
+                        channels_receiving_samples++;
+                    }
+            }
+        control_queue->push(pmt::make_any(command_event_make(200, 0)));
+    });
+
+    try
+        {
+            control_thread->run();
+        }
+    catch (const boost::exception& e)
+        {
+            std::cout << "Boost exception: " << boost::diagnostic_information(e);
+        }
+    catch (const std::exception& ex)
+        {
+            std::cout << "STD exception: " << ex.what();
+        }
+
+    inspect_thread.join();
+    EXPECT_GE(channels_receiving_samples, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+}
@@ -0,0 +1,206 @@
+/*!
+ * \file gnss_synchro_udp_sink_test.cc
+ * \brief Checks that Gnss_Synchro_Udp_Sink delivers every forwarded object,
+ * in order and with the same encoding as a direct serialization.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "gnss_synchro_udp_sink.h"
+#include "serdes_gnss_synchro.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/asio.hpp>
+#include <boost/serialization/vector.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class GnssSynchroUdpSinkTest : public ::testing::Test
+{
+protected:
+    GnssSynchroUdpSinkTest() : d_receiver(d_io_context, boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0))
+    {
+        d_receiver.set_option(boost::asio::socket_base::receive_buffer_size(4 * 1024 * 1024));
+        d_receiver.non_blocking(true);
+        d_port = d_receiver.local_endpoint().port();
+    }
+
+    // Observables of one epoch of nchannels channels, as forwarded by
+    // gnss_synchro_monitor
+    static std::vector<Gnss_Synchro> make_epoch(int epoch, int nchannels)
+    {
+        std::vector<Gnss_Synchro> stocks(nchannels);
+        for (int ch = 0; ch < nchannels; ch++)
+            {
+                Gnss_Synchro& gs = stocks[ch];
+                gs.System = 'G';
+                gs.Signal[0] = '1';
+                gs.Signal[1] = 'C';
+                gs.PRN = static_cast<uint32_t>(ch + 1);
+                gs.Channel_ID = ch;
+                gs.fs = 4000000;
+                gs.Prompt_I = 1000.0 + ch;
+                gs.Prompt_Q = -0.5 * epoch;
+                gs.CN0_dB_hz = 40.0 + 0.01 * epoch;
+                gs.Carrier_Doppler_hz = 100.0 * ch - 0.25 * epoch;
+                gs.Carrier_phase_rads = 0.001 * epoch * ch;
+                gs.Code_phase_samples = 0.5 * ch;
+                gs.Tracking_sample_counter = static_cast<uint64_t>(epoch) * 4000 + ch;
+                gs.TOW_at_current_symbol_ms = static_cast<uint32_t>(epoch);
+                gs.Pseudorange_m = 2.0e7 + 1.5 * epoch + ch;
+                gs.RX_time = 0.001 * epoch;
+                gs.interp_TOW_ms = epoch + 0.5;
+                gs.Flag_valid_symbol_output = (epoch % 2 == 0);
+                gs.Flag_valid_pseudorange = true;
+            }
+        return stocks;
+    }
+
+    // Waits until num_datagrams datagrams are received, or one second passes
+    std::vector<std::string> receive(size_t num_datagrams)
+    {
+        std::vector<std::string> datagrams;
+        std::array<char, 65536> buffer{};
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (datagrams.size() < num_datagrams && std::chrono::steady_clock::now() < deadline)
+            {
+                boost::system::error_code error;
+                const size_t length = d_receiver.receive(boost::asio::buffer(buffer), 0, error);
+                if (error)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        continue;
+                    }
+                datagrams.emplace_back(buffer.data(), length);
+            }
+        return datagrams;
+    }
+
+    static void expect_same(const Gnss_Synchro& expected, const Gnss_Synchro& actual)
+    {
+        EXPECT_EQ(expected.System, actual.System);
+        EXPECT_EQ(expected.Signal[0], actual.Signal[0]);
+        EXPECT_EQ(expected.Signal[1], actual.Signal[1]);
+        EXPECT_EQ(expected.PRN, actual.PRN);
+        EXPECT_EQ(expected.Channel_ID, actual.Channel_ID);
+        EXPECT_EQ(expected.fs, actual.fs);
+        EXPECT_EQ(expected.Prompt_I, actual.Prompt_I);
+        EXPECT_EQ(expected.Prompt_Q, actual.Prompt_Q);
+        EXPECT_EQ(expected.CN0_dB_hz, actual.CN0_dB_hz);
+        EXPECT_EQ(expected.Carrier_Doppler_hz, actual.Carrier_Doppler_hz);
+        EXPECT_EQ(expected.Carrier_phase_rads, actual.Carrier_phase_rads);
+        EXPECT_EQ(expected.Code_phase_samples, actual.Code_phase_samples);
+        EXPECT_EQ(expected.Tracking_sample_counter, actual.Tracking_sample_counter);
+        EXPECT_EQ(expected.TOW_at_current_symbol_ms, actual.TOW_at_current_symbol_ms);
+        EXPECT_EQ(expected.Pseudorange_m, actual.Pseudorange_m);
+        EXPECT_EQ(expected.RX_time, actual.RX_time);
+        EXPECT_EQ(expected.interp_TOW_ms, actual.interp_TOW_ms);
+        EXPECT_EQ(expected.Flag_valid_symbol_output, actual.Flag_valid_symbol_output);
+        EXPECT_EQ(expected.Flag_valid_pseudorange, actual.Flag_valid_pseudorange);
+    }
+
+    b_io_context d_io_context;
+    boost::asio::ip::udp::socket d_receiver;
+    uint16_t d_port{0};
+};
+
+
+TEST_F(GnssSynchroUdpSinkTest, DeliversAllObjectsInOrder)
+{
+    const int epochs = 20;
+    const int nchannels = 10;
+    std::vector<Gnss_Synchro> sent;
+    {
+        Gnss_Synchro_Udp_Sink sink({"127.0.0.1"}, d_port, false);
+        for (int epoch = 0; epoch < epochs; epoch++)
+            {
+                const auto stocks = make_epoch(epoch, nchannels);
+                EXPECT_TRUE(sink.write_gnss_synchro(stocks));
+                sent.insert(sent.end(), stocks.cbegin(), stocks.cend());
+            }
+        // The destructor sends the pending batches before returning
+    }
+
+    // Each batch fits in one datagram
+    const auto datagrams = receive(epochs);
+    ASSERT_EQ(datagrams.size(), static_cast<size_t>(epochs));
+    std::vector<Gnss_Synchro> received;
+    for (const auto& datagram : datagrams)
+        {
+            std::vector<Gnss_Synchro> stocks;
+            std::istringstream archive_stream(datagram);
+            boost::archive::binary_iarchive ia{archive_stream};
+            ia >> stocks;
+            received.insert(received.end(), stocks.cbegin(), stocks.cend());
+        }
+    ASSERT_EQ(received.size(), sent.size());
+    for (size_t n = 0; n < sent.size(); n++)
+        {
+            expect_same(sent[n], received[n]);
+        }
+}
+
+
+TEST_F(GnssSynchroUdpSinkTest, SameEncodingAsDirectSerialization)
+{
+    const auto stocks = make_epoch(3, 12);
+    {
+        Gnss_Synchro_Udp_Sink sink({"127.0.0.1"}, d_port, false);
+        EXPECT_TRUE(sink.write_gnss_synchro(stocks));
+    }
+
+    // What the sink sent for each batch before it had a thread of its own
+    std::ostringstream archive_stream;
+    boost::archive::binary_oarchive oa{archive_stream};
+    oa << stocks;
+
+    const auto datagrams = receive(1);
+    ASSERT_EQ(datagrams.size(), 1U);
+    EXPECT_EQ(datagrams[0], archive_stream.str());
+}
+
+
+TEST_F(GnssSynchroUdpSinkTest, SplitsLargeBatchesIntoProtobufDatagrams)
+{
+    // More objects than fit in a datagram
+    const auto stocks = make_epoch(7, 150);
+    {
+        Gnss_Synchro_Udp_Sink sink({"127.0.0.1"}, d_port, true);
+        EXPECT_TRUE(sink.write_gnss_synchro(stocks));
+    }
+
+    const auto datagrams = receive(3);
+    ASSERT_EQ(datagrams.size(), 3U);
+    Serdes_Gnss_Synchro serdes;
+    std::vector<Gnss_Synchro> received;
+    for (const auto& datagram : datagrams)
+        {
+            gnss_sdr::Observables observables;
+            ASSERT_TRUE(observables.ParseFromString(datagram));
+            const auto chunk = serdes.readProtobuffer(observables);
+            received.insert(received.end(), chunk.cbegin(), chunk.cend());
+        }
+    ASSERT_EQ(received.size(), stocks.size());
+    for (size_t n = 0; n < stocks.size(); n++)
+        {
+            expect_same(stocks[n], received[n]);
+        }
+}
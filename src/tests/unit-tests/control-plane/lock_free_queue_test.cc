@@ -0,0 +1,170 @@
+/*!
+ * \file lock_free_queue_test.cc
+ * \brief Checks the order, completeness and wake-up of Lock_Free_Queue, with
+ * one and several producers, and past the capacity of its ring.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "lock_free_queue.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST(LockFreeQueueTest, FifoOrderOfOneProducer)
+{
+    Lock_Free_Queue<int, 16> queue;
+    EXPECT_TRUE(queue.empty());
+    int value = -1;
+    EXPECT_FALSE(queue.try_pop(value));
+
+    for (int round = 0; round < 5; round++)
+        {
+            // Fewer messages than the capacity, wrapping around the ring
+            for (int i = 0; i < 11; i++)
+                {
+                    queue.push(100 * round + i);
+                }
+            EXPECT_FALSE(queue.empty());
+            for (int i = 0; i < 11; i++)
+                {
+                    ASSERT_TRUE(queue.try_pop(value));
+                    EXPECT_EQ(value, 100 * round + i);
+                }
+            EXPECT_TRUE(queue.empty());
+            EXPECT_FALSE(queue.try_pop(value));
+        }
+}
+
+
+TEST(LockFreeQueueTest, OverflowBeyondCapacityDrainsInOrder)
+{
+    Lock_Free_Queue<std::string, 4> queue;
+    for (int i = 0; i < 10; i++)
+        {
+            queue.push(std::to_string(i));
+        }
+
+    // The ring first, then the overflow
+    std::string value;
+    for (int i = 0; i < 6; i++)
+        {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, std::to_string(i));
+        }
+
+    // While the overflow is not drained, new messages go after it, even if
+    // there is room in the ring again
+    for (int i = 10; i < 13; i++)
+        {
+            queue.push(std::to_string(i));
+        }
+    for (int i = 6; i < 13; i++)
+        {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, std::to_string(i));
+        }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+
+    // Once drained, the ring is used again
+    for (int i = 0; i < 4; i++)
+        {
+            queue.push(std::to_string(100 + i));
+        }
+    for (int i = 0; i < 4; i++)
+        {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, std::to_string(100 + i));
+        }
+    EXPECT_TRUE(queue.empty());
+}
+
+
+TEST(LockFreeQueueTest, NoLossNorDuplicationWithManyProducers)
+{
+    const int producers = 8;
+    const int messages_per_producer = 20000;
+    // A small ring, so that the producers also go through the overflow
+    Lock_Free_Queue<int, 8> queue;
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producers; producer++)
+        {
+            threads.emplace_back([&queue, producer]() {
+                for (int i = 0; i < messages_per_producer; i++)
+                    {
+                        queue.push(producer * messages_per_producer + i);
+                    }
+            });
+        }
+
+    std::vector<int> next(producers, 0);
+    for (int n = 0; n < producers * messages_per_producer; n++)
+        {
+            int value = -1;
+            ASSERT_TRUE(queue.timed_wait_and_pop(value, 5000)) << "after " << n << " messages";
+            const int producer = value / messages_per_producer;
+            ASSERT_GE(producer, 0);
+            ASSERT_LT(producer, producers);
+            // In order, hence neither lost nor duplicated
+            ASSERT_EQ(value % messages_per_producer, next[producer]) << "producer " << producer;
+            next[producer]++;
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    for (int producer = 0; producer < producers; producer++)
+        {
+            EXPECT_EQ(next[producer], messages_per_producer);
+        }
+    EXPECT_TRUE(queue.empty());
+    int value = -1;
+    EXPECT_FALSE(queue.timed_wait_and_pop(value, 10));
+}
+
+
+TEST(LockFreeQueueTest, WaitAndPopWakesUpAfterParking)
+{
+    Lock_Free_Queue<int, 16> queue;
+    for (int round = 0; round < 3; round++)
+        {
+            int value = -1;
+            std::thread consumer([&queue, &value]() { queue.wait_and_pop(value); });
+            // Long enough for the consumer to stop spinning and park
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            EXPECT_EQ(value, -1);
+            queue.push(round);
+            consumer.join();
+            EXPECT_EQ(value, round);
+            EXPECT_TRUE(queue.empty());
+        }
+
+    // The timed wait gives up when nothing arrives
+    int value = -1;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.timed_wait_and_pop(value, 50));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    // and wakes up when something does
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        queue.push(7);
+    });
+    EXPECT_TRUE(queue.timed_wait_and_pop(value, 5000));
+    EXPECT_EQ(value, 7);
+    producer.join();
+}
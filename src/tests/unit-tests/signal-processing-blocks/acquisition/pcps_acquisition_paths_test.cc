@@ -0,0 +1,399 @@
+/*!
+ * \file pcps_acquisition_paths_test.cc
+ * \brief Checks that the optional search paths of pcps_acquisition (shared
+ * input spectra, Doppler workers, shared tables, frequency-domain Doppler
+ * search) acquire the same peak as the default one.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_shared_engine.h"
+#include "acq_table_cache.h"
+#include "acq_worker_pool.h"
+#include "gnss_block_interface.h"
+#include "gnss_synchro.h"
+#include "gps_l1_ca_pcps_acquisition.h"
+#include "in_memory_configuration.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if HAS_GENERIC_LAMBDA
+#else
+#include <boost/bind/bind.hpp>
+#endif
+
+#if PMT_USES_BOOST_ANY
+namespace wht = boost;
+#else
+namespace wht = std;
+#endif
+
+
+// ######## GNURADIO BLOCK MESSAGE RECEVER #########
+class PcpsAcquisitionPathsTest_msg_rx;
+
+using PcpsAcquisitionPathsTest_msg_rx_sptr = gnss_shared_ptr<PcpsAcquisitionPathsTest_msg_rx>;
+
+PcpsAcquisitionPathsTest_msg_rx_sptr PcpsAcquisitionPathsTest_msg_rx_make();
+
+class PcpsAcquisitionPathsTest_msg_rx : public gr::block
+{
+private:
+    friend PcpsAcquisitionPathsTest_msg_rx_sptr PcpsAcquisitionPathsTest_msg_rx_make();
+    void msg_handler_channel_events(const pmt::pmt_t &msg);
+    PcpsAcquisitionPathsTest_msg_rx();
+
+public:
+    int rx_message{0};
+    ~PcpsAcquisitionPathsTest_msg_rx() override;  //!< Default destructor
+};
+
+
+PcpsAcquisitionPathsTest_msg_rx_sptr PcpsAcquisitionPathsTest_msg_rx_make()
+{
+    return PcpsAcquisitionPathsTest_msg_rx_sptr(new PcpsAcquisitionPathsTest_msg_rx());
+}
+
+
+void PcpsAcquisitionPathsTest_msg_rx::msg_handler_channel_events(const pmt::pmt_t &msg)
+{
+    try
+        {
+            const int64_t message = pmt::to_long(msg);
+            if (rx_message == 0)
+                {
+                    rx_message = message;  // keep the result of the first dwell
+                }
+        }
+    catch (const wht::bad_any_cast &e)
+        {
+            LOG(WARNING) << "msg_handler_channel_events Bad any_cast: " << e.what();
+            rx_message = 0;
+        }
+}
+
+
+PcpsAcquisitionPathsTest_msg_rx::PcpsAcquisitionPathsTest_msg_rx()
+    : gr::block("PcpsAcquisitionPathsTest_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"),
+#if HAS_GENERIC_LAMBDA
+        [this](auto &&PH1) { msg_handler_channel_events(PH1); });
+#else
+#if USE_BOOST_BIND_PLACEHOLDERS
+        boost::bind(&PcpsAcquisitionPathsTest_msg_rx::msg_handler_channel_events, this, boost::placeholders::_1));
+#else
+        boost::bind(&PcpsAcquisitionPathsTest_msg_rx::msg_handler_channel_events, this, _1));
+#endif
+#endif
+}
+
+
+PcpsAcquisitionPathsTest_msg_rx::~PcpsAcquisitionPathsTest_msg_rx() = default;
+
+
+// ###########################################################
+
+class PcpsAcquisitionPathsTest : public ::testing::Test
+{
+protected:
+    struct Result
+    {
+        Gnss_Synchro synchro{};
+        int message{0};
+    };
+
+    /*
+     * Searches the PRNs, one channel each, in the GPS L1 C/A test file (which
+     * contains PRN 1), with the given acquisition properties on top of the
+     * default ones.
+     */
+    std::vector<Result> acquire(const std::vector<uint32_t> &prns, const std::map<std::string, std::string> &properties) const;
+
+    // The first dwell of all the paths must find the very same peak
+    void expect_same_peak(const Result &result, const Result &reference) const;
+};
+
+
+std::vector<PcpsAcquisitionPathsTest::Result> PcpsAcquisitionPathsTest::acquire(const std::vector<uint32_t> &prns,
+    const std::map<std::string, std::string> &properties) const
+{
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", "4000000");
+    config->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    config->set_property("Acquisition_1C.item_type", "gr_complex");
+    config->set_property("Acquisition_1C.coherent_integration_time_ms", "1");
+    config->set_property("Acquisition_1C.dump", "false");
+    config->set_property("Acquisition_1C.threshold", "0.001");
+    config->set_property("Acquisition_1C.doppler_max", "5000");
+    config->set_property("Acquisition_1C.doppler_step", "100");
+    config->set_property("Acquisition_1C.repeat_satellite", "false");
+    config->set_property("Acquisition_1C.blocking", "true");
+    for (const auto &property : properties)
+        {
+            config->set_property("Acquisition_1C." + property.first, property.second);
+        }
+
+    std::vector<Result> results(prns.size());
+    std::vector<gnss_shared_ptr<GpsL1CaPcpsAcquisition>> acquisitions;
+    std::vector<PcpsAcquisitionPathsTest_msg_rx_sptr> receivers;
+    auto top_block = gr::make_top_block("Acquisition paths test");
+    const std::string file = std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+    auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), file.c_str(), false);
+    for (size_t channel = 0; channel < prns.size(); channel++)
+        {
+            results[channel].synchro.Channel_ID = static_cast<int32_t>(channel);
+            results[channel].synchro.System = 'G';
+            std::string("1C").copy(results[channel].synchro.Signal, 2, 0);
+            results[channel].synchro.PRN = prns[channel];
+
+            auto acquisition = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+            auto msg_rx = PcpsAcquisitionPathsTest_msg_rx_make();
+            acquisition->set_channel(static_cast<unsigned int>(channel));
+            acquisition->set_gnss_synchro(&results[channel].synchro);
+            acquisition->set_threshold(0.001);
+            acquisition->set_doppler_max(5000);
+            acquisition->set_doppler_step(100);
+            acquisition->connect(top_block);
+            top_block->connect(file_source, 0, acquisition->get_left_block(), 0);
+            top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+            acquisition->set_local_code();
+            acquisition->set_state(1);  // Ensure that acquisition starts at the first sample
+            acquisition->init();
+            acquisitions.push_back(acquisition);
+            receivers.push_back(msg_rx);
+        }
+
+    top_block->run();  // Start threads and wait
+
+    for (size_t channel = 0; channel < prns.size(); channel++)
+        {
+            results[channel].message = receivers[channel]->rx_message;
+        }
+    return results;
+}
+
+
+void PcpsAcquisitionPathsTest::expect_same_peak(const Result &result, const Result &reference) const
+{
+    EXPECT_EQ(result.message, reference.message);
+    EXPECT_EQ(result.synchro.Acq_samplestamp_samples, reference.synchro.Acq_samplestamp_samples);
+    EXPECT_DOUBLE_EQ(result.synchro.Acq_delay_samples, reference.synchro.Acq_delay_samples);
+    EXPECT_DOUBLE_EQ(result.synchro.Acq_doppler_hz, reference.synchro.Acq_doppler_hz);
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, SharedEngineReusesTheSpectraOfTheSameBlock)
+{
+    Acq_Shared_Engine engine;
+    std::vector<std::complex<float>> block(16, std::complex<float>(1.0, -1.0));
+    int builds = 0;
+    const auto builder = [&builds](Acq_Input_Spectra &spectra) {
+        builds++;
+        spectra.bin(1)[0] = std::complex<float>(static_cast<float>(builds), 0.0);
+    };
+
+    const auto first = engine.get_spectra("1C_4000000", 0, block, 2, 16, builder);
+    const auto second = engine.get_spectra("1C_4000000", 0, block, 2, 16, builder);
+    EXPECT_EQ(builds, 1);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(engine.hits(), 1U);
+    EXPECT_EQ(second->bin(1)[0], std::complex<float>(1.0, 0.0));
+
+    // Another grid, another stamp or other samples are never shared
+    engine.get_spectra("1C_2000000", 0, block, 2, 16, builder);
+    engine.get_spectra("1C_4000000", 16, block, 2, 16, builder);
+    block[3] = std::complex<float>(0.0, 0.0);
+    engine.get_spectra("1C_4000000", 16, block, 2, 16, builder);
+    EXPECT_EQ(builds, 4);
+    EXPECT_EQ(engine.hits(), 1U);
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, SharedEngineRecoversFromBuilderFailure)
+{
+    Acq_Shared_Engine engine;
+    const std::vector<std::complex<float>> block(16, std::complex<float>(1.0, -1.0));
+    std::promise<void> building;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto failing = std::async(std::launch::async, [&engine, &block, &building, released]() {
+        engine.get_spectra("1C_4000000", 0, block, 2, 16, [&building, released](Acq_Input_Spectra &) {
+            building.set_value();
+            released.wait();
+            throw std::runtime_error("out of memory");
+        });
+    });
+    building.get_future().wait();
+
+    // This channel waits for the spectra being built, then builds them itself
+    auto waiting = std::async(std::launch::async, [&engine, &block]() {
+        return engine.get_spectra("1C_4000000", 0, block, 2, 16, [](Acq_Input_Spectra &spectra) {
+            spectra.bin(1)[0] = std::complex<float>(2.0, 0.0);
+        });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    release.set_value();
+    EXPECT_THROW(failing.get(), std::runtime_error);
+    ASSERT_EQ(waiting.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    const auto spectra = waiting.get();
+    EXPECT_EQ(spectra->bin(1)[0], std::complex<float>(2.0, 0.0));
+
+    // Those are the spectra shared from now on
+    int builds = 0;
+    EXPECT_EQ(engine.get_spectra("1C_4000000", 0, block, 2, 16, [&builds](Acq_Input_Spectra &) { builds++; }), spectra);
+    EXPECT_EQ(builds, 0);
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, SharedEngineFindsTheSamePeak)
+{
+    const std::vector<Result> reference = acquire({1, 2}, {});
+    ASSERT_EQ(reference[0].message, 1) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    const std::vector<Result> shared = acquire({1, 2}, {{"use_shared_engine", "true"}});
+    for (size_t channel = 0; channel < shared.size(); channel++)
+        {
+            expect_same_peak(shared[channel], reference[channel]);
+        }
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, WorkerPoolRunsEachWorkerOnce)
+{
+    Acq_Worker_Pool pool(4);
+    ASSERT_EQ(pool.size(), 4U);
+    std::vector<std::atomic<int>> runs(4);
+    for (auto &worker_runs : runs)
+        {
+            worker_runs = 0;
+        }
+    for (int task = 0; task < 100; task++)
+        {
+            pool.run([&runs](uint32_t worker_index) { runs[worker_index]++; });
+        }
+    for (const auto &worker_runs : runs)
+        {
+            EXPECT_EQ(worker_runs.load(), 100);
+        }
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, DopplerWorkersFindTheSamePeak)
+{
+    const std::vector<Result> reference = acquire({1}, {});
+    ASSERT_EQ(reference[0].message, 1) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    expect_same_peak(acquire({1}, {{"doppler_workers", "4"}})[0], reference[0]);
+
+    // Also in the narrow grid of the second step
+    const std::map<std::string, std::string> two_steps{{"make_two_steps", "true"}, {"second_nbins", "8"}, {"second_doppler_step", "10"}};
+    const std::vector<Result> reference_two_steps = acquire({1}, two_steps);
+    std::map<std::string, std::string> two_steps_workers = two_steps;
+    two_steps_workers["doppler_workers"] = "3";
+    expect_same_peak(acquire({1}, two_steps_workers)[0], reference_two_steps[0]);
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, TableCacheSharesTablesInUse)
+{
+    Acq_Table_Cache cache;
+    int builds = 0;
+    const auto builder = [&builds](Acq_Wipeoff_Table &table) {
+        builds++;
+        table[1][2] = std::complex<float>(0.0, 1.0);
+    };
+    auto table = cache.get_wipeoffs("4000000_4000_-5000_100_100", 2, 4, builder);
+    EXPECT_EQ(cache.get_wipeoffs("4000000_4000_-5000_100_100", 2, 4, builder), table);
+    EXPECT_EQ(builds, 1);
+    EXPECT_EQ((*table)[1][2], std::complex<float>(0.0, 1.0));
+
+    // Released when no channel uses it
+    table.reset();
+    cache.get_wipeoffs("4000000_4000_-5000_100_100", 2, 4, builder);
+    EXPECT_EQ(builds, 2);
+
+    // Code spectra are only reused for the same code
+    std::vector<std::complex<float>> code(4, std::complex<float>(1.0, 0.0));
+    int code_builds = 0;
+    const auto code_builder = [&code_builds](Acq_Code_Spectrum &) { code_builds++; };
+    const auto spectrum = cache.get_code_spectrum("1C_1", code, 8, code_builder);
+    EXPECT_EQ(cache.get_code_spectrum("1C_1", code, 8, code_builder), spectrum);
+    EXPECT_EQ(code_builds, 1);
+    code[0] = std::complex<float>(-1.0, 0.0);
+    EXPECT_NE(cache.get_code_spectrum("1C_1", code, 8, code_builder), spectrum);
+    EXPECT_EQ(code_builds, 2);
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, TableCacheBuildsWithoutBlockingOtherChannels)
+{
+    Acq_Table_Cache cache;
+    std::promise<void> building;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto slow = std::async(std::launch::async, [&cache, &building, released]() {
+        return cache.get_wipeoffs("slow", 1, 4, [&building, released](Acq_Wipeoff_Table &) {
+            building.set_value();
+            released.wait();
+        });
+    });
+    building.get_future().wait();
+
+    // Another table is served while the first one is being built
+    auto fast = std::async(std::launch::async, [&cache]() {
+        return cache.get_wipeoffs("fast", 1, 4, [](Acq_Wipeoff_Table &) {});
+    });
+    EXPECT_EQ(fast.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    release.set_value();
+    EXPECT_TRUE(slow.get());
+    EXPECT_TRUE(fast.get());
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, SharedTablesFindTheSamePeak)
+{
+    // A channel alone builds its tables, the second channel searching PRN 1
+    // finds the wipeoffs already built by the channel searching PRN 2
+    const std::vector<Result> reference = acquire({1}, {});
+    ASSERT_EQ(reference[0].message, 1) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    expect_same_peak(acquire({2, 1}, {})[1], reference[0]);
+}
+
+
+TEST_F(PcpsAcquisitionPathsTest, FrequencyDomainDopplerFindsTheSamePeak)
+{
+    // With 4000-point FFTs at 4 Msps the FFT bins are 1 kHz apart, so the
+    // 100 Hz Doppler step needs ten residual frequencies
+    const std::vector<Result> reference = acquire({1}, {});
+    ASSERT_EQ(reference[0].message, 1) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    expect_same_peak(acquire({1}, {{"frequency_domain_doppler", "true"}})[0], reference[0]);
+    expect_same_peak(acquire({1}, {{"frequency_domain_doppler", "true"}, {"doppler_workers", "4"}})[0], reference[0]);
+
+    // The residual spectra can also be shared among channels
+    expect_same_peak(acquire({2, 1}, {{"frequency_domain_doppler", "true"}, {"use_shared_engine", "true"}})[1], reference[0]);
+}
@@ -0,0 +1,164 @@
+/*!
+ * \file pulse_blanking_cc_test.cc
+ * \brief Checks that the pulse_blanking_cc block blanks the same samples as
+ * the segment by segment algorithm it replaced, across work calls.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pulse_blanking_cc.h"
+#include <boost/math/distributions/chi_squared.hpp>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_sink_c.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+
+namespace
+{
+constexpr float PULSE_BLANKING_TEST_PFA = 0.04;
+constexpr int32_t PULSE_BLANKING_TEST_LENGTH = 32;
+constexpr int32_t PULSE_BLANKING_TEST_SEGMENTS_EST = 100;
+constexpr int32_t PULSE_BLANKING_TEST_SEGMENTS_RESET = 2000;
+
+
+/*
+ * Former algorithm of the block: the energy of each segment of length
+ * samples, except the last sample of the input, is compared with the
+ * threshold given by pfa times the noise power estimated over the first
+ * n_segments_est segments, and the segment is zeroed if it exceeds it.
+ */
+std::vector<gr_complex> blank_segment_by_segment(const std::vector<gr_complex>& in)
+{
+    const int32_t n_deg_fred = 2 * PULSE_BLANKING_TEST_LENGTH;
+    boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred);
+    const float thres = boost::math::quantile(boost::math::complement(my_dist_, PULSE_BLANKING_TEST_PFA));
+    float noise_power_estimation = 0.0;
+    int32_t n_segments = 0;
+    bool last_filtered = false;
+    std::vector<gr_complex> out;
+    for (size_t sample_index = 0; sample_index + PULSE_BLANKING_TEST_LENGTH < in.size(); sample_index += PULSE_BLANKING_TEST_LENGTH)
+        {
+            float segment_energy = 0.0;
+            for (int32_t i = 0; i < PULSE_BLANKING_TEST_LENGTH; i++)
+                {
+                    segment_energy += std::norm(in[sample_index + i]);
+                }
+            bool blank = false;
+            if ((n_segments < PULSE_BLANKING_TEST_SEGMENTS_EST) && (last_filtered == false))
+                {
+                    noise_power_estimation = (static_cast<float>(n_segments) * noise_power_estimation + segment_energy / static_cast<float>(n_deg_fred)) / static_cast<float>(n_segments + 1);
+                }
+            else
+                {
+                    if ((segment_energy / noise_power_estimation) > thres)
+                        {
+                            blank = true;
+                            last_filtered = true;
+                        }
+                    else
+                        {
+                            last_filtered = false;
+                            if (n_segments > PULSE_BLANKING_TEST_SEGMENTS_RESET)
+                                {
+                                    n_segments = 0;
+                                }
+                        }
+                }
+            for (int32_t i = 0; i < PULSE_BLANKING_TEST_LENGTH; i++)
+                {
+                    out.push_back(blank ? gr_complex(0.0, 0.0) : in[sample_index + i]);
+                }
+            n_segments++;
+        }
+    return out;
+}
+
+
+/*
+ * Unit power complex noise with pulses of amplitude 10 and of different
+ * lengths, none of them aligned with the segments.
+ */
+std::vector<gr_complex> make_pulsed_noise(size_t num_samples)
+{
+    std::mt19937 generator(2026);
+    std::normal_distribution<float> noise(0.0, 0.7071);
+    std::uniform_real_distribution<float> phase(0.0, 6.2832);
+    std::vector<gr_complex> signal(num_samples);
+    for (auto& sample : signal)
+        {
+            sample = gr_complex(noise(generator), noise(generator));
+        }
+    for (size_t start = 10000; start < num_samples; start += 7919)
+        {
+            // Short pulses over two segments and, every few, a long one over
+            // several work calls
+            const size_t pulse_length = (start / 7919) % 5 == 0 ? 3000 : 45;
+            for (size_t n = start; n < std::min(start + pulse_length, num_samples); n++)
+                {
+                    signal[n] += std::polar(10.0F, phase(generator));
+                }
+        }
+    return signal;
+}
+}  // namespace
+
+
+TEST(PulseBlankingCcTest, SameOutputAsSegmentBySegmentBlanking)
+{
+    const std::vector<gr_complex> input = make_pulsed_noise(400001);
+    const std::vector<gr_complex> expected = blank_segment_by_segment(input);
+
+    auto top_block = gr::make_top_block("pulse_blanking_cc_test");
+    auto source = gr::blocks::vector_source_c::make(input);
+    auto blanking = make_pulse_blanking_cc(PULSE_BLANKING_TEST_PFA, PULSE_BLANKING_TEST_LENGTH, PULSE_BLANKING_TEST_SEGMENTS_EST, PULSE_BLANKING_TEST_SEGMENTS_RESET, 0.0);
+    // Many work calls, shorter than the long pulses
+    blanking->set_max_noutput_items(1000);
+    auto sink = gr::blocks::vector_sink_c::make();
+    top_block->connect(source, 0, blanking, 0);
+    top_block->connect(blanking, 0, sink, 0);
+    top_block->run();
+
+    const std::vector<gr_complex> output = sink->data();
+    ASSERT_EQ(output.size(), expected.size());
+    size_t blanked = 0;
+    for (size_t n = 0; n < output.size(); n++)
+        {
+            ASSERT_EQ(output[n], expected[n]) << "sample " << n << ", segment " << n / PULSE_BLANKING_TEST_LENGTH;
+            blanked += output[n] == gr_complex(0.0, 0.0);
+        }
+
+    // The pulses are blanked, except those that arrive while the noise power
+    // is being estimated again after a reset
+    size_t pulses = 0;
+    size_t blanked_pulses = 0;
+    for (size_t start = 10000; start < output.size(); start += 7919)
+        {
+            pulses++;
+            blanked_pulses += output[start + 1] == gr_complex(0.0, 0.0);
+        }
+    EXPECT_GT(blanked_pulses, pulses * 9 / 10);
+    EXPECT_GT(blanked, output.size() / 20);
+    EXPECT_LT(blanked, output.size() / 5);
+}
@@ -0,0 +1,133 @@
+/*!
+ * \file gnss_block_profiler_test.cc
+ * \brief This file implements unit tests for the Gnss_Block_Profiler class
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_block_profiler.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST(GnssBlockProfilerTest, HistogramBins)
+{
+    EXPECT_EQ(Gnss_Block_Stats::histogram_bin(0), 0U);
+    EXPECT_EQ(Gnss_Block_Stats::histogram_bin(1), 1U);
+    EXPECT_EQ(Gnss_Block_Stats::histogram_bin(2), 2U);
+    EXPECT_EQ(Gnss_Block_Stats::histogram_bin(3), 2U);
+    EXPECT_EQ(Gnss_Block_Stats::histogram_bin(1024), 11U);
+    EXPECT_EQ(Gnss_Block_Stats::histogram_bin(UINT64_MAX), Gnss_Block_Stats::HISTOGRAM_BINS - 1);
+}
+
+
+TEST(GnssBlockProfilerTest, RecordAndDrain)
+{
+    Gnss_Block_Stats stats("test_block", 1);
+    for (uint64_t i = 0; i < 10; i++)
+        {
+            stats.record(static_cast<int64_t>(i * 1000), 500, i * 4, 8);
+        }
+    EXPECT_EQ(stats.calls(), 10U);
+    EXPECT_EQ(stats.items(), 36U);  // items consumed by the first nine calls
+    EXPECT_EQ(stats.busy_ns(), 5000U);
+    EXPECT_EQ(stats.max_ns(), 500U);
+    EXPECT_EQ(stats.items_available(), 80U);
+    EXPECT_EQ(stats.duration_histogram()[Gnss_Block_Stats::histogram_bin(500)], 10U);
+    EXPECT_EQ(stats.occupancy_histogram()[Gnss_Block_Stats::histogram_bin(8)], 10U);
+
+    std::vector<Gnss_Block_Stats::Trace_Event> events;
+    stats.drain(events);
+    ASSERT_EQ(events.size(), 10U);
+    EXPECT_EQ(events[3].start_ns, 3000);
+    EXPECT_EQ(events[3].duration_ns, 500);
+    EXPECT_EQ(events[3].items_available, 8);
+
+    // The trace ring drops the calls it cannot hold
+    events.clear();
+    for (size_t i = 0; i < Gnss_Block_Stats::TRACE_CAPACITY + 5; i++)
+        {
+            stats.record(0, 1, 0, 0);
+        }
+    EXPECT_EQ(stats.dropped(), 5U);
+    stats.drain(events);
+    EXPECT_EQ(events.size(), Gnss_Block_Stats::TRACE_CAPACITY);
+
+    stats.reset();
+    EXPECT_EQ(stats.calls(), 0U);
+    EXPECT_EQ(stats.dropped(), 0U);
+}
+
+
+TEST(GnssBlockProfilerTest, TraceFile)
+{
+    const std::string filename("gnss_block_profiler_test.json");
+    auto& profiler = Gnss_Block_Profiler::instance();
+    auto stats = profiler.register_block("profiled_block", 1234);
+    {
+        // Nothing is recorded while profiling is disabled
+        const Gnss_Block_Timer timer(stats.get(), 0, 1);
+    }
+    EXPECT_EQ(stats->calls(), 0U);
+
+    ASSERT_TRUE(profiler.start(filename, 10));
+    EXPECT_TRUE(profiler.enabled());
+    EXPECT_FALSE(profiler.start(filename));
+    for (int i = 0; i < 3; i++)
+        {
+            const Gnss_Block_Timer timer(stats.get(), 0, 1);
+        }
+    profiler.stop();
+    EXPECT_FALSE(profiler.enabled());
+    EXPECT_EQ(stats->calls(), 3U);
+    EXPECT_NE(profiler.report().find("profiled_block (1234)"), std::string::npos);
+
+    std::ifstream trace(filename);
+    std::stringstream contents;
+    contents << trace.rdbuf();
+    const std::string json = contents.str();
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_NE(json.find(R"("name":"profiled_block")"), std::string::npos);
+    size_t work_events = 0;
+    for (size_t pos = json.find(R"("name":"work")"); pos != std::string::npos; pos = json.find(R"("name":"work")", pos + 1))
+        {
+            work_events++;
+        }
+    EXPECT_EQ(work_events, 3U);
+    EXPECT_EQ(json.substr(json.size() - 3), "\n]\n");
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssBlockProfilerTest, ConcurrentStartAndStop)
+{
+    // Commands may arrive while another thread is stopping the profiler
+    auto& profiler = Gnss_Block_Profiler::instance();
+    auto toggle = [&profiler]() {
+        for (int i = 0; i < 200; i++)
+            {
+                profiler.start("", 1);
+                profiler.stop();
+            }
+    };
+    std::thread first(toggle);
+    std::thread second(toggle);
+    first.join();
+    second.join();
+    EXPECT_FALSE(profiler.enabled());
+}
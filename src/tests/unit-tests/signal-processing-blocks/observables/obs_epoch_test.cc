@@ -0,0 +1,373 @@
+/*!
+ * \file obs_epoch_test.cc
+ * \brief Checks that Obs_Epoch computes the same receiver time, pseudoranges
+ * and carrier smoothing as the per-channel code it replaced in the
+ * Observables block.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include "gnss_synchro.h"
+#include "obs_epoch.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+constexpr uint32_t OBS_EPOCH_TEST_CHANNELS = 24;
+constexpr uint32_t OBS_EPOCH_TEST_STEP_MS = 20;
+constexpr double OBS_EPOCH_TEST_SMOOTH_M = 100.0;
+
+
+/*
+ * Receiver time, pseudoranges and carrier smoothing computed channel by
+ * channel, as hybrid_observables_gs did before Obs_Epoch.
+ */
+class Per_Channel_Observables
+{
+public:
+    explicit Per_Channel_Observables(uint32_t nchann)
+        : d_last_pseudorange_smooth(nchann, 0.0),
+          d_last_carrier_phase_rads(nchann, 0.0),
+          d_last_pll_lock(nchann, false)
+    {
+        d_wavelength_m["1C"] = SPEED_OF_LIGHT_M_S / FREQ1;
+        d_wavelength_m["1B"] = SPEED_OF_LIGHT_M_S / FREQ1;
+        d_wavelength_m["L5"] = SPEED_OF_LIGHT_M_S / FREQ5;
+        d_wavelength_m["5X"] = SPEED_OF_LIGHT_M_S / FREQ5;
+        d_wavelength_m["E6"] = SPEED_OF_LIGHT_M_S / FREQ6;
+        d_wavelength_m["7X"] = SPEED_OF_LIGHT_M_S / FREQ7;
+        d_wavelength_m["2S"] = SPEED_OF_LIGHT_M_S / FREQ2;
+        d_wavelength_m["B3"] = SPEED_OF_LIGHT_M_S / FREQ3_BDS;
+        d_wavelength_m["1G"] = SPEED_OF_LIGHT_M_S / FREQ1_GLO;
+        d_wavelength_m["2G"] = SPEED_OF_LIGHT_M_S / FREQ2_GLO;
+        d_wavelength_m["B1"] = SPEED_OF_LIGHT_M_S / FREQ1_BDS;
+        d_wavelength_m["B2"] = SPEED_OF_LIGHT_M_S / FREQ2_BDS;
+    }
+
+    void update_TOW(const std::vector<Gnss_Synchro>& data)
+    {
+        if (!T_rx_TOW_set)
+            {
+                uint32_t TOW_ref = 0U;
+                for (const auto& it : data)
+                    {
+                        if (it.Flag_valid_word && it.TOW_at_current_symbol_ms > TOW_ref)
+                            {
+                                TOW_ref = it.TOW_at_current_symbol_ms;
+                                T_rx_TOW_set = true;
+                            }
+                    }
+                T_rx_TOW_ms = TOW_ref;
+                if (T_rx_TOW_ms % OBS_EPOCH_TEST_STEP_MS)
+                    {
+                        T_rx_TOW_ms += OBS_EPOCH_TEST_STEP_MS - T_rx_TOW_ms % OBS_EPOCH_TEST_STEP_MS;
+                    }
+            }
+        else
+            {
+                T_rx_TOW_ms += OBS_EPOCH_TEST_STEP_MS;
+                if (T_rx_TOW_ms >= 604800000)
+                    {
+                        T_rx_TOW_ms = T_rx_TOW_ms % 604800000;
+                    }
+            }
+    }
+
+    void compute_pranges(std::vector<Gnss_Synchro>& data) const
+    {
+        const auto current_T_rx_TOW_ms = static_cast<double>(T_rx_TOW_ms);
+        const double current_T_rx_TOW_s = current_T_rx_TOW_ms / 1000.0;
+        for (auto& it : data)
+            {
+                if (it.Flag_valid_word)
+                    {
+                        double traveltime_ms = current_T_rx_TOW_ms - it.interp_TOW_ms;
+                        if (std::fabs(traveltime_ms) > 302400)
+                            {
+                                traveltime_ms = 604800000.0 + current_T_rx_TOW_ms - it.interp_TOW_ms;
+                            }
+                        it.Pseudorange_m = traveltime_ms * SPEED_OF_LIGHT_M_MS;
+                        it.Flag_valid_pseudorange = true;
+                    }
+                it.RX_time = current_T_rx_TOW_s;
+            }
+    }
+
+    void smooth_pseudoranges(std::vector<Gnss_Synchro>& data)
+    {
+        for (auto& it : data)
+            {
+                if (it.Flag_valid_pseudorange)
+                    {
+                        // unknown signals were looked up as GPS L1 C/A
+                        const auto wavelength = d_wavelength_m.find(std::string(it.Signal, 2));
+                        const double wavelength_m = wavelength == d_wavelength_m.end() ? SPEED_OF_LIGHT_M_S / FREQ1 : wavelength->second;
+                        if (d_last_pll_lock[it.Channel_ID])
+                            {
+                                const double r_sm = d_last_pseudorange_smooth[it.Channel_ID];
+                                const double factor = ((OBS_EPOCH_TEST_SMOOTH_M - 1.0) / OBS_EPOCH_TEST_SMOOTH_M);
+                                it.Pseudorange_m = factor * r_sm + (1.0 / OBS_EPOCH_TEST_SMOOTH_M) * it.Pseudorange_m + wavelength_m * (factor / TWO_PI) * (it.Carrier_phase_rads - d_last_carrier_phase_rads[it.Channel_ID]);
+                            }
+                        d_last_pseudorange_smooth[it.Channel_ID] = it.Pseudorange_m;
+                        d_last_carrier_phase_rads[it.Channel_ID] = it.Carrier_phase_rads;
+                        d_last_pll_lock[it.Channel_ID] = it.Flag_valid_pseudorange;
+                    }
+                else
+                    {
+                        d_last_pll_lock[it.Channel_ID] = false;
+                    }
+            }
+    }
+
+    uint32_t T_rx_TOW_ms{0};
+    bool T_rx_TOW_set{false};
+
+private:
+    std::map<std::string, double> d_wavelength_m;
+    std::vector<double> d_last_pseudorange_smooth;
+    std::vector<double> d_last_carrier_phase_rads;
+    std::vector<bool> d_last_pll_lock;
+};
+
+
+/*
+ * Runs both implementations on the same epochs, as hybrid_observables_gs
+ * calls them, and checks that they produce the same observables.
+ * valid_word_probability = 0 gives epochs without any valid channel.
+ */
+class Obs_Epoch_Comparison
+{
+public:
+    Obs_Epoch_Comparison() : d_reference(OBS_EPOCH_TEST_CHANNELS), d_epoch(OBS_EPOCH_TEST_CHANNELS) {}
+
+    void run_epoch(const std::vector<Gnss_Synchro>& interpolated)
+    {
+        int32_t n_valid = 0;
+        for (const auto& it : interpolated)
+            {
+                n_valid += it.Flag_valid_word;
+            }
+        std::vector<Gnss_Synchro> expected(interpolated);
+        std::vector<Gnss_Synchro> actual(interpolated);
+
+        if (d_reference.T_rx_TOW_set || n_valid > 0)
+            {
+                d_reference.update_TOW(expected);
+            }
+        if (n_valid > 0)
+            {
+                d_reference.compute_pranges(expected);
+            }
+        d_reference.smooth_pseudoranges(expected);
+
+        d_epoch.load(actual);
+        if (d_T_rx_TOW_set)
+            {
+                d_T_rx_TOW_ms += OBS_EPOCH_TEST_STEP_MS;
+                if (d_T_rx_TOW_ms >= 604800000)
+                    {
+                        d_T_rx_TOW_ms = d_T_rx_TOW_ms % 604800000;
+                    }
+            }
+        else if (n_valid > 0)
+            {
+                d_T_rx_TOW_ms = d_epoch.max_valid_tow_ms();
+                d_T_rx_TOW_set = d_T_rx_TOW_ms > 0U;
+                if (d_T_rx_TOW_ms % OBS_EPOCH_TEST_STEP_MS)
+                    {
+                        d_T_rx_TOW_ms += OBS_EPOCH_TEST_STEP_MS - d_T_rx_TOW_ms % OBS_EPOCH_TEST_STEP_MS;
+                    }
+            }
+        if (n_valid > 0)
+            {
+                d_epoch.compute_pranges(d_T_rx_TOW_ms);
+            }
+        d_epoch.smooth_pseudoranges(OBS_EPOCH_TEST_SMOOTH_M);
+        d_epoch.store(actual);
+
+        ASSERT_EQ(d_T_rx_TOW_set, d_reference.T_rx_TOW_set) << "epoch " << d_epochs;
+        ASSERT_EQ(d_T_rx_TOW_ms, d_reference.T_rx_TOW_ms) << "epoch " << d_epochs;
+        for (uint32_t ch = 0; ch < OBS_EPOCH_TEST_CHANNELS; ch++)
+            {
+                // Same operations in the same order, the results must be identical
+                ASSERT_EQ(actual[ch].Flag_valid_pseudorange, expected[ch].Flag_valid_pseudorange) << "epoch " << d_epochs << ", channel " << ch;
+                ASSERT_EQ(0, std::memcmp(&actual[ch].Pseudorange_m, &expected[ch].Pseudorange_m, sizeof(double))) << "epoch " << d_epochs << ", channel " << ch << ": " << actual[ch].Pseudorange_m << " != " << expected[ch].Pseudorange_m;
+                ASSERT_EQ(0, std::memcmp(&actual[ch].RX_time, &expected[ch].RX_time, sizeof(double))) << "epoch " << d_epochs << ", channel " << ch;
+                d_valid_pseudoranges += expected[ch].Flag_valid_pseudorange;
+            }
+        d_epochs++;
+    }
+
+    // Interpolated observables of one epoch, with the TOW of the channels
+    // some 70 ms behind the given receiver time
+    std::vector<Gnss_Synchro> make_epoch(double T_rx_TOW_ms, double valid_word_probability, uint32_t signal_offset)
+    {
+        static const std::vector<std::string> signals{"1C", "2S", "L5", "1B", "5X", "E6", "7X", "1G", "2G", "B1", "B2", "B3", "XX"};
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<Gnss_Synchro> data(OBS_EPOCH_TEST_CHANNELS);
+        for (uint32_t ch = 0; ch < OBS_EPOCH_TEST_CHANNELS; ch++)
+            {
+                Gnss_Synchro& obs = data[ch];
+                obs = Gnss_Synchro();
+                obs.Channel_ID = ch;
+                if (uniform(d_generator) < valid_word_probability)
+                    {
+                        obs.Flag_valid_word = true;
+                        double tow_ms = std::fmod(T_rx_TOW_ms, 604800000.0) - 70.0 - 10.0 * uniform(d_generator);
+                        if (tow_ms < 0.0)
+                            {
+                                tow_ms += 604800000.0;
+                            }
+                        obs.interp_TOW_ms = tow_ms;
+                        obs.TOW_at_current_symbol_ms = static_cast<uint32_t>(tow_ms);
+                        obs.Carrier_phase_rads = 1000.0 * d_epochs + uniform(d_generator);
+                        std::strcpy(obs.Signal, signals[(ch + signal_offset) % signals.size()].c_str());
+                        // left over from the tracking, overwritten by compute_pranges()
+                        obs.Flag_valid_pseudorange = uniform(d_generator) < 0.1;
+                        obs.Pseudorange_m = uniform(d_generator);
+                    }
+                else
+                    {
+                        // empty observation, as produced when the interpolation fails
+                        obs.Flag_valid_pseudorange = uniform(d_generator) < 0.05;
+                        obs.RX_time = uniform(d_generator);
+                    }
+            }
+        return data;
+    }
+
+    uint32_t T_rx_TOW_ms() const { return d_T_rx_TOW_ms; }
+    int32_t valid_pseudoranges() const { return d_valid_pseudoranges; }
+
+private:
+    Per_Channel_Observables d_reference;
+    Obs_Epoch d_epoch;
+    std::mt19937 d_generator{2026};
+    uint32_t d_T_rx_TOW_ms{0};
+    bool d_T_rx_TOW_set{false};
+    int32_t d_epochs{0};
+    int32_t d_valid_pseudoranges{0};
+};
+}  // namespace
+
+
+TEST(ObsEpochTest, CarrierWavelengths)
+{
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("1C"), SPEED_OF_LIGHT_M_S / FREQ1);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("1B"), SPEED_OF_LIGHT_M_S / FREQ1);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("L5"), SPEED_OF_LIGHT_M_S / FREQ5);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("5X"), SPEED_OF_LIGHT_M_S / FREQ5);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("E6"), SPEED_OF_LIGHT_M_S / FREQ6);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("7X"), SPEED_OF_LIGHT_M_S / FREQ7);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("2S"), SPEED_OF_LIGHT_M_S / FREQ2);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("B3"), SPEED_OF_LIGHT_M_S / FREQ3_BDS);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("1G"), SPEED_OF_LIGHT_M_S / FREQ1_GLO);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("2G"), SPEED_OF_LIGHT_M_S / FREQ2_GLO);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("B1"), SPEED_OF_LIGHT_M_S / FREQ1_BDS);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m("B2"), SPEED_OF_LIGHT_M_S / FREQ2_BDS);
+    EXPECT_DOUBLE_EQ(Obs_Epoch::carrier_wavelength_m(""), SPEED_OF_LIGHT_M_S / FREQ1);
+}
+
+
+TEST(ObsEpochTest, MaxValidTowIgnoresChannelsWithoutValidWord)
+{
+    Obs_Epoch epoch(3);
+    std::vector<Gnss_Synchro> data(3);
+    data[0].TOW_at_current_symbol_ms = 500000;
+    data[1].TOW_at_current_symbol_ms = 300000;
+    data[2].TOW_at_current_symbol_ms = 400000;
+    epoch.load(data);
+    EXPECT_EQ(epoch.max_valid_tow_ms(), 0U);
+
+    data[1].Flag_valid_word = true;
+    data[2].Flag_valid_word = true;
+    epoch.load(data);
+    EXPECT_EQ(epoch.max_valid_tow_ms(), 400000U);
+}
+
+
+TEST(ObsEpochTest, SameObservablesAsPerChannelCode)
+{
+    Obs_Epoch_Comparison comparison;
+    // Epochs without any valid channel before and in between, signal changes
+    // on every channel every 100 epochs
+    for (int32_t n = 0; n < 1000; n++)
+        {
+            const double valid_word_probability = (n < 5 || (n >= 400 && n < 410)) ? 0.0 : 0.8;
+            comparison.run_epoch(comparison.make_epoch(100000.0 + 20.0 * n, valid_word_probability, n / 100));
+        }
+    EXPECT_GT(comparison.valid_pseudoranges(), 0);
+}
+
+
+TEST(ObsEpochTest, SameObservablesAcrossWeekRollover)
+{
+    Obs_Epoch_Comparison comparison;
+    // The receiver time crosses the end of the week after 250 epochs, while
+    // the TOW of the channels is still in the previous week for a few epochs
+    const double start_ms = 604800000.0 - 5000.0;
+    for (int32_t n = 0; n < 500; n++)
+        {
+            comparison.run_epoch(comparison.make_epoch(start_ms + 20.0 * n, n < 3 ? 0.0 : 0.9, n / 50));
+        }
+    EXPECT_LT(comparison.T_rx_TOW_ms(), 10000U);
+    EXPECT_GT(comparison.valid_pseudoranges(), 0);
+}
+
+
+TEST(ObsEpochTest, SmoothingRestartsAfterLossOfLock)
+{
+    Obs_Epoch epoch(1);
+    std::vector<Gnss_Synchro> data(1);
+    std::strcpy(data[0].Signal, "1C");
+    const double wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1;
+
+    data[0].Flag_valid_pseudorange = true;
+    data[0].Pseudorange_m = 20000000.0;
+    data[0].Carrier_phase_rads = 0.0;
+    epoch.load(data);
+    epoch.smooth_pseudoranges(OBS_EPOCH_TEST_SMOOTH_M);
+    epoch.store(data);
+    EXPECT_EQ(data[0].Pseudorange_m, 20000000.0);
+
+    // Filtered with the previous epoch
+    data[0].Pseudorange_m = 20000010.0;
+    data[0].Carrier_phase_rads = TWO_PI;
+    epoch.load(data);
+    epoch.smooth_pseudoranges(OBS_EPOCH_TEST_SMOOTH_M);
+    epoch.store(data);
+    const double factor = (OBS_EPOCH_TEST_SMOOTH_M - 1.0) / OBS_EPOCH_TEST_SMOOTH_M;
+    EXPECT_DOUBLE_EQ(data[0].Pseudorange_m, factor * 20000000.0 + 20000010.0 / OBS_EPOCH_TEST_SMOOTH_M + wavelength_m * factor);
+
+    // An epoch without valid pseudorange restarts the filter
+    data[0].Flag_valid_pseudorange = false;
+    epoch.load(data);
+    epoch.smooth_pseudoranges(OBS_EPOCH_TEST_SMOOTH_M);
+    data[0].Flag_valid_pseudorange = true;
+    data[0].Pseudorange_m = 20000100.0;
+    data[0].Carrier_phase_rads = 3.0 * TWO_PI;
+    epoch.load(data);
+    epoch.smooth_pseudoranges(OBS_EPOCH_TEST_SMOOTH_M);
+    epoch.store(data);
+    EXPECT_EQ(data[0].Pseudorange_m, 20000100.0);
+}
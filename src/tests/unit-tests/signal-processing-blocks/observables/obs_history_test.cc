@@ -0,0 +1,132 @@
+/*!
+ * \file obs_history_test.cc
+ * \brief Checks that Obs_History returns the same observables as the
+ * Gnss_circular_deque history it replaced in the Observables block.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_circular_deque.h"
+#include "gnss_synchro.h"
+#include "obs_history.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+
+namespace
+{
+constexpr uint32_t OBS_HISTORY_TEST_CHANNELS = 4;
+constexpr uint32_t OBS_HISTORY_TEST_CAPACITY = 7;
+
+
+// Checks every element of channel ch, as read by find_nearest_trk_obs() and
+// interp_trk_obs(), against the baseline history
+void expect_same_history(const Obs_History& history, Gnss_circular_deque<Gnss_Synchro>& baseline, uint32_t ch)
+{
+    ASSERT_EQ(history.size(ch), baseline.size(ch));
+    for (uint32_t pos = 0; pos < history.size(ch); pos++)
+        {
+            const Gnss_Synchro& expected = baseline.at(ch, pos);
+            EXPECT_EQ(history.sample_counter(ch, pos), expected.Tracking_sample_counter);
+            EXPECT_EQ(history.rx_time(ch, pos), expected.RX_time);
+            EXPECT_EQ(history.carrier_phase_rads(ch, pos), expected.Carrier_phase_rads);
+            EXPECT_EQ(history.carrier_doppler_hz(ch, pos), expected.Carrier_Doppler_hz);
+            EXPECT_EQ(history.tow_ms(ch, pos), expected.TOW_at_current_symbol_ms);
+
+            const Gnss_Synchro& actual = history.get(ch, pos);
+            EXPECT_EQ(actual.PRN, expected.PRN);
+            EXPECT_EQ(actual.fs, expected.fs);
+            EXPECT_EQ(actual.Code_phase_samples, expected.Code_phase_samples);
+            EXPECT_EQ(actual.CN0_dB_hz, expected.CN0_dB_hz);
+            EXPECT_EQ(actual.Flag_valid_symbol_output, expected.Flag_valid_symbol_output);
+            EXPECT_EQ(actual.RX_time, expected.RX_time);
+        }
+    if (baseline.size(ch) > 0)
+        {
+            EXPECT_EQ(history.prn(ch), baseline.front(ch).PRN);
+        }
+}
+}  // namespace
+
+
+TEST(ObsHistoryTest, MatchesCircularDeque)
+{
+    Obs_History history(OBS_HISTORY_TEST_CAPACITY, OBS_HISTORY_TEST_CHANNELS);
+    Gnss_circular_deque<Gnss_Synchro> baseline(OBS_HISTORY_TEST_CAPACITY, OBS_HISTORY_TEST_CHANNELS);
+
+    std::default_random_engine generator(42);
+    std::uniform_int_distribution<uint32_t> channel(0, OBS_HISTORY_TEST_CHANNELS - 1);
+    std::uniform_int_distribution<uint32_t> percent(0, 99);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    uint32_t prn[OBS_HISTORY_TEST_CHANNELS] = {1, 2, 3, 4};
+    uint64_t sample_counter[OBS_HISTORY_TEST_CHANNELS] = {0, 0, 0, 0};
+
+    for (int n = 0; n < 2000; n++)
+        {
+            const uint32_t ch = channel(generator);
+            if (percent(generator) < 2)
+                {
+                    // The channel is assigned to another satellite, as handled
+                    // by the Observables block
+                    prn[ch] += OBS_HISTORY_TEST_CHANNELS;
+                    history.clear(ch);
+                    baseline.clear(ch);
+                }
+
+            Gnss_Synchro obs{};
+            obs.PRN = prn[ch];
+            obs.fs = 4000000;
+            sample_counter[ch] += 4000 + percent(generator);
+            obs.Tracking_sample_counter = sample_counter[ch];
+            obs.Code_phase_samples = noise(generator);
+            obs.Carrier_phase_rads = 1e3 * noise(generator);
+            obs.Carrier_Doppler_hz = 1e3 * noise(generator);
+            obs.CN0_dB_hz = 45.0 + noise(generator);
+            obs.TOW_at_current_symbol_ms = static_cast<uint32_t>(n * 20);
+            obs.Flag_valid_symbol_output = (percent(generator) < 90);
+            const double rx_time = static_cast<double>(sample_counter[ch]) / 4e6 + 1e-9 * noise(generator);
+
+            history.push_back(ch, obs, rx_time);
+            // The baseline block stored the receiver time in the last element
+            baseline.push_back(ch, obs);
+            baseline.back(ch).RX_time = rx_time;
+
+            expect_same_history(history, baseline, ch);
+        }
+
+    for (uint32_t ch = 0; ch < OBS_HISTORY_TEST_CHANNELS; ch++)
+        {
+            expect_same_history(history, baseline, ch);
+        }
+}
+
+
+TEST(ObsHistoryTest, OverwritesOldestElement)
+{
+    Obs_History history(3, 1);
+    for (uint32_t n = 0; n < 5; n++)
+        {
+            Gnss_Synchro obs{};
+            obs.PRN = 7;
+            obs.Tracking_sample_counter = n;
+            history.push_back(0, obs, static_cast<double>(n));
+        }
+    ASSERT_EQ(history.size(0), 3U);
+    EXPECT_EQ(history.sample_counter(0, 0), 2U);
+    EXPECT_EQ(history.sample_counter(0, 2), 4U);
+    EXPECT_EQ(history.get(0, 1).RX_time, 3.0);
+
+    history.clear(0);
+    EXPECT_EQ(history.size(0), 0U);
+}
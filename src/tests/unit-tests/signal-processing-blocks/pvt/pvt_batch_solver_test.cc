@@ -0,0 +1,382 @@
+/*!
+ * \file pvt_batch_solver_test.cc
+ * \brief Implements Unit Tests for the observables log and the batch PVT
+ * solver.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_ephemeris.h"
+#include "gnss_synchro.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "pvt_batch_solver.h"
+#include "pvt_observables_log.h"
+#include "rtklib.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_solver.h"
+#include "rtklib_test_data.h"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+
+TEST(PvtBatchSolverTest, ObservablesLogRoundTrip)
+{
+    const std::string filename("./pvt_observables_test.dat");
+    std::map<int, Gnss_Synchro> observables;
+    observables[2] = Gnss_Synchro();
+    observables[2].System = 'G';
+    std::memcpy(observables[2].Signal, "1C", 3);
+    observables[2].PRN = 5;
+    observables[2].Pseudorange_m = 21000000.125;
+    observables[2].Carrier_phase_rads = -1234.5;
+    observables[2].Carrier_Doppler_hz = 1500.25;
+    observables[2].CN0_dB_hz = 45.5;
+    observables[2].RX_time = 345600.02;
+    Gps_Iono iono;
+    iono.alpha0 = 1e-8;
+    Gps_Ephemeris eph;
+    eph.PRN = 5;
+    eph.toe = 7200;
+    Gps_Ephemeris new_eph = eph;
+    new_eph.toe = 14400;
+    Galileo_Ephemeris gal_eph;
+    gal_eph.PRN = 3;
+    {
+        Pvt_Observables_Log_Writer log(filename);
+        ASSERT_TRUE(log.is_open());
+        log.write(iono);
+        log.write(observables);
+        log.write(observables);
+        log.write(eph);
+        log.write(observables);
+        log.write(new_eph);
+        log.write(gal_eph);
+    }
+
+    Pvt_Recorded_Observables recording;
+    ASSERT_TRUE(recording.read(filename));
+    std::remove(filename.c_str());
+    ASSERT_EQ(recording.epochs.size(), 3U);
+    const Gnss_Synchro& obs = recording.epochs[2].at(2);
+    EXPECT_EQ(obs.System, 'G');
+    EXPECT_EQ(std::string(obs.Signal), "1C");
+    EXPECT_EQ(obs.PRN, 5U);
+    EXPECT_DOUBLE_EQ(obs.Pseudorange_m, 21000000.125);
+    EXPECT_DOUBLE_EQ(obs.Carrier_phase_rads, -1234.5);
+    EXPECT_DOUBLE_EQ(obs.Carrier_Doppler_hz, 1500.25);
+    EXPECT_DOUBLE_EQ(obs.CN0_dB_hz, 45.5);
+    EXPECT_DOUBLE_EQ(obs.RX_time, 345600.02);
+    EXPECT_TRUE(obs.Flag_valid_pseudorange);
+
+    // Each record applies from the next epoch, and knows the one it replaces
+    ASSERT_EQ(recording.navigation.size(), 4U);
+    EXPECT_EQ(recording.navigation[0].epoch, 0U);
+    EXPECT_EQ(recording.navigation[1].epoch, 2U);
+    EXPECT_EQ(recording.navigation[2].epoch, 3U);
+    EXPECT_EQ(recording.navigation[2].previous, 1);
+    EXPECT_EQ(recording.navigation[3].previous, -1);
+
+    rtk_t rtk{};
+    Rtklib_Solver solver(rtk, "filename", false, false);
+    recording.navigation[0].store(solver);
+    recording.navigation[2].store(solver);
+    EXPECT_DOUBLE_EQ(solver.gps_iono.alpha0, 1e-8);
+    EXPECT_EQ(solver.gps_ephemeris_map.at(5).toe, 14400);
+    recording.navigation[1].store(solver);
+    EXPECT_EQ(solver.gps_ephemeris_map.at(5).toe, 7200);
+    recording.navigation[1].reset(solver);
+    EXPECT_TRUE(solver.gps_ephemeris_map.empty());
+}
+
+
+TEST(PvtBatchSolverTest, ClearEphemerisRecord)
+{
+    const std::string filename("./pvt_observables_clear_test.dat");
+    const std::map<int, Gnss_Synchro> observables;
+    Gps_Ephemeris eph;
+    eph.PRN = 5;
+    eph.toe = 7200;
+    Gps_Ephemeris new_eph = eph;
+    new_eph.toe = 14400;
+    Gps_Iono iono;
+    iono.alpha0 = 1e-8;
+    {
+        Pvt_Observables_Log_Writer log(filename);
+        ASSERT_TRUE(log.is_open());
+        log.write(eph);
+        log.write(iono);
+        log.write(observables);
+        log.write_clear_ephemeris();  // written with the next record
+        log.write(observables);
+        log.write(new_eph);
+        log.write(observables);
+    }
+
+    Pvt_Recorded_Observables recording;
+    ASSERT_TRUE(recording.read(filename));
+    std::remove(filename.c_str());
+    ASSERT_EQ(recording.epochs.size(), 3U);
+    ASSERT_EQ(recording.navigation.size(), 4U);
+    EXPECT_EQ(recording.navigation[2].epoch, 1U);
+    EXPECT_EQ(recording.navigation[3].epoch, 2U);
+    EXPECT_EQ(recording.navigation[3].previous, -1);  // nothing to go back to after a cold start
+
+    rtk_t rtk{};
+    Rtklib_Solver solver(rtk, "filename", false, false);
+    for (const auto& record : recording.navigation)
+        {
+            record.store(solver);
+        }
+    EXPECT_EQ(solver.gps_ephemeris_map.at(5).toe, 14400);
+    recording.navigation[3].reset(solver);
+    EXPECT_TRUE(solver.gps_ephemeris_map.empty());
+    recording.navigation[2].reset(solver);
+    EXPECT_EQ(solver.gps_ephemeris_map.at(5).toe, 7200);
+    recording.navigation[2].store(solver);
+    EXPECT_TRUE(solver.gps_ephemeris_map.empty());
+    EXPECT_DOUBLE_EQ(solver.gps_iono.alpha0, 1e-8);  // only the ephemerides are cleared
+}
+
+
+TEST(PvtBatchSolverTest, SmoothingWeightsByCovariance)
+{
+    Pvt_Batch_Solution forward;
+    forward.valid = true;
+    forward.sol.stat = SOLQ_PPP;
+    forward.sol.qr[0] = forward.sol.qr[1] = forward.sol.qr[2] = 1.0;
+    Pvt_Batch_Solution backward = forward;
+    backward.sol.rr[0] = 2.0;
+    backward.sol.rr[1] = 4.0;
+    backward.sol.rr[2] = 6.0;
+
+    const Pvt_Batch_Solution combined = combine_pvt_solutions(forward, backward);
+    EXPECT_NEAR(combined.sol.rr[0], 1.0, 1e-9);
+    EXPECT_NEAR(combined.sol.rr[1], 2.0, 1e-9);
+    EXPECT_NEAR(combined.sol.rr[2], 3.0, 1e-9);
+    EXPECT_NEAR(combined.sol.qr[0], 0.5, 1e-6);
+    EXPECT_NEAR(combined.sol.qr[3], 0.0, 1e-6);
+
+    // Otherwise, the best of both
+    backward.sol.stat = SOLQ_FIX;
+    EXPECT_DOUBLE_EQ(combine_pvt_solutions(forward, backward).sol.rr[2], 6.0);
+    backward.valid = false;
+    EXPECT_DOUBLE_EQ(combine_pvt_solutions(forward, backward).sol.rr[2], 0.0);
+}
+
+
+TEST(PvtBatchSolverTest, SingleModeSolvesAllTheEpochs)
+{
+    Pvt_Recorded_Observables recording;
+    prcopt_t options{};
+    options.mode = PMODE_SINGLE;
+    options.nf = 1;
+    const Pvt_Batch_Solver solver(options, false, 4);
+    EXPECT_TRUE(solver.solve(recording).empty());
+
+    // Without ephemerides no epoch can be solved, but all of them are tried
+    recording.epochs.resize(10);
+    for (std::size_t i = 0; i < recording.epochs.size(); i++)
+        {
+            recording.epochs[i][0] = Gnss_Synchro();
+            recording.epochs[i][0].System = 'G';
+            std::memcpy(recording.epochs[i][0].Signal, "1C", 3);
+            recording.epochs[i][0].PRN = 1;
+            recording.epochs[i][0].RX_time = 100.0 + static_cast<double>(i);
+        }
+    const std::vector<Pvt_Batch_Solution> solutions = solver.solve(recording);
+    ASSERT_EQ(solutions.size(), 10U);
+    for (std::size_t i = 0; i < solutions.size(); i++)
+        {
+            EXPECT_FALSE(solutions[i].valid);
+            EXPECT_DOUBLE_EQ(solutions[i].rx_time, 100.0 + static_cast<double>(i));
+        }
+}
+
+
+// Replays real observables, with a cold start in the middle of the recording,
+// and checks the batch solutions against those of a sequential solver
+class PvtBatchSolverReplayTest : public ::testing::Test
+{
+protected:
+    static constexpr std::size_t NUM_EPOCHS = 20;
+    static constexpr std::size_t COLD_START = 8;  // no ephemerides in this epoch and the next one
+    static constexpr std::size_t EPHEMERIDES_BACK = 10;
+
+    static prcopt_t replay_options(int mode)
+    {
+        prcopt_t options{};
+        options.mode = mode;
+        options.nf = 1;
+        options.navsys = SYS_GPS;
+        options.ionoopt = IONOOPT_OFF;
+        options.tropopt = TROPOPT_OFF;
+        options.elmin = 0.0;
+        options.eratio[0] = 100.0;
+        options.err[0] = 100.0;
+        options.err[1] = 0.03;
+        options.err[2] = 0.03;
+        options.prn[0] = 1e-4;
+        options.prn[1] = 1e-3;
+        options.prn[2] = 1e-4;
+        options.maxgdop = 30.0;
+        options.maxinno = 30.0;
+        options.niter = 1;
+        options.thresslip = 0.05;
+        return options;
+    }
+
+    static bool has_ephemerides(std::size_t epoch)
+    {
+        return epoch < COLD_START || epoch >= EPHEMERIDES_BACK;
+    }
+
+    void SetUp() override
+    {
+        const std::string filename("./pvt_observables_replay_test.dat");
+        {
+            Pvt_Observables_Log_Writer log(filename);
+            ASSERT_TRUE(log.is_open());
+            for (std::size_t epoch = 0; epoch < NUM_EPOCHS; epoch++)
+                {
+                    if (epoch == COLD_START)
+                        {
+                            log.write_clear_ephemeris();
+                        }
+                    if (epoch == 0 || epoch == EPHEMERIDES_BACK)
+                        {
+                            for (const auto& eph : rtklib_test_gps_ephemerides())
+                                {
+                                    log.write(eph.second);
+                                }
+                        }
+                    log.write(rtklib_test_observables(static_cast<int>(epoch)));
+                }
+        }
+        ASSERT_TRUE(d_recording.read(filename));
+        std::remove(filename.c_str());
+        ASSERT_EQ(d_recording.epochs.size(), NUM_EPOCHS);
+    }
+
+    // Solves the epochs one by one, in the given order, with the ephemerides
+    // the receiver had at each of them
+    static std::vector<Pvt_Batch_Solution> solve_sequentially(const prcopt_t& options, bool backward)
+    {
+        std::vector<Pvt_Batch_Solution> solutions(NUM_EPOCHS);
+        rtk_t rtk{};
+        rtkinit(&rtk, &options);
+        {
+            Rtklib_Solver solver(rtk, "", false, false);
+            solver.set_averaging_depth(1);
+            bool stored = false;
+            for (std::size_t i = 0; i < NUM_EPOCHS; i++)
+                {
+                    const std::size_t epoch = backward ? NUM_EPOCHS - 1 - i : i;
+                    if (has_ephemerides(epoch) && !stored)
+                        {
+                            for (const auto& eph : rtklib_test_gps_ephemerides())
+                                {
+                                    solver.store_ephemeris(eph.second);
+                                }
+                        }
+                    else if (!has_ephemerides(epoch) && stored)
+                        {
+                            solver.gps_ephemeris_map.clear();
+                        }
+                    stored = has_ephemerides(epoch);
+                    solutions[epoch].rx_time = rtklib_test_observables(static_cast<int>(epoch)).cbegin()->second.RX_time;
+                    solutions[epoch].valid = solver.get_PVT(rtklib_test_observables(static_cast<int>(epoch)), false);
+                    if (solutions[epoch].valid)
+                        {
+                            solutions[epoch].sol = solver.pvt_sol;
+                        }
+                }
+        }
+        rtkfree(&rtk);
+        return solutions;
+    }
+
+    Pvt_Recorded_Observables d_recording;
+};
+
+
+constexpr std::size_t PvtBatchSolverReplayTest::NUM_EPOCHS;
+constexpr std::size_t PvtBatchSolverReplayTest::COLD_START;
+constexpr std::size_t PvtBatchSolverReplayTest::EPHEMERIDES_BACK;
+
+
+TEST_F(PvtBatchSolverReplayTest, SingleModeMatchesSequentialSolver)
+{
+    const prcopt_t options = replay_options(PMODE_SINGLE);
+    const std::vector<Pvt_Batch_Solution> expected = solve_sequentially(options, false);
+    const std::vector<Pvt_Batch_Solution> solutions = Pvt_Batch_Solver(options, false, 4).solve(d_recording);
+    ASSERT_EQ(solutions.size(), NUM_EPOCHS);
+    for (std::size_t epoch = 0; epoch < NUM_EPOCHS; epoch++)
+        {
+            ASSERT_EQ(solutions[epoch].valid, expected[epoch].valid) << "epoch " << epoch;
+            EXPECT_EQ(solutions[epoch].valid, has_ephemerides(epoch)) << "epoch " << epoch;
+            EXPECT_DOUBLE_EQ(solutions[epoch].rx_time, expected[epoch].rx_time);
+            if (solutions[epoch].valid)
+                {
+                    EXPECT_EQ(solutions[epoch].sol.ns, expected[epoch].sol.ns);
+                    EXPECT_EQ(solutions[epoch].sol.time.time, expected[epoch].sol.time.time);
+                    // The first epoch of each block starts from no position, so
+                    // the iterations can end at a slightly different point
+                    for (int i = 0; i < 6; i++)
+                        {
+                            EXPECT_NEAR(solutions[epoch].sol.rr[i], expected[epoch].sol.rr[i], 1e-6) << "epoch " << epoch;
+                        }
+                    EXPECT_NEAR(solutions[epoch].sol.dtr[0], expected[epoch].sol.dtr[0], 1e-15) << "epoch " << epoch;
+                }
+        }
+}
+
+
+TEST_F(PvtBatchSolverReplayTest, KinematicSmoothingCombinesBothPasses)
+{
+    const prcopt_t options = replay_options(PMODE_PPP_KINEMA);
+    const std::vector<Pvt_Batch_Solution> forward = solve_sequentially(options, false);
+    const std::vector<Pvt_Batch_Solution> backward = solve_sequentially(options, true);
+    const std::vector<Pvt_Batch_Solution> solutions = Pvt_Batch_Solver(options, false, 2, true).solve(d_recording);
+    ASSERT_EQ(solutions.size(), NUM_EPOCHS);
+    std::size_t smoothed = 0;
+    for (std::size_t epoch = 0; epoch < NUM_EPOCHS; epoch++)
+        {
+            const Pvt_Batch_Solution expected = combine_pvt_solutions(forward[epoch], backward[epoch]);
+            ASSERT_EQ(solutions[epoch].valid, expected.valid) << "epoch " << epoch;
+            EXPECT_EQ(solutions[epoch].valid, has_ephemerides(epoch)) << "epoch " << epoch;
+            if (!expected.valid)
+                {
+                    continue;
+                }
+            EXPECT_EQ(solutions[epoch].sol.stat, expected.sol.stat) << "epoch " << epoch;
+            for (int i = 0; i < 3; i++)
+                {
+                    EXPECT_EQ(solutions[epoch].sol.rr[i], expected.sol.rr[i]) << "epoch " << epoch;
+                }
+            for (int i = 0; i < 6; i++)
+                {
+                    EXPECT_EQ(solutions[epoch].sol.qr[i], expected.sol.qr[i]) << "epoch " << epoch;
+                }
+            if (expected.sol.stat == SOLQ_PPP && expected.sol.rr[0] != forward[epoch].sol.rr[0])
+                {
+                    smoothed++;
+                }
+        }
+    EXPECT_GT(smoothed, 0U);
+}
@@ -0,0 +1,115 @@
+/*!
+ * \file pvt_ephemeris_store_test.cc
+ * \brief Implements Unit Tests for the Pvt_Ephemeris_Store class.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beidou_dnav_ephemeris.h"
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "gnss_synchro.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "pvt_ephemeris_store.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+
+namespace
+{
+Gnss_Synchro pvt_store_observable(uint32_t prn, const char* signal)
+{
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.PRN = prn;
+    std::strncpy(gnss_synchro.Signal, signal, 3);
+    return gnss_synchro;
+}
+}  // namespace
+
+
+TEST(PvtEphemerisStoreTest, GpsAndGalileo)
+{
+    Pvt_Ephemeris_Store store;
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "1C")));
+
+    Gps_Ephemeris gps_eph;
+    gps_eph.PRN = 5;
+    store.update(gps_eph);
+    EXPECT_TRUE(store.has(Pvt_Ephemeris_Store::GPS_LNAV, 5));
+    EXPECT_FALSE(store.has(Pvt_Ephemeris_Store::GALILEO_NAV, 5));
+    EXPECT_TRUE(store.usable(pvt_store_observable(5, "1C")));
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "2S")));  // no CNAV ephemeris
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "1B")));
+    EXPECT_FALSE(store.usable(pvt_store_observable(6, "1C")));
+
+    gps_eph.SV_health = 1;
+    store.update(gps_eph);
+    EXPECT_TRUE(store.has(Pvt_Ephemeris_Store::GPS_LNAV, 5));
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "1C")));
+
+    Galileo_Ephemeris gal_eph;
+    gal_eph.PRN = 5;
+    gal_eph.E5a_HS = 3;
+    store.update(gal_eph);
+    EXPECT_TRUE(store.usable(pvt_store_observable(5, "1B")));
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "5X")));
+    EXPECT_TRUE(store.usable(pvt_store_observable(5, "7X")));
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "E6")));
+
+    gal_eph.E1B_DVS = true;
+    store.update(gal_eph);
+    EXPECT_FALSE(store.usable(pvt_store_observable(5, "1B")));
+
+    store.clear(Pvt_Ephemeris_Store::GPS_LNAV);
+    EXPECT_FALSE(store.has(Pvt_Ephemeris_Store::GPS_LNAV, 5));
+    EXPECT_TRUE(store.has(Pvt_Ephemeris_Store::GALILEO_NAV, 5));
+    EXPECT_TRUE(store.usable(pvt_store_observable(5, "7X")));
+}
+
+
+TEST(PvtEphemerisStoreTest, OtherSystems)
+{
+    Pvt_Ephemeris_Store store;
+
+    Gps_CNAV_Ephemeris cnav_eph;
+    cnav_eph.PRN = 10;
+    store.update(cnav_eph);
+    EXPECT_TRUE(store.usable(pvt_store_observable(10, "2S")));
+    EXPECT_TRUE(store.usable(pvt_store_observable(10, "L5")));
+    EXPECT_FALSE(store.usable(pvt_store_observable(10, "1C")));
+
+    Glonass_Gnav_Ephemeris glo_eph;
+    glo_eph.PRN = 3;
+    store.update(glo_eph);
+    EXPECT_TRUE(store.usable(pvt_store_observable(3, "1G")));
+    EXPECT_TRUE(store.usable(pvt_store_observable(3, "2G")));
+
+    Beidou_Dnav_Ephemeris bds_eph;
+    bds_eph.PRN = 60;
+    bds_eph.SV_health = 1;
+    store.update(bds_eph);
+    EXPECT_TRUE(store.has(Pvt_Ephemeris_Store::BEIDOU_DNAV, 60));
+    EXPECT_FALSE(store.usable(pvt_store_observable(60, "B1")));
+    bds_eph.SV_health = 0;
+    store.update(bds_eph);
+    EXPECT_TRUE(store.usable(pvt_store_observable(60, "B1")));
+    EXPECT_TRUE(store.usable(pvt_store_observable(60, "B3")));
+    EXPECT_FALSE(store.usable(pvt_store_observable(60, "B2")));
+
+    // Out of range PRNs are ignored
+    bds_eph.PRN = Pvt_Ephemeris_Store::MAX_PRN;
+    store.update(bds_eph);
+    EXPECT_FALSE(store.has(Pvt_Ephemeris_Store::BEIDOU_DNAV, Pvt_Ephemeris_Store::MAX_PRN));
+    EXPECT_FALSE(store.usable(pvt_store_observable(Pvt_Ephemeris_Store::MAX_PRN, "B1")));
+}
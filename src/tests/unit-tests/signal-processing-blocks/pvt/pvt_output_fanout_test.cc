@@ -0,0 +1,128 @@
+/*!
+ * \file pvt_output_fanout_test.cc
+ * \brief Implements Unit Tests for the Pvt_Output_Fanout class.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "pvt_output_fanout.h"
+#include "rtklib.h"
+#include "rtklib_solver.h"
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+TEST(PvtOutputFanoutTest, SnapshotCopiesTheSolver)
+{
+    rtk_t rtk{};
+    Rtklib_Solver solver(rtk, "filename", false, false);
+    solver.set_rx_pos({4796983.0, 166418.0, 4187334.0});
+    solver.set_num_valid_observations(7);
+    solver.pvt_sol.ns = 7;
+    std::map<int, Gnss_Synchro> observables;
+    observables[3] = Gnss_Synchro();
+    observables[3].PRN = 11;
+
+    const Pvt_Output_Snapshot snapshot(solver, observables, 1000);
+    solver.set_rx_pos({0.0, 0.0, 0.0});
+    solver.set_num_valid_observations(0);
+    solver.pvt_sol.ns = 0;
+
+    EXPECT_DOUBLE_EQ(snapshot.get_rx_pos()[0], 4796983.0);
+    EXPECT_DOUBLE_EQ(snapshot.get_rx_pos()[2], 4187334.0);
+    EXPECT_EQ(snapshot.get_num_valid_observations(), 7);
+    EXPECT_EQ(snapshot.pvt_sol.ns, 7);
+    EXPECT_EQ(snapshot.observables.at(3).PRN, 11U);
+    EXPECT_EQ(snapshot.rx_time_ms, 1000U);
+}
+
+
+TEST(PvtOutputFanoutTest, BlockingSinkWritesAllInOrder)
+{
+    rtk_t rtk{};
+    Rtklib_Solver solver(rtk, "filename", false, false);
+    const std::map<int, Gnss_Synchro> observables;
+    std::vector<uint64_t> written;
+    {
+        Pvt_Output_Fanout fanout;
+        const int32_t sink = fanout.add_sink(
+            "file", [&written](const Pvt_Output_Snapshot& pvt) { written.push_back(pvt.rx_time_ms); },
+            Pvt_Output_Fanout::Backpressure::BLOCK, 2);
+        for (uint64_t t = 0; t < 100; t++)
+            {
+                fanout.publish(sink, std::make_shared<const Pvt_Output_Snapshot>(solver, observables, t));
+            }
+        fanout.stop();
+        const Pvt_Output_Fanout::Sink_Stats stats = fanout.stats(sink);
+        EXPECT_EQ(stats.published, 100U);
+        EXPECT_EQ(stats.written, 100U);
+        EXPECT_EQ(stats.dropped, 0U);
+    }
+    ASSERT_EQ(written.size(), 100U);
+    for (uint64_t t = 0; t < 100; t++)
+        {
+            EXPECT_EQ(written[t], t);
+        }
+}
+
+
+TEST(PvtOutputFanoutTest, DroppingSinkKeepsTheLatest)
+{
+    rtk_t rtk{};
+    Rtklib_Solver solver(rtk, "filename", false, false);
+    const std::map<int, Gnss_Synchro> observables;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    std::vector<uint64_t> written;
+
+    Pvt_Output_Fanout fanout;
+    const int32_t sink = fanout.add_sink(
+        "device", [&](const Pvt_Output_Snapshot& pvt) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&release] { return release; });  // a stuck device
+            written.push_back(pvt.rx_time_ms);
+        },
+        Pvt_Output_Fanout::Backpressure::DROP_OLDEST, 4);
+
+    // The publisher never waits, whatever the sink does
+    for (uint64_t t = 0; t < 20; t++)
+        {
+            fanout.publish(sink, std::make_shared<const Pvt_Output_Snapshot>(solver, observables, t));
+        }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    fanout.stop();
+
+    // The sink thread may have taken the first snapshot before the ring
+    // filled up, the rest are the 4 latest ones
+    const Pvt_Output_Fanout::Sink_Stats stats = fanout.stats(sink);
+    EXPECT_EQ(stats.published, 20U);
+    EXPECT_EQ(stats.written + stats.dropped, 20U);
+    ASSERT_GE(written.size(), 4U);
+    ASSERT_LE(written.size(), 5U);
+    for (uint64_t i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(written[written.size() - 4 + i], 16 + i);
+        }
+    EXPECT_EQ(fanout.stats(sink + 1).published, 0U);  // invalid identifier
+}
@@ -15,10 +15,13 @@
  */
 
 #include "gnss_sdr_filesystem.h"
+#include "rinex_async_writer.h"
 #include "rinex_printer.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solver.h"
 #include <fstream>
+#include <iterator>
+#include <ostream>
 #include <string>
 
 
@@ -1010,3 +1013,68 @@ TEST_F(RinexPrinterTest, MixedObsLogGpsGlo)
     fs::remove(navfile);
     fs::remove(obsfile);
 }
+
+
+TEST(RinexAsyncWriterTest, AppendsInOrder)
+{
+    const std::string filename("rinex_async_writer_test.txt");
+    fs::remove(filename);  // left by an interrupted run, the writer would append to it
+    std::string expected;
+    {
+        // Small threshold and period, so the writer thread works while epochs are queued
+        Rinex_Async_Writer writer(filename, 5, 256);
+        ASSERT_TRUE(writer.is_open());
+        Rinex_Text_Buffer buffer;
+        std::ostream out(&buffer);
+        for (int i = 0; i < 2000; i++)
+            {
+                out << "> epoch " << i << '\n';
+                writer.write(buffer.str());
+                expected += buffer.str();
+                buffer.clear();
+                if (i == 1000)
+                    {
+                        writer.flush();
+                        EXPECT_EQ(expected.size(), writer.bytes_written());
+                    }
+            }
+    }  // the destructor writes the rest
+
+    std::ifstream file(filename, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(expected, contents);
+    file.close();
+    fs::remove(filename);
+}
+
+
+TEST(RinexAsyncWriterTest, RunsCommandsInOrder)
+{
+    const std::string filename("rinex_async_writer_commands_test.txt");
+    fs::remove(filename);
+    std::string seen_by_command;
+    {
+        Rinex_Async_Writer writer(filename);
+        ASSERT_TRUE(writer.is_open());
+        writer.write("first\n");
+        // Rewrites the file in place, as Rinex_Printer does with the header
+        writer.execute([&filename, &seen_by_command]() {
+            std::ifstream in(filename, std::ios::binary);
+            seen_by_command.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            in.close();
+            std::ofstream out(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+            out << "header\n"
+                << seen_by_command;
+        });
+        writer.write("second\n");
+        writer.flush();
+        EXPECT_EQ(std::string("first\n"), seen_by_command);
+        writer.write("third\n");
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(std::string("header\nfirst\nsecond\nthird\n"), contents);
+    file.close();
+    fs::remove(filename);
+}
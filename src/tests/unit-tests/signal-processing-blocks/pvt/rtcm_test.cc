@@ -157,6 +157,23 @@ TEST(RtcmTest, BinToBinaryData)
 }
 
 
+TEST(RtcmTest, BitWriter)
+{
+    Rtcm_Bit_Writer writer;
+    writer.append(std::bitset<12>(1005));
+    writer.append(0x5, 3);
+    writer.append(0xFFFFFFFFFFFFFFFFULL, 64);
+    writer.append(0, 2);
+    EXPECT_EQ(static_cast<size_t>(81), writer.size());
+    const std::vector<uint8_t> expected = {0x3E, 0xDB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00};
+    EXPECT_TRUE(expected == writer.bytes());
+
+    writer.clear();
+    EXPECT_EQ(static_cast<size_t>(0), writer.size());
+    EXPECT_TRUE(writer.bytes().empty());
+}
+
+
 TEST(RtcmTest, CheckCRC)
 {
     auto rtcm = std::make_shared<Rtcm>();
@@ -201,6 +218,7 @@ TEST(RtcmTest, MT1005)
     std::string reference_msg = rtcm->print_MT1005_test();
     std::string reference_msg2 = rtcm->print_MT1005(2003, 1114104.5999, -4850729.7108, 3975521.4643, true, false, false, false, false, 0);
     EXPECT_EQ(0, reference_msg.compare(reference_msg2));
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(reference_msg)).compare("D300133ED7D30202980EDEEF34B4BD62AC0941986F33360B98"));
 
     unsigned int ref_id;
     double ecef_x;
@@ -336,6 +354,112 @@ TEST(RtcmTest, MT1045)
 }
 
 
+TEST(RtcmTest, EphemerisReferenceMessages)
+{
+    // Reference messages generated by the former encoder, which composed
+    // the messages as strings of '0' and '1' characters
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.PRN = 1;
+    gps_eph.WN = 799;
+    gps_eph.SV_accuracy = 2;
+    gps_eph.code_on_L2 = 1;
+    gps_eph.idot = 4.150172871358495e-10;
+    gps_eph.IODE_SF2 = 92;
+    gps_eph.toc = 518400;
+    gps_eph.af1 = 3.41060513164848e-13;
+    gps_eph.af0 = -1.0993797332048416e-05;
+    gps_eph.IODC = 92;
+    gps_eph.Crs = 18.3125;
+    gps_eph.delta_n = 4.864131182016467e-09;
+    gps_eph.M_0 = 2.0646819893094372;
+    gps_eph.Cuc = 9.424984455108643e-07;
+    gps_eph.ecc = 0.0037308292230591174;
+    gps_eph.Cus = 5.764886736869812e-06;
+    gps_eph.sqrtA = 5153.66174697876;
+    gps_eph.toe = 518400;
+    gps_eph.Cic = -5.4016709327697754e-08;
+    gps_eph.OMEGA_0 = 0.9521672475992009;
+    gps_eph.Cis = 1.862645149230957e-08;
+    gps_eph.i_0 = 0.9613770264234561;
+    gps_eph.Crc = 266.96875;
+    gps_eph.omega = 0.44493533370829186;
+    gps_eph.OMEGAdot = -8.146410759278477e-09;
+    gps_eph.TGD = 5.122274160385132e-09;
+
+    Glonass_Gnav_Ephemeris gnav_ephemeris = Glonass_Gnav_Ephemeris();
+    gnav_ephemeris.i_satellite_slot_number = 5;
+    gnav_ephemeris.PRN = 5;
+    gnav_ephemeris.i_satellite_freq_channel = 1;
+    gnav_ephemeris.d_P_1 = 15;
+    gnav_ephemeris.d_t_k = 10770;
+    gnav_ephemeris.d_P_2 = true;
+    gnav_ephemeris.d_t_b = 10800;
+    gnav_ephemeris.d_Xn = 12365.3876953125;
+    gnav_ephemeris.d_Yn = -8712.6611328125;
+    gnav_ephemeris.d_Zn = 21398.70703125;
+    gnav_ephemeris.d_VXn = -0.490900039672852;
+    gnav_ephemeris.d_VYn = 2.86674499511719;
+    gnav_ephemeris.d_VZn = 1.43215847015381;
+    gnav_ephemeris.d_AXn = 9.31322574615479e-10;
+    gnav_ephemeris.d_AYn = -1.86264514923096e-09;
+    gnav_ephemeris.d_AZn = -2.79396772384644e-09;
+    gnav_ephemeris.d_P_3 = true;
+    gnav_ephemeris.d_gamma_n = 1.81898940354586e-12;
+    gnav_ephemeris.d_P = 3;
+    gnav_ephemeris.d_tau_n = -8.95173847675323e-05;
+    gnav_ephemeris.d_Delta_tau_n = -2.79396772384644e-09;
+    gnav_ephemeris.d_E_n = 3;
+    gnav_ephemeris.d_F_T = 2;
+    gnav_ephemeris.d_N_T = 1085;
+    gnav_ephemeris.d_M = 1;
+    Glonass_Gnav_Utc_Model gnav_utc_model = Glonass_Gnav_Utc_Model();
+    gnav_utc_model.d_N_A = 1085;
+    gnav_utc_model.d_tau_c = -1.86264514923096e-08;
+    gnav_utc_model.d_N_4 = 7;
+    gnav_utc_model.d_tau_gps = 4.65661287307739e-09;
+
+    Galileo_Ephemeris gal_eph = Galileo_Ephemeris();
+    gal_eph.PRN = 11;
+    gal_eph.WN = 1057;
+    gal_eph.IOD_nav = 97;
+    gal_eph.SISA = 107;
+    gal_eph.idot = -1.5357781353e-10;
+    gal_eph.toc = 518400;
+    gal_eph.af1 = -8.39950630e-13;
+    gal_eph.af0 = 6.10917178e-04;
+    gal_eph.Crs = -4.3125;
+    gal_eph.delta_n = 2.98726157e-09;
+    gal_eph.M_0 = -1.12471526;
+    gal_eph.Cuc = -2.15321779e-07;
+    gal_eph.ecc = 3.02514597e-04;
+    gal_eph.Cus = 1.06915831e-05;
+    gal_eph.sqrtA = 5440.61259;
+    gal_eph.toe = 518400;
+    gal_eph.Cic = 2.42143869e-08;
+    gal_eph.OMEGA_0 = -2.67226014;
+    gal_eph.Cis = -1.86264515e-08;
+    gal_eph.i_0 = 0.989532;
+    gal_eph.Crc = 137.0;
+    gal_eph.omega = 0.291838;
+    gal_eph.OMEGAdot = -5.37950117e-09;
+    gal_eph.BGD_E1E5a = -2.79396772e-09;
+    gal_eph.BGD_E1E5b = -3.02679837e-09;
+
+    auto rtcm = std::make_shared<Rtcm>();
+    std::string msg = rtcm->print_MT1019(gps_eph);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3003D3FB071F2448A5C7E90000003FE8F1C5C024A3533541F6A1101FA01E901DB0C17A10D4B427E90FFE326CB76F3000A272B86B0215F1220D808FFA6E70B00AA8B29"));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+
+    msg = rtcm->print_MT1020(gnav_ephemeris, gnav_utc_model);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3002D3FC15002EC8C87DABA304D63412DDE30A208A95216EA1F5396B513802D0BBBBCC6287AE1EFFFFFFEC1C0000000E45CE4"));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+
+    msg = rtcm->print_MT1045(gal_eph);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3003E4152D084616B000290003FFF8A028097D7FDD882B348B32D5FFE30009E9AD459B2A8139A5A1C0000D931F50D1FFF62851317211200BE3FB13FFC52AFD000BE5DB3"));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+}
+
+
 TEST(RtcmTest, MSMCell)
 {
     auto rtcm = std::make_shared<Rtcm>();
@@ -594,6 +718,159 @@ TEST(RtcmTest, MSM1)
 }
 
 
+TEST(RtcmTest, MSM4AndMSM7)
+{
+    // Reference messages generated by the former encoder, which composed
+    // the messages as strings of '0' and '1' characters
+    auto make_synchro = [](char system, const std::string& signal, uint32_t prn, double pseudorange, double phase, double doppler, double cn0) {
+        Gnss_Synchro gnss_synchro;
+        gnss_synchro.System = system;
+        std::memcpy(static_cast<void*>(gnss_synchro.Signal), signal.c_str(), 3);
+        gnss_synchro.PRN = prn;
+        gnss_synchro.Pseudorange_m = pseudorange;
+        gnss_synchro.Carrier_phase_rads = phase;
+        gnss_synchro.Carrier_Doppler_hz = doppler;
+        gnss_synchro.CN0_dB_hz = cn0;
+        return gnss_synchro;
+    };
+
+    std::map<int, Gnss_Synchro> gps_observables;
+    gps_observables.insert(std::pair<int, Gnss_Synchro>(0, make_synchro('G', "1C", 2, 20000000.0, 1.0e8, -1234.5, 45.0)));
+    gps_observables.insert(std::pair<int, Gnss_Synchro>(1, make_synchro('G', "1C", 4, 21001010.0, -2.0e8, 2345.25, 41.5)));
+    gps_observables.insert(std::pair<int, Gnss_Synchro>(2, make_synchro('G', "2S", 4, 21001012.5, -1.5e8, 1827.75, 38.0)));
+    gps_observables.insert(std::pair<int, Gnss_Synchro>(3, make_synchro('G', "1C", 32, 24002020.0, 3.0e8, 123.0, 35.25)));
+
+    std::map<int, Gnss_Synchro> gal_observables;
+    gal_observables.insert(std::pair<int, Gnss_Synchro>(0, make_synchro('E', "1B", 1, 23000000.0, 2.0e8, -2222.5, 44.0)));
+    gal_observables.insert(std::pair<int, Gnss_Synchro>(1, make_synchro('E', "5X", 1, 23000003.5, 1.5e8, -1659.75, 42.0)));
+    gal_observables.insert(std::pair<int, Gnss_Synchro>(2, make_synchro('E', "1B", 19, 25500000.25, -1.0e8, 3000.0, 39.5)));
+
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.PRN = 2;
+    Galileo_Ephemeris gal_eph = Galileo_Ephemeris();
+    gal_eph.PRN = 1;
+    unsigned short ref_id = 1234;
+    double obs_time = 25.0;
+
+    // A new object for each message, so lock times start from scratch
+    auto rtcm = std::make_shared<Rtcm>();
+    std::string msg = rtcm->print_MSM_4(gps_eph, {}, {}, {}, obs_time, gps_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D300354324D2000186A000002800000080000000200100005C848CA16D06A207B4F095414DB39380006E0000F7FFECA0001E800005B54D185948FB"));
+
+    rtcm.reset();  // release the server port
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_4({}, {}, gal_eph, {}, obs_time, gal_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3002D4464D2000186A000004000100000000000080000807262ADC21E0101038A41E7FFFFF000113FFFE70001655400AB7917"));
+
+    rtcm.reset();  // release the server port
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_7(gps_eph, {}, {}, {}, obs_time, gps_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3004C4354D2000186A000002800000080000000200100005C848CA00016D06A2001D7F217FD3ED3C012A8A14D859C9B20001B60000F3FFFB280001E4000000000016853130469F31FA697220E04607BC76F"));
+
+    rtcm.reset();  // release the server port
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_7({}, {}, gal_eph, {}, obs_time, gal_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3003D4494D2000186A000004000100000000000080000807262A805C21E034FEE28101401C52107927FFFFE000088FFFFCD000000002C0A8278FA5BF85425309AB207"));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+}
+
+
+TEST(RtcmTest, GlonassMSM4AndMSM7)
+{
+    // Reference messages generated by the former encoder. The encoder
+    // identifies the GLONASS signals with their RINEX codes.
+    auto make_synchro = [](const std::string& signal, uint32_t prn, double pseudorange, double phase, double doppler, double cn0) {
+        Gnss_Synchro gnss_synchro;
+        gnss_synchro.System = 'R';
+        std::memcpy(static_cast<void*>(gnss_synchro.Signal), signal.c_str(), 3);
+        gnss_synchro.PRN = prn;
+        gnss_synchro.Pseudorange_m = pseudorange;
+        gnss_synchro.Carrier_phase_rads = phase;
+        gnss_synchro.Carrier_Doppler_hz = doppler;
+        gnss_synchro.CN0_dB_hz = cn0;
+        return gnss_synchro;
+    };
+
+    std::map<int, Gnss_Synchro> glo_observables;
+    glo_observables.insert(std::pair<int, Gnss_Synchro>(0, make_synchro("1C", 5, 19500000.0, 1.2e8, -1500.5, 46.0)));
+    glo_observables.insert(std::pair<int, Gnss_Synchro>(1, make_synchro("2C", 5, 19500002.5, 0.9e8, -1167.0, 40.5)));
+    glo_observables.insert(std::pair<int, Gnss_Synchro>(2, make_synchro("1C", 12, 22100100.75, -0.8e8, 2750.25, 37.75)));
+
+    Glonass_Gnav_Ephemeris glo_eph = Glonass_Gnav_Ephemeris();
+    glo_eph.i_satellite_slot_number = 5;
+    glo_eph.PRN = 5;
+    glo_eph.i_satellite_freq_channel = 1;
+    glo_eph.d_t_b = 10800;
+    glo_eph.d_N_T = 1085;
+    unsigned short ref_id = 1234;
+    double obs_time = 25.0;
+
+    // A new object for each message, so lock times start from scratch
+    auto rtcm = std::make_shared<Rtcm>();
+    std::string msg = rtcm->print_MSM_4({}, {}, {}, glo_eph, obs_time, glo_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3002D43C4D2000186A00000040800000000000020800000020A485D6F85070B263BB3FFF6C000183FFFAD000175330056DF2A"));
+
+    rtcm.reset();  // release the server port
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_7({}, {}, {}, glo_eph, obs_time, glo_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare("D3003D43F4D2000186A00000040800000000000020800000020A48005D6F823DEFA8506A059288EEBA7FFED88000BFFFFF5A800000002E0A225CE889DE5C2E107F45AC"));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+}
+
+
+TEST(RtcmTest, BeidouMSM4AndMSM7)
+{
+    // Reference messages checked by decoding them with RTKLIB. The B1I
+    // signal is identified as "2I" in the signal mask.
+    auto make_synchro = [](uint32_t prn, double pseudorange, double phase, double doppler, double cn0) {
+        Gnss_Synchro gnss_synchro;
+        gnss_synchro.System = 'C';
+        std::memcpy(static_cast<void*>(gnss_synchro.Signal), "B1", 3);
+        gnss_synchro.PRN = prn;
+        gnss_synchro.Pseudorange_m = pseudorange;
+        gnss_synchro.Carrier_phase_rads = phase;
+        gnss_synchro.Carrier_Doppler_hz = doppler;
+        gnss_synchro.CN0_dB_hz = cn0;
+        return gnss_synchro;
+    };
+
+    std::map<int, Gnss_Synchro> bds_observables;
+    bds_observables.insert(std::pair<int, Gnss_Synchro>(0, make_synchro(6, 38500000.25, 2.3e8, -1200.5, 42.0)));
+    bds_observables.insert(std::pair<int, Gnss_Synchro>(1, make_synchro(21, 22100100.75, -0.8e8, 2750.25, 37.75)));
+    bds_observables.insert(std::pair<int, Gnss_Synchro>(2, make_synchro(35, 23200050.5, 1.1e8, -300.0, 45.5)));
+    unsigned short ref_id = 1234;
+    double obs_time = 25.0;
+    const std::string msm4_reference("D3002F4644D2000186A00000020004001000000020000000780494D6C2DF6309E98EEC29EBFFFCB7FFFABFFFEA0000AA6B80F571B9");
+    const std::string msm7_reference("D300414674D2000186A00000020004001000000020000000780494D0006C2DF6300E7F7C003A27A5C1DD7429EA4FFFE59FFFF54FFFF51000000005412E5B1B8ABCF170D6791A1C");
+
+    // No ephemeris is needed, the message numbers (1124, 1127) follow from
+    // the system of the observables
+    auto rtcm = std::make_shared<Rtcm>();
+    std::string msg = rtcm->print_MSM_4({}, {}, {}, {}, obs_time, bds_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare(msm4_reference));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+
+    rtcm.reset();  // release the server port
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_7({}, {}, {}, {}, obs_time, bds_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare(msm7_reference));
+    EXPECT_TRUE(rtcm->check_CRC(msg));
+
+    // Observables whose PRN does not fit in the satellite mask are skipped
+    bds_observables.insert(std::pair<int, Gnss_Synchro>(3, make_synchro(0, 23200050.5, 1.1e8, -300.0, 45.5)));
+    bds_observables.insert(std::pair<int, Gnss_Synchro>(4, make_synchro(65, 23200050.5, 1.1e8, -300.0, 45.5)));
+    rtcm.reset();
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_4({}, {}, {}, {}, obs_time, bds_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare(msm4_reference));
+
+    rtcm.reset();
+    rtcm = std::make_shared<Rtcm>();
+    msg = rtcm->print_MSM_7({}, {}, {}, {}, obs_time, bds_observables, ref_id, 0, 0, 0, false, false);
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(msg)).compare(msm7_reference));
+}
+
+
 TEST(RtcmTest, InstantiateServer)
 {
     auto rtcm = std::make_shared<Rtcm>();
@@ -0,0 +1,194 @@
+/*!
+ * \file rtklib_solver_cache_test.cc
+ * \brief Checks that Rtklib_Solver converts again the ephemerides that
+ * change, whichever way they reach it.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "glonass_gnav_ephemeris.h"
+#include "gnss_synchro.h"
+#include "gps_ephemeris.h"
+#include "rtklib.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_solver.h"
+#include "rtklib_test_data.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <map>
+
+
+class RtklibSolverCacheTest : public ::testing::Test
+{
+protected:
+    static rtk_t single_mode()
+    {
+        rtk_t rtk{};
+        rtk.opt.mode = PMODE_SINGLE;
+        rtk.opt.nf = 1;
+        rtk.opt.navsys = SYS_GPS | SYS_GLO;
+        rtk.opt.ionoopt = IONOOPT_OFF;
+        rtk.opt.tropopt = TROPOPT_OFF;
+        rtk.opt.err[0] = 100.0;
+        rtk.opt.err[1] = 0.003;
+        rtk.opt.err[2] = 0.003;
+        rtk.opt.maxgdop = 30.0;
+        return rtk;
+    }
+
+    // Stores the GPS ephemerides of the scenario in both solvers, which
+    // must always produce the same solutions
+    void store_gps_ephemerides()
+    {
+        for (const auto& eph : rtklib_test_gps_ephemerides())
+            {
+                d_solver.store_ephemeris(eph.second);
+                d_reference.store_ephemeris(eph.second);
+            }
+    }
+
+    // Adds a GLONASS satellite at the position of GPS PRN 17, with an
+    // ephemeris valid at the time of the observables
+    void add_glonass_satellite(std::map<int, Gnss_Synchro>& observables)
+    {
+        Glonass_Gnav_Ephemeris glo_eph;
+        glo_eph.i_satellite_slot_number = 1;
+        glo_eph.PRN = 1;
+        glo_eph.i_satellite_freq_channel = 1;
+        glo_eph.d_yr = 2014;
+        glo_eph.d_N_T = 1085;   // 20 December 2014
+        glo_eph.d_t_b = 10800;  // 00:00 UTC
+        glo_eph.d_t_k = 10800;
+        glo_eph.d_WN = 1823;
+        const geph_t geph = eph_to_rtklib(glo_eph, d_solver.glonass_gnav_utc_model);
+
+        const eph_t gps_eph = eph_to_rtklib(rtklib_test_gps_ephemerides().at(17), true);
+        double pos[3];
+        double before[3];
+        double after[3];
+        double dts;
+        double var;
+        eph2pos(geph.toe, &gps_eph, pos, &dts, &var);
+        eph2pos(timeadd(geph.toe, -0.5), &gps_eph, before, &dts, &var);
+        eph2pos(timeadd(geph.toe, 0.5), &gps_eph, after, &dts, &var);
+        glo_eph.d_Xn = pos[0] / 1000.0;
+        glo_eph.d_Yn = pos[1] / 1000.0;
+        glo_eph.d_Zn = pos[2] / 1000.0;
+        glo_eph.d_VXn = (after[0] - before[0]) / 1000.0;
+        glo_eph.d_VYn = (after[1] - before[1]) / 1000.0;
+        glo_eph.d_VZn = (after[2] - before[2]) / 1000.0;
+
+        d_solver.store_ephemeris(glo_eph);
+        d_reference.store_ephemeris(glo_eph);
+
+        // Any pseudorange will do, its bias is absorbed by the inter-system
+        // bias of GLONASS
+        Gnss_Synchro obs = observables.at(6);
+        obs.System = 'R';
+        std::memcpy(obs.Signal, "1G", 3);
+        obs.PRN = 1;
+        obs.Channel_ID = 11;
+        observables[obs.Channel_ID] = obs;
+    }
+
+    void solve_and_compare(const std::map<int, Gnss_Synchro>& observables)
+    {
+        const bool valid = d_solver.get_PVT(observables, false);
+        ASSERT_EQ(d_reference.get_PVT(observables, false), valid);
+        ASSERT_TRUE(valid);
+        EXPECT_EQ(d_solver.pvt_sol.ns, d_reference.pvt_sol.ns);
+        EXPECT_EQ(d_solver.pvt_sol.time.time, d_reference.pvt_sol.time.time);
+        EXPECT_EQ(d_solver.pvt_sol.time.sec, d_reference.pvt_sol.time.sec);
+        for (int i = 0; i < 6; i++)
+            {
+                EXPECT_EQ(d_solver.pvt_sol.rr[i], d_reference.pvt_sol.rr[i]) << "rr[" << i << "]";
+                EXPECT_EQ(d_solver.pvt_sol.dtr[i], d_reference.pvt_sol.dtr[i]) << "dtr[" << i << "]";
+            }
+    }
+
+    const rtk_t d_rtk{single_mode()};
+    Rtklib_Solver d_solver{d_rtk, "", false, false};
+    Rtklib_Solver d_reference{d_rtk, "", false, false};  // always told of the changes with store_ephemeris()
+};
+
+
+TEST_F(RtklibSolverCacheTest, EphemerisWrittenToTheMap)
+{
+    store_gps_ephemerides();
+    const auto observables = rtklib_test_observables();
+    solve_and_compare(observables);
+    const sol_t first = d_solver.pvt_sol;
+
+    // A new ephemeris of PRN 17, with a different issue of data and clock
+    Gps_Ephemeris eph = d_solver.gps_ephemeris_map.at(17);
+    eph.IODE_SF2 = 27;
+    eph.IODE_SF3 = 27;
+    eph.IODC = 27;
+    eph.af0 += 1e-8;
+    d_solver.gps_ephemeris_map[17] = eph;
+    d_reference.store_ephemeris(eph);
+    solve_and_compare(observables);
+    EXPECT_NE(d_solver.pvt_sol.rr[0], first.rr[0]);
+}
+
+
+TEST_F(RtklibSolverCacheTest, Pre2009FileToggled)
+{
+    store_gps_ephemerides();
+    const auto observables = rtklib_test_observables();
+    solve_and_compare(observables);
+    const sol_t first = d_solver.pvt_sol;
+
+    // The week of the ephemerides changes, the maps do not
+    d_solver.set_pre_2009_file(true);
+    d_reference.set_pre_2009_file(true);
+    for (const auto& eph : rtklib_test_gps_ephemerides())
+        {
+            d_reference.store_ephemeris(eph.second);
+        }
+    solve_and_compare(observables);
+    int week = 0;
+    time2gpst(d_solver.pvt_sol.time, &week);
+    EXPECT_EQ(week, 1823);
+
+    d_solver.set_pre_2009_file(false);
+    d_reference.set_pre_2009_file(false);
+    for (const auto& eph : rtklib_test_gps_ephemerides())
+        {
+            d_reference.store_ephemeris(eph.second);
+        }
+    solve_and_compare(observables);
+    EXPECT_EQ(d_solver.pvt_sol.time.time, first.time.time);
+}
+
+
+TEST_F(RtklibSolverCacheTest, GlonassTimeCorrectionChanged)
+{
+    d_solver.set_pre_2009_file(true);
+    d_reference.set_pre_2009_file(true);
+    store_gps_ephemerides();
+    auto observables = rtklib_test_observables();
+    add_glonass_satellite(observables);
+    solve_and_compare(observables);
+    EXPECT_EQ(d_solver.pvt_sol.ns, 11);
+
+    // Moving the reference time of the GLONASS ephemeris one hour away makes
+    // it too old to be used
+    d_solver.glonass_gnav_utc_model.d_tau_c = 3600.0;
+    d_reference.glonass_gnav_utc_model.d_tau_c = 3600.0;
+    d_reference.store_ephemeris(d_reference.glonass_gnav_ephemeris_map.at(1));
+    solve_and_compare(observables);
+    EXPECT_EQ(d_solver.pvt_sol.ns, 10);
+}
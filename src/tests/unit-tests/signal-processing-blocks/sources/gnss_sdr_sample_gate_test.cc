@@ -0,0 +1,120 @@
+/*!
+ * \file gnss_sdr_sample_gate_test.cc
+ * \brief Checks the samples and tags delivered by the sample gate of idle
+ * channels.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_gate.h"
+#include <gnuradio/blocks/throttle.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <pmt/pmt.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// Sample n of the input has the value n
+std::vector<float> make_ramp(int num_samples)
+{
+    std::vector<float> ramp(num_samples);
+    for (int n = 0; n < num_samples; n++)
+        {
+            ramp[n] = static_cast<float>(n);
+        }
+    return ramp;
+}
+}  // namespace
+
+
+TEST(SampleGateTest, OpenGateForwardsAllSamples)
+{
+    const auto input = make_ramp(100000);
+    auto top_block = gr::make_top_block("sample_gate_test");
+    auto source = gr::blocks::vector_source_f::make(input);
+    auto gate = gnss_sdr_make_sample_gate(sizeof(float));
+    auto sink = gr::blocks::vector_sink_f::make();
+    top_block->connect(source, 0, gate, 0);
+    top_block->connect(gate, 0, sink, 0);
+    top_block->run();
+
+    EXPECT_EQ(sink->data(), input);
+    EXPECT_EQ(gate->nitems_read(0), input.size());
+    EXPECT_TRUE(sink->tags().empty());
+}
+
+
+TEST(SampleGateTest, ClosedGateConsumesWithoutProducing)
+{
+    const auto input = make_ramp(100000);
+    auto top_block = gr::make_top_block("sample_gate_test");
+    auto source = gr::blocks::vector_source_f::make(input);
+    auto gate = gnss_sdr_make_sample_gate(sizeof(float));
+    auto sink = gr::blocks::vector_sink_f::make();
+    gate->set_open(false);
+    top_block->connect(source, 0, gate, 0);
+    top_block->connect(gate, 0, sink, 0);
+    top_block->run();
+
+    EXPECT_TRUE(sink->data().empty());
+    EXPECT_EQ(gate->nitems_read(0), input.size());
+}
+
+
+TEST(SampleGateTest, ReopenedGateTagsTheDroppedSamples)
+{
+    // 0.6 s of samples, throttled so the gate can be closed mid-stream
+    const int num_samples = 600000;
+    const auto input = make_ramp(num_samples);
+    auto top_block = gr::make_top_block("sample_gate_test");
+    auto source = gr::blocks::vector_source_f::make(input);
+    auto throttle = gr::blocks::throttle::make(sizeof(float), 1e6);
+    auto gate = gnss_sdr_make_sample_gate(sizeof(float));
+    auto sink = gr::blocks::vector_sink_f::make();
+    top_block->connect(source, 0, throttle, 0);
+    top_block->connect(throttle, 0, gate, 0);
+    top_block->connect(gate, 0, sink, 0);
+
+    top_block->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    gate->set_open(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    gate->set_open(true);
+    top_block->wait();
+
+    const std::vector<float> output = sink->data();
+    const std::vector<gr::tag_t> tags = sink->tags();
+    EXPECT_EQ(gate->nitems_read(0), static_cast<uint64_t>(num_samples));
+    ASSERT_GT(output.size(), 0U);
+    ASSERT_LT(output.size(), static_cast<size_t>(num_samples));
+    EXPECT_EQ(output.back(), static_cast<float>(num_samples - 1));
+
+    // Each output sample is the input sample at its index plus the number of
+    // samples dropped so far, as announced by the last sample_offset tag
+    ASSERT_EQ(tags.size(), 1U);
+    EXPECT_TRUE(pmt::eq(tags[0].key, pmt::mp("sample_offset")));
+    const uint64_t tag_offset = tags[0].offset;
+    const uint64_t dropped = pmt::to_uint64(tags[0].value);
+    EXPECT_EQ(dropped, num_samples - output.size());
+    for (size_t n = 0; n < output.size(); n++)
+        {
+            const uint64_t expected = (n < tag_offset) ? n : n + dropped;
+            ASSERT_EQ(output[n], static_cast<float>(expected)) << "output " << n;
+        }
+}
@@ -0,0 +1,136 @@
+/*!
+ * \file mmap_file_source_test.cc
+ * \brief Checks that mmap_file_source delivers the same samples as the
+ * gr::blocks::file_source path of FileSourceBase.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+class MmapFileSourceTest : public ::testing::Test
+{
+protected:
+    MmapFileSourceTest() : d_filename("./mmap_file_source_test.dat")
+    {
+        // Not a whole number of pages, so the last buffer is a short one
+        std::default_random_engine generator(7);
+        std::uniform_int_distribution<int16_t> sample(-2048, 2047);
+        std::ofstream file(d_filename, std::ios::binary | std::ios::trunc);
+        for (int n = 0; n < 300001; n++)
+            {
+                const int16_t value = sample(generator);
+                file.write(reinterpret_cast<const char*>(&value), sizeof(int16_t));
+            }
+    }
+
+    ~MmapFileSourceTest() override
+    {
+        std::remove(d_filename.c_str());
+    }
+
+    // Samples delivered by source, up to max_items if it is not zero
+    static std::vector<int16_t> run(const gr::basic_block_sptr& source, uint64_t max_items)
+    {
+        auto top_block = gr::make_top_block("mmap_file_source_test");
+        auto sink = gr::blocks::vector_sink_s::make();
+        if (max_items > 0)
+            {
+                auto head = gr::blocks::head::make(sizeof(int16_t), max_items);
+                top_block->connect(source, 0, head, 0);
+                top_block->connect(head, 0, sink, 0);
+            }
+        else
+            {
+                top_block->connect(source, 0, sink, 0);
+            }
+        top_block->run();
+        return sink->data();
+    }
+
+    // Baseline path of FileSourceBase: a file_source moved with seek()
+    std::vector<int16_t> run_file_source(uint64_t offset_items, bool repeat, uint64_t max_items) const
+    {
+        auto source = gr::blocks::file_source::make(sizeof(int16_t), d_filename.c_str(), repeat);
+        if (offset_items > 0)
+            {
+                EXPECT_TRUE(source->seek(offset_items, SEEK_SET));
+            }
+        return run(source, max_items);
+    }
+
+    std::vector<int16_t> run_mmap_file_source(uint64_t offset_items, bool repeat, uint64_t max_items) const
+    {
+        return run(make_mmap_file_source(sizeof(int16_t), d_filename, offset_items, repeat), max_items);
+    }
+
+    std::string d_filename;
+};
+
+
+TEST_F(MmapFileSourceTest, SameSamplesAsFileSource)
+{
+    const auto expected = run_file_source(0, false, 0);
+    const auto actual = run_mmap_file_source(0, false, 0);
+    ASSERT_EQ(expected.size(), 300001U);
+    EXPECT_EQ(expected, actual);
+}
+
+
+TEST_F(MmapFileSourceTest, SameSamplesAfterSkipping)
+{
+    const auto expected = run_file_source(12345, false, 0);
+    const auto actual = run_mmap_file_source(12345, false, 0);
+    ASSERT_EQ(expected.size(), 300001U - 12345U);
+    EXPECT_EQ(expected, actual);
+}
+
+
+TEST_F(MmapFileSourceTest, SameSamplesWhenRepeating)
+{
+    const auto expected = run_file_source(0, true, 1000000);
+    const auto actual = run_mmap_file_source(0, true, 1000000);
+    ASSERT_EQ(expected.size(), 1000000U);
+    EXPECT_EQ(expected, actual);
+}
+
+
+TEST_F(MmapFileSourceTest, RepeatGoesBackToTheOffset)
+{
+    const auto once = run_mmap_file_source(100, false, 0);
+    const auto actual = run_mmap_file_source(100, true, 2 * once.size() + 10);
+    ASSERT_EQ(actual.size(), 2 * once.size() + 10);
+    for (size_t n = 0; n < actual.size(); n++)
+        {
+            ASSERT_EQ(actual[n], once[n % once.size()]) << "sample " << n;
+        }
+}
+
+
+TEST_F(MmapFileSourceTest, ThrowsIfFileIsMissing)
+{
+    EXPECT_THROW(make_mmap_file_source(sizeof(int16_t), "./mmap_file_source_test_missing.dat", 0, false), std::runtime_error);
+}
@@ -26,6 +26,7 @@
 #include <chrono>
 #include <exception>
 #include <iterator>  // for std::back_inserter
+#include <stdexcept>
 #include <string>
 #include <unistd.h>
 
@@ -239,3 +240,12 @@ TEST_F(Galileo_FNAV_INAV_test, ValidationOfResults)
     elapsed_seconds = end - start;
     std::cout << "Galileo INAV/FNAV CRC and Viterbi decoder test completed in " << elapsed_seconds.count() * 1e6 << " microseconds\n";
 }
+
+
+TEST_F(Galileo_FNAV_INAV_test, RejectsOtherCodes)
+{
+    // The decoder only implements the K=7, rate 1/2 trellis
+    EXPECT_THROW(Viterbi_Decoder(9, nn, 100, g_encoder), std::invalid_argument);
+    EXPECT_THROW(Viterbi_Decoder(KK, 3, 100, g_encoder), std::invalid_argument);
+    EXPECT_NO_THROW(Viterbi_Decoder(KK, nn, 100, g_encoder));
+}
@@ -0,0 +1,264 @@
+/*!
+ * \file viterbi_decoder_sbas_test.cc
+ * \brief Checks the Viterbi decoder of the SBAS navigation message with
+ * encoded SBAS frames.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_decoder_sbas.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+class ViterbiDecoderSbasTest : public ::testing::Test
+{
+protected:
+    static constexpr int KK = 7;
+    static constexpr int NN = 2;
+    static constexpr int FRAME_BITS = 250;
+    static constexpr int TRACEBACK_DEPTH = 5 * KK;  // as in sbas_l1_telemetry_decoder_gs
+
+    /*
+     * 250-bit SBAS message: one of the three rotating preambles, a 6-bit
+     * message type, 212 random data bits and the CRC-24Q parity.
+     */
+    std::vector<int> frame(int index)
+    {
+        const std::array<int, 3> preambles{0x53, 0x9A, 0xC6};
+        std::vector<int> bits;
+        for (int b = 7; b >= 0; b--)
+            {
+                bits.push_back((preambles[index % 3] >> b) & 1);
+            }
+        for (int b = 5; b >= 0; b--)
+            {
+                bits.push_back((index >> b) & 1);
+            }
+        while (bits.size() < FRAME_BITS - 24)
+            {
+                bits.push_back(static_cast<int>(d_generator() & 1U));
+            }
+        const uint32_t parity = crc24q(bits);
+        for (int b = 23; b >= 0; b--)
+            {
+                bits.push_back(static_cast<int>((parity >> b) & 1U));
+            }
+        return bits;
+    }
+
+    static uint32_t crc24q(const std::vector<int>& bits)
+    {
+        uint32_t crc = 0;
+        for (const int bit : bits)
+            {
+                crc ^= static_cast<uint32_t>(bit) << 23U;
+                crc = (crc & 0x800000U) ? ((crc << 1U) ^ 0x1864CFBU) : (crc << 1U);
+                crc &= 0xFFFFFFU;
+            }
+        return crc;
+    }
+
+    /*
+     * Rate 1/2 convolutional encoder with the SBAS polynomials, BPSK symbols
+     * of unit amplitude. The state is kept across calls, as in a continuous
+     * stream.
+     */
+    std::vector<double> encode(const std::vector<int>& bits)
+    {
+        std::vector<double> symbols;
+        for (const int bit : bits)
+            {
+                const int shift_register = (bit << (KK - 1)) ^ d_encoder_state;
+                d_encoder_state = shift_register >> 1;
+                for (const int polynomial : G_ENCODER)
+                    {
+                        int parity = 0;
+                        for (int word = shift_register & polynomial; word != 0; word >>= 1)
+                            {
+                                parity ^= word & 1;
+                            }
+                        symbols.push_back(parity ? 1.0 : -1.0);
+                    }
+            }
+        return symbols;
+    }
+
+    /*
+     * Decodes the symbols in consecutive calls of the given numbers of bits,
+     * and returns all the bits decoded so far.
+     */
+    static std::vector<int> decode_in_chunks(Viterbi_Decoder_Sbas& decoder, const std::vector<double>& symbols, const std::vector<int>& chunk_bits)
+    {
+        std::vector<int> decoded;
+        size_t position = 0;
+        size_t chunk = 0;
+        while (position < symbols.size())
+            {
+                const int nbits_requested = std::min(chunk_bits[chunk++ % chunk_bits.size()], static_cast<int>((symbols.size() - position) / NN));
+                std::vector<int> bits(nbits_requested);
+                int nbits_decoded = 0;
+                decoder.decode_continuous(&symbols[position], TRACEBACK_DEPTH, bits.data(), nbits_requested, nbits_decoded);
+                decoded.insert(decoded.end(), bits.begin(), bits.begin() + std::max(nbits_decoded, 0));
+                position += static_cast<size_t>(nbits_requested) * NN;
+            }
+        return decoded;
+    }
+
+    static const std::array<int, NN> G_ENCODER;
+    std::mt19937 d_generator{2026};
+    int d_encoder_state{0};
+};
+
+
+constexpr int ViterbiDecoderSbasTest::KK;
+constexpr int ViterbiDecoderSbasTest::NN;
+constexpr int ViterbiDecoderSbasTest::FRAME_BITS;
+constexpr int ViterbiDecoderSbasTest::TRACEBACK_DEPTH;
+const std::array<int, ViterbiDecoderSbasTest::NN> ViterbiDecoderSbasTest::G_ENCODER{121, 91};
+
+
+TEST_F(ViterbiDecoderSbasTest, OnlyAcceptsTheSbasCode)
+{
+    EXPECT_THROW(Viterbi_Decoder_Sbas(G_ENCODER.data(), 9, NN), std::invalid_argument);
+    EXPECT_THROW(Viterbi_Decoder_Sbas(G_ENCODER.data(), KK, 3), std::invalid_argument);
+}
+
+
+TEST_F(ViterbiDecoderSbasTest, DecodesTerminatedFrame)
+{
+    Viterbi_Decoder_Sbas decoder(G_ENCODER.data(), KK, NN);
+    for (int index = 0; index < 3; index++)
+        {
+            // Each frame is followed by KK - 1 zero tail bits, back to the
+            // all-zeros state in which the decoder starts after a reset
+            const std::vector<int> message = frame(index);
+            std::vector<int> tailed(message);
+            tailed.insert(tailed.end(), KK - 1, 0);
+            const std::vector<double> symbols = encode(tailed);
+            std::vector<int> decoded(FRAME_BITS, -1);
+            const float metric = decoder.decode_block(symbols.data(), decoded.data(), FRAME_BITS);
+            EXPECT_EQ(decoded, message) << "frame " << index;
+            EXPECT_EQ(crc24q(decoded), 0U);
+            // Noiseless symbols agree with both symbols of every branch
+            EXPECT_FLOAT_EQ(metric, 2.0);
+        }
+}
+
+
+TEST_F(ViterbiDecoderSbasTest, DecodesStreamAcrossFrameBoundaries)
+{
+    std::vector<int> sent;
+    for (int index = 0; index < 8; index++)
+        {
+            const std::vector<int> message = frame(index);
+            sent.insert(sent.end(), message.begin(), message.end());
+        }
+    const std::vector<double> symbols = encode(sent);
+
+    // Whatever the size of the calls, the traceback holds back the newest
+    // TRACEBACK_DEPTH bits and outputs the rest in order
+    for (const auto& chunk_bits : std::vector<std::vector<int>>{{FRAME_BITS}, {1}, {37, 250, 3, 125, 249, 251}, {static_cast<int>(sent.size())}})
+        {
+            Viterbi_Decoder_Sbas decoder(G_ENCODER.data(), KK, NN);
+            const std::vector<int> decoded = decode_in_chunks(decoder, symbols, chunk_bits);
+            ASSERT_EQ(decoded.size(), sent.size() - TRACEBACK_DEPTH) << "first call of " << chunk_bits[0] << " bits";
+            EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), sent.begin())) << "first call of " << chunk_bits[0] << " bits";
+            for (size_t start = 0; start + FRAME_BITS <= decoded.size(); start += FRAME_BITS)
+                {
+                    EXPECT_EQ(crc24q(std::vector<int>(decoded.begin() + start, decoded.begin() + start + FRAME_BITS)), 0U);
+                }
+        }
+
+    // The first calls have not filled the traceback yet, the number of
+    // decoded bits is negative until it is
+    Viterbi_Decoder_Sbas decoder(G_ENCODER.data(), KK, NN);
+    std::vector<int> bits(10);
+    int nbits_decoded = 0;
+    decoder.decode_continuous(symbols.data(), TRACEBACK_DEPTH, bits.data(), 10, nbits_decoded);
+    EXPECT_EQ(nbits_decoded, 10 - TRACEBACK_DEPTH);
+    std::vector<int> more_bits(40);
+    decoder.decode_continuous(&symbols[20], TRACEBACK_DEPTH, more_bits.data(), 40, nbits_decoded);
+    EXPECT_EQ(nbits_decoded, 15);
+    EXPECT_TRUE(std::equal(more_bits.begin(), more_bits.begin() + 15, sent.begin()));
+}
+
+
+TEST_F(ViterbiDecoderSbasTest, CorrectsNoisyAndErasedSymbols)
+{
+    std::vector<int> sent;
+    for (int index = 0; index < 8; index++)
+        {
+            const std::vector<int> message = frame(index);
+            sent.insert(sent.end(), message.begin(), message.end());
+        }
+    const std::vector<double> clean = encode(sent);
+
+    std::normal_distribution<double> noise(0.0, 0.4);
+    std::vector<double> symbols(clean);
+    for (auto& symbol : symbols)
+        {
+            symbol += noise(d_generator);
+        }
+    for (size_t n = 0; n + 4 <= symbols.size(); n += 100)
+        {
+            // a burst of four erased symbols (zero log-likelihood ratio), then an inverted one
+            std::fill(symbols.begin() + n, symbols.begin() + n + 4, 0.0);
+            if (n + 50 < symbols.size())
+                {
+                    symbols[n + 50] = -symbols[n + 50];
+                }
+        }
+
+    Viterbi_Decoder_Sbas clean_decoder(G_ENCODER.data(), KK, NN);
+    Viterbi_Decoder_Sbas decoder(G_ENCODER.data(), KK, NN);
+    std::vector<int> clean_bits(sent.size());
+    std::vector<int> bits(sent.size());
+    int nbits_decoded = 0;
+    const float clean_metric = clean_decoder.decode_continuous(clean.data(), TRACEBACK_DEPTH, clean_bits.data(), static_cast<int>(sent.size()), nbits_decoded);
+    const float metric = decoder.decode_continuous(symbols.data(), TRACEBACK_DEPTH, bits.data(), static_cast<int>(sent.size()), nbits_decoded);
+    ASSERT_EQ(nbits_decoded, static_cast<int>(sent.size()) - TRACEBACK_DEPTH);
+    EXPECT_TRUE(std::equal(bits.begin(), bits.begin() + nbits_decoded, sent.begin()));
+
+    // The metric of the decoded path drops with the corrupted symbols, but it
+    // stays well above the one of the misaligned symbols
+    EXPECT_LT(metric, clean_metric);
+    EXPECT_GT(metric, 1.0);
+    Viterbi_Decoder_Sbas misaligned_decoder(G_ENCODER.data(), KK, NN);
+    std::vector<double> misaligned(symbols.size(), 0.0);
+    std::copy(symbols.begin(), symbols.end() - 1, misaligned.begin() + 1);
+    const float misaligned_metric = misaligned_decoder.decode_continuous(misaligned.data(), TRACEBACK_DEPTH, bits.data(), static_cast<int>(sent.size()), nbits_decoded);
+    EXPECT_LT(misaligned_metric, metric);
+}
+
+
+TEST_F(ViterbiDecoderSbasTest, ResetStartsANewStream)
+{
+    Viterbi_Decoder_Sbas decoder(G_ENCODER.data(), KK, NN);
+    const std::vector<int> first = frame(0);
+    decode_in_chunks(decoder, encode(first), {100});
+
+    // The new stream starts again in the all-zeros state
+    decoder.reset();
+    d_encoder_state = 0;
+    const std::vector<int> second = frame(1);
+    const std::vector<int> decoded = decode_in_chunks(decoder, encode(second), {100});
+    ASSERT_EQ(decoded.size(), second.size() - TRACEBACK_DEPTH);
+    EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), second.begin()));
+}
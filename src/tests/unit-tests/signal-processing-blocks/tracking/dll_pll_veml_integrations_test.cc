@@ -0,0 +1,176 @@
+/*!
+ * \file dll_pll_veml_integrations_test.cc
+ * \brief Checks that running several integrations per work call does not
+ * change the outputs of the DLL/PLL tracking block.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "gnss_block_profiler.h"
+#include "gnss_synchro.h"
+#include "gps_sdr_signal_replica.h"
+#include "in_memory_configuration.h"
+#include "tracking_interface.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+class DllPllVemlIntegrationsTest : public ::testing::Test
+{
+protected:
+    DllPllVemlIntegrationsTest()
+    {
+        // PRN 1 at 45 dB-Hz, 400 ms at 4 Msps
+        const double fs = 4e6;
+        const double code_rate_cps = GPS_L1_CA_CODE_RATE_CPS * (1.0 + DOPPLER_HZ / GPS_L1_FREQ_HZ);
+        const auto code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+        std::vector<float> code(code_length);
+        gps_l1_ca_code_gen_float(code, 1, 0);
+        std::default_random_engine generator(2026);
+        std::normal_distribution<float> noise(0.0, static_cast<float>(std::sqrt(fs / std::pow(10.0, 4.5) / 2.0)));
+        d_signal.resize(1600000);
+        for (size_t n = 0; n < d_signal.size(); n++)
+            {
+                const double t = (static_cast<double>(n) - CODE_DELAY_SAMPLES) / fs;
+                const auto chip = static_cast<int64_t>(std::floor(t * code_rate_cps));
+                const int index = static_cast<int>(((chip % code_length) + code_length) % code_length);
+                const double phase = TWO_PI * DOPPLER_HZ * static_cast<double>(n) / fs;
+                d_signal[n] = code[index] * std::complex<float>(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase))) + std::complex<float>(noise(generator), noise(generator));
+            }
+    }
+
+    /*
+     * Runs the tracking block over the whole signal and returns its outputs.
+     * The number of work calls of the tracking block is stored in \p work_calls.
+     */
+    std::vector<Gnss_Synchro> track(bool multiple_integrations_per_call, uint64_t& work_calls)
+    {
+        work_calls = 0;
+        auto config = std::make_shared<InMemoryConfiguration>();
+        config->set_property("GNSS-SDR.internal_fs_sps", "4000000");
+        config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+        config->set_property("Tracking_1C.item_type", "gr_complex");
+        config->set_property("Tracking_1C.pll_bw_hz", "35.0");
+        config->set_property("Tracking_1C.dll_bw_hz", "2.0");
+        config->set_property("Tracking_1C.early_late_space_chips", "0.5");
+        config->set_property("Tracking_1C.multiple_integrations_per_call", multiple_integrations_per_call ? "true" : "false");
+
+        auto factory = std::make_shared<GNSSBlockFactory>();
+        auto tracking = std::dynamic_pointer_cast<TrackingInterface>(factory->GetBlock(config.get(), "Tracking_1C", 1, 1));
+        EXPECT_TRUE(tracking != nullptr);
+        if (tracking == nullptr)
+            {
+                return {};
+            }
+
+        Gnss_Synchro gnss_synchro{};
+        gnss_synchro.Channel_ID = 0;
+        gnss_synchro.System = 'G';
+        gnss_synchro.Signal[0] = '1';
+        gnss_synchro.Signal[1] = 'C';
+        gnss_synchro.PRN = 1;
+        // Coarse estimates, so the pull-in stage has something to do
+        gnss_synchro.Acq_delay_samples = CODE_DELAY_SAMPLES + 1.0;
+        gnss_synchro.Acq_doppler_hz = DOPPLER_HZ - 150.0;
+        gnss_synchro.Acq_samplestamp_samples = 0;
+
+        auto top_block = gr::make_top_block("Tracking integrations test");
+        tracking->set_channel(gnss_synchro.Channel_ID);
+        tracking->set_gnss_synchro(&gnss_synchro);
+        tracking->connect(top_block);
+        auto source = gr::blocks::vector_source_c::make(d_signal);
+        auto sink = gr::blocks::vector_sink_b::make(static_cast<int>(sizeof(Gnss_Synchro)));
+        top_block->connect(source, 0, tracking->get_left_block(), 0);
+        top_block->connect(tracking->get_right_block(), 0, sink, 0);
+        tracking->start_tracking();
+        auto& profiler = Gnss_Block_Profiler::instance();
+        profiler.start("");
+        top_block->run();
+        profiler.stop();
+
+        // The statistics go away with the block, read them before returning
+        std::istringstream report(profiler.report());
+        std::string line;
+        while (std::getline(report, line))
+            {
+                if (line.compare(0, std::strlen("dll_pll_veml_tracking ("), "dll_pll_veml_tracking (") == 0)
+                    {
+                        std::istringstream(line.substr(40)) >> work_calls;
+                    }
+            }
+
+        const std::vector<unsigned char>& bytes = sink->data();
+        std::vector<Gnss_Synchro> outputs(bytes.size() / sizeof(Gnss_Synchro));
+        if (!outputs.empty())
+            {
+                std::memcpy(outputs.data(), bytes.data(), outputs.size() * sizeof(Gnss_Synchro));
+            }
+        return outputs;
+    }
+
+    static constexpr double DOPPLER_HZ = 1250.0;
+    static constexpr double CODE_DELAY_SAMPLES = 1000.0;
+    std::vector<std::complex<float>> d_signal;
+};
+
+
+constexpr double DllPllVemlIntegrationsTest::DOPPLER_HZ;
+constexpr double DllPllVemlIntegrationsTest::CODE_DELAY_SAMPLES;
+
+
+TEST_F(DllPllVemlIntegrationsTest, SameOutputsAsOneIntegrationPerCall)
+{
+    uint64_t expected_calls = 0;
+    uint64_t actual_calls = 0;
+    const auto expected = track(false, expected_calls);
+    const auto actual = track(true, actual_calls);
+
+    // The channel locked, so the comparison covers the tracking loops
+    ASSERT_GT(expected.size(), 300U);
+    EXPECT_TRUE(expected.back().Flag_valid_symbol_output);
+    EXPECT_NEAR(expected.back().Carrier_Doppler_hz, DOPPLER_HZ, 10.0);
+
+    // At most one output per work call, or several on average
+    EXPECT_GE(expected_calls, expected.size());
+    ASSERT_GT(actual_calls, 0U);
+    EXPECT_LT(actual_calls, actual.size());
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t n = 0; n < expected.size(); n++)
+        {
+            EXPECT_EQ(expected[n].Tracking_sample_counter, actual[n].Tracking_sample_counter) << "output " << n;
+            EXPECT_EQ(expected[n].Prompt_I, actual[n].Prompt_I) << "output " << n;
+            EXPECT_EQ(expected[n].Prompt_Q, actual[n].Prompt_Q) << "output " << n;
+            EXPECT_EQ(expected[n].Carrier_Doppler_hz, actual[n].Carrier_Doppler_hz) << "output " << n;
+            EXPECT_EQ(expected[n].Carrier_phase_rads, actual[n].Carrier_phase_rads) << "output " << n;
+            EXPECT_EQ(expected[n].Code_phase_samples, actual[n].Code_phase_samples) << "output " << n;
+            EXPECT_EQ(expected[n].CN0_dB_hz, actual[n].CN0_dB_hz) << "output " << n;
+            EXPECT_EQ(expected[n].Flag_valid_symbol_output, actual[n].Flag_valid_symbol_output) << "output " << n;
+            EXPECT_EQ(expected[n].correlation_length_ms, actual[n].correlation_length_ms) << "output " << n;
+        }
+}
@@ -0,0 +1,229 @@
+/*!
+ * \file tracking_batch_correlator_test.cc
+ * \brief Checks that the batched multicorrelator reproduces the outputs of
+ * Cpu_Multicorrelator_Real_Codes.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "MATH_CONSTANTS.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_replica.h"
+#include "tracking_batch_correlator.h"
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+constexpr int BATCH_TEST_CHANNELS = 8;
+constexpr int BATCH_TEST_TAPS = 3;
+constexpr double BATCH_TEST_FS_HZ = 4e6;
+// One code period at 4 Msps
+constexpr int BATCH_TEST_SIGNAL_LENGTH = 4000;
+}  // namespace
+
+
+class TrackingBatchCorrelatorTest : public ::testing::Test
+{
+public:
+    TrackingBatchCorrelatorTest() : d_code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)),
+                                    d_signal(2 * BATCH_TEST_SIGNAL_LENGTH),
+                                    d_shifts_chips(BATCH_TEST_TAPS)
+    {
+        gps_l1_ca_code_gen_float(d_code, 1, 0);
+        // Early, Prompt and Late taps half a chip apart
+        d_shifts_chips[0] = -0.5;
+        d_shifts_chips[1] = 0.0;
+        d_shifts_chips[2] = 0.5;
+
+        // PRN 1 with a Doppler of 1.5 kHz at 4 Msps, plus noise
+        std::default_random_engine generator(1234);
+        std::normal_distribution<float> noise(0.0, 1.0);
+        const double code_rate_cps = GPS_L1_CA_CODE_RATE_CPS * (1.0 + doppler_hz(0) / GPS_L1_FREQ_HZ);
+        for (int n = 0; n < 2 * BATCH_TEST_SIGNAL_LENGTH; n++)
+            {
+                const auto chip = static_cast<int>(std::floor(code_rate_cps * static_cast<double>(n) / BATCH_TEST_FS_HZ));
+                const double phase = TWO_PI * doppler_hz(0) * static_cast<double>(n) / BATCH_TEST_FS_HZ;
+                d_signal[n] = d_code[chip % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)] * std::complex<float>(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase))) + std::complex<float>(noise(generator), noise(generator));
+            }
+    }
+
+    // Doppler hypothesis of channel ch, kHz apart as in a real receiver
+    static double doppler_hz(int ch)
+    {
+        return 1500.0 - 700.0 * static_cast<double>(ch);
+    }
+
+    // Parameters of channel ch, emulating channels at different code phases
+    // and Doppler shifts that read overlapping parts of the same buffer
+    Tracking_Correlation_Job make_job(int ch, std::complex<float>* corr_out, bool high_dynamics) const
+    {
+        const double code_rate_cps = GPS_L1_CA_CODE_RATE_CPS * (1.0 + doppler_hz(ch) / GPS_L1_FREQ_HZ);
+        Tracking_Correlation_Job job;
+        job.corr_out = corr_out;
+        job.sig_in = d_signal.data() + 37 * ch;
+        job.local_code = d_code.data();
+        job.shifts_chips = d_shifts_chips.data();
+        job.rem_carrier_phase_rad = 0.1F * static_cast<float>(ch);
+        job.phase_step_rad = static_cast<float>(TWO_PI * doppler_hz(ch) / BATCH_TEST_FS_HZ);
+        job.phase_rate_step_rad = static_cast<float>(TWO_PI * 50.0 / (BATCH_TEST_FS_HZ * BATCH_TEST_FS_HZ));
+        job.rem_code_phase_chips = -0.01F * static_cast<float>(ch);
+        job.code_phase_step_chips = static_cast<float>(code_rate_cps / BATCH_TEST_FS_HZ);
+        job.code_phase_rate_step_chips = static_cast<float>(50.0 / GPS_L1_FREQ_HZ * GPS_L1_CA_CODE_RATE_CPS / (BATCH_TEST_FS_HZ * BATCH_TEST_FS_HZ));
+        job.code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+        job.n_correlators = BATCH_TEST_TAPS;
+        // The loops adjust the integration length to the code phase
+        job.signal_length_samples = BATCH_TEST_SIGNAL_LENGTH - ch;
+        job.high_dynamics = high_dynamics;
+        return job;
+    }
+
+    void reference(const Tracking_Correlation_Job& job, std::complex<float>* corr_out)
+    {
+        Cpu_Multicorrelator_Real_Codes correlator;
+        correlator.set_high_dynamics_resampler(job.high_dynamics);
+        correlator.init(job.signal_length_samples, job.n_correlators);
+        correlator.set_local_code_and_taps(job.code_length_chips, job.local_code, d_shifts_chips.data());
+        correlator.set_input_output_vectors(corr_out, job.sig_in);
+        correlator.Carrier_wipeoff_multicorrelator_resampler(job.rem_carrier_phase_rad,
+            job.phase_step_rad,
+            job.phase_rate_step_rad,
+            job.rem_code_phase_chips,
+            job.code_phase_step_chips,
+            job.code_phase_rate_step_chips,
+            job.signal_length_samples);
+        correlator.free();
+    }
+
+    void check(const std::complex<float>* expected, const std::complex<float>* actual) const
+    {
+        // Same kernels with the same arguments, so the results are identical
+        for (int tap = 0; tap < BATCH_TEST_TAPS; tap++)
+            {
+                EXPECT_EQ(expected[tap].real(), actual[tap].real()) << "tap " << tap;
+                EXPECT_EQ(expected[tap].imag(), actual[tap].imag()) << "tap " << tap;
+            }
+    }
+
+    void check_batch(bool high_dynamics)
+    {
+        std::vector<volk_gnsssdr::vector<std::complex<float>>> expected(BATCH_TEST_CHANNELS, volk_gnsssdr::vector<std::complex<float>>(BATCH_TEST_TAPS));
+        std::vector<volk_gnsssdr::vector<std::complex<float>>> actual(BATCH_TEST_CHANNELS, volk_gnsssdr::vector<std::complex<float>>(BATCH_TEST_TAPS));
+        std::vector<Tracking_Correlation_Job> jobs;
+        std::vector<Tracking_Correlation_Job*> job_pointers;
+        jobs.reserve(BATCH_TEST_CHANNELS);
+        for (int ch = 0; ch < BATCH_TEST_CHANNELS; ch++)
+            {
+                jobs.push_back(make_job(ch, actual[ch].data(), high_dynamics));
+                reference(jobs.back(), expected[ch].data());
+            }
+        // Submit the channels in reverse order, the batch sorts them back
+        for (int ch = BATCH_TEST_CHANNELS - 1; ch >= 0; ch--)
+            {
+                job_pointers.push_back(&jobs[ch]);
+            }
+
+        Tracking_Batch_Correlator batch;
+        batch.correlate(job_pointers.data(), job_pointers.size());
+
+        // The code of channel 0 is aligned with the signal
+        EXPECT_GT(std::abs(actual[0][1]), std::abs(actual[0][0]));
+        EXPECT_GT(std::abs(actual[0][1]), std::abs(actual[0][2]));
+        for (int ch = 0; ch < BATCH_TEST_CHANNELS; ch++)
+            {
+                check(expected[ch].data(), actual[ch].data());
+            }
+    }
+
+    void check_concurrent_channels(bool high_dynamics)
+    {
+        std::vector<volk_gnsssdr::vector<std::complex<float>>> expected(BATCH_TEST_CHANNELS, volk_gnsssdr::vector<std::complex<float>>(BATCH_TEST_TAPS));
+        std::vector<volk_gnsssdr::vector<std::complex<float>>> actual(BATCH_TEST_CHANNELS, volk_gnsssdr::vector<std::complex<float>>(BATCH_TEST_TAPS));
+        std::vector<Tracking_Correlation_Job> jobs;
+        jobs.reserve(BATCH_TEST_CHANNELS);
+        for (int ch = 0; ch < BATCH_TEST_CHANNELS; ch++)
+            {
+                jobs.push_back(make_job(ch, actual[ch].data(), high_dynamics));
+                reference(jobs.back(), expected[ch].data());
+            }
+
+        // Each thread emulates the scheduler thread of a tracking block
+        auto batch = tracking_batch_correlator();
+        std::vector<std::thread> channels;
+        for (int ch = 0; ch < BATCH_TEST_CHANNELS; ch++)
+            {
+                channels.emplace_back([&batch, &jobs, ch]() {
+                    for (int iteration = 0; iteration < 20; iteration++)
+                        {
+                            batch->execute(&jobs[ch], 1);
+                        }
+                });
+            }
+        for (auto& channel : channels)
+            {
+                channel.join();
+            }
+
+        for (int ch = 0; ch < BATCH_TEST_CHANNELS; ch++)
+            {
+                check(expected[ch].data(), actual[ch].data());
+            }
+    }
+
+    volk_gnsssdr::vector<float> d_code;
+    volk_gnsssdr::vector<std::complex<float>> d_signal;
+    volk_gnsssdr::vector<float> d_shifts_chips;
+};
+
+
+TEST_F(TrackingBatchCorrelatorTest, MatchesMulticorrelator)
+{
+    check_batch(false);
+}
+
+
+TEST_F(TrackingBatchCorrelatorTest, MatchesHighDynamicsMulticorrelator)
+{
+    check_batch(true);
+}
+
+
+TEST_F(TrackingBatchCorrelatorTest, ConcurrentChannels)
+{
+    check_concurrent_channels(false);
+    check_concurrent_channels(true);
+}
+
+
+TEST_F(TrackingBatchCorrelatorTest, ChannelsAreSpreadAmongCombiners)
+{
+    const unsigned int combiners = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::shared_ptr<Tracking_Batch_Correlator>> channels;
+    std::set<Tracking_Batch_Correlator*> distinct;
+    for (unsigned int ch = 0; ch < 2 * combiners; ch++)
+        {
+            channels.push_back(tracking_batch_correlator());
+            distinct.insert(channels.back().get());
+        }
+    EXPECT_EQ(distinct.size(), combiners);
+}
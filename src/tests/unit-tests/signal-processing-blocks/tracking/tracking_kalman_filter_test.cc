@@ -0,0 +1,194 @@
+/*!
+ * \file tracking_kalman_filter_test.cc
+ * \brief Checks Tracking_Kalman_Filter against the Armadillo formulation
+ * previously used by kf_vtl_tracking.
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "MATH_CONSTANTS.h"
+#include "tracking_kalman_filter.h"
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+
+namespace
+{
+// Kalman filter of kf_vtl_tracking as written with Armadillo matrices
+class Reference_Kalman_Filter
+{
+public:
+    void set_F(double Ti)
+    {
+        F = arma::mat(5, 5);
+        F << 1 << 0 << 0 << 0 << Ti << arma::endr
+          << 0 << 1 << 2.0 * GNSS_PI * Ti << GNSS_PI * (Ti * Ti) << 0 << arma::endr
+          << 0 << 0 << 1 << Ti << 0 << arma::endr
+          << 0 << 0 << 0 << 1 << 0 << arma::endr
+          << 0 << 0 << 0 << 0 << 1 << arma::endr;
+    }
+
+    void set_H(double Ti, double B)
+    {
+        H = arma::mat(2, 5);
+        H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
+          << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
+    }
+
+    void update(double code_error_chips, double carrier_phase_error_rad)
+    {
+        const arma::vec x_pred = F * x;
+        const arma::mat P_pred = F * P * F.t() + Q;
+        const arma::vec z = {code_error_chips, carrier_phase_error_rad};
+        const arma::mat K = P_pred * H.t() * arma::inv(H * P_pred * H.t() + R);
+        x = x_pred + K * z;
+        P = (arma::eye(5, 5) - K * H) * P_pred;
+    }
+
+    arma::mat F;
+    arma::mat H;
+    arma::mat R;
+    arma::mat Q;
+    arma::mat P;
+    arma::vec x;
+};
+}  // namespace
+
+
+class TrackingKalmanFilterTest : public ::testing::Test
+{
+protected:
+    TrackingKalmanFilterTest() : d_noise(0.0, 1.0),
+                                 d_B(GPS_L1_CA_CODE_RATE_CPS / GPS_L1_FREQ_HZ)
+    {
+    }
+
+    // kf_vtl_tracking::init_kf()
+    void init(double Ti)
+    {
+        d_kf.set_model(Ti, d_B);
+        d_kf.set_measurement_noise(0.01 * 0.01, 0.1 * 0.1);
+        d_kf.set_process_noise({1e-4, 1e-3, 1.0, 10.0, 1e-3});
+        d_kf.reset({0.1, 0.0, 1250.0, 0.0, 0.0}, {1.0, 1.0, 100.0, 10.0, 1.0});
+
+        d_ref.set_F(Ti);
+        d_ref.set_H(Ti, d_B);
+        d_ref.R = arma::diagmat(arma::vec({0.01 * 0.01, 0.1 * 0.1}));
+        d_ref.Q = arma::diagmat(arma::vec({1e-4, 1e-3, 1.0, 10.0, 1e-3}));
+        d_ref.P = arma::diagmat(arma::vec({1.0, 1.0, 100.0, 10.0, 1.0}));
+        d_ref.x = arma::vec({0.1, 0.0, 1250.0, 0.0, 0.0});
+    }
+
+    // kf_vtl_tracking::update_kf_narrow_integration_time()
+    void narrow(double Ti)
+    {
+        d_kf.set_model(Ti, d_B);
+        d_kf.set_measurement_noise(0.01 * 0.01, 0.1 * 0.1);
+        d_kf.set_process_noise({1e-5, 1e-4, 0.1, 1.0, 1e-4});
+
+        d_ref.set_F(Ti);
+        d_ref.set_H(Ti, d_B);
+        d_ref.R = arma::diagmat(arma::vec({0.01 * 0.01, 0.1 * 0.1}));
+        d_ref.Q = arma::diagmat(arma::vec({1e-5, 1e-4, 0.1, 1.0, 1e-4}));
+    }
+
+    // kf_vtl_tracking::update_kf_cn0(), which uses the correlation length of
+    // one code period and keeps the state transition matrix
+    void cn0(double Ti, double cn0_dbhz)
+    {
+        const double CN0_lin = std::pow(10.0, cn0_dbhz / 10.0);
+        const double Sigma2_Tau = 0.25 * (1.0 + 2.0 * CN0_lin * Ti) / std::pow(CN0_lin * Ti, 2.0) * (1.0 + (1.0 + 2.0 * CN0_lin * Ti) / std::pow(CN0_lin * Ti, 2.0));
+        const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
+
+        d_kf.set_measurement_matrix(Ti, d_B);
+        d_kf.set_measurement_noise(Sigma2_Tau, Sigma2_Phase);
+
+        d_ref.set_H(Ti, d_B);
+        d_ref.R = arma::diagmat(arma::vec({Sigma2_Tau, Sigma2_Phase}));
+    }
+
+    // kf_vtl_tracking::run_Kf(), which resets the code phase and code rate
+    // errors after each update
+    void run(int epochs)
+    {
+        for (int epoch = 0; epoch < epochs; epoch++)
+            {
+                const double code_error_chips = 0.02 * d_noise(d_generator);
+                const double carrier_phase_error_rad = 0.1 * d_noise(d_generator);
+                d_kf.update(code_error_chips, carrier_phase_error_rad);
+                d_ref.update(code_error_chips, carrier_phase_error_rad);
+                for (size_t i = 0; i < Tracking_Kalman_Filter::NUM_STATES; i++)
+                    {
+                        ASSERT_NEAR(d_kf.state(i), d_ref.x(i), 1e-12 * (1.0 + std::abs(d_ref.x(i)))) << "state " << i << ", epoch " << epoch;
+                    }
+                d_kf.set_state(0, 0.0);
+                d_kf.set_state(4, 0.0);
+                d_ref.x(0) = 0.0;
+                d_ref.x(4) = 0.0;
+            }
+    }
+
+    Tracking_Kalman_Filter d_kf;
+    Reference_Kalman_Filter d_ref;
+    std::default_random_engine d_generator{1234};
+    std::normal_distribution<double> d_noise;
+    double d_B;
+};
+
+
+TEST_F(TrackingKalmanFilterTest, MatchesReferenceAtOneCodePeriod)
+{
+    init(0.001);
+    run(2000);
+}
+
+
+TEST_F(TrackingKalmanFilterTest, MatchesReferenceAfterNarrowingTheIntegrationTime)
+{
+    init(0.001);
+    run(500);
+    narrow(0.02);
+    run(500);
+}
+
+
+TEST_F(TrackingKalmanFilterTest, MatchesReferenceWithEstimatedCn0)
+{
+    init(0.001);
+    run(500);
+    narrow(0.02);
+    for (int n = 0; n < 200; n++)
+        {
+            cn0(0.001, 40.0 + 5.0 * std::sin(0.05 * n));
+            run(5);
+        }
+}
+
+
+TEST_F(TrackingKalmanFilterTest, MeasurementMatrixKeepsTheStateTransition)
+{
+    // After narrowing, updating the measurement model must not bring back the
+    // state transition matrix of one code period
+    init(0.001);
+    narrow(0.02);
+    cn0(0.001, 45.0);
+    d_kf.reset({0.0, 0.0, 1250.0, 100.0, 0.0}, {1.0, 1.0, 1.0, 1.0, 1.0});
+    d_kf.set_process_noise({0.0, 0.0, 0.0, 0.0, 0.0});
+    d_kf.update(0.0, 0.0);
+    // The Doppler rate advances the Doppler by 100 Hz/s over 20 ms
+    EXPECT_NEAR(d_kf.state(2), 1252.0, 1e-9);
+}
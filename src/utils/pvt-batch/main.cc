@@ -0,0 +1,130 @@
+/*!
+ * \file main.cc
+ * \brief Solves the PVT of the observables logged by a receiver, using all
+ * the cores
+ * \author agent, 2026. agent(at)local
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2026  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"  // for R2D
+#include "file_configuration.h"
+#include "gnss_sdr_flags.h"
+#include "pvt_batch_solver.h"
+#include "pvt_observables_log.h"
+#include "rtklib_pvt.h"
+#include "rtklib_rtkcmn.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(pvt_role, "PVT", "Role of the PVT block in the configuration file.");
+DEFINE_int32(threads, 0, "Number of threads used in single positioning mode, 0 for one per core.");
+DEFINE_bool(smoothing, true, "Combine a forward and a backward pass in kinematic positioning modes.");
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n pvt-batch solves the PVT of the observables logged by the receiver with PVT.log_observables=true,\n") +
+        " using the RTKLIB options of its configuration file.\n" +
+        "Copyright (C) 2010-2022 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License.\n \n" +
+        "Usage: \n" +
+        "   pvt-batch --config_file=<receiver configuration> <observables log> <output CSV file>");
+
+    gflags::SetUsageMessage(intro_help);
+    gflags::SetVersionString(GNSS_SDR_VERSION);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (argc != 3)
+        {
+            std::cerr << "Usage:\n";
+            std::cerr << "   " << argv[0]
+                      << " --config_file=<receiver configuration> <observables log> <output CSV file>"
+                      << '\n';
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+    const std::string log_filename(argv[1]);
+    const std::string output_filename(argv[2]);
+
+    const auto configuration = std::make_shared<FileConfiguration>(FLAGS_config_file);
+    const prcopt_t options = Rtklib_Pvt::get_rtklib_options(configuration.get(), FLAGS_pvt_role);
+    const bool pre_2009_file = configuration->property("GNSS-SDR.pre_2009_file", false);
+
+    Pvt_Recorded_Observables recording;
+    if (!recording.read(log_filename))
+        {
+            std::cerr << "Cannot read the observables log " << log_filename << '\n';
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+    std::cout << "Read " << recording.epochs.size() << " epochs and "
+              << recording.navigation.size() << " navigation messages from " << log_filename << '\n';
+
+    const auto start = std::chrono::steady_clock::now();
+    const Pvt_Batch_Solver solver(options, pre_2009_file, static_cast<uint32_t>(FLAGS_threads), FLAGS_smoothing);
+    const std::vector<Pvt_Batch_Solution> solutions = solver.solve(recording);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::ofstream output(output_filename);
+    if (!output.is_open())
+        {
+            std::cerr << "Cannot create " << output_filename << '\n';
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+    output << "rx_time_s,week,tow_s,x_m,y_m,z_m,latitude_deg,longitude_deg,height_m,vx_m_s,vy_m_s,vz_m_s,status,num_sats\n";
+    std::size_t num_solved = 0;
+    for (const auto& solution : solutions)
+        {
+            if (!solution.valid)
+                {
+                    continue;
+                }
+            int week = 0;
+            const double tow = time2gpst(solution.sol.time, &week);
+            std::array<double, 3> pos{};
+            ecef2pos(solution.sol.rr, pos.data());
+            output << std::fixed << std::setprecision(3) << solution.rx_time << ',' << week << ',' << tow << ','
+                   << solution.sol.rr[0] << ',' << solution.sol.rr[1] << ',' << solution.sol.rr[2] << ','
+                   << std::setprecision(9) << pos[0] * R2D << ',' << pos[1] * R2D << ','
+                   << std::setprecision(3) << pos[2] << ','
+                   << solution.sol.rr[3] << ',' << solution.sol.rr[4] << ',' << solution.sol.rr[5] << ','
+                   << static_cast<int>(solution.sol.stat) << ',' << static_cast<int>(solution.sol.ns) << '\n';
+            num_solved++;
+        }
+
+    std::cout << "Solved " << num_solved << " of " << solutions.size() << " epochs in "
+              << elapsed.count() << " s, solutions written to " << output_filename << '\n';
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}